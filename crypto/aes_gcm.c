@@ -0,0 +1,384 @@
+/****************************************************************************
+ * crypto/aes_gcm.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+
+#include <nuttx/crypto/aes.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define GCM_BLOCK_SIZE  16
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The reduction of the four bits shifted out of the 128-bit value by
+ * each 4-bit step of the GHASH multiplication (Shoup's method).
+ */
+
+static const uint16_t g_last4[16] =
+{
+  0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+  0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static uint64_t gcm_getu64(FAR const uint8_t *p)
+{
+  return ((uint64_t)p[0] << 56) | ((uint64_t)p[1] << 48) |
+         ((uint64_t)p[2] << 40) | ((uint64_t)p[3] << 32) |
+         ((uint64_t)p[4] << 24) | ((uint64_t)p[5] << 16) |
+         ((uint64_t)p[6] << 8)  |  (uint64_t)p[7];
+}
+
+static void gcm_putu64(FAR uint8_t *p, uint64_t v)
+{
+  int i;
+
+  for (i = 7; i >= 0; i--)
+    {
+      p[i] = (uint8_t)v;
+      v  >>= 8;
+    }
+}
+
+/****************************************************************************
+ * Name: gcm_mult
+ *
+ * Description:
+ *   x = x * H in GF(2^128) using the 4-bit table prepared by
+ *   aes_gcm_setkey().
+ *
+ ****************************************************************************/
+
+static void gcm_mult(FAR const struct aes_gcm_s *gcm, FAR uint8_t *x)
+{
+  uint64_t zh;
+  uint64_t zl;
+  uint8_t lo;
+  uint8_t hi;
+  uint8_t rem;
+  int i;
+
+  lo = x[15] & 0x0f;
+  zh = gcm->hh[lo];
+  zl = gcm->hl[lo];
+
+  for (i = 15; i >= 0; i--)
+    {
+      lo = x[i] & 0x0f;
+      hi = x[i] >> 4;
+
+      if (i != 15)
+        {
+          rem = (uint8_t)(zl & 0x0f);
+          zl  = (zh << 60) | (zl >> 4);
+          zh  = (zh >> 4) ^ ((uint64_t)g_last4[rem] << 48);
+          zh ^= gcm->hh[lo];
+          zl ^= gcm->hl[lo];
+        }
+
+      rem = (uint8_t)(zl & 0x0f);
+      zl  = (zh << 60) | (zl >> 4);
+      zh  = (zh >> 4) ^ ((uint64_t)g_last4[rem] << 48);
+      zh ^= gcm->hh[hi];
+      zl ^= gcm->hl[hi];
+    }
+
+  gcm_putu64(x, zh);
+  gcm_putu64(x + 8, zl);
+}
+
+/****************************************************************************
+ * Name: gcm_ghash
+ *
+ * Description:
+ *   Add 'len' bytes of data to the GHASH value 'x'.  A final partial block
+ *   is padded with zeros.
+ *
+ ****************************************************************************/
+
+static void gcm_ghash(FAR const struct aes_gcm_s *gcm, FAR uint8_t *x,
+                      FAR const uint8_t *data, size_t len)
+{
+  size_t n;
+  size_t i;
+
+  while (len > 0)
+    {
+      n = len < GCM_BLOCK_SIZE ? len : GCM_BLOCK_SIZE;
+      for (i = 0; i < n; i++)
+        {
+          x[i] ^= data[i];
+        }
+
+      gcm_mult(gcm, x);
+      data += n;
+      len  -= n;
+    }
+}
+
+/****************************************************************************
+ * Name: gcm_incr
+ *
+ * Description:
+ *   Increment the rightmost 32 bits of the counter block.
+ *
+ ****************************************************************************/
+
+static void gcm_incr(FAR uint8_t *counter)
+{
+  int i;
+
+  for (i = GCM_BLOCK_SIZE - 1; i >= GCM_BLOCK_SIZE - 4; i--)
+    {
+      if (++counter[i] != 0)
+        {
+          break;
+        }
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: aes_gcm_setkey
+ *
+ * Description:
+ *   Configure the given AES-GCM context for operation with the selected
+ *   key.  See include/nuttx/crypto/aes.h.
+ *
+ ****************************************************************************/
+
+int aes_gcm_setkey(FAR struct aes_gcm_s *gcm, FAR const uint8_t *key,
+                   int len)
+{
+  uint8_t h[GCM_BLOCK_SIZE];
+  uint64_t vh;
+  uint64_t vl;
+  int ret;
+  int i;
+  int j;
+
+  ret = aes_setupkey(&gcm->aes, key, len);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* The hash subkey is the encryption of the zero block */
+
+  memset(h, 0, sizeof(h));
+  aes_encipher(&gcm->aes, h, 1);
+
+  /* Precompute the products of H with all 4-bit values.  The bit order of
+   * GHASH is reflected, so 8 * H is H itself and halving is a
+   * multiplication by x.
+   */
+
+  vh = gcm_getu64(h);
+  vl = gcm_getu64(h + 8);
+
+  gcm->hl[8] = vl;
+  gcm->hh[8] = vh;
+  gcm->hl[0] = 0;
+  gcm->hh[0] = 0;
+
+  for (i = 4; i > 0; i >>= 1)
+    {
+      uint32_t t = (vl & 1) ? 0xe1000000 : 0;
+
+      vl = (vh << 63) | (vl >> 1);
+      vh = (vh >> 1) ^ ((uint64_t)t << 32);
+
+      gcm->hl[i] = vl;
+      gcm->hh[i] = vh;
+    }
+
+  for (i = 2; i <= 8; i <<= 1)
+    {
+      vh = gcm->hh[i];
+      vl = gcm->hl[i];
+
+      for (j = 1; j < i; j++)
+        {
+          gcm->hh[i + j] = vh ^ gcm->hh[j];
+          gcm->hl[i + j] = vl ^ gcm->hl[j];
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: aes_gcm_crypt
+ *
+ * Description:
+ *   AES-GCM authenticated encryption and decryption.  See
+ *   include/nuttx/crypto/aes.h.
+ *
+ ****************************************************************************/
+
+int aes_gcm_crypt(FAR struct aes_gcm_s *gcm, int encrypt,
+                  FAR const uint8_t *iv, size_t ivlen,
+                  FAR const uint8_t *aad, size_t aadlen,
+                  FAR const uint8_t *in, FAR uint8_t *out, size_t len,
+                  FAR uint8_t *tag, size_t taglen)
+{
+  uint8_t counter[GCM_BLOCK_SIZE];
+  uint8_t ectr0[GCM_BLOCK_SIZE];
+  uint8_t stream[GCM_BLOCK_SIZE];
+  uint8_t ghash[GCM_BLOCK_SIZE];
+  uint8_t lenblk[GCM_BLOCK_SIZE];
+  uint8_t diff;
+  size_t remaining;
+  size_t n;
+  size_t i;
+
+  if (ivlen == 0 || taglen < 4 || taglen > AES_GCM_TAG_SIZE)
+    {
+      return -EINVAL;
+    }
+
+  /* Form the pre-counter block J0 */
+
+  if (ivlen == AES_GCM_IV_SIZE)
+    {
+      memcpy(counter, iv, AES_GCM_IV_SIZE);
+      counter[12] = 0;
+      counter[13] = 0;
+      counter[14] = 0;
+      counter[15] = 1;
+    }
+  else
+    {
+      memset(counter, 0, sizeof(counter));
+      gcm_ghash(gcm, counter, iv, ivlen);
+
+      memset(lenblk, 0, sizeof(lenblk));
+      gcm_putu64(lenblk + 8, (uint64_t)ivlen * 8);
+      gcm_ghash(gcm, counter, lenblk, GCM_BLOCK_SIZE);
+    }
+
+  memcpy(ectr0, counter, GCM_BLOCK_SIZE);
+  aes_encipher(&gcm->aes, ectr0, 1);
+
+  /* Authenticate the additional data */
+
+  memset(ghash, 0, sizeof(ghash));
+  gcm_ghash(gcm, ghash, aad, aadlen);
+
+  /* Encrypt or decrypt with the counter starting at J0 + 1.  The cipher
+   * text is added to the hash as each block is processed.
+   */
+
+  for (remaining = len; remaining > 0; remaining -= n)
+    {
+      n = remaining < GCM_BLOCK_SIZE ? remaining : GCM_BLOCK_SIZE;
+
+      gcm_incr(counter);
+      memcpy(stream, counter, GCM_BLOCK_SIZE);
+      aes_encipher(&gcm->aes, stream, 1);
+
+      if (!encrypt)
+        {
+          gcm_ghash(gcm, ghash, in, n);
+        }
+
+      for (i = 0; i < n; i++)
+        {
+          out[i] = in[i] ^ stream[i];
+        }
+
+      if (encrypt)
+        {
+          gcm_ghash(gcm, ghash, out, n);
+        }
+
+      in  += n;
+      out += n;
+    }
+
+  /* Add the lengths in bits and compute the tag */
+
+  gcm_putu64(lenblk, (uint64_t)aadlen * 8);
+  gcm_putu64(lenblk + 8, (uint64_t)len * 8);
+  gcm_ghash(gcm, ghash, lenblk, GCM_BLOCK_SIZE);
+
+  for (i = 0; i < GCM_BLOCK_SIZE; i++)
+    {
+      ghash[i] ^= ectr0[i];
+    }
+
+  memset(stream, 0, sizeof(stream));
+
+  if (encrypt)
+    {
+      memcpy(tag, ghash, taglen);
+      return OK;
+    }
+
+  /* Verify the tag in constant time */
+
+  for (diff = 0, i = 0; i < taglen; i++)
+    {
+      diff |= tag[i] ^ ghash[i];
+    }
+
+  if (diff != 0)
+    {
+      memset(out - len, 0, len);
+      return -EBADMSG;
+    }
+
+  return OK;
+}
@@ -0,0 +1,506 @@
+/****************************************************************************
+ * crypto/chacha20poly1305.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+
+#include <nuttx/crypto/chacha20poly1305.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define CHACHA20_BLOCK_SIZE  64
+#define POLY1305_BLOCK_SIZE  16
+#define POLY1305_MASK26      0x3ffffff
+
+#define ROL32(x, n)          (((x) << (n)) | ((x) >> (32 - (n))))
+
+#define GETU32LE(p) \
+  ((uint32_t)(p)[0] | ((uint32_t)(p)[1] << 8) | \
+   ((uint32_t)(p)[2] << 16) | ((uint32_t)(p)[3] << 24))
+
+#define PUTU32LE(p, v) \
+  do \
+    { \
+      (p)[0] = (uint8_t)(v); \
+      (p)[1] = (uint8_t)((v) >> 8); \
+      (p)[2] = (uint8_t)((v) >> 16); \
+      (p)[3] = (uint8_t)((v) >> 24); \
+    } \
+  while (0)
+
+#define QUARTERROUND(x, a, b, c, d) \
+  do \
+    { \
+      x[a] += x[b]; x[d] ^= x[a]; x[d] = ROL32(x[d], 16); \
+      x[c] += x[d]; x[b] ^= x[c]; x[b] = ROL32(x[b], 12); \
+      x[a] += x[b]; x[d] ^= x[a]; x[d] = ROL32(x[d], 8); \
+      x[c] += x[d]; x[b] ^= x[c]; x[b] = ROL32(x[b], 7); \
+    } \
+  while (0)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* Poly1305 state with the 130-bit values held in five 26-bit limbs */
+
+struct poly1305_s
+{
+  uint32_t r[5];
+  uint32_t h[5];
+  uint32_t pad[4];
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: chacha20_init
+ *
+ * Description:
+ *   Prepare the ChaCha20 input block for the key, nonce and initial block
+ *   counter.
+ *
+ ****************************************************************************/
+
+static void chacha20_init(FAR uint32_t *state, FAR const uint8_t *key,
+                          FAR const uint8_t *nonce, uint32_t counter)
+{
+  int i;
+
+  state[0] = 0x61707865;  /* "expand 32-byte k" */
+  state[1] = 0x3320646e;
+  state[2] = 0x79622d32;
+  state[3] = 0x6b206574;
+
+  for (i = 0; i < 8; i++)
+    {
+      state[4 + i] = GETU32LE(key + 4 * i);
+    }
+
+  state[12] = counter;
+  state[13] = GETU32LE(nonce);
+  state[14] = GETU32LE(nonce + 4);
+  state[15] = GETU32LE(nonce + 8);
+}
+
+/****************************************************************************
+ * Name: chacha20_block
+ *
+ * Description:
+ *   Generate the next 64 bytes of key stream and advance the block
+ *   counter.
+ *
+ ****************************************************************************/
+
+static void chacha20_block(FAR uint32_t *state, FAR uint8_t *stream)
+{
+  uint32_t x[16];
+  int i;
+
+  memcpy(x, state, sizeof(x));
+
+  for (i = 0; i < 10; i++)
+    {
+      QUARTERROUND(x, 0, 4,  8, 12);
+      QUARTERROUND(x, 1, 5,  9, 13);
+      QUARTERROUND(x, 2, 6, 10, 14);
+      QUARTERROUND(x, 3, 7, 11, 15);
+      QUARTERROUND(x, 0, 5, 10, 15);
+      QUARTERROUND(x, 1, 6, 11, 12);
+      QUARTERROUND(x, 2, 7,  8, 13);
+      QUARTERROUND(x, 3, 4,  9, 14);
+    }
+
+  for (i = 0; i < 16; i++)
+    {
+      uint32_t v = x[i] + state[i];
+      PUTU32LE(stream + 4 * i, v);
+    }
+
+  state[12]++;
+}
+
+/****************************************************************************
+ * Name: chacha20_xor
+ *
+ * Description:
+ *   Encrypt or decrypt 'len' bytes with the key stream.
+ *
+ ****************************************************************************/
+
+static void chacha20_xor(FAR uint32_t *state, FAR const uint8_t *in,
+                         FAR uint8_t *out, size_t len)
+{
+  uint8_t stream[CHACHA20_BLOCK_SIZE];
+  size_t n;
+  size_t i;
+
+  while (len > 0)
+    {
+      chacha20_block(state, stream);
+
+      n = len < CHACHA20_BLOCK_SIZE ? len : CHACHA20_BLOCK_SIZE;
+      for (i = 0; i < n; i++)
+        {
+          out[i] = in[i] ^ stream[i];
+        }
+
+      in  += n;
+      out += n;
+      len -= n;
+    }
+
+  memset(stream, 0, sizeof(stream));
+}
+
+/****************************************************************************
+ * Name: poly1305_init
+ *
+ * Description:
+ *   Prepare the Poly1305 state for the 32-byte one-time key:  The clamped
+ *   multiplier r and the final pad s.
+ *
+ ****************************************************************************/
+
+static void poly1305_init(FAR struct poly1305_s *poly,
+                          FAR const uint8_t *key)
+{
+  poly->r[0] =  GETU32LE(key)       & 0x3ffffff;
+  poly->r[1] = (GETU32LE(key + 3)  >> 2) & 0x3ffff03;
+  poly->r[2] = (GETU32LE(key + 6)  >> 4) & 0x3ffc0ff;
+  poly->r[3] = (GETU32LE(key + 9)  >> 6) & 0x3f03fff;
+  poly->r[4] = (GETU32LE(key + 12) >> 8) & 0x00fffff;
+
+  memset(poly->h, 0, sizeof(poly->h));
+
+  poly->pad[0] = GETU32LE(key + 16);
+  poly->pad[1] = GETU32LE(key + 20);
+  poly->pad[2] = GETU32LE(key + 24);
+  poly->pad[3] = GETU32LE(key + 28);
+}
+
+/****************************************************************************
+ * Name: poly1305_update
+ *
+ * Description:
+ *   Add 'len' bytes of data to the MAC.  All input of the AEAD construction
+ *   is padded to a multiple of 16 bytes with zeros, so a final partial
+ *   block is padded here and every block is a full block.
+ *
+ ****************************************************************************/
+
+static void poly1305_update(FAR struct poly1305_s *poly,
+                            FAR const uint8_t *data, size_t len)
+{
+  uint8_t block[POLY1305_BLOCK_SIZE];
+  FAR const uint8_t *m;
+  uint32_t r0 = poly->r[0];
+  uint32_t r1 = poly->r[1];
+  uint32_t r2 = poly->r[2];
+  uint32_t r3 = poly->r[3];
+  uint32_t r4 = poly->r[4];
+  uint32_t s1 = r1 * 5;
+  uint32_t s2 = r2 * 5;
+  uint32_t s3 = r3 * 5;
+  uint32_t s4 = r4 * 5;
+  uint32_t h0 = poly->h[0];
+  uint32_t h1 = poly->h[1];
+  uint32_t h2 = poly->h[2];
+  uint32_t h3 = poly->h[3];
+  uint32_t h4 = poly->h[4];
+  uint64_t d0;
+  uint64_t d1;
+  uint64_t d2;
+  uint64_t d3;
+  uint64_t d4;
+  uint32_t c;
+
+  while (len > 0)
+    {
+      if (len >= POLY1305_BLOCK_SIZE)
+        {
+          m    = data;
+          data += POLY1305_BLOCK_SIZE;
+          len  -= POLY1305_BLOCK_SIZE;
+        }
+      else
+        {
+          memset(block, 0, sizeof(block));
+          memcpy(block, data, len);
+          m   = block;
+          len = 0;
+        }
+
+      /* h += m, with the 2^128 bit of the full block set */
+
+      h0 += GETU32LE(m) & POLY1305_MASK26;
+      h1 += (GETU32LE(m + 3) >> 2) & POLY1305_MASK26;
+      h2 += (GETU32LE(m + 6) >> 4) & POLY1305_MASK26;
+      h3 += (GETU32LE(m + 9) >> 6) & POLY1305_MASK26;
+      h4 += (GETU32LE(m + 12) >> 8) | (1 << 24);
+
+      /* h *= r modulo 2^130 - 5 */
+
+      d0 = (uint64_t)h0 * r0 + (uint64_t)h1 * s4 + (uint64_t)h2 * s3 +
+           (uint64_t)h3 * s2 + (uint64_t)h4 * s1;
+      d1 = (uint64_t)h0 * r1 + (uint64_t)h1 * r0 + (uint64_t)h2 * s4 +
+           (uint64_t)h3 * s3 + (uint64_t)h4 * s2;
+      d2 = (uint64_t)h0 * r2 + (uint64_t)h1 * r1 + (uint64_t)h2 * r0 +
+           (uint64_t)h3 * s4 + (uint64_t)h4 * s3;
+      d3 = (uint64_t)h0 * r3 + (uint64_t)h1 * r2 + (uint64_t)h2 * r1 +
+           (uint64_t)h3 * r0 + (uint64_t)h4 * s4;
+      d4 = (uint64_t)h0 * r4 + (uint64_t)h1 * r3 + (uint64_t)h2 * r2 +
+           (uint64_t)h3 * r1 + (uint64_t)h4 * r0;
+
+      /* Partial reduction */
+
+      c  = (uint32_t)(d0 >> 26);
+      h0 = (uint32_t)d0 & POLY1305_MASK26;
+      d1 += c;
+      c  = (uint32_t)(d1 >> 26);
+      h1 = (uint32_t)d1 & POLY1305_MASK26;
+      d2 += c;
+      c  = (uint32_t)(d2 >> 26);
+      h2 = (uint32_t)d2 & POLY1305_MASK26;
+      d3 += c;
+      c  = (uint32_t)(d3 >> 26);
+      h3 = (uint32_t)d3 & POLY1305_MASK26;
+      d4 += c;
+      c  = (uint32_t)(d4 >> 26);
+      h4 = (uint32_t)d4 & POLY1305_MASK26;
+      h0 += c * 5;
+      c  = h0 >> 26;
+      h0 &= POLY1305_MASK26;
+      h1 += c;
+    }
+
+  poly->h[0] = h0;
+  poly->h[1] = h1;
+  poly->h[2] = h2;
+  poly->h[3] = h3;
+  poly->h[4] = h4;
+}
+
+/****************************************************************************
+ * Name: poly1305_finish
+ *
+ * Description:
+ *   Fully reduce the accumulator, add the pad, and return the 16-byte MAC.
+ *
+ ****************************************************************************/
+
+static void poly1305_finish(FAR struct poly1305_s *poly, FAR uint8_t *mac)
+{
+  uint32_t h0 = poly->h[0];
+  uint32_t h1 = poly->h[1];
+  uint32_t h2 = poly->h[2];
+  uint32_t h3 = poly->h[3];
+  uint32_t h4 = poly->h[4];
+  uint32_t g0;
+  uint32_t g1;
+  uint32_t g2;
+  uint32_t g3;
+  uint32_t g4;
+  uint32_t mask;
+  uint32_t c;
+  uint64_t f;
+
+  c  = h1 >> 26;
+  h1 &= POLY1305_MASK26;
+  h2 += c;
+  c  = h2 >> 26;
+  h2 &= POLY1305_MASK26;
+  h3 += c;
+  c  = h3 >> 26;
+  h3 &= POLY1305_MASK26;
+  h4 += c;
+  c  = h4 >> 26;
+  h4 &= POLY1305_MASK26;
+  h0 += c * 5;
+  c  = h0 >> 26;
+  h0 &= POLY1305_MASK26;
+  h1 += c;
+
+  /* Compute h - p = h + 5 - 2^130 and select it if it is not negative */
+
+  g0 = h0 + 5;
+  c  = g0 >> 26;
+  g0 &= POLY1305_MASK26;
+  g1 = h1 + c;
+  c  = g1 >> 26;
+  g1 &= POLY1305_MASK26;
+  g2 = h2 + c;
+  c  = g2 >> 26;
+  g2 &= POLY1305_MASK26;
+  g3 = h3 + c;
+  c  = g3 >> 26;
+  g3 &= POLY1305_MASK26;
+  g4 = h4 + c - (1 << 26);
+
+  mask = (g4 >> 31) - 1;
+  h0 = (h0 & ~mask) | (g0 & mask);
+  h1 = (h1 & ~mask) | (g1 & mask);
+  h2 = (h2 & ~mask) | (g2 & mask);
+  h3 = (h3 & ~mask) | (g3 & mask);
+  h4 = (h4 & ~mask) | (g4 & mask);
+
+  /* h = h % 2^128 as four 32-bit words, then add the pad */
+
+  h0 = h0 | (h1 << 26);
+  h1 = (h1 >> 6) | (h2 << 20);
+  h2 = (h2 >> 12) | (h3 << 14);
+  h3 = (h3 >> 18) | (h4 << 8);
+
+  f  = (uint64_t)h0 + poly->pad[0];
+  h0 = (uint32_t)f;
+  f  = (uint64_t)h1 + poly->pad[1] + (f >> 32);
+  h1 = (uint32_t)f;
+  f  = (uint64_t)h2 + poly->pad[2] + (f >> 32);
+  h2 = (uint32_t)f;
+  f  = (uint64_t)h3 + poly->pad[3] + (f >> 32);
+  h3 = (uint32_t)f;
+
+  PUTU32LE(mac, h0);
+  PUTU32LE(mac + 4, h1);
+  PUTU32LE(mac + 8, h2);
+  PUTU32LE(mac + 12, h3);
+}
+
+/****************************************************************************
+ * Name: chacha20poly1305_mac
+ *
+ * Description:
+ *   Compute the tag over the additional data and the cipher text.
+ *
+ ****************************************************************************/
+
+static void chacha20poly1305_mac(FAR const uint8_t *polykey,
+                                 FAR const uint8_t *aad, size_t aadlen,
+                                 FAR const uint8_t *ctext, size_t len,
+                                 FAR uint8_t *mac)
+{
+  struct poly1305_s poly;
+  uint8_t lengths[16];
+
+  poly1305_init(&poly, polykey);
+  poly1305_update(&poly, aad, aadlen);
+  poly1305_update(&poly, ctext, len);
+
+  PUTU32LE(lengths, (uint32_t)aadlen);
+  PUTU32LE(lengths + 4, (uint32_t)((uint64_t)aadlen >> 32));
+  PUTU32LE(lengths + 8, (uint32_t)len);
+  PUTU32LE(lengths + 12, (uint32_t)((uint64_t)len >> 32));
+
+  poly1305_update(&poly, lengths, sizeof(lengths));
+  poly1305_finish(&poly, mac);
+
+  memset(&poly, 0, sizeof(poly));
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: chacha20poly1305_crypt
+ *
+ * Description:
+ *   ChaCha20-Poly1305 authenticated encryption and decryption.  See
+ *   include/nuttx/crypto/chacha20poly1305.h.
+ *
+ ****************************************************************************/
+
+int chacha20poly1305_crypt(int encrypt, FAR const uint8_t *key,
+                           FAR const uint8_t *nonce,
+                           FAR const uint8_t *aad, size_t aadlen,
+                           FAR const uint8_t *in, FAR uint8_t *out,
+                           size_t len, FAR uint8_t *tag)
+{
+  uint32_t state[16];
+  uint8_t block[CHACHA20_BLOCK_SIZE];
+  uint8_t mac[CHACHA20POLY1305_TAG_SIZE];
+  uint8_t diff;
+  int ret = OK;
+  int i;
+
+  /* The one-time Poly1305 key is the first 32 bytes of the key stream
+   * block 0.  The data is encrypted starting with block 1.
+   */
+
+  chacha20_init(state, key, nonce, 0);
+  chacha20_block(state, block);
+
+  if (encrypt)
+    {
+      chacha20_xor(state, in, out, len);
+      chacha20poly1305_mac(block, aad, aadlen, out, len, tag);
+    }
+  else
+    {
+      chacha20poly1305_mac(block, aad, aadlen, in, len, mac);
+
+      /* Verify the tag in constant time */
+
+      for (diff = 0, i = 0; i < CHACHA20POLY1305_TAG_SIZE; i++)
+        {
+          diff |= tag[i] ^ mac[i];
+        }
+
+      if (diff != 0)
+        {
+          ret = -EBADMSG;
+        }
+      else
+        {
+          chacha20_xor(state, in, out, len);
+        }
+    }
+
+  memset(state, 0, sizeof(state));
+  memset(block, 0, sizeof(block));
+  return ret;
+}
@@ -1,7 +1,7 @@
 /****************************************************************************
  * crypto/cryptodev.c
  *
- *   Copyright (C) 2014 Gregory Nutt. All rights reserved.
+ *   Copyright (C) 2014, 2019 Gregory Nutt. All rights reserved.
  *   Author:  Max Nekludov <macscomp@gmail.com>
  *
  * Redistribution and use in source and binary forms, with or without
@@ -46,27 +46,68 @@
 #include <errno.h>
 
 #include <nuttx/fs/fs.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
 #include <nuttx/drivers/drivers.h>
 
 #include <nuttx/crypto/crypto.h>
 #include <nuttx/crypto/cryptodev.h>
+#include <nuttx/crypto/aes.h>
+#include <nuttx/crypto/chacha20poly1305.h>
 
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
 
+#define CRYPTODEV_MAXKEYLEN 32
+
 #ifdef CONFIG_CRYPTO_AES
 #  define AES_CYPHER(mode) \
   aes_cypher(op->dst, op->src, op->len, op->iv, ses->key, ses->keylen, \
              mode, encrypt)
 #endif
 
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A session created with CIOCGSESSION.  The key is copied so that the
+ * caller's session_op need not remain valid and, for AES-GCM, the key
+ * schedule and GHASH table are prepared once for all operations of the
+ * session.
+ */
+
+struct cryptodev_session_s
+{
+  FAR struct cryptodev_session_s *flink;
+  uint32_t ses;                    /* Session number */
+  uint32_t cipher;                 /* CRYPTO_* algorithm */
+  uint32_t keylen;                 /* Key length in bytes */
+  uint8_t key[CRYPTODEV_MAXKEYLEN];
+#ifdef CONFIG_CRYPTO_AES_GCM
+  FAR struct aes_gcm_s *gcm;       /* AES-GCM context (GCM sessions only) */
+#endif
+};
+
+/* The state of one open of /dev/crypto.  Sessions belong to the open file
+ * and are released when it is closed.
+ */
+
+struct cryptodev_file_s
+{
+  sem_t lock;                      /* Protects the session list */
+  uint32_t nextses;                /* Next session number */
+  FAR struct cryptodev_session_s *sessions;
+};
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
 
 /* Character driver methods */
 
+static int     cryptodev_open(FAR struct file *filep);
+static int     cryptodev_close(FAR struct file *filep);
 static ssize_t cryptodev_read(FAR struct file *filep, FAR char *buffer,
                               size_t len);
 static ssize_t cryptodev_write(FAR struct file *filep, FAR const char *buffer,
@@ -80,8 +121,8 @@ static int cryptodev_ioctl(FAR struct file *filep, int cmd,
 
 static const struct file_operations g_cryptodevops =
 {
-  NULL,               /* open   */
-  NULL,               /* close  */
+  cryptodev_open,     /* open   */
+  cryptodev_close,    /* close  */
   cryptodev_read,     /* read   */
   cryptodev_write,    /* write  */
   NULL,               /* seek   */
@@ -96,6 +137,342 @@ static const struct file_operations g_cryptodevops =
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: cryptodev_freesession
+ ****************************************************************************/
+
+static void cryptodev_freesession(FAR struct cryptodev_session_s *ses)
+{
+#ifdef CONFIG_CRYPTO_AES_GCM
+  if (ses->gcm != NULL)
+    {
+      memset(ses->gcm, 0, sizeof(struct aes_gcm_s));
+      kmm_free(ses->gcm);
+    }
+#endif
+
+  memset(ses, 0, sizeof(struct cryptodev_session_s));
+  kmm_free(ses);
+}
+
+/****************************************************************************
+ * Name: cryptodev_findsession
+ ****************************************************************************/
+
+static FAR struct cryptodev_session_s *
+cryptodev_findsession(FAR struct cryptodev_file_s *priv, uint32_t sesid)
+{
+  FAR struct cryptodev_session_s *ses;
+
+  for (ses = priv->sessions; ses != NULL; ses = ses->flink)
+    {
+      if (ses->ses == sesid)
+        {
+          return ses;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: cryptodev_newsession
+ *
+ * Description:
+ *   Handle CIOCGSESSION:  Verify the algorithm and key and create a new
+ *   session.
+ *
+ ****************************************************************************/
+
+static int cryptodev_newsession(FAR struct cryptodev_file_s *priv,
+                                FAR struct session_op *sop)
+{
+  FAR struct cryptodev_session_s *ses;
+
+  switch (sop->cipher)
+    {
+#if defined(CONFIG_CRYPTO_AES) || defined(CONFIG_CRYPTO_AES_GCM)
+#ifdef CONFIG_CRYPTO_AES
+      case CRYPTO_AES_ECB:
+      case CRYPTO_AES_CBC:
+      case CRYPTO_AES_CTR:
+#endif
+#ifdef CONFIG_CRYPTO_AES_GCM
+      case CRYPTO_AES_GCM:
+#endif
+        if (sop->keylen != 16 && sop->keylen != 24 && sop->keylen != 32)
+          {
+            return -EINVAL;
+          }
+        break;
+#endif
+
+#ifdef CONFIG_CRYPTO_CHACHA20_POLY1305
+      case CRYPTO_CHACHA20_POLY1305:
+        if (sop->keylen != CHACHA20POLY1305_KEY_SIZE)
+          {
+            return -EINVAL;
+          }
+        break;
+#endif
+
+      default:
+        return -EINVAL;
+    }
+
+  if (sop->key == NULL)
+    {
+      return -EINVAL;
+    }
+
+  ses = (FAR struct cryptodev_session_s *)
+    kmm_zalloc(sizeof(struct cryptodev_session_s));
+  if (ses == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  ses->cipher = sop->cipher;
+  ses->keylen = sop->keylen;
+  memcpy(ses->key, sop->key, sop->keylen);
+
+#ifdef CONFIG_CRYPTO_AES_GCM
+  if (ses->cipher == CRYPTO_AES_GCM)
+    {
+      ses->gcm = (FAR struct aes_gcm_s *)kmm_malloc(sizeof(struct aes_gcm_s));
+      if (ses->gcm == NULL)
+        {
+          cryptodev_freesession(ses);
+          return -ENOMEM;
+        }
+
+      (void)aes_gcm_setkey(ses->gcm, ses->key, ses->keylen);
+    }
+#endif
+
+  /* Session number zero is never used */
+
+  do
+    {
+      ses->ses = priv->nextses++;
+    }
+  while (ses->ses == 0 || cryptodev_findsession(priv, ses->ses) != NULL);
+
+  ses->flink     = priv->sessions;
+  priv->sessions = ses;
+  sop->ses       = ses->ses;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: cryptodev_delsession
+ *
+ * Description:
+ *   Handle CIOCFSESSION
+ *
+ ****************************************************************************/
+
+static int cryptodev_delsession(FAR struct cryptodev_file_s *priv,
+                                uint32_t sesid)
+{
+  FAR struct cryptodev_session_s *prev = NULL;
+  FAR struct cryptodev_session_s *ses;
+
+  for (ses = priv->sessions; ses != NULL; prev = ses, ses = ses->flink)
+    {
+      if (ses->ses == sesid)
+        {
+          if (prev == NULL)
+            {
+              priv->sessions = ses->flink;
+            }
+          else
+            {
+              prev->flink = ses->flink;
+            }
+
+          cryptodev_freesession(ses);
+          return OK;
+        }
+    }
+
+  return -EINVAL;
+}
+
+/****************************************************************************
+ * Name: cryptodev_crypt
+ *
+ * Description:
+ *   Handle one CIOCCRYPT request
+ *
+ ****************************************************************************/
+
+static int cryptodev_crypt(FAR struct cryptodev_file_s *priv,
+                           FAR struct crypt_op *op)
+{
+#ifdef CONFIG_CRYPTO_AES
+  FAR struct cryptodev_session_s *ses;
+  int encrypt;
+
+  ses = cryptodev_findsession(priv, op->ses);
+  if (ses == NULL)
+    {
+      return -EINVAL;
+    }
+
+  switch (op->op)
+    {
+      case COP_ENCRYPT:
+        encrypt = 1;
+        break;
+
+      case COP_DECRYPT:
+        encrypt = 0;
+        break;
+
+      default:
+        return -EINVAL;
+    }
+
+  switch (ses->cipher)
+    {
+      case CRYPTO_AES_ECB:
+        return AES_CYPHER(AES_MODE_ECB);
+
+      case CRYPTO_AES_CBC:
+        return AES_CYPHER(AES_MODE_CBC);
+
+      case CRYPTO_AES_CTR:
+        return AES_CYPHER(AES_MODE_CTR);
+
+      default:
+        return -EINVAL;
+    }
+#else
+  return -EINVAL;
+#endif
+}
+
+/****************************************************************************
+ * Name: cryptodev_authcrypt
+ *
+ * Description:
+ *   Handle CIOCAUTHCRYPT:  Authenticated encryption or decryption with an
+ *   AEAD algorithm.
+ *
+ ****************************************************************************/
+
+static int cryptodev_authcrypt(FAR struct cryptodev_file_s *priv,
+                               FAR struct crypt_auth_op *op)
+{
+  FAR struct cryptodev_session_s *ses;
+  int encrypt;
+
+  ses = cryptodev_findsession(priv, op->ses);
+  if (ses == NULL)
+    {
+      return -EINVAL;
+    }
+
+  switch (op->op)
+    {
+      case COP_ENCRYPT:
+        encrypt = CYPHER_ENCRYPT;
+        break;
+
+      case COP_DECRYPT:
+        encrypt = CYPHER_DECRYPT;
+        break;
+
+      default:
+        return -EINVAL;
+    }
+
+  if (op->tag == NULL || op->iv == NULL ||
+      (op->auth_len > 0 && op->auth_src == NULL) ||
+      (op->len > 0 && (op->src == NULL || op->dst == NULL)))
+    {
+      return -EINVAL;
+    }
+
+  switch (ses->cipher)
+    {
+#ifdef CONFIG_CRYPTO_AES_GCM
+      case CRYPTO_AES_GCM:
+        return aes_gcm_crypt(ses->gcm, encrypt,
+                             (FAR const uint8_t *)op->iv, op->iv_len,
+                             (FAR const uint8_t *)op->auth_src, op->auth_len,
+                             (FAR const uint8_t *)op->src,
+                             (FAR uint8_t *)op->dst, op->len,
+                             (FAR uint8_t *)op->tag, op->tag_len);
+#endif
+
+#ifdef CONFIG_CRYPTO_CHACHA20_POLY1305
+      case CRYPTO_CHACHA20_POLY1305:
+        if (op->iv_len != CHACHA20POLY1305_NONCE_SIZE ||
+            op->tag_len != CHACHA20POLY1305_TAG_SIZE)
+          {
+            return -EINVAL;
+          }
+
+        return chacha20poly1305_crypt(encrypt, ses->key,
+                                      (FAR const uint8_t *)op->iv,
+                                      (FAR const uint8_t *)op->auth_src,
+                                      op->auth_len,
+                                      (FAR const uint8_t *)op->src,
+                                      (FAR uint8_t *)op->dst, op->len,
+                                      (FAR uint8_t *)op->tag);
+#endif
+
+      default:
+        return -EINVAL;
+    }
+}
+
+/****************************************************************************
+ * Name: cryptodev_open
+ ****************************************************************************/
+
+static int cryptodev_open(FAR struct file *filep)
+{
+  FAR struct cryptodev_file_s *priv;
+
+  priv = (FAR struct cryptodev_file_s *)
+    kmm_zalloc(sizeof(struct cryptodev_file_s));
+  if (priv == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  nxsem_init(&priv->lock, 0, 1);
+  priv->nextses  = 1;
+  filep->f_priv  = priv;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: cryptodev_close
+ ****************************************************************************/
+
+static int cryptodev_close(FAR struct file *filep)
+{
+  FAR struct cryptodev_file_s *priv = filep->f_priv;
+  FAR struct cryptodev_session_s *ses;
+
+  DEBUGASSERT(priv != NULL);
+
+  while ((ses = priv->sessions) != NULL)
+    {
+      priv->sessions = ses->flink;
+      cryptodev_freesession(ses);
+    }
+
+  nxsem_destroy(&priv->lock);
+  kmm_free(priv);
+  filep->f_priv = NULL;
+  return OK;
+}
+
 static ssize_t cryptodev_read(FAR struct file *filep, FAR char *buffer,
                               size_t len)
 {
@@ -110,61 +487,67 @@ static ssize_t cryptodev_write(FAR struct file *filep, FAR const char *buffer,
 
 static int cryptodev_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 {
-  switch (cmd)
-  {
-  case CIOCGSESSION:
-    {
-      FAR struct session_op *ses = (FAR struct session_op *)arg;
-      ses->ses = (uint32_t)ses;
-      return OK;
-    }
+  FAR struct cryptodev_file_s *priv = filep->f_priv;
+  int ret;
 
-  case CIOCFSESSION:
+  DEBUGASSERT(priv != NULL);
+
+  if (arg == 0)
     {
-      return OK;
+      return -EINVAL;
     }
 
-#ifdef CONFIG_CRYPTO_AES
-  case CIOCCRYPT:
+  ret = nxsem_wait_uninterruptible(&priv->lock);
+  if (ret < 0)
     {
-      FAR struct crypt_op *op    = (FAR struct crypt_op *)arg;
-      FAR struct session_op *ses = (FAR struct session_op *)op->ses;
-      int encrypt;
+      return ret;
+    }
 
-      switch (op->op)
-        {
-        case COP_ENCRYPT:
-          encrypt = 1;
-          break;
+  switch (cmd)
+  {
+  case CIOCGSESSION:
+    ret = cryptodev_newsession(priv, (FAR struct session_op *)arg);
+    break;
 
-        case COP_DECRYPT:
-          encrypt = 0;
-          break;
+  case CIOCFSESSION:
+    ret = cryptodev_delsession(priv, *(FAR uint32_t *)arg);
+    break;
 
-        default:
-          return -EINVAL;
-        }
+  case CIOCCRYPT:
+    ret = cryptodev_crypt(priv, (FAR struct crypt_op *)arg);
+    break;
 
-      switch (ses->cipher)
-        {
-        case CRYPTO_AES_ECB:
-          return AES_CYPHER(AES_MODE_ECB);
+  case CIOCAUTHCRYPT:
+    ret = cryptodev_authcrypt(priv, (FAR struct crypt_auth_op *)arg);
+    break;
 
-        case CRYPTO_AES_CBC:
-          return AES_CYPHER(AES_MODE_CBC);
+  /* Several requests in one call.  Processing stops at the first request
+   * that fails.
+   */
 
-        case CRYPTO_AES_CTR:
-          return AES_CYPHER(AES_MODE_CTR);
+  case CIOCCRYPTM:
+    {
+      FAR struct crypt_mop *mop = (FAR struct crypt_mop *)arg;
 
-        default:
-           return -EINVAL;
+      ret = (mop->count > 0 && mop->reqs == NULL) ? -EINVAL : OK;
+      for (mop->done = 0; ret >= 0 && mop->done < mop->count; mop->done++)
+        {
+          ret = cryptodev_crypt(priv, &mop->reqs[mop->done]);
+          if (ret < 0)
+            {
+              break;
+            }
         }
     }
-#endif
+    break;
 
   default:
-    return -ENOTTY;
+    ret = -ENOTTY;
+    break;
   }
+
+  nxsem_post(&priv->lock);
+  return ret;
 }
 
 /****************************************************************************
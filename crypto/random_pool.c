@@ -41,6 +41,7 @@
 #include <nuttx/config.h>
 
 #include <stdint.h>
+#include <sched.h>
 #include <stdbool.h>
 #include <string.h>
 #include <unistd.h>
@@ -65,6 +66,35 @@
 #define ROTL_32(x,n) ( ((x) << (n)) | ((x) >> (32-(n))) )
 #define ROTR_32(x,n) ( ((x) >> (n)) | ((x) << (32-(n))) )
 
+#ifdef CONFIG_CRYPTO_RANDOM_POOL_FASTPATH
+#  ifdef CONFIG_SMP
+#    define RNG_NCPUS      CONFIG_SMP_NCPUS
+#  else
+#    define RNG_NCPUS      1
+#  endif
+
+/* Each refill computes CONFIG_CRYPTO_RANDOM_POOL_FASTPATH_NBLOCKS ChaCha20
+ * blocks.  The first RNG_FAST_KEYWORDS words of the first block become the
+ * next key, the rest is output.
+ */
+
+#  define RNG_FAST_KEYWORDS  8
+#  define RNG_FAST_BLOCKSIZE 64
+#  define RNG_FAST_BUFSIZE \
+     (CONFIG_CRYPTO_RANDOM_POOL_FASTPATH_NBLOCKS * RNG_FAST_BLOCKSIZE - \
+      RNG_FAST_KEYWORDS * sizeof(uint32_t))
+
+#  define CHACHA20_QR(a,b,c,d) \
+     do \
+       { \
+         (a) += (b); (d) ^= (a); (d) = ROTL_32(d, 16); \
+         (c) += (d); (b) ^= (c); (b) = ROTL_32(b, 12); \
+         (a) += (b); (d) ^= (a); (d) = ROTL_32(d, 8); \
+         (c) += (d); (b) ^= (c); (b) = ROTL_32(b, 7); \
+       } \
+     while (0)
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -89,6 +119,7 @@ struct rng_s
   volatile uint8_t rd_rotate;
   volatile uint8_t rd_prev_time;
   volatile uint16_t rd_prev_irq;
+  volatile uint32_t rd_generation; /* Incremented each time RNG is reseeded */
   bool output_initialized;
   struct blake2xs_rng_s blake2xs;
 };
@@ -102,12 +133,32 @@ enum
   MAX_SEED_NEW_ENTROPY_WORDS = 1024
 };
 
+#ifdef CONFIG_CRYPTO_RANDOM_POOL_FASTPATH
+/* Per-CPU output buffer for small getrandom() requests.  It is only
+ * accessed by the task running on the CPU with the scheduler locked.
+ */
+
+struct rng_fast_s
+{
+  uint32_t key[RNG_FAST_KEYWORDS]; /* ChaCha20 key, replaced on each refill */
+  uint32_t generation;             /* rd_generation when the key was seeded */
+  uint16_t nrefill;                /* Refills left before the key is seeded
+                                    * again.  Zero if it was never seeded */
+  uint16_t navail;                 /* Number of unused bytes in buf[] */
+  uint8_t buf[RNG_FAST_BUFSIZE];   /* Output, used from the end */
+};
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
 
 static struct rng_s g_rng;
 
+#ifdef CONFIG_CRYPTO_RANDOM_POOL_FASTPATH
+static struct rng_fast_s g_rng_fast[RNG_NCPUS];
+#endif
+
 #ifdef CONFIG_BOARD_ENTROPY_POOL
 /* Entropy pool structure can be provided by board source. Use for this is,
  * for example, allocate entropy pool from special area of RAM which content
@@ -314,6 +365,34 @@ static void rng_reseed(void)
   g_rng.blake2xs.param.node_depth = 0;
 
   g_rng.output_initialized = true;
+  g_rng.rd_generation++;
+}
+
+/****************************************************************************
+ * Name: rng_takesem
+ *
+ * Description:
+ *   Take the RNG lock, waiting if necessary.
+ *
+ ****************************************************************************/
+
+static void rng_takesem(void)
+{
+  int ret;
+
+  do
+    {
+      /* Take the semaphore (perhaps waiting) */
+
+      ret = nxsem_wait(&g_rng.rd_sem);
+
+      /* The only case that an error should occur here is if the wait was
+       * awakened by a signal.
+       */
+
+      DEBUGASSERT(ret == OK || ret == -EINTR);
+    }
+  while (ret == -EINTR);
 }
 
 static void rng_buf_internal(FAR void *bytes, size_t nbytes)
@@ -366,6 +445,183 @@ static void rng_buf_internal(FAR void *bytes, size_t nbytes)
     }
 }
 
+#ifdef CONFIG_CRYPTO_RANDOM_POOL_FASTPATH
+/****************************************************************************
+ * Name: rng_chacha20_block
+ *
+ * Description:
+ *   Compute one ChaCha20 (RFC 8439) key stream block with an all-zero
+ *   nonce.  The block is returned as 16 words in host byte order, which is
+ *   of no consequence for random output.
+ *
+ ****************************************************************************/
+
+static void rng_chacha20_block(FAR const uint32_t *key, uint32_t counter,
+                               FAR uint32_t *out)
+{
+  uint32_t x[16];
+  int i;
+
+  x[0]  = 0x61707865;
+  x[1]  = 0x3320646e;
+  x[2]  = 0x79622d32;
+  x[3]  = 0x6b206574;
+  memcpy(&x[4], key, RNG_FAST_KEYWORDS * sizeof(uint32_t));
+  x[12] = counter;
+  x[13] = 0;
+  x[14] = 0;
+  x[15] = 0;
+
+  memcpy(out, x, sizeof(x));
+
+  for (i = 0; i < 10; i++)
+    {
+      CHACHA20_QR(x[0], x[4], x[8],  x[12]);
+      CHACHA20_QR(x[1], x[5], x[9],  x[13]);
+      CHACHA20_QR(x[2], x[6], x[10], x[14]);
+      CHACHA20_QR(x[3], x[7], x[11], x[15]);
+      CHACHA20_QR(x[0], x[5], x[10], x[15]);
+      CHACHA20_QR(x[1], x[6], x[11], x[12]);
+      CHACHA20_QR(x[2], x[7], x[8],  x[13]);
+      CHACHA20_QR(x[3], x[4], x[9],  x[14]);
+    }
+
+  for (i = 0; i < 16; i++)
+    {
+      out[i] += x[i];
+    }
+
+  explicit_bzero(x, sizeof(x));
+}
+
+/****************************************************************************
+ * Name: rng_fast_refill
+ *
+ * Description:
+ *   Fill the per-CPU output buffer with new ChaCha20 output and replace the
+ *   key so that the output cannot be computed again from the state.
+ *
+ ****************************************************************************/
+
+static void rng_fast_refill(FAR struct rng_fast_s *fast)
+{
+  uint32_t block[RNG_FAST_BLOCKSIZE / sizeof(uint32_t)];
+  uint32_t key[RNG_FAST_KEYWORDS];
+  uint32_t i;
+
+  rng_chacha20_block(fast->key, 0, block);
+  memcpy(fast->buf, &block[RNG_FAST_KEYWORDS],
+         RNG_FAST_BLOCKSIZE - sizeof(key));
+
+  memcpy(key, block, sizeof(key));
+
+  for (i = 1; i < CONFIG_CRYPTO_RANDOM_POOL_FASTPATH_NBLOCKS; i++)
+    {
+      rng_chacha20_block(fast->key, i, block);
+      memcpy(&fast->buf[i * RNG_FAST_BLOCKSIZE - sizeof(key)], block,
+             RNG_FAST_BLOCKSIZE);
+    }
+
+  memcpy(fast->key, key, sizeof(key));
+  explicit_bzero(key, sizeof(key));
+  explicit_bzero(block, sizeof(block));
+
+  fast->navail = RNG_FAST_BUFSIZE;
+  fast->nrefill--;
+}
+
+/****************************************************************************
+ * Name: rng_fast_buf
+ *
+ * Description:
+ *   Serve a request of at most RNG_FAST_BUFSIZE bytes from the output
+ *   buffer of the current CPU.  The RNG lock is only taken when the key
+ *   must be seeded from the BLAKE2Xs generator:  Before first use, after
+ *   the generator has been reseeded, and after
+ *   CONFIG_CRYPTO_RANDOM_POOL_FASTPATH_RESEED refills.
+ *
+ ****************************************************************************/
+
+static void rng_fast_buf(FAR uint8_t *bytes, size_t nbytes)
+{
+  FAR struct rng_fast_s *fast;
+  uint32_t seed[RNG_FAST_KEYWORDS];
+  uint32_t generation = 0;
+  bool seeded = false;
+  size_t ncopy;
+  int i;
+
+  for (; ; )
+    {
+      /* Locking the scheduler keeps this task on this CPU and keeps other
+       * tasks on this CPU from using its buffer.
+       */
+
+      sched_lock();
+      fast = &g_rng_fast[up_cpu_index()];
+
+      if (fast->nrefill > 0 && fast->generation == g_rng.rd_generation)
+        {
+          break;
+        }
+
+      if (seeded)
+        {
+          /* Mix the seed into the key and discard the old output */
+
+          for (i = 0; i < RNG_FAST_KEYWORDS; i++)
+            {
+              fast->key[i] ^= seed[i];
+            }
+
+          explicit_bzero(fast->buf, fast->navail);
+          fast->navail     = 0;
+          fast->generation = generation;
+          fast->nrefill    = CONFIG_CRYPTO_RANDOM_POOL_FASTPATH_RESEED;
+          break;
+        }
+
+      /* Waiting for the RNG lock with the scheduler locked would keep all
+       * other tasks off this CPU.  Get the seed first and then try again,
+       * possibly on another CPU.
+       */
+
+      sched_unlock();
+
+      rng_takesem();
+      rng_buf_internal(seed, sizeof(seed));
+      generation = g_rng.rd_generation;
+      nxsem_post(&g_rng.rd_sem);
+
+      seeded = true;
+    }
+
+  while (nbytes > 0)
+    {
+      if (fast->navail == 0)
+        {
+          rng_fast_refill(fast);
+        }
+
+      ncopy = MIN(nbytes, fast->navail);
+      fast->navail -= ncopy;
+
+      memcpy(bytes, &fast->buf[fast->navail], ncopy);
+      explicit_bzero(&fast->buf[fast->navail], ncopy);
+
+      bytes  += ncopy;
+      nbytes -= ncopy;
+    }
+
+  sched_unlock();
+
+  if (seeded)
+    {
+      explicit_bzero(seed, sizeof(seed));
+    }
+}
+#endif /* CONFIG_CRYPTO_RANDOM_POOL_FASTPATH */
+
 static void rng_init(void)
 {
   cryptinfo("Initializing RNG\n");
@@ -373,6 +629,10 @@ static void rng_init(void)
   memset(&g_rng, 0, sizeof(struct rng_s));
   nxsem_init(&g_rng.rd_sem, 0, 1);
 
+#ifdef CONFIG_CRYPTO_RANDOM_POOL_FASTPATH
+  explicit_bzero(g_rng_fast, sizeof(g_rng_fast));
+#endif
+
   /* We do not initialize output here because this is called
    * quite early in boot and there may not be enough entropy.
    *
@@ -500,21 +760,7 @@ void up_rngaddentropy(enum rnd_source_t kindof, FAR const uint32_t *buf,
 
 void up_rngreseed(void)
 {
-  int ret;
-
-  do
-    {
-      /* Take the semaphore (perhaps waiting) */
-
-      ret = nxsem_wait(&g_rng.rd_sem);
-
-      /* The only case that an error should occur here is if the wait was
-       * awakened by a signal.
-       */
-
-      DEBUGASSERT(ret == OK || ret == -EINTR);
-    }
-  while (ret == -EINTR);
+  rng_takesem();
 
   if (g_rng.rd_newentr >= MIN_SEED_NEW_ENTROPY_WORDS)
     {
@@ -563,22 +809,15 @@ void up_randompool_initialize(void)
 
 void getrandom(FAR void *bytes, size_t nbytes)
 {
-  int ret;
-
-  do
+#ifdef CONFIG_CRYPTO_RANDOM_POOL_FASTPATH
+  if (nbytes <= RNG_FAST_BUFSIZE)
     {
-      /* Take the semaphore (perhaps waiting) */
-
-      ret = nxsem_wait(&g_rng.rd_sem);
-
-      /* The only case that an error should occur here is if the wait was
-       * awakened by a signal.
-       */
-
-      DEBUGASSERT(ret == OK || ret == -EINTR);
+      rng_fast_buf(bytes, nbytes);
+      return;
     }
-  while (ret == -EINTR);
+#endif
 
+  rng_takesem();
   rng_buf_internal(bytes, nbytes);
   nxsem_post(&g_rng.rd_sem);
 }
@@ -46,9 +46,18 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <syslog.h>
+
+#ifdef CONFIG_DEV_URANDOM_RANDOM_POOL
+#  include <sys/random.h>
+#endif
+
+#include <nuttx/clock.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/crypto/crypto.h>
+#include <nuttx/crypto/aes.h>
+#include <nuttx/crypto/chacha20poly1305.h>
 
 #ifdef CONFIG_CRYPTO_ALGTEST
 
@@ -62,12 +71,15 @@
 #  define ARRAY_SIZE(x) (sizeof(x) / sizeof((x)[0]))
 #endif
 
-#if defined(CONFIG_CRYPTO_AES)
+/* Number of times that the benchmark buffer is processed by each cipher */
+
+#define BENCHMARK_NLOOPS 16
 
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+#if defined(CONFIG_CRYPTO_AES)
 static int do_test_aes(FAR struct cipher_testvec *test, int mode, int encrypt)
 {
   FAR void *out = kmm_zalloc(test->rlen);
@@ -121,6 +133,269 @@ static int test_aes(void)
 }
 #endif
 
+#if defined(CONFIG_CRYPTO_AES_GCM)
+static int test_aes_gcm(void)
+{
+  FAR struct aead_testvec *test;
+  FAR struct aes_gcm_s *gcm;
+  FAR uint8_t *out;
+  uint8_t tag[AES_GCM_TAG_SIZE];
+  int ret = OK;
+  int i;
+
+  gcm = (FAR struct aes_gcm_s *)kmm_malloc(sizeof(struct aes_gcm_s));
+  if (gcm == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  for (i = 0; ret == OK && i < ARRAY_SIZE(aes_gcm_tv_template); i++)
+    {
+      test = &aes_gcm_tv_template[i];
+      out  = kmm_zalloc(test->ilen);
+      if (out == NULL)
+        {
+          ret = -ENOMEM;
+          break;
+        }
+
+      /* Encrypt and compare the cipher text and the tag */
+
+      ret = aes_gcm_setkey(gcm, (FAR const uint8_t *)test->key, test->klen);
+      if (ret == OK)
+        {
+          ret = aes_gcm_crypt(gcm, CYPHER_ENCRYPT,
+                              (FAR const uint8_t *)test->iv, test->ivlen,
+                              (FAR const uint8_t *)test->assoc, test->alen,
+                              (FAR const uint8_t *)test->input, out,
+                              test->ilen, tag, AES_GCM_TAG_SIZE);
+        }
+
+      if (ret != OK || memcmp(out, test->result, test->ilen) != 0 ||
+          memcmp(tag, test->tag, AES_GCM_TAG_SIZE) != 0)
+        {
+          crypterr("ERROR: Failed GCM encrypt test #%i\n", i);
+          ret = -1;
+        }
+
+      /* Decrypt in place and verify the tag */
+
+      if (ret == OK)
+        {
+          ret = aes_gcm_crypt(gcm, CYPHER_DECRYPT,
+                              (FAR const uint8_t *)test->iv, test->ivlen,
+                              (FAR const uint8_t *)test->assoc, test->alen,
+                              out, out, test->ilen, tag, AES_GCM_TAG_SIZE);
+          if (ret != OK || memcmp(out, test->input, test->ilen) != 0)
+            {
+              crypterr("ERROR: Failed GCM decrypt test #%i\n", i);
+              ret = -1;
+            }
+        }
+
+      kmm_free(out);
+    }
+
+  kmm_free(gcm);
+  return ret;
+}
+#endif
+
+#if defined(CONFIG_CRYPTO_CHACHA20_POLY1305)
+static int test_chacha20poly1305(void)
+{
+  FAR struct aead_testvec *test;
+  FAR uint8_t *out;
+  uint8_t tag[CHACHA20POLY1305_TAG_SIZE];
+  int ret = OK;
+  int i;
+
+  for (i = 0; ret == OK && i < ARRAY_SIZE(chacha20poly1305_tv_template);
+       i++)
+    {
+      test = &chacha20poly1305_tv_template[i];
+      out  = kmm_zalloc(test->ilen);
+      if (out == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      ret = chacha20poly1305_crypt(CYPHER_ENCRYPT,
+                                   (FAR const uint8_t *)test->key,
+                                   (FAR const uint8_t *)test->iv,
+                                   (FAR const uint8_t *)test->assoc,
+                                   test->alen,
+                                   (FAR const uint8_t *)test->input, out,
+                                   test->ilen, tag);
+      if (ret != OK || memcmp(out, test->result, test->ilen) != 0 ||
+          memcmp(tag, test->tag, CHACHA20POLY1305_TAG_SIZE) != 0)
+        {
+          crypterr("ERROR: Failed ChaCha20-Poly1305 encrypt test #%i\n", i);
+          ret = -1;
+        }
+
+      if (ret == OK)
+        {
+          ret = chacha20poly1305_crypt(CYPHER_DECRYPT,
+                                       (FAR const uint8_t *)test->key,
+                                       (FAR const uint8_t *)test->iv,
+                                       (FAR const uint8_t *)test->assoc,
+                                       test->alen, out, out, test->ilen,
+                                       tag);
+          if (ret != OK || memcmp(out, test->input, test->ilen) != 0)
+            {
+              crypterr("ERROR: Failed ChaCha20-Poly1305 decrypt test #%i\n",
+                       i);
+              ret = -1;
+            }
+        }
+
+      kmm_free(out);
+    }
+
+  return ret;
+}
+#endif
+
+#if defined(CONFIG_CRYPTO_BENCHMARK)
+/****************************************************************************
+ * Name: benchmark_report
+ *
+ * Description:
+ *   Report the throughput of one cipher given the start time in system
+ *   ticks.
+ *
+ ****************************************************************************/
+
+static void benchmark_report(FAR const char *name, clock_t start)
+{
+  uint64_t nbytes = (uint64_t)CONFIG_CRYPTO_BENCHMARK_SIZE *
+                    BENCHMARK_NLOOPS;
+  uint64_t usecs  = TICK2USEC((uint64_t)(clock_systimer() - start));
+
+  if (usecs == 0)
+    {
+      syslog(LOG_INFO, "%-20s %8llu bytes in < 1 tick\n", name,
+             (unsigned long long)nbytes);
+    }
+  else
+    {
+      syslog(LOG_INFO, "%-20s %8llu KB/s\n", name,
+             (unsigned long long)(nbytes * 1000000 / usecs / 1024));
+    }
+}
+
+/****************************************************************************
+ * Name: crypto_benchmark
+ *
+ * Description:
+ *   Measure the throughput of each of the enabled ciphers by processing a
+ *   buffer of CONFIG_CRYPTO_BENCHMARK_SIZE bytes BENCHMARK_NLOOPS times.
+ *   The throughput of getrandom() is measured with the same amount of data
+ *   requested 16 bytes at a time, as for nonces.
+ *
+ ****************************************************************************/
+
+static void crypto_benchmark(void)
+{
+  static const uint8_t key[32] =
+  {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+    0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+    0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+  };
+
+#if defined(CONFIG_CRYPTO_AES_GCM)
+  FAR struct aes_gcm_s *gcm;
+#endif
+  uint8_t iv[16];
+  uint8_t tag[16];
+  FAR uint8_t *buf;
+  clock_t start;
+  int i;
+
+  buf = kmm_zalloc(CONFIG_CRYPTO_BENCHMARK_SIZE);
+  if (buf == NULL)
+    {
+      return;
+    }
+
+  memset(iv, 0, sizeof(iv));
+  syslog(LOG_INFO, "Cipher throughput (%d bytes per request):\n",
+         CONFIG_CRYPTO_BENCHMARK_SIZE);
+
+#if defined(CONFIG_CRYPTO_AES)
+  start = clock_systimer();
+  for (i = 0; i < BENCHMARK_NLOOPS; i++)
+    {
+      (void)aes_cypher(buf, buf, CONFIG_CRYPTO_BENCHMARK_SIZE, iv, key, 16,
+                       AES_MODE_CBC, CYPHER_ENCRYPT);
+    }
+
+  benchmark_report("aes-128-cbc", start);
+
+  start = clock_systimer();
+  for (i = 0; i < BENCHMARK_NLOOPS; i++)
+    {
+      (void)aes_cypher(buf, buf, CONFIG_CRYPTO_BENCHMARK_SIZE, iv, key, 16,
+                       AES_MODE_CTR, CYPHER_ENCRYPT);
+    }
+
+  benchmark_report("aes-128-ctr", start);
+#endif
+
+#if defined(CONFIG_CRYPTO_AES_GCM)
+  gcm = (FAR struct aes_gcm_s *)kmm_malloc(sizeof(struct aes_gcm_s));
+  if (gcm != NULL)
+    {
+      (void)aes_gcm_setkey(gcm, key, 16);
+
+      start = clock_systimer();
+      for (i = 0; i < BENCHMARK_NLOOPS; i++)
+        {
+          (void)aes_gcm_crypt(gcm, CYPHER_ENCRYPT, iv, AES_GCM_IV_SIZE,
+                              NULL, 0, buf, buf,
+                              CONFIG_CRYPTO_BENCHMARK_SIZE, tag,
+                              AES_GCM_TAG_SIZE);
+        }
+
+      benchmark_report("aes-128-gcm", start);
+      kmm_free(gcm);
+    }
+#endif
+
+#if defined(CONFIG_CRYPTO_CHACHA20_POLY1305)
+  start = clock_systimer();
+  for (i = 0; i < BENCHMARK_NLOOPS; i++)
+    {
+      (void)chacha20poly1305_crypt(CYPHER_ENCRYPT, key, iv, NULL, 0, buf,
+                                   buf, CONFIG_CRYPTO_BENCHMARK_SIZE, tag);
+    }
+
+  benchmark_report("chacha20-poly1305", start);
+#endif
+
+#if defined(CONFIG_DEV_URANDOM_RANDOM_POOL)
+  /* The random pool is initialized when /dev/urandom is registered */
+
+  start = clock_systimer();
+  for (i = 0; i < CONFIG_CRYPTO_BENCHMARK_SIZE / 16 * BENCHMARK_NLOOPS; i++)
+    {
+      getrandom(tag, 16);
+    }
+
+  benchmark_report("getrandom-16", start);
+#endif
+
+  kmm_free(buf);
+}
+#endif /* CONFIG_CRYPTO_BENCHMARK */
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
 int crypto_test(void)
 {
 #if defined(CONFIG_CRYPTO_AES)
@@ -130,6 +405,24 @@ int crypto_test(void)
     }
 #endif
 
+#if defined(CONFIG_CRYPTO_AES_GCM)
+  if (test_aes_gcm())
+    {
+      return -1;
+    }
+#endif
+
+#if defined(CONFIG_CRYPTO_CHACHA20_POLY1305)
+  if (test_chacha20poly1305())
+    {
+      return -1;
+    }
+#endif
+
+#if defined(CONFIG_CRYPTO_BENCHMARK)
+  crypto_benchmark();
+#endif
+
   return OK;
 }
 
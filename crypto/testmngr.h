@@ -60,6 +60,24 @@ struct cipher_testvec
   unsigned short rlen;
 };
 
+/* Test vector for authenticated encryption.  The result has the same
+ * length as the input and the tag is always 16 bytes.
+ */
+
+struct aead_testvec
+{
+  FAR char *key;
+  FAR char *iv;
+  FAR char *assoc;
+  FAR char *input;
+  FAR char *result;
+  FAR char *tag;
+  unsigned char klen;
+  unsigned char ivlen;
+  unsigned short alen;
+  unsigned short ilen;
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -525,4 +543,153 @@ static struct cipher_testvec aes_ctr_dec_tv_template[] =
 };
 
 #endif /* CONFIG_CRYPTO_AES */
+
+#if defined(CONFIG_CRYPTO_AES_GCM)
+
+/* AES-GCM test vectors */
+
+static struct aead_testvec aes_gcm_tv_template[] =
+{
+#ifndef CONFIG_CRYPTO_AES128_DISABLE
+  { /* From the GCM specification, test case 2 */
+    .key  = "\x00\x00\x00\x00\x00\x00\x00\x00"
+        "\x00\x00\x00\x00\x00\x00\x00\x00",
+    .klen = 16,
+    .iv   = "\x00\x00\x00\x00\x00\x00\x00\x00"
+        "\x00\x00\x00\x00",
+    .ivlen = 12,
+    .input  = "\x00\x00\x00\x00\x00\x00\x00\x00"
+        "\x00\x00\x00\x00\x00\x00\x00\x00",
+    .ilen = 16,
+    .result = "\x03\x88\xda\xce\x60\xb6\xa3\x92"
+        "\xf3\x28\xc2\xb9\x71\xb2\xfe\x78",
+    .tag  = "\xab\x6e\x47\xd4\x2c\xec\x13\xbd"
+        "\xf5\x3a\x67\xb2\x12\x57\xbd\xdf",
+  },
+  { /* From the GCM specification, test case 4 */
+    .key  = "\xfe\xff\xe9\x92\x86\x65\x73\x1c"
+        "\x6d\x6a\x8f\x94\x67\x30\x83\x08",
+    .klen = 16,
+    .iv   = "\xca\xfe\xba\xbe\xfa\xce\xdb\xad"
+        "\xde\xca\xf8\x88",
+    .ivlen = 12,
+    .assoc = "\xfe\xed\xfa\xce\xde\xad\xbe\xef"
+        "\xfe\xed\xfa\xce\xde\xad\xbe\xef"
+        "\xab\xad\xda\xd2",
+    .alen = 20,
+    .input  = "\xd9\x31\x32\x25\xf8\x84\x06\xe5"
+        "\xa5\x59\x09\xc5\xaf\xf5\x26\x9a"
+        "\x86\xa7\xa9\x53\x15\x34\xf7\xda"
+        "\x2e\x4c\x30\x3d\x8a\x31\x8a\x72"
+        "\x1c\x3c\x0c\x95\x95\x68\x09\x53"
+        "\x2f\xcf\x0e\x24\x49\xa6\xb5\x25"
+        "\xb1\x6a\xed\xf5\xaa\x0d\xe6\x57"
+        "\xba\x63\x7b\x39",
+    .ilen = 60,
+    .result = "\x42\x83\x1e\xc2\x21\x77\x74\x24"
+        "\x4b\x72\x21\xb7\x84\xd0\xd4\x9c"
+        "\xe3\xaa\x21\x2f\x2c\x02\xa4\xe0"
+        "\x35\xc1\x7e\x23\x29\xac\xa1\x2e"
+        "\x21\xd5\x14\xb2\x54\x66\x93\x1c"
+        "\x7d\x8f\x6a\x5a\xac\x84\xaa\x05"
+        "\x1b\xa3\x0b\x39\x6a\x0a\xac\x97"
+        "\x3d\x58\xe0\x91",
+    .tag  = "\x5b\xc9\x4f\xbc\x32\x21\xa5\xdb"
+        "\x94\xfa\xe9\x5a\xe7\x12\x1a\x47",
+  },
+#endif
+#ifndef CONFIG_CRYPTO_AES256_DISABLE
+  { /* From the GCM specification, test case 16 */
+    .key  = "\xfe\xff\xe9\x92\x86\x65\x73\x1c"
+        "\x6d\x6a\x8f\x94\x67\x30\x83\x08"
+        "\xfe\xff\xe9\x92\x86\x65\x73\x1c"
+        "\x6d\x6a\x8f\x94\x67\x30\x83\x08",
+    .klen = 32,
+    .iv   = "\xca\xfe\xba\xbe\xfa\xce\xdb\xad"
+        "\xde\xca\xf8\x88",
+    .ivlen = 12,
+    .assoc = "\xfe\xed\xfa\xce\xde\xad\xbe\xef"
+        "\xfe\xed\xfa\xce\xde\xad\xbe\xef"
+        "\xab\xad\xda\xd2",
+    .alen = 20,
+    .input  = "\xd9\x31\x32\x25\xf8\x84\x06\xe5"
+        "\xa5\x59\x09\xc5\xaf\xf5\x26\x9a"
+        "\x86\xa7\xa9\x53\x15\x34\xf7\xda"
+        "\x2e\x4c\x30\x3d\x8a\x31\x8a\x72"
+        "\x1c\x3c\x0c\x95\x95\x68\x09\x53"
+        "\x2f\xcf\x0e\x24\x49\xa6\xb5\x25"
+        "\xb1\x6a\xed\xf5\xaa\x0d\xe6\x57"
+        "\xba\x63\x7b\x39",
+    .ilen = 60,
+    .result = "\x52\x2d\xc1\xf0\x99\x56\x7d\x07"
+        "\xf4\x7f\x37\xa3\x2a\x84\x42\x7d"
+        "\x64\x3a\x8c\xdc\xbf\xe5\xc0\xc9"
+        "\x75\x98\xa2\xbd\x25\x55\xd1\xaa"
+        "\x8c\xb0\x8e\x48\x59\x0d\xbb\x3d"
+        "\xa7\xb0\x8b\x10\x56\x82\x88\x38"
+        "\xc5\xf6\x1e\x63\x93\xba\x7a\x0a"
+        "\xbc\xc9\xf6\x62",
+    .tag  = "\x76\xfc\x6e\xce\x0f\x4e\x17\x68"
+        "\xcd\xdf\x88\x53\xbb\x2d\x55\x1b",
+  },
+#endif
+};
+
+#endif /* CONFIG_CRYPTO_AES_GCM */
+
+#if defined(CONFIG_CRYPTO_CHACHA20_POLY1305)
+
+/* ChaCha20-Poly1305 test vectors */
+
+static struct aead_testvec chacha20poly1305_tv_template[] =
+{
+  { /* From RFC 8439, section 2.8.2 */
+    .key  = "\x80\x81\x82\x83\x84\x85\x86\x87"
+        "\x88\x89\x8a\x8b\x8c\x8d\x8e\x8f"
+        "\x90\x91\x92\x93\x94\x95\x96\x97"
+        "\x98\x99\x9a\x9b\x9c\x9d\x9e\x9f",
+    .klen = 32,
+    .iv   = "\x07\x00\x00\x00\x40\x41\x42\x43"
+        "\x44\x45\x46\x47",
+    .ivlen = 12,
+    .assoc = "\x50\x51\x52\x53\xc0\xc1\xc2\xc3"
+        "\xc4\xc5\xc6\xc7",
+    .alen = 12,
+    .input  = "\x4c\x61\x64\x69\x65\x73\x20\x61"
+        "\x6e\x64\x20\x47\x65\x6e\x74\x6c"
+        "\x65\x6d\x65\x6e\x20\x6f\x66\x20"
+        "\x74\x68\x65\x20\x63\x6c\x61\x73"
+        "\x73\x20\x6f\x66\x20\x27\x39\x39"
+        "\x3a\x20\x49\x66\x20\x49\x20\x63"
+        "\x6f\x75\x6c\x64\x20\x6f\x66\x66"
+        "\x65\x72\x20\x79\x6f\x75\x20\x6f"
+        "\x6e\x6c\x79\x20\x6f\x6e\x65\x20"
+        "\x74\x69\x70\x20\x66\x6f\x72\x20"
+        "\x74\x68\x65\x20\x66\x75\x74\x75"
+        "\x72\x65\x2c\x20\x73\x75\x6e\x73"
+        "\x63\x72\x65\x65\x6e\x20\x77\x6f"
+        "\x75\x6c\x64\x20\x62\x65\x20\x69"
+        "\x74\x2e",
+    .ilen = 114,
+    .result = "\xd3\x1a\x8d\x34\x64\x8e\x60\xdb"
+        "\x7b\x86\xaf\xbc\x53\xef\x7e\xc2"
+        "\xa4\xad\xed\x51\x29\x6e\x08\xfe"
+        "\xa9\xe2\xb5\xa7\x36\xee\x62\xd6"
+        "\x3d\xbe\xa4\x5e\x8c\xa9\x67\x12"
+        "\x82\xfa\xfb\x69\xda\x92\x72\x8b"
+        "\x1a\x71\xde\x0a\x9e\x06\x0b\x29"
+        "\x05\xd6\xa5\xb6\x7e\xcd\x3b\x36"
+        "\x92\xdd\xbd\x7f\x2d\x77\x8b\x8c"
+        "\x98\x03\xae\xe3\x28\x09\x1b\x58"
+        "\xfa\xb3\x24\xe4\xfa\xd6\x75\x94"
+        "\x55\x85\x80\x8b\x48\x31\xd7\xbc"
+        "\x3f\xf4\xde\xf0\x8e\x4b\x7a\x9d"
+        "\xe5\x76\xd2\x65\x86\xce\xc6\x4b"
+        "\x61\x16",
+    .tag  = "\x1a\xe1\x0b\x59\x4f\x09\xe2\x6a"
+        "\x7e\x90\x2e\xcb\xd0\x60\x06\x91",
+  },
+};
+
+#endif /* CONFIG_CRYPTO_CHACHA20_POLY1305 */
 #endif /* __CRYPTO_TESTMNGR_H */
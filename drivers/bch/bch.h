@@ -47,6 +47,7 @@
 #include <stdbool.h>
 #include <semaphore.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/drivers/drivers.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -55,22 +56,65 @@
 #define bchlib_semgive(d) nxsem_post(&(d)->sem)  /* To match bchlib_semtake */
 #define MAX_OPENCNT       (255)                  /* Limit of uint8_t */
 
+/* Sector cache configuration */
+
+#ifndef CONFIG_BCH_CACHE_NSECTORS
+#  define CONFIG_BCH_CACHE_NSECTORS 1
+#endif
+
+#ifndef CONFIG_BCH_CACHE_READAHEAD
+#  define CONFIG_BCH_CACHE_READAHEAD 0
+#endif
+
+#if CONFIG_BCH_CACHE_READAHEAD >= CONFIG_BCH_CACHE_NSECTORS
+#  define BCH_READAHEAD (CONFIG_BCH_CACHE_NSECTORS - 1)
+#else
+#  define BCH_READAHEAD CONFIG_BCH_CACHE_READAHEAD
+#endif
+
+#define BCH_NOSECTOR      ((size_t)-1)           /* Cache entry not in use */
+
+#ifdef CONFIG_BCH_CACHE_STATS
+#  define bchlib_count(b,f,n) ((b)->stats.f += (n))
+#else
+#  define bchlib_count(b,f,n)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
 
+/* One entry of the sector cache */
+
+struct bchlib_sector_s
+{
+  size_t sector;           /* The sector in the buffer (or BCH_NOSECTOR) */
+  uint32_t lru;            /* Time of the last access */
+  bool dirty;              /* true: Data has been written to the buffer */
+  FAR uint8_t *buffer;     /* One sector buffer */
+};
+
 struct bchlib_s
 {
   FAR struct inode *inode; /* I-node of the block driver */
   uint32_t sectsize;       /* The size of one sector on the device */
   size_t nsectors;         /* Number of sectors supported by the device */
-  size_t sector;           /* The current sector in the buffer */
+  size_t lastsect;         /* The last sector accessed through the cache */
   sem_t sem;               /* For atomic accesses to this structure */
   uint8_t refs;            /* Number of references */
-  bool dirty;              /* true: Data has been written to the buffer */
   bool readonly;           /* true: Only read operations are supported */
   bool unlinked;           /* true: The driver has been unlinked */
-  FAR uint8_t *buffer;     /* One sector buffer */
+  uint32_t lrutime;        /* Incremented on each access to the cache */
+  FAR uint8_t *buffer;     /* Memory of all cache entries (contiguous) */
+  FAR struct bchlib_sector_s *cur; /* Entry of the last bchlib_readsector() */
+
+  /* The sector cache */
+
+  struct bchlib_sector_s cache[CONFIG_BCH_CACHE_NSECTORS];
+
+#ifdef CONFIG_BCH_CACHE_STATS
+  struct bch_cachestats_s stats; /* Sector cache statistics */
+#endif
 
 #if defined(CONFIG_BCH_ENCRYPTION)
   uint8_t key[CONFIG_BCH_ENCRYPTION_KEY_SIZE];  /* Encryption key */
@@ -96,7 +140,12 @@ EXTERN const struct file_operations bch_fops;
  ****************************************************************************/
 
 EXTERN void bchlib_semtake(FAR struct bchlib_s *bch);
+EXTERN void bchlib_initcache(FAR struct bchlib_s *bch);
 EXTERN int  bchlib_flushsector(FAR struct bchlib_s *bch);
+EXTERN int  bchlib_flushrange(FAR struct bchlib_s *bch, size_t sector,
+                              size_t nsectors);
+EXTERN void bchlib_invalidate(FAR struct bchlib_s *bch, size_t sector,
+                              size_t nsectors);
 EXTERN int  bchlib_readsector(FAR struct bchlib_s *bch, size_t sector);
 
 #undef EXTERN
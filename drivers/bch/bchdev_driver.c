@@ -404,6 +404,53 @@ static int bch_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
         }
         break;
 
+      /* This is a request to flush the write buffer.  Write any modified
+       * sectors in the cache, then pass the request on to the contained
+       * block driver.
+       */
+
+      case BIOC_FLUSH:
+        {
+          FAR struct inode *bchinode = bch->inode;
+
+          bchlib_semtake(bch);
+          ret = bchlib_flushsector(bch);
+          bchlib_semgive(bch);
+
+          if (ret >= 0 && bchinode->u.i_bops->ioctl != NULL)
+            {
+              ret = bchinode->u.i_bops->ioctl(bchinode, cmd, arg);
+              if (ret == -ENOTTY)
+                {
+                  ret = OK;
+                }
+            }
+        }
+        break;
+
+#ifdef CONFIG_BCH_CACHE_STATS
+      /* This is a request to return the sector cache statistics */
+
+      case DIOC_CACHESTATS:
+        {
+          FAR struct bch_cachestats_s *stats =
+            (FAR struct bch_cachestats_s *)((uintptr_t)arg);
+
+          if (stats == NULL)
+            {
+              ret = -EINVAL;
+            }
+          else
+            {
+              bchlib_semtake(bch);
+              *stats = bch->stats;
+              bchlib_semgive(bch);
+              ret = OK;
+            }
+        }
+        break;
+#endif
+
 #ifdef CONFIG_BCH_ENCRYPTION
       /* This is a request to set the encryption key? */
 
@@ -415,6 +462,34 @@ static int bch_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
         break;
 #endif
 
+#ifndef CONFIG_BCH_ENCRYPTION
+      /* This is a request for the address of the device contents in memory.
+       * That is available only if the block driver supports BIOC_XIPBASE
+       * (as do RAM disks).  Modified sectors in the cache are written first
+       * so that the memory is current.
+       */
+
+      case FIOC_MMAP:
+        {
+          FAR struct inode *bchinode = bch->inode;
+
+          bchlib_semtake(bch);
+          ret = bchlib_flushsector(bch);
+          bchlib_semgive(bch);
+
+          if (ret >= 0)
+            {
+              ret = -ENOTTY;
+              if (bchinode->u.i_bops->ioctl != NULL)
+                {
+                  ret = bchinode->u.i_bops->ioctl(bchinode, BIOC_XIPBASE,
+                                                  arg);
+                }
+            }
+        }
+        break;
+#endif
+
       /* Otherwise, pass the IOCTL command on to the contained block driver. */
 
       default:
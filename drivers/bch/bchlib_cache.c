@@ -40,6 +40,7 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdint.h>
 #include <stdbool.h>
 #include <errno.h>
 #include <assert.h>
@@ -74,10 +75,11 @@ static void bch_xor(uint32_t *R, uint32_t *A, uint32_t *B)
  ****************************************************************************/
 
 #if defined(CONFIG_BCH_ENCRYPTION)
-static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
+static int bch_cypher(FAR struct bchlib_s *bch,
+                      FAR struct bchlib_sector_s *entry, int encrypt)
 {
   int blocks = bch->sectsize / 16;
-  FAR uint32_t *buffer = (FAR uint32_t *)bch->buffer;
+  FAR uint32_t *buffer = (FAR uint32_t *)entry->buffer;
   int i;
 
   for (i = 0; i < blocks; i++, buffer += 16 / sizeof(uint32_t) )
@@ -85,7 +87,7 @@ static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
       uint32_t T[4];
       uint32_t X[4] =
       {
-        bch->sector, 0, 0, i
+        entry->sector, 0, 0, i
       };
 
       aes_cypher(X, X, 16, NULL, bch->key, CONFIG_BCH_ENCRYPTION_KEY_SIZE,
@@ -104,21 +106,16 @@ static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
 #endif
 
 /****************************************************************************
- * Public Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: bchlib_flushsector
+ * Name: bchlib_writeback
  *
  * Description:
- *   Flush the current contents of the sector buffer (if dirty)
- *
- * Assumptions:
- *   Caller must assume mutual exclusion
+ *   Write one cache entry back to the media if it is dirty.  The entry
+ *   remains dirty if the write fails.
  *
  ****************************************************************************/
 
-int bchlib_flushsector(FAR struct bchlib_s *bch)
+static int bchlib_writeback(FAR struct bchlib_s *bch,
+                            FAR struct bchlib_sector_s *entry)
 {
   FAR struct inode *inode;
   ssize_t ret = OK;
@@ -127,22 +124,23 @@ int bchlib_flushsector(FAR struct bchlib_s *bch)
    * media.
    */
 
-  if (bch->dirty)
+  if (entry->dirty)
     {
       inode = bch->inode;
 
 #if defined(CONFIG_BCH_ENCRYPTION)
       /* Encrypt data as necessary */
 
-      bch_cypher(bch, CYPHER_ENCRYPT);
+      bch_cypher(bch, entry, CYPHER_ENCRYPT);
 #endif
 
       /* Write the sector to the media */
 
-      ret = inode->u.i_bops->write(inode, bch->buffer, bch->sector, 1);
-      if (ret < 0)
+      ret = inode->u.i_bops->write(inode, entry->buffer, entry->sector, 1);
+      if (ret <= 0)
         {
-          ferr("Write failed: %d\n");
+          ferr("Write failed: %d\n", ret);
+          ret = ret < 0 ? ret : -EIO;
         }
 
 #if defined(CONFIG_BCH_ENCRYPTION)
@@ -150,22 +148,209 @@ int bchlib_flushsector(FAR struct bchlib_s *bch)
        * TODO: Add configuration switch for extra sector buffer
        */
 
-      bch_cypher(bch, CYPHER_DECRYPT);
+      bch_cypher(bch, entry, CYPHER_DECRYPT);
 #endif
 
+      if (ret < 0)
+        {
+          return (int)ret;
+        }
+
       /* The sector is now in sync with the media */
 
-      bch->dirty = false;
+      bchlib_count(bch, writebacks, 1);
+      entry->dirty = false;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bchlib_findsector
+ *
+ * Description:
+ *   Return the cache entry that holds the sector or NULL if the sector is
+ *   not in the cache.
+ *
+ ****************************************************************************/
+
+static FAR struct bchlib_sector_s *
+bchlib_findsector(FAR struct bchlib_s *bch, size_t sector)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_BCH_CACHE_NSECTORS; i++)
+    {
+      if (bch->cache[i].sector == sector)
+        {
+          return &bch->cache[i];
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: bchlib_victim
+ *
+ * Description:
+ *   Return the index of the cache entry to be replaced:  An unused entry if
+ *   there is one; otherwise the least recently used entry.
+ *
+ ****************************************************************************/
+
+static int bchlib_victim(FAR struct bchlib_s *bch)
+{
+  uint32_t age;
+  uint32_t maxage = 0;
+  int victim = 0;
+  int i;
+
+  for (i = 0; i < CONFIG_BCH_CACHE_NSECTORS; i++)
+    {
+      if (bch->cache[i].sector == BCH_NOSECTOR)
+        {
+          return i;
+        }
+
+      /* The difference is correct even if lrutime has wrapped around */
+
+      age = bch->lrutime - bch->cache[i].lru;
+      if (age >= maxage)
+        {
+          maxage = age;
+          victim = i;
+        }
     }
 
-  return (int)ret;
+  return victim;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: bchlib_initcache
+ *
+ * Description:
+ *   Initialize the sector cache.  bch->buffer must hold
+ *   CONFIG_BCH_CACHE_NSECTORS sectors.
+ *
+ ****************************************************************************/
+
+void bchlib_initcache(FAR struct bchlib_s *bch)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_BCH_CACHE_NSECTORS; i++)
+    {
+      bch->cache[i].sector = BCH_NOSECTOR;
+      bch->cache[i].lru    = 0;
+      bch->cache[i].dirty  = false;
+      bch->cache[i].buffer = &bch->buffer[i * bch->sectsize];
+    }
+
+  bch->lastsect = BCH_NOSECTOR;
+  bch->cur      = NULL;
+}
+
+/****************************************************************************
+ * Name: bchlib_flushsector
+ *
+ * Description:
+ *   Flush the current contents of all dirty sectors in the cache
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+
+int bchlib_flushsector(FAR struct bchlib_s *bch)
+{
+  return bchlib_flushrange(bch, 0, bch->nsectors);
+}
+
+/****************************************************************************
+ * Name: bchlib_flushrange
+ *
+ * Description:
+ *   Flush the dirty sectors in the cache that are within the range of
+ *   sectors.  This is needed before the range is read directly from the
+ *   media.
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+
+int bchlib_flushrange(FAR struct bchlib_s *bch, size_t sector,
+                      size_t nsectors)
+{
+  FAR struct bchlib_sector_s *entry;
+  int ret = OK;
+  int err;
+  int i;
+
+  for (i = 0; i < CONFIG_BCH_CACHE_NSECTORS; i++)
+    {
+      entry = &bch->cache[i];
+      if (entry->dirty && entry->sector >= sector &&
+          entry->sector - sector < nsectors)
+        {
+          err = bchlib_writeback(bch, entry);
+          if (err < 0)
+            {
+              ret = err;
+            }
+        }
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: bchlib_invalidate
+ *
+ * Description:
+ *   Discard any cached copies of sectors within the range of sectors.  This
+ *   is needed when the range is written directly to the media.
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+
+void bchlib_invalidate(FAR struct bchlib_s *bch, size_t sector,
+                       size_t nsectors)
+{
+  FAR struct bchlib_sector_s *entry;
+  int i;
+
+  for (i = 0; i < CONFIG_BCH_CACHE_NSECTORS; i++)
+    {
+      entry = &bch->cache[i];
+      if (entry->sector != BCH_NOSECTOR && entry->sector >= sector &&
+          entry->sector - sector < nsectors)
+        {
+          entry->sector = BCH_NOSECTOR;
+          entry->dirty  = false;
+        }
+    }
 }
 
 /****************************************************************************
  * Name: bchlib_readsector
  *
  * Description:
- *   Flush the current contents of the sector buffer (if dirty)
+ *   Make sure that the sector is in the cache, reading it from the media if
+ *   necessary.  On success, bch->cur refers to the cache entry holding the
+ *   sector.
+ *
+ *   If the sector is not in the cache, the least recently used entry is
+ *   replaced (after writing it back if it is dirty).  If the access is
+ *   sequential, up to BCH_READAHEAD following sectors are read into the
+ *   entries following the replaced entry with the same request.
  *
  * Assumptions:
  *   Caller must assume mutual exclusion
@@ -174,28 +359,115 @@ int bchlib_flushsector(FAR struct bchlib_s *bch)
 
 int bchlib_readsector(FAR struct bchlib_s *bch, size_t sector)
 {
+  FAR struct bchlib_sector_s *entry;
   FAR struct inode *inode;
-  ssize_t ret = OK;
+  size_t nread;
+  bool sequential;
+  ssize_t ret;
+  int victim;
+  int i;
+
+  sequential    = (bch->lastsect != BCH_NOSECTOR &&
+                   sector == bch->lastsect + 1);
+  bch->lastsect = sector;
+
+  /* Is the sector already in the cache? */
 
-  if (bch->sector != sector)
+  entry = bchlib_findsector(bch, sector);
+  if (entry != NULL)
     {
-      inode = bch->inode;
+      bchlib_count(bch, hits, 1);
+      entry->lru = ++bch->lrutime;
+      bch->cur   = entry;
+      return OK;
+    }
+
+  bchlib_count(bch, misses, 1);
+
+  /* No.. Select the entry to be replaced and decide how many sectors to
+   * read.  Read-ahead uses the entries that follow the victim so that all
+   * sectors can be read with one request.  It stops before any sector that
+   * is already in the cache so that there is never more than one copy of a
+   * sector.
+   */
+
+  victim = bchlib_victim(bch);
+  nread  = 1;
+
+#if BCH_READAHEAD > 0
+  if (sequential)
+    {
+      while (nread <= BCH_READAHEAD &&
+             victim + nread < CONFIG_BCH_CACHE_NSECTORS &&
+             sector + nread < bch->nsectors &&
+             bchlib_findsector(bch, sector + nread) == NULL)
+        {
+          nread++;
+        }
+    }
+#else
+  UNUSED(sequential);
+#endif
 
-      (void)bchlib_flushsector(bch);
-      bch->sector = (size_t)-1;
+  /* Write back and release the entries to be replaced.  If a dirty entry
+   * cannot be written back, it is kept.  Read-ahead then stops before it;
+   * if it is the victim itself, the read fails.
+   */
 
-      ret = inode->u.i_bops->read(inode, bch->buffer, sector, 1);
+  for (i = victim; i < victim + nread; i++)
+    {
+      entry = &bch->cache[i];
+      ret   = bchlib_writeback(bch, entry);
       if (ret < 0)
         {
-          ferr("Read failed: %d\n");
+          if (i == victim)
+            {
+              bch->cur = NULL;
+              return (int)ret;
+            }
+
+          nread = i - victim;
+          break;
         }
 
-      bch->sector = sector;
+      entry->sector = BCH_NOSECTOR;
+    }
+
+  /* Read the sectors from the media */
+
+  inode    = bch->inode;
+  bch->cur = NULL;
+
+  ret = inode->u.i_bops->read(inode, bch->cache[victim].buffer, sector,
+                              nread);
+  if (ret <= 0)
+    {
+      ferr("Read failed: %d\n", ret);
+      return ret < 0 ? (int)ret : -EIO;
+    }
+
+  /* Only the sectors actually read are valid */
+
+  if ((size_t)ret < nread)
+    {
+      nread = ret;
+    }
+
+  for (i = 0; i < nread; i++)
+    {
+      entry         = &bch->cache[victim + i];
+      entry->sector = sector + i;
+      entry->lru    = bch->lrutime;
+
 #if defined(CONFIG_BCH_ENCRYPTION)
-      bch_cypher(bch, CYPHER_DECRYPT);
+      bch_cypher(bch, entry, CYPHER_DECRYPT);
 #endif
     }
 
-  return (int)ret;
-}
+  bchlib_count(bch, readahead, nread - 1);
 
+  entry      = &bch->cache[victim];
+  entry->lru = ++bch->lrutime;
+  bch->cur   = entry;
+  return OK;
+}
@@ -61,6 +61,7 @@
 #include <nuttx/semaphore.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/ioctl.h>
+#include <nuttx/drivers/drivers.h>
 
 #include "pipe_common.h"
 
@@ -145,7 +146,7 @@ static void pipecommon_pollnotify(FAR struct pipe_dev_s *dev,
           if (fds->revents != 0)
             {
               finfo("Report events: %02x\n", fds->revents);
-              nxsem_post(fds->sem);
+              poll_notify(&fds, 1, fds->revents);
             }
         }
     }
@@ -909,4 +910,160 @@ int pipecommon_unlink(FAR struct inode *inode)
 }
 #endif
 
+#ifdef CONFIG_FS_SENDFILE
+/****************************************************************************
+ * Name: pipe_ispipe
+ *
+ * Description:
+ *   Return true if the open file is a pipe or a FIFO.
+ *
+ ****************************************************************************/
+
+bool pipe_ispipe(FAR struct file *filep)
+{
+  FAR struct inode *inode = filep->f_inode;
+
+  /* Pipes and FIFOs are the only drivers that use pipecommon_read() */
+
+  return inode != NULL && INODE_IS_DRIVER(inode) && inode->u.i_ops != NULL &&
+         inode->u.i_ops->read == pipecommon_read;
+}
+
+/****************************************************************************
+ * Name: pipe_splice
+ *
+ * Description:
+ *   Remove up to 'len' bytes from a pipe, passing them to 'writer' directly
+ *   from the pipe buffer.  See include/nuttx/drivers/drivers.h.
+ *
+ ****************************************************************************/
+
+ssize_t pipe_splice(FAR struct file *filep, pipe_splice_t writer,
+                    FAR void *arg, size_t len, bool nonblock)
+{
+  FAR struct inode      *inode   = filep->f_inode;
+  FAR struct pipe_dev_s *dev     = inode->i_private;
+  ssize_t                nsplice = 0;
+  ssize_t                nwritten;
+  size_t                 nbytes;
+  int                    sval;
+  int                    ret;
+
+  DEBUGASSERT(dev && writer);
+
+  if (len == 0)
+    {
+      return 0;
+    }
+
+  /* Make sure that we have exclusive access to the device structure */
+
+  ret = nxsem_wait(&dev->d_bfsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* If the pipe is empty, then wait for something to be written to it */
+
+  while (dev->d_wrndx == dev->d_rdndx)
+    {
+      /* If O_NONBLOCK was set, then return EGAIN */
+
+      if (nonblock || (filep->f_oflags & O_NONBLOCK) != 0)
+        {
+          nxsem_post(&dev->d_bfsem);
+          return -EAGAIN;
+        }
+
+      /* If there are no writers on the pipe, then return end of file */
+
+      if (dev->d_nwriters <= 0)
+        {
+          nxsem_post(&dev->d_bfsem);
+          return 0;
+        }
+
+      /* Otherwise, wait for something to be written to the pipe */
+
+      sched_lock();
+      nxsem_post(&dev->d_bfsem);
+      ret = nxsem_wait(&dev->d_rdsem);
+      sched_unlock();
+
+      if (ret < 0 || (ret = nxsem_wait(&dev->d_bfsem)) < 0)
+        {
+          return ret;
+        }
+    }
+
+  /* Pass on whatever is available in the pipe.  The data is contiguous in
+   * the circular buffer in at most two pieces.
+   */
+
+  while ((size_t)nsplice < len && dev->d_wrndx != dev->d_rdndx)
+    {
+      if (dev->d_wrndx > dev->d_rdndx)
+        {
+          nbytes = dev->d_wrndx - dev->d_rdndx;
+        }
+      else
+        {
+          nbytes = dev->d_bufsize - dev->d_rdndx;
+        }
+
+      if (nbytes > len - nsplice)
+        {
+          nbytes = len - nsplice;
+        }
+
+      nwritten = writer(arg, &dev->d_buffer[dev->d_rdndx], nbytes);
+      if (nwritten <= 0)
+        {
+          /* Report the error only if nothing was transferred */
+
+          if (nsplice == 0)
+            {
+              nsplice = nwritten;
+            }
+
+          break;
+        }
+
+      pipe_dumpbuffer("From PIPE:", &dev->d_buffer[dev->d_rdndx], nwritten);
+
+      dev->d_rdndx += nwritten;
+      if (dev->d_rdndx >= dev->d_bufsize)
+        {
+          dev->d_rdndx = 0;
+        }
+
+      nsplice += nwritten;
+      if ((size_t)nwritten < nbytes)
+        {
+          break;
+        }
+    }
+
+  if (nsplice > 0)
+    {
+      /* Notify all waiting writers that bytes have been removed from the
+       * buffer.
+       */
+
+      while (nxsem_getvalue(&dev->d_wrsem, &sval) == 0 && sval < 0)
+        {
+          nxsem_post(&dev->d_wrsem);
+        }
+
+      /* Notify all poll/select waiters that they can write to the FIFO */
+
+      pipecommon_pollnotify(dev, POLLOUT);
+    }
+
+  nxsem_post(&dev->d_bfsem);
+  return nsplice;
+}
+#endif /* CONFIG_FS_SENDFILE */
+
 #endif /* CONFIG_PIPES */
@@ -201,6 +201,16 @@ static void uart_pollnotify(FAR uart_dev_t *dev, pollevent_t eventset)
 
               finfo("Report events: %02x\n", fds->revents);
 
+              /* Let the callback handle the notification if there is one
+               * (as with epoll).
+               */
+
+              if (fds->cb != NULL)
+                {
+                  fds->cb(fds);
+                  continue;
+                }
+
               /* Limit the number of times that the semaphore is posted.
                * The critical section is needed to make the following
                * operation atomic.
@@ -91,7 +91,12 @@ struct aio_container_s
 #endif
     FAR void *ptr;                 /* Generic pointer to FAR data */
   } u;
+#ifdef CONFIG_FS_AIO_THREADS
+  worker_t aioc_worker;            /* Worker to run on an AIO thread */
+  FAR struct aio_container_s *aioc_merged; /* Next merged container */
+#else
   struct work_s aioc_work;         /* Used to defer I/O to the work thread */
+#endif
   pid_t aioc_pid;                  /* ID of the waiting task */
 #ifdef CONFIG_PRIORITY_INHERITANCE
   uint8_t aioc_prio;               /* Priority of the waiting task */
@@ -234,7 +239,8 @@ FAR struct aiocb *aioc_decant(FAR struct aio_container_s *aioc);
  * Name: aio_queue
  *
  * Description:
- *   Schedule the asynchronous I/O on the low priority work queue
+ *   Schedule the asynchronous I/O on the low priority work queue or, if
+ *   CONFIG_FS_AIO_THREADS is selected, on the AIO worker threads
  *
  * Input Parameters:
  *   arg - Worker argument.  In this case, a pointer to an instance of
@@ -248,6 +254,74 @@ FAR struct aiocb *aioc_decant(FAR struct aio_container_s *aioc);
 
 int aio_queue(FAR struct aio_container_s *aioc, worker_t worker);
 
+/****************************************************************************
+ * Name: aio_dequeue
+ *
+ * Description:
+ *   Remove asynchronous I/O that has not yet been started from the queue
+ *   where aio_queue() placed it.
+ *
+ * Input Parameters:
+ *   aioc - The AIO container to be removed
+ *
+ * Returned Value:
+ *   Zero (OK) if the I/O was removed from the queue; -ENOENT if the I/O
+ *   has already been started.
+ *
+ * Assumptions:
+ *   The caller holds the lock on the pending asynchronous I/O list.
+ *
+ ****************************************************************************/
+
+int aio_dequeue(FAR struct aio_container_s *aioc);
+
+#ifdef CONFIG_FS_AIO_THREADS
+/****************************************************************************
+ * Name: aio_merge
+ *
+ * Description:
+ *   Find the queued requests for the same file that use the same worker
+ *   and that continue the transfer of aioc both in the file and in memory.
+ *   These requests are removed from the queue and linked to aioc through
+ *   aioc_merged so that all of them can be performed as one transfer.
+ *   Only the request that would be started next for the file is ever
+ *   merged so that the order of the requests for the file is preserved.
+ *
+ * Input Parameters:
+ *   aioc   - The AIO container that is about to be started
+ *   worker - The worker that performs the transfer
+ *
+ * Returned Value:
+ *   The total size of the merged transfer.
+ *
+ ****************************************************************************/
+
+size_t aio_merge(FAR struct aio_container_s *aioc, worker_t worker);
+
+/****************************************************************************
+ * Name: aio_unmerge
+ *
+ * Description:
+ *   Complete the requests that were merged by aio_merge().  Each request
+ *   receives its part of the result of the merged transfer, in order, as
+ *   if the requests had been performed one after the other.  The
+ *   containers are freed and the clients are signalled.
+ *
+ * Input Parameters:
+ *   merged - The first merged AIO container (may be NULL)
+ *   nbytes - The size of the request that the containers were merged into
+ *   result - The result of the merged transfer
+ *
+ * Returned Value:
+ *   The part of the result that belongs to the request that the
+ *   containers were merged into.
+ *
+ ****************************************************************************/
+
+ssize_t aio_unmerge(FAR struct aio_container_s *merged, size_t nbytes,
+                    ssize_t result);
+#endif
+
 /****************************************************************************
  * Name: aio_signal
  *
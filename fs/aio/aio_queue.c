@@ -51,7 +51,7 @@
 #ifdef CONFIG_FS_AIO
 
 /****************************************************************************
- * Private Functions
+ * Public Functions
  ****************************************************************************/
 
 /****************************************************************************
@@ -110,4 +110,29 @@ int aio_queue(FAR struct aio_container_s *aioc, worker_t worker)
   return ret;
 }
 
+/****************************************************************************
+ * Name: aio_dequeue
+ *
+ * Description:
+ *   Remove asynchronous I/O that has not yet been started from the queue
+ *   where aio_queue() placed it.
+ *
+ * Input Parameters:
+ *   aioc - The AIO container to be removed
+ *
+ * Returned Value:
+ *   Zero (OK) if the I/O was removed from the queue; -ENOENT if the I/O
+ *   has already been started.
+ *
+ ****************************************************************************/
+
+int aio_dequeue(FAR struct aio_container_s *aioc)
+{
+  /* work_cancel() will return -ENOENT if the work has already been
+   * started and is no longer queued.
+   */
+
+  return work_cancel(LPWORK, &aioc->aioc_work);
+}
+
 #endif /* CONFIG_FS_AIO */
@@ -76,11 +76,19 @@ static void aio_read_worker(FAR void *arg)
 {
   FAR struct aio_container_s *aioc = (FAR struct aio_container_s *)arg;
   FAR struct aiocb *aiocbp;
+  FAR struct file *filep;
+#ifdef AIO_HAVE_PSOCK
+  FAR struct socket *psock;
+#endif
+#ifdef CONFIG_FS_AIO_THREADS
+  FAR struct aio_container_s *merged;
+#endif
   pid_t pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
+#if defined(CONFIG_PRIORITY_INHERITANCE) && !defined(CONFIG_FS_AIO_THREADS)
   uint8_t prio;
 #endif
   ssize_t nread = 0;
+  size_t nbytes;
 
   /* Get the information from the container, decant the AIO control block,
    * and free the container before starting any I/O.  That will minimize
@@ -89,9 +97,23 @@ static void aio_read_worker(FAR void *arg)
 
   DEBUGASSERT(aioc && aioc->aioc_aiocbp);
   pid    = aioc->aioc_pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
+#if defined(CONFIG_PRIORITY_INHERITANCE) && !defined(CONFIG_FS_AIO_THREADS)
   prio   = aioc->aioc_prio;
 #endif
+  filep  = aioc->u.aioc_filep;
+#ifdef AIO_HAVE_PSOCK
+  psock  = aioc->u.aioc_psock;
+#endif
+
+#ifdef CONFIG_FS_AIO_THREADS
+  /* Merge any queued reads that continue this one */
+
+  nbytes = aio_merge(aioc, aio_read_worker);
+  merged = aioc->aioc_merged;
+#else
+  nbytes = aioc->aioc_aiocbp->aio_nbytes;
+#endif
+
   aiocbp = aioc_decant(aioc);
 
 #ifdef AIO_HAVE_PSOCK
@@ -102,12 +124,12 @@ static void aio_read_worker(FAR void *arg)
        *
        *   u.aioc_filep - File structure pointer
        *   aio_buf      - Location of buffer
-       *   aio_nbytes   - Length of transfer
+       *   nbytes       - Length of transfer, including merged reads
        *   aio_offset   - File offset
        */
 
-     nread = file_pread(aioc->u.aioc_filep, (FAR void *)aiocbp->aio_buf,
-                        aiocbp->aio_nbytes, aiocbp->aio_offset);
+     nread = file_pread(filep, (FAR void *)aiocbp->aio_buf, nbytes,
+                        aiocbp->aio_offset);
     }
 #ifdef AIO_HAVE_PSOCK
   else
@@ -119,7 +141,7 @@ static void aio_read_worker(FAR void *arg)
        *   aio_nbytes   - Length of transfer
        */
 
-      nread = psock_recv(aioc->u.aioc_psock, (FAR void *)aiocbp->aio_buf,
+      nread = psock_recv(psock, (FAR void *)aiocbp->aio_buf,
                          aiocbp->aio_nbytes, 0);
     }
 #endif
@@ -133,13 +155,19 @@ static void aio_read_worker(FAR void *arg)
     }
 #endif
 
+#ifdef CONFIG_FS_AIO_THREADS
+  /* Complete any merged reads with their part of the result */
+
+  nread = aio_unmerge(merged, aiocbp->aio_nbytes, nread);
+#endif
+
   aiocbp->aio_result = nread;
 
   /* Signal the client */
 
   (void)aio_signal(pid, aiocbp);
 
-#ifdef CONFIG_PRIORITY_INHERITANCE
+#if defined(CONFIG_PRIORITY_INHERITANCE) && !defined(CONFIG_FS_AIO_THREADS)
   /* Restore the low priority worker thread default priority */
 
   lpwork_restorepriority(prio);
@@ -0,0 +1,563 @@
+/****************************************************************************
+ * fs/aio/aio_thread.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sched.h>
+#include <aio.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/sched.h>
+#include <nuttx/kthread.h>
+#include <nuttx/semaphore.h>
+
+#include "aio/aio.h"
+
+#if defined(CONFIG_FS_AIO) && defined(CONFIG_FS_AIO_THREADS)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define AIO_THREADNAME "aio"
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes the state of one AIO worker thread */
+
+struct aio_thread_s
+{
+  pid_t at_pid;                    /* Task ID of the AIO thread */
+  FAR void *at_file;               /* File or socket in use or NULL */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The state of each AIO worker thread.  Only g_aio_nthreads threads have
+ * been started; these are started when the first I/O is queued.
+ */
+
+static struct aio_thread_s g_aio_threads[CONFIG_FS_AIO_NTHREADS];
+static uint8_t g_aio_nthreads;
+
+/* This counting semaphore is posted each time that I/O is queued */
+
+static sem_t g_aio_readysem;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: aio_takeready
+ *
+ * Description:
+ *   Take the next queued I/O that can be started by an AIO thread.  The
+ *   I/O for each file is started in the order that it was queued and is
+ *   never started while another AIO thread is using the same file.
+ *
+ * Input Parameters:
+ *   thread - The AIO thread that will start the I/O
+ *   worker - The location to return the worker to run
+ *
+ * Returned Value:
+ *   The AIO container of the I/O or NULL if there is no I/O to start.
+ *
+ * Assumptions:
+ *   The caller holds the lock on the pending asynchronous I/O list.
+ *
+ ****************************************************************************/
+
+static FAR struct aio_container_s *
+aio_takeready(FAR struct aio_thread_s *thread, FAR worker_t *worker)
+{
+  FAR struct aio_container_s *aioc;
+  int i;
+
+  for (aioc = (FAR struct aio_container_s *)g_aio_pending.head;
+       aioc != NULL;
+       aioc = (FAR struct aio_container_s *)aioc->aioc_link.flink)
+    {
+      /* Skip over I/O that is not yet queued or that was already taken */
+
+      if (aioc->aioc_worker == NULL)
+        {
+          continue;
+        }
+
+      /* Skip over I/O for files that are in use by another thread.  This
+       * also skips over all of the later I/O for the same file.
+       */
+
+      for (i = 0; i < g_aio_nthreads; i++)
+        {
+          if (g_aio_threads[i].at_file == aioc->u.ptr)
+            {
+              break;
+            }
+        }
+
+      if (i >= g_aio_nthreads)
+        {
+          /* Take the I/O.  aioc_worker is cleared so that the I/O can no
+           * longer be taken or canceled.
+           */
+
+          *worker            = aioc->aioc_worker;
+          aioc->aioc_worker  = NULL;
+          aioc->aioc_merged  = NULL;
+          thread->at_file    = aioc->u.ptr;
+          return aioc;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: aio_thread
+ *
+ * Description:
+ *   This is the body of each AIO worker thread.
+ *
+ * Input Parameters:
+ *   argc, argv (not used)
+ *
+ * Returned Value:
+ *   Does not return
+ *
+ ****************************************************************************/
+
+static int aio_thread(int argc, FAR char *argv[])
+{
+  FAR struct aio_thread_s *thread;
+  FAR struct aio_container_s *aioc;
+  worker_t worker;
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  struct sched_param param;
+  uint8_t prio;
+#endif
+  pid_t me = getpid();
+  int i;
+
+  /* Find our state structure */
+
+  for (i = 0; i < CONFIG_FS_AIO_NTHREADS; i++)
+    {
+      if (g_aio_threads[i].at_pid == me)
+        {
+          break;
+        }
+    }
+
+  DEBUGASSERT(i < CONFIG_FS_AIO_NTHREADS);
+  thread = &g_aio_threads[i];
+
+  /* Loop forever */
+
+  for (; ; )
+    {
+      aio_lock();
+      aioc = aio_takeready(thread, &worker);
+      aio_unlock();
+
+      if (aioc == NULL)
+        {
+          /* Wait for more I/O to be queued.  I/O that was held back
+           * because its file was in use is taken by the thread that was
+           * using the file when that thread is finished.
+           */
+
+          (void)nxsem_wait(&g_aio_readysem);
+          continue;
+        }
+
+#ifdef CONFIG_PRIORITY_INHERITANCE
+      /* Run at least at the priority of the waiting task */
+
+      prio = aioc->aioc_prio;
+      if (prio > CONFIG_FS_AIO_PRIORITY)
+        {
+          param.sched_priority = prio;
+          (void)nxsched_setparam(0, &param);
+        }
+#endif
+
+      /* Perform the I/O.  The worker frees the container. */
+
+      worker(aioc);
+
+#ifdef CONFIG_PRIORITY_INHERITANCE
+      /* Restore the default priority of the AIO thread */
+
+      if (prio > CONFIG_FS_AIO_PRIORITY)
+        {
+          param.sched_priority = CONFIG_FS_AIO_PRIORITY;
+          (void)nxsched_setparam(0, &param);
+        }
+#endif
+
+      /* The file is no longer in use */
+
+      aio_lock();
+      thread->at_file = NULL;
+      aio_unlock();
+    }
+
+  return OK; /* To keep some compilers happy */
+}
+
+/****************************************************************************
+ * Name: aio_start
+ *
+ * Description:
+ *   Start the AIO worker threads that have not yet been started.  If some
+ *   of the threads cannot be created, then the I/O is performed by those
+ *   that could be and the others are retried when the next I/O is queued.
+ *
+ * Returned Value:
+ *   Zero (OK) if at least one worker thread is running; a negated errno
+ *   value on failure.
+ *
+ * Assumptions:
+ *   The caller holds the lock on the pending asynchronous I/O list.
+ *
+ ****************************************************************************/
+
+static int aio_start(void)
+{
+  pid_t pid;
+
+  if (g_aio_nthreads == 0)
+    {
+      (void)nxsem_init(&g_aio_readysem, 0, 0);
+      (void)nxsem_setprotocol(&g_aio_readysem, SEM_PRIO_NONE);
+    }
+
+  /* Don't permit any of the threads to run until their task IDs are
+   * recorded in g_aio_threads.
+   */
+
+  sched_lock();
+  while (g_aio_nthreads < CONFIG_FS_AIO_NTHREADS)
+    {
+      pid = kthread_create(AIO_THREADNAME, CONFIG_FS_AIO_PRIORITY,
+                           CONFIG_FS_AIO_STACKSIZE, (main_t)aio_thread,
+                           (FAR char * const *)NULL);
+      if (pid < 0)
+        {
+          ferr("ERROR: kthread_create %d failed: %d\n",
+               g_aio_nthreads, (int)pid);
+
+          /* That is only fatal if there is no worker to perform the I/O */
+
+          if (g_aio_nthreads == 0)
+            {
+              sched_unlock();
+              return (int)pid;
+            }
+
+          break;
+        }
+
+      g_aio_threads[g_aio_nthreads].at_pid  = pid;
+      g_aio_threads[g_aio_nthreads].at_file = NULL;
+      g_aio_nthreads++;
+    }
+
+  sched_unlock();
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: aio_queue
+ *
+ * Description:
+ *   Schedule the asynchronous I/O on the AIO worker threads
+ *
+ * Input Parameters:
+ *   aioc   - The AIO container of the I/O
+ *   worker - The worker that will perform the I/O
+ *
+ * Returned Value:
+ *   Zero (OK) on success.  Otherwise, -1 is returned and the errno is set
+ *   appropriately.
+ *
+ ****************************************************************************/
+
+int aio_queue(FAR struct aio_container_s *aioc, worker_t worker)
+{
+  int ret = OK;
+
+  aio_lock();
+
+  /* Start the AIO worker threads when the first I/O is queued */
+
+  if (g_aio_nthreads < CONFIG_FS_AIO_NTHREADS)
+    {
+      ret = aio_start();
+    }
+
+  if (ret >= 0)
+    {
+      /* The container is already in the list of pending I/O.  Setting
+       * the worker makes it available to the AIO threads.
+       */
+
+      aioc->aioc_worker = worker;
+      nxsem_post(&g_aio_readysem);
+    }
+
+  aio_unlock();
+
+  if (ret < 0)
+    {
+      FAR struct aiocb *aiocbp = aioc->aioc_aiocbp;
+      DEBUGASSERT(aiocbp);
+
+      aiocbp->aio_result = ret;
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: aio_dequeue
+ *
+ * Description:
+ *   Remove asynchronous I/O that has not yet been started from the queue
+ *   where aio_queue() placed it.
+ *
+ * Input Parameters:
+ *   aioc - The AIO container to be removed
+ *
+ * Returned Value:
+ *   Zero (OK) if the I/O was removed from the queue; -ENOENT if the I/O
+ *   has already been started.
+ *
+ * Assumptions:
+ *   The caller holds the lock on the pending asynchronous I/O list.
+ *
+ ****************************************************************************/
+
+int aio_dequeue(FAR struct aio_container_s *aioc)
+{
+  if (aioc->aioc_worker == NULL)
+    {
+      return -ENOENT;
+    }
+
+  aioc->aioc_worker = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: aio_merge
+ *
+ * Description:
+ *   Find the queued requests for the same file that use the same worker
+ *   and that continue the transfer of aioc both in the file and in memory.
+ *   These requests are removed from the queue and linked to aioc through
+ *   aioc_merged so that all of them can be performed as one transfer.
+ *   Only the request that would be started next for the file is ever
+ *   merged so that the order of the requests for the file is preserved.
+ *
+ * Input Parameters:
+ *   aioc   - The AIO container that is about to be started
+ *   worker - The worker that performs the transfer
+ *
+ * Returned Value:
+ *   The total size of the merged transfer.
+ *
+ ****************************************************************************/
+
+size_t aio_merge(FAR struct aio_container_s *aioc, worker_t worker)
+{
+  FAR struct aio_container_s *last = aioc;
+  FAR struct aio_container_s *next;
+  FAR struct aiocb *prev;
+  FAR struct aiocb *aiocbp;
+  size_t nbytes;
+
+  DEBUGASSERT(aioc != NULL && aioc->aioc_aiocbp != NULL);
+  nbytes = aioc->aioc_aiocbp->aio_nbytes;
+
+#ifdef AIO_HAVE_PSOCK
+  /* Socket I/O has no file offset and is never merged */
+
+  if (aioc->aioc_aiocbp->aio_fildes >= CONFIG_NFILE_DESCRIPTORS)
+    {
+      return nbytes;
+    }
+#endif
+
+  aio_lock();
+  for (; ; )
+    {
+      /* Find the next queued I/O for the same file */
+
+      for (next = (FAR struct aio_container_s *)g_aio_pending.head;
+           next != NULL;
+           next = (FAR struct aio_container_s *)next->aioc_link.flink)
+        {
+          if (next->aioc_worker != NULL && next->u.ptr == aioc->u.ptr)
+            {
+              break;
+            }
+        }
+
+      if (next == NULL || next->aioc_worker != worker)
+        {
+          break;
+        }
+
+      /* It can be merged only if it begins where the last merged request
+       * ends, both in the file and in memory.
+       */
+
+      prev   = last->aioc_aiocbp;
+      aiocbp = next->aioc_aiocbp;
+
+      if (aiocbp->aio_offset != prev->aio_offset + (off_t)prev->aio_nbytes ||
+          (FAR uint8_t *)aiocbp->aio_buf !=
+          (FAR uint8_t *)prev->aio_buf + prev->aio_nbytes ||
+          nbytes + aiocbp->aio_nbytes > SSIZE_MAX)
+        {
+          break;
+        }
+
+      /* Take the I/O and add it to the merged transfer */
+
+      next->aioc_worker  = NULL;
+      next->aioc_merged  = NULL;
+      last->aioc_merged  = next;
+      last               = next;
+      nbytes            += aiocbp->aio_nbytes;
+    }
+
+  aio_unlock();
+  return nbytes;
+}
+
+/****************************************************************************
+ * Name: aio_unmerge
+ *
+ * Description:
+ *   Complete the requests that were merged by aio_merge().  Each request
+ *   receives its part of the result of the merged transfer, in order, as
+ *   if the requests had been performed one after the other.  The
+ *   containers are freed and the clients are signalled.
+ *
+ * Input Parameters:
+ *   merged - The first merged AIO container (may be NULL)
+ *   nbytes - The size of the request that the containers were merged into
+ *   result - The result of the merged transfer
+ *
+ * Returned Value:
+ *   The part of the result that belongs to the request that the
+ *   containers were merged into.
+ *
+ ****************************************************************************/
+
+ssize_t aio_unmerge(FAR struct aio_container_s *merged, size_t nbytes,
+                    ssize_t result)
+{
+  FAR struct aio_container_s *next;
+  FAR struct aiocb *aiocbp;
+  ssize_t remaining;
+  ssize_t ret;
+  pid_t pid;
+
+  /* An error is reported by every request.  Otherwise, the bytes that were
+   * transferred are distributed to the requests in order.
+   */
+
+  ret       = result;
+  remaining = 0;
+
+  if (result > (ssize_t)nbytes)
+    {
+      ret       = nbytes;
+      remaining = result - nbytes;
+    }
+
+  for (; merged != NULL; merged = next)
+    {
+      next   = merged->aioc_merged;
+      pid    = merged->aioc_pid;
+      aiocbp = aioc_decant(merged);
+
+      if (result < 0)
+        {
+          aiocbp->aio_result = result;
+        }
+      else if (remaining > (ssize_t)aiocbp->aio_nbytes)
+        {
+          aiocbp->aio_result = aiocbp->aio_nbytes;
+          remaining         -= aiocbp->aio_nbytes;
+        }
+      else
+        {
+          aiocbp->aio_result = remaining;
+          remaining          = 0;
+        }
+
+      (void)aio_signal(pid, aiocbp);
+    }
+
+  return ret;
+}
+
+#endif /* CONFIG_FS_AIO && CONFIG_FS_AIO_THREADS */
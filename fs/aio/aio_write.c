@@ -76,11 +76,19 @@ static void aio_write_worker(FAR void *arg)
 {
   FAR struct aio_container_s *aioc = (FAR struct aio_container_s *)arg;
   FAR struct aiocb *aiocbp;
+  FAR struct file *filep;
+#ifdef AIO_HAVE_PSOCK
+  FAR struct socket *psock;
+#endif
+#ifdef CONFIG_FS_AIO_THREADS
+  FAR struct aio_container_s *merged;
+#endif
   pid_t pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
+#if defined(CONFIG_PRIORITY_INHERITANCE) && !defined(CONFIG_FS_AIO_THREADS)
   uint8_t prio;
 #endif
   ssize_t nwritten = 0;
+  size_t nbytes;
   int oflags;
 
   /* Get the information from the container, decant the AIO control block,
@@ -90,9 +98,23 @@ static void aio_write_worker(FAR void *arg)
 
   DEBUGASSERT(aioc && aioc->aioc_aiocbp);
   pid    = aioc->aioc_pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
+#if defined(CONFIG_PRIORITY_INHERITANCE) && !defined(CONFIG_FS_AIO_THREADS)
   prio   = aioc->aioc_prio;
 #endif
+  filep  = aioc->u.aioc_filep;
+#ifdef AIO_HAVE_PSOCK
+  psock  = aioc->u.aioc_psock;
+#endif
+
+#ifdef CONFIG_FS_AIO_THREADS
+  /* Merge any queued writes that continue this one */
+
+  nbytes = aio_merge(aioc, aio_write_worker);
+  merged = aioc->aioc_merged;
+#else
+  nbytes = aioc->aioc_aiocbp->aio_nbytes;
+#endif
+
   aiocbp = aioc_decant(aioc);
 
 #ifdef AIO_HAVE_PSOCK
@@ -101,11 +123,11 @@ static void aio_write_worker(FAR void *arg)
     {
       /* Call fcntl(F_GETFL) to get the file open mode. */
 
-      oflags = file_fcntl(aioc->u.aioc_filep, F_GETFL);
+      oflags = file_fcntl(filep, F_GETFL);
       if (oflags < 0)
         {
           ferr("ERROR: file_fcntl failed: %d\n", oflags);
-          aiocbp->aio_result = oflags;
+          nwritten = oflags;
           goto errout;
         }
 
@@ -113,7 +135,7 @@ static void aio_write_worker(FAR void *arg)
        *
        *   u.aioc_filep - File structure pointer
        *   aio_buf      - Location of buffer
-       *   aio_nbytes   - Length of transfer
+       *   nbytes       - Length of transfer, including merged writes
        *   aio_offset   - File offset
        */
 
@@ -123,16 +145,13 @@ static void aio_write_worker(FAR void *arg)
         {
           /* Append to the current file position */
 
-          nwritten = file_write(aioc->u.aioc_filep,
-                                (FAR const void *)aiocbp->aio_buf,
-                                aiocbp->aio_nbytes);
+          nwritten = file_write(filep, (FAR const void *)aiocbp->aio_buf,
+                                nbytes);
         }
       else
         {
-          nwritten = file_pwrite(aioc->u.aioc_filep,
-                                 (FAR const void *)aiocbp->aio_buf,
-                                 aiocbp->aio_nbytes,
-                                 aiocbp->aio_offset);
+          nwritten = file_pwrite(filep, (FAR const void *)aiocbp->aio_buf,
+                                 nbytes, aiocbp->aio_offset);
         }
     }
 #ifdef AIO_HAVE_PSOCK
@@ -145,8 +164,7 @@ static void aio_write_worker(FAR void *arg)
        *   aio_nbytes   - Length of transfer
        */
 
-      nwritten = psock_send(aioc->u.aioc_psock,
-                            (FAR const void *)aiocbp->aio_buf,
+      nwritten = psock_send(psock, (FAR const void *)aiocbp->aio_buf,
                             aiocbp->aio_nbytes, 0);
     }
 #endif
@@ -156,17 +174,22 @@ static void aio_write_worker(FAR void *arg)
       ferr("ERROR: write/pwrite/send failed: %d\n", nwritten);
     }
 
+errout:
+#ifdef CONFIG_FS_AIO_THREADS
+  /* Complete any merged writes with their part of the result */
+
+  nwritten = aio_unmerge(merged, aiocbp->aio_nbytes, nwritten);
+#endif
+
   /* Save the result of the write */
 
   aiocbp->aio_result = nwritten;
 
-errout:
-
   /* Signal the client */
 
   (void)aio_signal(pid, aiocbp);
 
-#ifdef CONFIG_PRIORITY_INHERITANCE
+#if defined(CONFIG_PRIORITY_INHERITANCE) && !defined(CONFIG_FS_AIO_THREADS)
   /* Restore the low priority worker thread default priority */
 
   lpwork_restorepriority(prio);
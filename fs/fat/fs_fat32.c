@@ -272,6 +272,12 @@ static int fat_open(FAR struct file *filep, FAR const char *relpath,
             {
               goto errout_with_semaphore;
             }
+
+          /* The directory sector is back in the cache, but not
+           * necessarily in the same buffer.
+           */
+
+          direntry = &fs->fs_buffer[dirinfo.fd_seq.ds_offset];
         }
 
       /* fall through to finish the file open operations */
@@ -593,6 +599,8 @@ static ssize_t fat_read(FAR struct file *filep, FAR char *buffer,
           ff->ff_currentcluster   = cluster;
           ff->ff_currentsector    = fat_cluster2sector(fs, cluster);
           ff->ff_sectorsincluster = fs->fs_fatsecperclus;
+
+          fat_extentadd(ff, CLUS_NCLUSTERS(fs, filep->f_pos), cluster, 1);
         }
 
 #ifdef CONFIG_FAT_DIRECT_RETRY /* Warning avoidance */
@@ -613,12 +621,19 @@ fat_read_restart:
            *
            * Limit the number of sectors that we read on this time
            * through the loop to the remaining contiguous sectors
-           * in this cluster
+           * in this cluster and in any following clusters that are
+           * contiguous on the media.
            */
 
           if (nsectors > ff->ff_sectorsincluster)
             {
-              nsectors = ff->ff_sectorsincluster;
+              ret = fat_contiguous(fs, ff, nsectors, false);
+              if (ret < 0)
+                {
+                  goto errout_with_semaphore;
+                }
+
+              nsectors = ret;
             }
 
           /* We are not sure of the state of the file buffer so
@@ -652,9 +667,8 @@ fat_read_restart:
               goto errout_with_semaphore;
             }
 
-          ff->ff_sectorsincluster -= nsectors;
-          ff->ff_currentsector    += nsectors;
-          bytesread                = nsectors * fs->fs_hwsectorsize;
+          fat_advance(fs, ff, filep->f_pos, nsectors);
+          bytesread = nsectors * fs->fs_hwsectorsize;
         }
       else
 #endif /* CONFIG_FAT_FORCE_INDIRECT */
@@ -853,6 +867,8 @@ static ssize_t fat_write(FAR struct file *filep, FAR const char *buffer,
           ff->ff_currentcluster   = cluster;
           ff->ff_sectorsincluster = fs->fs_fatsecperclus;
           ff->ff_currentsector    = fat_cluster2sector(fs, cluster);
+
+          fat_extentadd(ff, CLUS_NCLUSTERS(fs, filep->f_pos), cluster, 1);
         }
 
 #ifdef CONFIG_FAT_DIRECT_RETRY /* Warning avoidance */
@@ -872,12 +888,19 @@ fat_write_restart:
            *
            * Limit the number of sectors that we write on this time
            * through the loop to the remaining contiguous sectors
-           * in this cluster
+           * in this cluster and in any following clusters that are
+           * (or can be allocated) contiguous on the media.
            */
 
           if (nsectors > ff->ff_sectorsincluster)
             {
-              nsectors = ff->ff_sectorsincluster;
+              ret = fat_contiguous(fs, ff, nsectors, true);
+              if (ret < 0)
+                {
+                  goto errout_with_semaphore;
+                }
+
+              nsectors = ret;
             }
 
           /* We are not sure of the state of the sector cache so the
@@ -912,10 +935,9 @@ fat_write_restart:
               goto errout_with_semaphore;
             }
 
-          ff->ff_sectorsincluster -= nsectors;
-          ff->ff_currentsector    += nsectors;
-          writesize                = nsectors * fs->fs_hwsectorsize;
-          ff->ff_bflags           |= FFBUFF_MODIFIED;
+          fat_advance(fs, ff, filep->f_pos, nsectors);
+          writesize      = nsectors * fs->fs_hwsectorsize;
+          ff->ff_bflags |= FFBUFF_MODIFIED;
         }
       else
 #endif /* CONFIG_FAT_FORCE_INDIRECT */
@@ -1027,6 +1049,10 @@ static off_t fat_seek(FAR struct file *filep, off_t offset, int whence)
   int32_t cluster;
   off_t position;
   unsigned int clustersize;
+#if CONFIG_FAT_NEXTENTS > 0
+  uint32_t index;
+  uint32_t known;
+#endif
   int ret;
 
   /* Sanity checks */
@@ -1152,6 +1178,22 @@ static off_t fat_seek(FAR struct file *filep, off_t offset, int whence)
        */
 
       clustersize = fs->fs_fatsecperclus * fs->fs_hwsectorsize;
+
+#if CONFIG_FAT_NEXTENTS > 0
+      /* Start from the known cluster nearest to the requested position
+       * rather than from the beginning of the chain.
+       */
+
+      index = position / clustersize;
+      known = fat_extentfind(ff, &index);
+      if (known != 0)
+        {
+          cluster       = known;
+          filep->f_pos  = (off_t)index * clustersize;
+          position     -= filep->f_pos;
+        }
+#endif
+
       for (; ; )
         {
           /* Skip over clusters prior to the one containing
@@ -1159,6 +1201,8 @@ static off_t fat_seek(FAR struct file *filep, off_t offset, int whence)
            */
 
           ff->ff_currentcluster = cluster;
+          fat_extentadd(ff, filep->f_pos / clustersize, cluster, 1);
+
           if (position < clustersize)
             {
               break;
@@ -1514,6 +1558,10 @@ static int fat_dup(FAR const struct file *oldp, FAR struct file *newp)
   newff->ff_startcluster     = oldff->ff_startcluster;     /* Start cluster of file on media */
   newff->ff_currentsector    = oldff->ff_currentsector;    /* Current sector */
   newff->ff_cachesector      = 0;                          /* Sector in file buffer */
+#if CONFIG_FAT_NEXTENTS > 0
+  newff->ff_nextents         = oldff->ff_nextents;         /* Known runs */
+  memcpy(newff->ff_extents, oldff->ff_extents, sizeof(newff->ff_extents));
+#endif
 
   /* Attach the private date to the struct file instance */
 
@@ -1809,6 +1857,10 @@ static int fat_truncate(FAR struct file *filep, off_t length)
           ff->ff_size = length;
           ret = OK;
         }
+
+      /* Forget the clusters that may have been removed from the chain */
+
+      fat_extentreset(ff);
     }
   else
     {
@@ -2172,6 +2224,13 @@ static int fat_unbind(FAR void *handle, FAR struct inode **blkdriver,
         }
     }
 
+  /* Write back any modified sectors that remain in the sector cache */
+
+  if (fs->fs_buffer)
+    {
+      (void)fat_fscacheflush(fs);
+    }
+
   /* Unmount ... close the block driver */
 
   if (fs->fs_blkdriver)
@@ -2199,10 +2258,7 @@ static int fat_unbind(FAR void *handle, FAR struct inode **blkdriver,
 
   /* Release the mountpoint private data */
 
-  if (fs->fs_buffer)
-    {
-      fat_io_free(fs->fs_buffer, fs->fs_hwsectorsize);
-    }
+  fat_fscachefree(fs);
 
   nxsem_destroy(&fs->fs_sem);
   kmm_free(fs);
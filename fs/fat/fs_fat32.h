@@ -56,6 +56,24 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* Configuration ************************************************************/
+
+/* The number of FAT/directory sectors buffered for each mounted volume */
+
+#ifndef CONFIG_FAT_CACHE_NSECTORS
+#  define CONFIG_FAT_CACHE_NSECTORS 1
+#endif
+
+#if CONFIG_FAT_CACHE_NSECTORS < 1
+#  error CONFIG_FAT_CACHE_NSECTORS must be at least one
+#endif
+
+/* The number of cluster extents remembered by each open file */
+
+#ifndef CONFIG_FAT_NEXTENTS
+#  define CONFIG_FAT_NEXTENTS 0
+#endif
+
 /****************************************************************************
  * These offsets describes the master boot record (MBR).
  *
@@ -280,6 +298,7 @@
 #define SEC_NSECTORS(f,n)   ((n) / (f)->fs_hwsectorsize)
 
 #define CLUS_NDXMASK(f)     ((f)->fs_fatsecperclus - 1)
+#define CLUS_NCLUSTERS(f,n) (SEC_NSECTORS(f,n) / (f)->fs_fatsecperclus)
 
 /****************************************************************************
  * The FAT "long" file name (LFN) directory entry */
@@ -347,6 +366,12 @@
 #define FFBUFF_DIRTY         2
 #define FFBUFF_MODIFIED      4
 
+/* A sector number that is never valid.  Used to mark empty sector cache
+ * entries.
+ */
+
+#define FAT_NOSECTOR         ((off_t)-1)
+
 /* Mount status flags (ff_bflags) */
 
 #define UMOUNT_FORCED        8
@@ -867,6 +892,23 @@
  * Public Types
  ****************************************************************************/
 
+#if CONFIG_FAT_CACHE_NSECTORS > 1
+/* This structure describes one sector in the sector cache of a mountpoint.
+ * The sector that is currently selected is also described by the
+ * fs_currentsector, fs_dirty, and fs_buffer fields of the mountpoint
+ * structure; those fields are the authoritative copy while the sector is
+ * selected.
+ */
+
+struct fat_cachesector_s
+{
+  off_t    cs_sector;              /* The sector number or FAT_NOSECTOR */
+  uint32_t cs_age;                 /* Time of last use (for LRU replacement) */
+  bool     cs_dirty;               /* true: The buffer must be written back */
+  uint8_t *cs_buffer;              /* Buffer holding one hardware sector */
+};
+#endif
+
 /* This structure represents the overall mountpoint state.  An instance of this
  * structure is retained as inode private data on each mountpoint that is
  * mounted with a fat32 filesystem.
@@ -901,7 +943,27 @@ struct fat_mountpt_s
   uint8_t  fs_fatsecperclus;       /* MBR: Sectors per allocation unit: 2**n, n=0..7 */
   uint8_t *fs_buffer;              /* This is an allocated buffer to hold one sector
                                     * from the device */
+#if CONFIG_FAT_CACHE_NSECTORS > 1
+  uint8_t  fs_cachendx;            /* Index of the selected cache sector */
+  uint32_t fs_cacheage;            /* Incremented on each selection */
+  struct fat_cachesector_s fs_cache[CONFIG_FAT_CACHE_NSECTORS];
+#endif
+};
+
+#if CONFIG_FAT_NEXTENTS > 0
+/* This structure describes one run of physically contiguous clusters in the
+ * cluster chain of a file:  Clusters fe_index through
+ * fe_index + fe_count - 1 of the file are held in clusters fe_cluster
+ * through fe_cluster + fe_count - 1 of the volume.
+ */
+
+struct fat_extent_s
+{
+  uint32_t fe_index;               /* Index of the first cluster in the file */
+  uint32_t fe_cluster;             /* First cluster of the run on the media */
+  uint32_t fe_count;               /* Number of clusters in the run */
 };
+#endif
 
 /* This structure represents on open file under the mountpoint.  An instance
  * of this structure is retained as struct file specific information on each
@@ -922,6 +984,10 @@ struct fat_file_s
   off_t    ff_currentsector;       /* Current sector being operated on */
   off_t    ff_cachesector;         /* Current sector in the file buffer */
   uint8_t *ff_buffer;              /* File buffer (for partial sector accesses) */
+#if CONFIG_FAT_NEXTENTS > 0
+  uint8_t  ff_nextents;            /* Number of valid entries in ff_extents[] */
+  struct fat_extent_s ff_extents[CONFIG_FAT_NEXTENTS]; /* Known cluster runs */
+#endif
 };
 
 /* This structure holds the sequence of directory entries used by one
@@ -1053,6 +1119,22 @@ EXTERN int    fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
                              off_t startsector);
 EXTERN int    fat_removechain(struct fat_mountpt_s *fs, uint32_t cluster);
 EXTERN int32_t fat_extendchain(struct fat_mountpt_s *fs, uint32_t cluster);
+EXTERN int    fat_contiguous(struct fat_mountpt_s *fs, struct fat_file_s *ff,
+                             unsigned int nsectors, bool extend);
+EXTERN void   fat_advance(struct fat_mountpt_s *fs, struct fat_file_s *ff,
+                          off_t position, unsigned int nsectors);
+
+/* Per-file cache of cluster runs */
+
+#if CONFIG_FAT_NEXTENTS > 0
+EXTERN void   fat_extentadd(struct fat_file_s *ff, uint32_t index,
+                            uint32_t cluster, uint32_t count);
+EXTERN uint32_t fat_extentfind(struct fat_file_s *ff, FAR uint32_t *index);
+#  define fat_extentreset(ff) ((ff)->ff_nextents = 0)
+#else
+#  define fat_extentadd(ff,i,c,n)
+#  define fat_extentreset(ff)
+#endif
 
 #define fat_createchain(fs) fat_extendchain(fs, 0)
 
@@ -1082,6 +1164,10 @@ EXTERN int    fat_remove(struct fat_mountpt_s *fs, const char *relpath, bool dir
 
 EXTERN int    fat_fscacheflush(struct fat_mountpt_s *fs);
 EXTERN int    fat_fscacheread(struct fat_mountpt_s *fs, off_t sector);
+EXTERN void   fat_fscacheinvalidate(struct fat_mountpt_s *fs, off_t sector,
+                                    unsigned int nsectors);
+EXTERN int    fat_fscachealloc(struct fat_mountpt_s *fs);
+EXTERN void   fat_fscachefree(struct fat_mountpt_s *fs);
 EXTERN int    fat_ffcacheflush(struct fat_mountpt_s *fs, struct fat_file_s *ff);
 EXTERN int    fat_ffcacheread(struct fat_mountpt_s *fs, struct fat_file_s *ff, off_t sector);
 EXTERN int    fat_ffcacheinvalidate(struct fat_mountpt_s *fs, struct fat_file_s *ff);
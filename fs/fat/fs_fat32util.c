@@ -278,6 +278,85 @@ static int fat_checkbootrecord(struct fat_mountpt_s *fs)
   return OK;
 }
 
+/****************************************************************************
+ * Name: fat_fscachewrite
+ *
+ * Description:
+ *   Write one sector from the sector cache to the media.  If the sector
+ *   lies in the FAT region, then the change is made in each copy of the FAT
+ *   as well.
+ *
+ ****************************************************************************/
+
+static int fat_fscachewrite(struct fat_mountpt_s *fs, uint8_t *buffer,
+                            off_t sector)
+{
+  int ret;
+
+  /* Write the dirty sector */
+
+  ret = fat_hwwrite(fs, buffer, sector, 1);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Does the sector lie in the FAT region? */
+
+  if (sector >= fs->fs_fatbase &&
+      sector < fs->fs_fatbase + fs->fs_nfatsects)
+    {
+      int i;
+
+      /* Yes, then make the change in the FAT copy as well */
+
+      for (i = fs->fs_fatnumfats; i >= 2; i--)
+        {
+          sector += fs->fs_nfatsects;
+          ret = fat_hwwrite(fs, buffer, sector, 1);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fat_fscachesave and fat_fscacheselect
+ *
+ * Description:
+ *   The selected sector of the sector cache is described by the
+ *   fs_currentsector, fs_dirty, and fs_buffer fields of the mountpoint
+ *   structure which the rest of the FAT logic accesses directly.
+ *   fat_fscachesave() copies that state back into the cache entry;
+ *   fat_fscacheselect() makes another cache entry the selected sector.
+ *
+ ****************************************************************************/
+
+#if CONFIG_FAT_CACHE_NSECTORS > 1
+static void fat_fscachesave(struct fat_mountpt_s *fs)
+{
+  FAR struct fat_cachesector_s *cs = &fs->fs_cache[fs->fs_cachendx];
+
+  cs->cs_sector = fs->fs_currentsector;
+  cs->cs_dirty  = fs->fs_dirty;
+}
+
+static void fat_fscacheselect(struct fat_mountpt_s *fs, int ndx)
+{
+  FAR struct fat_cachesector_s *cs = &fs->fs_cache[ndx];
+
+  fs->fs_cachendx      = ndx;
+  fs->fs_currentsector = cs->cs_sector;
+  fs->fs_dirty         = cs->cs_dirty;
+  fs->fs_buffer        = cs->cs_buffer;
+  cs->cs_age           = ++fs->fs_cacheage;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -549,12 +628,11 @@ int fat_mount(struct fat_mountpt_s *fs, bool writeable)
   fs->fs_hwsectorsize = geo.geo_sectorsize;
   fs->fs_hwnsectors   = geo.geo_nsectors;
 
-  /* Allocate a buffer to hold one hardware sector */
+  /* Allocate the sector cache */
 
-  fs->fs_buffer = (FAR uint8_t *)fat_io_alloc(fs->fs_hwsectorsize);
-  if (!fs->fs_buffer)
+  ret = fat_fscachealloc(fs);
+  if (ret < 0)
     {
-      ret = -ENOMEM;
       goto errout;
     }
 
@@ -685,8 +763,7 @@ int fat_mount(struct fat_mountpt_s *fs, bool writeable)
   return OK;
 
 errout_with_buffer:
-  fat_io_free(fs->fs_buffer, fs->fs_hwsectorsize);
-  fs->fs_buffer = 0;
+  fat_fscachefree(fs);
 
 errout:
   fs->fs_mounted = false;
@@ -1321,6 +1398,13 @@ int32_t fat_extendchain(struct fat_mountpt_s *fs, uint32_t cluster)
         }
     }
 
+  /* Discard any stale copy of the sectors of the new cluster that may
+   * remain in the sector cache from an earlier use of the cluster.
+   */
+
+  fat_fscacheinvalidate(fs, fat_cluster2sector(fs, newcluster),
+                        fs->fs_fatsecperclus);
+
   /* And update the FINSINFO for the next time we have to search */
 
   fs->fs_fsinextfree = newcluster;
@@ -1335,6 +1419,201 @@ int32_t fat_extendchain(struct fat_mountpt_s *fs, uint32_t cluster)
   return newcluster;
 }
 
+/****************************************************************************
+ * Name: fat_contiguous
+ *
+ * Description:
+ *   Determine how many of the next nsectors of the file, starting with
+ *   ff_currentsector, lie in physically contiguous sectors on the media so
+ *   that they can be transferred with one request to the block driver.
+ *   The run may continue beyond the current cluster as long as each
+ *   following cluster in the chain is the next cluster on the media.  If
+ *   'extend' is true, the cluster chain is extended as necessary (for
+ *   writes).  The state of the file is not modified.
+ *
+ * Returned Value:
+ *   <0: error, otherwise the number of contiguous sectors (at least one
+ *   and no more than nsectors).
+ *
+ ****************************************************************************/
+
+int fat_contiguous(struct fat_mountpt_s *fs, struct fat_file_s *ff,
+                   unsigned int nsectors, bool extend)
+{
+  unsigned int avail = ff->ff_sectorsincluster;
+  uint32_t cluster = ff->ff_currentcluster;
+  off_t next;
+
+  while (avail < nsectors)
+    {
+      if (extend)
+        {
+          next = fat_extendchain(fs, cluster);
+        }
+      else
+        {
+          next = fat_getcluster(fs, cluster);
+        }
+
+      if (next < 0)
+        {
+          return (int)next;
+        }
+
+      /* Stop at the end of the chain or at the first discontinuity */
+
+      if (next != cluster + 1)
+        {
+          break;
+        }
+
+      cluster = next;
+      avail  += fs->fs_fatsecperclus;
+    }
+
+  return avail < nsectors ? avail : nsectors;
+}
+
+/****************************************************************************
+ * Name: fat_advance
+ *
+ * Description:
+ *   Update the file state after nsectors have been transferred directly,
+ *   starting with ff_currentsector at file position 'position'.  The
+ *   transfer may have continued into the following clusters as permitted
+ *   by fat_contiguous().
+ *
+ ****************************************************************************/
+
+void fat_advance(struct fat_mountpt_s *fs, struct fat_file_s *ff,
+                 off_t position, unsigned int nsectors)
+{
+  unsigned int extra;
+  uint32_t nclusters;
+
+  if (nsectors > ff->ff_sectorsincluster)
+    {
+      /* The transfer continued into the following, contiguous clusters */
+
+      extra     = nsectors - ff->ff_sectorsincluster;
+      nclusters = (extra + fs->fs_fatsecperclus - 1) / fs->fs_fatsecperclus;
+
+      fat_extentadd(ff, CLUS_NCLUSTERS(fs, position), ff->ff_currentcluster,
+                    nclusters + 1);
+
+      ff->ff_currentcluster  += nclusters;
+      ff->ff_sectorsincluster = nclusters * fs->fs_fatsecperclus - extra;
+    }
+  else
+    {
+      ff->ff_sectorsincluster -= nsectors;
+    }
+
+  ff->ff_currentsector += nsectors;
+}
+
+#if CONFIG_FAT_NEXTENTS > 0
+/****************************************************************************
+ * Name: fat_extentadd
+ *
+ * Description:
+ *   Record that clusters index through index + count - 1 of the file are
+ *   held in the clusters starting with 'cluster' on the media.  The extents
+ *   of a file always describe the beginning of its cluster chain without
+ *   gaps, so only information that continues the known part of the chain
+ *   is retained.  Nothing more is retained when all extents are in use.
+ *
+ ****************************************************************************/
+
+void fat_extentadd(struct fat_file_s *ff, uint32_t index, uint32_t cluster,
+                   uint32_t count)
+{
+  FAR struct fat_extent_s *fe = NULL;
+  uint32_t known = 0;
+
+  /* The first cluster of the chain is always known */
+
+  if (ff->ff_nextents == 0 && ff->ff_startcluster != 0)
+    {
+      fe             = &ff->ff_extents[0];
+      fe->fe_index   = 0;
+      fe->fe_cluster = ff->ff_startcluster;
+      fe->fe_count   = 1;
+
+      ff->ff_nextents = 1;
+    }
+
+  if (ff->ff_nextents > 0)
+    {
+      fe    = &ff->ff_extents[ff->ff_nextents - 1];
+      known = fe->fe_index + fe->fe_count;
+    }
+
+  /* Ignore runs that are already known or that would leave a gap */
+
+  if (index > known || index + count <= known)
+    {
+      return;
+    }
+
+  /* Skip over the part of the run that is already known */
+
+  cluster += known - index;
+  count   -= known - index;
+
+  if (fe != NULL && fe->fe_cluster + fe->fe_count == cluster)
+    {
+      /* The run continues the last extent */
+
+      fe->fe_count += count;
+    }
+  else if (ff->ff_nextents < CONFIG_FAT_NEXTENTS)
+    {
+      /* Start a new extent */
+
+      fe             = &ff->ff_extents[ff->ff_nextents++];
+      fe->fe_index   = known;
+      fe->fe_cluster = cluster;
+      fe->fe_count   = count;
+    }
+}
+
+/****************************************************************************
+ * Name: fat_extentfind
+ *
+ * Description:
+ *   Find the known cluster of the file that is nearest to, but not beyond,
+ *   the cluster with the index *index in the cluster chain.
+ *
+ * Returned Value:
+ *   The cluster number on the media with *index updated to the index of
+ *   that cluster in the file or zero if no cluster of the file is known.
+ *
+ ****************************************************************************/
+
+uint32_t fat_extentfind(struct fat_file_s *ff, FAR uint32_t *index)
+{
+  FAR struct fat_extent_s *fe;
+  int i;
+
+  for (i = ff->ff_nextents - 1; i >= 0; i--)
+    {
+      fe = &ff->ff_extents[i];
+      if (fe->fe_index <= *index)
+        {
+          if (*index >= fe->fe_index + fe->fe_count)
+            {
+              *index = fe->fe_index + fe->fe_count - 1;
+            }
+
+          return fe->fe_cluster + (*index - fe->fe_index);
+        }
+    }
+
+  return 0;
+}
+#endif
+
 /****************************************************************************
  * Name: fat_nextdirentry
  *
@@ -1772,12 +2051,43 @@ int fat_dirextend(FAR struct fat_mountpt_s *fs, FAR struct fat_file_s *ff,
  * Name: fat_fscacheflush
  *
  * Description:
- *   Flush any dirty sector if fs_buffer as necessary
+ *   Write back all dirty sectors in the sector cache
  *
  ****************************************************************************/
 
 int fat_fscacheflush(struct fat_mountpt_s *fs)
 {
+#if CONFIG_FAT_CACHE_NSECTORS > 1
+  FAR struct fat_cachesector_s *cs;
+  int ret = OK;
+  int i;
+
+  /* Write back each dirty sector.  Keep going so that a failure to write
+   * one sector does not prevent the others from being written.
+   */
+
+  fat_fscachesave(fs);
+  for (i = 0; i < CONFIG_FAT_CACHE_NSECTORS; i++)
+    {
+      cs = &fs->fs_cache[i];
+      if (cs->cs_dirty)
+        {
+          int err = fat_fscachewrite(fs, cs->cs_buffer, cs->cs_sector);
+          if (err < 0)
+            {
+              ret = err;
+            }
+          else
+            {
+              cs->cs_dirty = false;
+            }
+        }
+    }
+
+  fs->fs_dirty = fs->fs_cache[fs->fs_cachendx].cs_dirty;
+  return ret;
+
+#else
   int ret;
 
   /* Check if the fs_buffer is dirty.  In this case, we will write back the
@@ -1786,40 +2096,19 @@ int fat_fscacheflush(struct fat_mountpt_s *fs)
 
   if (fs->fs_dirty)
     {
-      /* Write the dirty sector */
-
-      ret = fat_hwwrite(fs, fs->fs_buffer, fs->fs_currentsector, 1);
+      ret = fat_fscachewrite(fs, fs->fs_buffer, fs->fs_currentsector);
       if (ret < 0)
         {
           return ret;
         }
 
-      /* Does the sector lie in the FAT region? */
-
-      if (fs->fs_currentsector >= fs->fs_fatbase &&
-          fs->fs_currentsector < fs->fs_fatbase + fs->fs_nfatsects)
-        {
-          int i;
-
-          /* Yes, then make the change in the FAT copy as well */
-
-          for (i = fs->fs_fatnumfats; i >= 2; i--)
-            {
-              fs->fs_currentsector += fs->fs_nfatsects;
-              ret = fat_hwwrite(fs, fs->fs_buffer, fs->fs_currentsector, 1);
-              if (ret < 0)
-                {
-                  return ret;
-                }
-            }
-        }
-
       /* No longer dirty */
 
       fs->fs_dirty = false;
     }
 
   return OK;
+#endif
 }
 
 /****************************************************************************
@@ -1833,6 +2122,84 @@ int fat_fscacheflush(struct fat_mountpt_s *fs)
 
 int fat_fscacheread(struct fat_mountpt_s *fs, off_t sector)
 {
+#if CONFIG_FAT_CACHE_NSECTORS > 1
+  FAR struct fat_cachesector_s *cs;
+  uint32_t oldest;
+  uint32_t age;
+  int victim;
+  int ret;
+  int i;
+
+  /* Nothing needs to be done if the sector is already selected */
+
+  if (fs->fs_currentsector == sector)
+    {
+      return OK;
+    }
+
+  /* Look for the sector in the cache.  While doing that, find the entry to
+   * be replaced if the sector is not found:  An empty entry if there is
+   * one, otherwise the least recently used entry.
+   */
+
+  fat_fscachesave(fs);
+
+  victim = 0;
+  oldest = 0;
+
+  for (i = 0; i < CONFIG_FAT_CACHE_NSECTORS; i++)
+    {
+      cs = &fs->fs_cache[i];
+      if (cs->cs_sector == sector)
+        {
+          fat_fscacheselect(fs, i);
+          return OK;
+        }
+
+      if (cs->cs_sector == FAT_NOSECTOR)
+        {
+          age = UINT32_MAX;
+        }
+      else
+        {
+          age = fs->fs_cacheage - cs->cs_age;
+        }
+
+      if (age >= oldest)
+        {
+          oldest = age;
+          victim = i;
+        }
+    }
+
+  /* Write back the sector being replaced if it is dirty */
+
+  cs = &fs->fs_cache[victim];
+  if (cs->cs_dirty)
+    {
+      ret = fat_fscachewrite(fs, cs->cs_buffer, cs->cs_sector);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      cs->cs_dirty = false;
+    }
+
+  /* Then read the specified sector into the cache */
+
+  ret = fat_hwread(fs, cs->cs_buffer, sector, 1);
+  cs->cs_sector = ret < 0 ? FAT_NOSECTOR : sector;
+
+  if (ret < 0 && victim != fs->fs_cachendx)
+    {
+      return ret;
+    }
+
+  fat_fscacheselect(fs, victim);
+  return ret < 0 ? ret : OK;
+
+#else
   int ret;
 
   /* fs->fs_currentsector holds the current sector that is buffered in
@@ -1857,6 +2224,9 @@ int fat_fscacheread(struct fat_mountpt_s *fs, off_t sector)
       ret = fat_hwread(fs, fs->fs_buffer, sector, 1);
       if (ret < 0)
         {
+          /* The buffer no longer holds any valid sector */
+
+          fs->fs_currentsector = FAT_NOSECTOR;
           return ret;
         }
 
@@ -1865,9 +2235,122 @@ int fat_fscacheread(struct fat_mountpt_s *fs, off_t sector)
       fs->fs_currentsector = sector;
     }
 
+  return OK;
+#endif
+}
+
+/****************************************************************************
+ * Name: fat_fscacheinvalidate
+ *
+ * Description:
+ *   Discard any cached copy of the sectors sector through
+ *   sector + nsectors - 1 without writing them back.  This is used when the
+ *   content of those sectors on the media is about to be replaced, for
+ *   example when a cluster is (re-)allocated.
+ *
+ ****************************************************************************/
+
+void fat_fscacheinvalidate(struct fat_mountpt_s *fs, off_t sector,
+                           unsigned int nsectors)
+{
+#if CONFIG_FAT_CACHE_NSECTORS > 1
+  FAR struct fat_cachesector_s *cs;
+  int i;
+
+  fat_fscachesave(fs);
+  for (i = 0; i < CONFIG_FAT_CACHE_NSECTORS; i++)
+    {
+      cs = &fs->fs_cache[i];
+      if (cs->cs_sector >= sector &&
+          cs->cs_sector < sector + (off_t)nsectors)
+        {
+          cs->cs_sector = FAT_NOSECTOR;
+          cs->cs_dirty  = false;
+        }
+    }
+
+  fat_fscacheselect(fs, fs->fs_cachendx);
+#else
+  if (fs->fs_currentsector >= sector &&
+      fs->fs_currentsector < sector + (off_t)nsectors)
+    {
+      fs->fs_currentsector = FAT_NOSECTOR;
+      fs->fs_dirty         = false;
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: fat_fscachealloc
+ *
+ * Description:
+ *   Allocate the sector cache of a mountpoint.  On return, the cache is
+ *   empty and fs_buffer refers to the buffer of the selected cache entry.
+ *
+ ****************************************************************************/
+
+int fat_fscachealloc(struct fat_mountpt_s *fs)
+{
+  FAR uint8_t *buffer;
+#if CONFIG_FAT_CACHE_NSECTORS > 1
+  int i;
+#endif
+
+  buffer = (FAR uint8_t *)
+    fat_io_alloc(CONFIG_FAT_CACHE_NSECTORS * fs->fs_hwsectorsize);
+  if (!buffer)
+    {
+      return -ENOMEM;
+    }
+
+#if CONFIG_FAT_CACHE_NSECTORS > 1
+  for (i = 0; i < CONFIG_FAT_CACHE_NSECTORS; i++)
+    {
+      fs->fs_cache[i].cs_sector = FAT_NOSECTOR;
+      fs->fs_cache[i].cs_age    = 0;
+      fs->fs_cache[i].cs_dirty  = false;
+      fs->fs_cache[i].cs_buffer = buffer + i * fs->fs_hwsectorsize;
+    }
+
+  fs->fs_cacheage = 0;
+  fat_fscacheselect(fs, 0);
+#else
+  fs->fs_buffer        = buffer;
+  fs->fs_currentsector = FAT_NOSECTOR;
+  fs->fs_dirty         = false;
+#endif
+
   return OK;
 }
 
+/****************************************************************************
+ * Name: fat_fscachefree
+ *
+ * Description:
+ *   Free the sector cache of a mountpoint (if it was allocated).  Any dirty
+ *   sectors are discarded.
+ *
+ ****************************************************************************/
+
+void fat_fscachefree(struct fat_mountpt_s *fs)
+{
+  FAR uint8_t *buffer;
+
+#if CONFIG_FAT_CACHE_NSECTORS > 1
+  buffer = fs->fs_cache[0].cs_buffer;
+  fs->fs_cache[0].cs_buffer = NULL;
+#else
+  buffer = fs->fs_buffer;
+#endif
+
+  if (buffer)
+    {
+      fat_io_free(buffer, CONFIG_FAT_CACHE_NSECTORS * fs->fs_hwsectorsize);
+    }
+
+  fs->fs_buffer = NULL;
+}
+
 /****************************************************************************
  * Name: fat_ffcacheflush
  *
@@ -2010,8 +2493,11 @@ int fat_updatefsinfo(struct fat_mountpt_s *fs)
 
       if (fs->fs_type == FSTYPE_FAT32 && fs->fs_fsidirty)
         {
-          /* Create an image of the FSINFO sector in the fs_buffer */
+          /* Create an image of the FSINFO sector in the fs_buffer.  First
+           * discard any other cached copy of the FSINFO sector.
+           */
 
+          fat_fscacheinvalidate(fs, fs->fs_fsinfo, 1);
           memset(fs->fs_buffer, 0, fs->fs_hwsectorsize);
           FSI_PUTLEADSIG(fs->fs_buffer, 0x41615252);
           FSI_PUTSTRUCTSIG(fs->fs_buffer, 0x61417272);
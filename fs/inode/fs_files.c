@@ -105,6 +105,10 @@ static int _files_close(FAR struct file *filep)
 
   if (inode)
     {
+      /* Remove any epoll registrations while the driver still exists */
+
+      epoll_detach(filep);
+
       /* Close the file, driver, or mountpoint. */
 
       if (inode->u.i_ops && inode->u.i_ops->close)
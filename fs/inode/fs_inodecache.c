@@ -0,0 +1,322 @@
+/****************************************************************************
+ * fs/inode/fs_inodecache.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#include <nuttx/fs/fs.h>
+
+#include "inode/inode.h"
+
+#ifdef CONFIG_FS_INODECACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The maximum number of path segments in a cached path.  Each segment
+ * requires at least one character plus a '/' delimiter.
+ */
+
+#define INODE_CACHE_MAXSEGS ((CONFIG_FS_INODECACHE_PATHLEN + 1) / 2)
+
+/* 32-bit FNV-1a hash parameters */
+
+#define INODE_CACHE_HASHINIT  2166136261ul
+#define INODE_CACHE_HASHPRIME 16777619ul
+
+#define INODE_CACHE_HASH(h,c) \
+  (((h) ^ (uint8_t)(c)) * INODE_CACHE_HASHPRIME)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One entry of the path look-up cache.  The entry is not in use if ic_node
+ * is NULL.  The path is not NUL terminated.
+ */
+
+struct inode_cache_s
+{
+  FAR struct inode *ic_node;        /* The inode found at ic_path */
+  FAR struct inode *ic_peer;        /* Node to the "left" of ic_node */
+  FAR struct inode *ic_parent;      /* Node "above" ic_node */
+  uint32_t ic_hash;                 /* Hash of ic_path */
+  uint8_t ic_len;                   /* Length of ic_path */
+  char ic_path[CONFIG_FS_INODECACHE_PATHLEN];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The cache and its statistics are protected by the g_inode_sem semaphore */
+
+static struct inode_cache_s g_inode_cache[CONFIG_FS_INODECACHE_NENTRIES];
+static struct inode_cacheinfo_s g_inode_cachestats;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inode_cache_hash
+ *
+ * Description:
+ *   Return the hash of the first 'len' characters of 'path'
+ *
+ ****************************************************************************/
+
+static uint32_t inode_cache_hash(FAR const char *path, size_t len)
+{
+  uint32_t hash = INODE_CACHE_HASHINIT;
+
+  while (len-- > 0)
+    {
+      hash = INODE_CACHE_HASH(hash, *path++);
+    }
+
+  return hash;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inode_cache_lookup
+ *
+ * Description:
+ *   Find the longest leading part of 'path' that is held in the path
+ *   look-up cache.  'path' must not include the leading '/'.
+ *
+ * Returned Value:
+ *   A pointer to the end of the cached part of 'path' (i.e., to a '/' or to
+ *   the NUL terminator) with the inode and its companion nodes returned in
+ *   'node', 'peer', and 'parent'.  NULL is returned if no part of the path
+ *   is cached.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore
+ *
+ ****************************************************************************/
+
+FAR const char *inode_cache_lookup(FAR const char *path,
+                                   FAR struct inode **node,
+                                   FAR struct inode **peer,
+                                   FAR struct inode **parent)
+{
+  FAR struct inode_cache_s *entry;
+  FAR const char *next;
+  uint32_t hashes[INODE_CACHE_MAXSEGS];
+  uint8_t lens[INODE_CACHE_MAXSEGS];
+  uint32_t hash = INODE_CACHE_HASHINIT;
+  int nsegs = 0;
+  int len;
+
+  /* Hash each leading part of the path that ends with a complete path
+   * segment.  All of these are computed in one pass over the path.
+   */
+
+  for (len = 0; ; len++)
+    {
+      char ch = path[len];
+
+      if ((ch == '\0' || ch == '/') && len > 0 && path[len - 1] != '/')
+        {
+          hashes[nsegs] = hash;
+          lens[nsegs]   = len;
+          nsegs++;
+        }
+
+      if (ch == '\0' || len >= CONFIG_FS_INODECACHE_PATHLEN)
+        {
+          break;
+        }
+
+      hash = INODE_CACHE_HASH(hash, ch);
+    }
+
+  /* Then look for the longest of those in the cache */
+
+  while (--nsegs >= 0)
+    {
+      len   = lens[nsegs];
+      entry = &g_inode_cache[hashes[nsegs] % CONFIG_FS_INODECACHE_NENTRIES];
+
+      if (entry->ic_node != NULL && entry->ic_hash == hashes[nsegs] &&
+          entry->ic_len == len && memcmp(entry->ic_path, path, len) == 0)
+        {
+          *node   = entry->ic_node;
+          *peer   = entry->ic_peer;
+          *parent = entry->ic_parent;
+
+          /* Was that the whole path (ignoring any trailing '/')? */
+
+          next = &path[len];
+          while (*next == '/')
+            {
+              next++;
+            }
+
+          if (*next == '\0')
+            {
+              g_inode_cachestats.hits++;
+            }
+          else
+            {
+              g_inode_cachestats.partial++;
+            }
+
+          return &path[len];
+        }
+    }
+
+  g_inode_cachestats.misses++;
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: inode_cache_add
+ *
+ * Description:
+ *   Add the inode found for the leading part of 'path' that ends with the
+ *   path segment 'name' to the path look-up cache.  Soft links are never
+ *   cached.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore
+ *
+ ****************************************************************************/
+
+void inode_cache_add(FAR const char *path, FAR const char *name,
+                     FAR struct inode *node, FAR struct inode *peer,
+                     FAR struct inode *parent)
+{
+  FAR struct inode_cache_s *entry;
+  uint32_t hash;
+  size_t len;
+
+  if (INODE_IS_SOFTLINK(node))
+    {
+      return;
+    }
+
+  /* Find the end of the path segment */
+
+  while (*name != '\0' && *name != '/')
+    {
+      name++;
+    }
+
+  len = name - path;
+  if (len > CONFIG_FS_INODECACHE_PATHLEN)
+    {
+      return;
+    }
+
+  /* Replace whatever was in the entry with this hash */
+
+  hash  = inode_cache_hash(path, len);
+  entry = &g_inode_cache[hash % CONFIG_FS_INODECACHE_NENTRIES];
+
+  entry->ic_node   = node;
+  entry->ic_peer   = peer;
+  entry->ic_parent = parent;
+  entry->ic_hash   = hash;
+  entry->ic_len    = len;
+  memcpy(entry->ic_path, path, len);
+}
+
+/****************************************************************************
+ * Name: inode_cache_invalidate
+ *
+ * Description:
+ *   Discard the content of the path look-up cache.  This must be called
+ *   whenever the structure of the inode tree is modified.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore
+ *
+ ****************************************************************************/
+
+void inode_cache_invalidate(void)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_FS_INODECACHE_NENTRIES; i++)
+    {
+      g_inode_cache[i].ic_node = NULL;
+    }
+
+  g_inode_cachestats.invalidations++;
+}
+
+/****************************************************************************
+ * Name: inode_cache_info
+ *
+ * Description:
+ *   Return the statistics of the path look-up cache.
+ *
+ ****************************************************************************/
+
+void inode_cache_info(FAR struct inode_cacheinfo_s *info)
+{
+  int i;
+
+  inode_semtake();
+
+  *info          = g_inode_cachestats;
+  info->nentries = CONFIG_FS_INODECACHE_NENTRIES;
+  info->nused    = 0;
+
+  for (i = 0; i < CONFIG_FS_INODECACHE_NENTRIES; i++)
+    {
+      if (g_inode_cache[i].ic_node != NULL)
+        {
+          info->nused++;
+        }
+    }
+
+  inode_semgive();
+}
+
+#endif /* CONFIG_FS_INODECACHE */
@@ -91,6 +91,10 @@ FAR struct inode *inode_unlink(FAR const char *path)
       node = desc.node;
       DEBUGASSERT(node != NULL);
 
+      /* Any cached look-up results may no longer be valid */
+
+      inode_cache_invalidate();
+
       /* If peer is non-null, then remove the node from the right of
        * of that peer node.
        */
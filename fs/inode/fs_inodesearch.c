@@ -241,6 +241,10 @@ static int _inode_search(FAR struct inode_search_s *desc)
   FAR struct inode *left    = NULL;
   FAR struct inode *above   = NULL;
   FAR const char   *relpath = NULL;
+#ifdef CONFIG_FS_INODECACHE
+  FAR const char   *start;
+  bool cacheable = true;
+#endif
   int ret = -ENOENT;
 
   /* Get the search path, skipping over the leading '/'.  The leading '/' is
@@ -273,12 +277,46 @@ static int _inode_search(FAR struct inode_search_s *desc)
       return -ENOSYS;
     }
 
+#ifdef CONFIG_FS_INODECACHE
+  /* Check if the path, or some leading part of it, was looked up before */
+
+  start = name;
+  name  = inode_cache_lookup(start, &node, &left, &above);
+  if (name == NULL)
+    {
+      /* No.. start at the root of the tree */
+
+      name = start;
+    }
+  else
+    {
+      /* Yes.. the cached node is never a soft link.  Handle the remainder
+       * of the path just as below when the names match.
+       */
+
+      name = inode_nextname(name);
+      if (*name == '\0' || INODE_IS_MOUNTPT(node))
+        {
+          /* The search loop below will not be entered */
+
+          relpath = name;
+          ret = OK;
+        }
+      else
+        {
+          above = node;
+          left  = NULL;
+          node  = node->i_child;
+        }
+    }
+#endif
+
   /* Traverse the pseudo file system node tree until either (1) all nodes
    * have been examined without finding the matching node, or (2) the
    * matching node is found.
    */
 
-  while (node != NULL)
+  while (ret < 0 && node != NULL)
     {
       int result = _inode_compare(name, node);
 
@@ -318,6 +356,17 @@ static int _inode_search(FAR struct inode_search_s *desc)
            *       below this one
            */
 
+#ifdef CONFIG_FS_INODECACHE
+          /* Remember where this part of the path was found.  Results that
+           * depend on a soft link are not cached.
+           */
+
+          if (cacheable)
+            {
+              inode_cache_add(start, name, node, left, above);
+            }
+#endif
+
           name = inode_nextname(name);
           if (*name == '\0' || INODE_IS_MOUNTPT(node))
             {
@@ -344,6 +393,10 @@ static int _inode_search(FAR struct inode_search_s *desc)
                 {
                   int status;
 
+#ifdef CONFIG_FS_INODECACHE
+                  cacheable = false;
+#endif
+
                   /* If this intermediate inode in the is a soft link, then
                    * (1) get the name of the full path of the soft link, (2)
                    * recursively look-up the inode referenced by the soft
@@ -95,6 +95,10 @@
 
 #endif
 
+#ifndef CONFIG_FS_INODECACHE
+#  define inode_cache_invalidate()
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -142,6 +146,20 @@ struct inode_search_s
 #endif
 };
 
+#ifdef CONFIG_FS_INODECACHE
+/* Statistics of the path look-up cache as returned by inode_cache_info() */
+
+struct inode_cacheinfo_s
+{
+  uint32_t hits;             /* Look-ups of a complete, cached path */
+  uint32_t partial;          /* Look-ups continued from a cached directory */
+  uint32_t misses;           /* Look-ups with no cached part of the path */
+  uint32_t invalidations;    /* Number of times the cache was discarded */
+  uint16_t nentries;         /* Number of entries in the cache */
+  uint16_t nused;            /* Number of entries currently in use */
+};
+#endif
+
 /* Callback used by foreach_inode to traverse all inodes in the pseudo-
  * file system.
  */
@@ -226,6 +244,78 @@ void inode_semgive(void);
 
 int inode_search(FAR struct inode_search_s *desc);
 
+/****************************************************************************
+ * Name: inode_cache_lookup
+ *
+ * Description:
+ *   Find the longest leading part of 'path' that is held in the path
+ *   look-up cache.  'path' must not include the leading '/'.
+ *
+ * Returned Value:
+ *   A pointer to the end of the cached part of 'path' (i.e., to a '/' or to
+ *   the NUL terminator) with the inode and its companion nodes returned in
+ *   'node', 'peer', and 'parent'.  NULL is returned if no part of the path
+ *   is cached.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_INODECACHE
+FAR const char *inode_cache_lookup(FAR const char *path,
+                                   FAR struct inode **node,
+                                   FAR struct inode **peer,
+                                   FAR struct inode **parent);
+#endif
+
+/****************************************************************************
+ * Name: inode_cache_add
+ *
+ * Description:
+ *   Add the inode found for the leading part of 'path' that ends with the
+ *   path segment 'name' to the path look-up cache.  Soft links are never
+ *   cached.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_INODECACHE
+void inode_cache_add(FAR const char *path, FAR const char *name,
+                     FAR struct inode *node, FAR struct inode *peer,
+                     FAR struct inode *parent);
+#endif
+
+/****************************************************************************
+ * Name: inode_cache_invalidate
+ *
+ * Description:
+ *   Discard the content of the path look-up cache.  This must be called
+ *   whenever the structure of the inode tree is modified.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_INODECACHE
+void inode_cache_invalidate(void);
+#endif
+
+/****************************************************************************
+ * Name: inode_cache_info
+ *
+ * Description:
+ *   Return the statistics of the path look-up cache.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_INODECACHE
+void inode_cache_info(FAR struct inode_cacheinfo_s *info);
+#endif
+
 /****************************************************************************
  * Name: inode_find
  *
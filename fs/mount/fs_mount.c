@@ -479,6 +479,12 @@ int mount(FAR const char *source, FAR const char *target,
 
   INODE_SET_MOUNTPT(mountpt_inode);
 
+  /* If the mountpoint was an existing directory, then any cached look-ups
+   * of the nodes below it are no longer valid.
+   */
+
+  inode_cache_invalidate();
+
   mountpt_inode->u.i_mops  = mops;
 #ifdef CONFIG_FILE_MODE
   mountpt_inode->i_mode    = mode;
@@ -67,10 +67,15 @@
  ****************************************************************************/
 
 /* Determines the size of an intermediate buffer that must be large enough
- * to handle the longest line generated by this logic.
+ * to handle the longest line generated by this logic.  In the SMP case,
+ * the overall load is followed by one line for each CPU.
  */
 
-#define CPULOAD_LINELEN 16
+#ifdef CONFIG_SMP
+#  define CPULOAD_LINELEN (16 * (CONFIG_SMP_NCPUS + 1))
+#else
+#  define CPULOAD_LINELEN 16
+#endif
 
 /****************************************************************************
  * Private Types
@@ -91,6 +96,8 @@ struct cpuload_file_s
 
 /* File system methods */
 
+static void    cpuload_percent(uint32_t idle, uint32_t total,
+                 FAR uint32_t *intpart, FAR uint32_t *fracpart);
 static int     cpuload_open(FAR struct file *filep, FAR const char *relpath,
                  int oflags, mode_t mode);
 static int     cpuload_close(FAR struct file *filep);
@@ -130,6 +137,37 @@ const struct procfs_operations cpuload_operations =
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: cpuload_percent
+ *
+ * Description:
+ *   Convert the ticks spent in the IDLE thread(s) to a load percentage with
+ *   one decimal place.
+ *
+ ****************************************************************************/
+
+static void cpuload_percent(uint32_t idle, uint32_t total,
+                            FAR uint32_t *intpart, FAR uint32_t *fracpart)
+{
+  /* On the simulator, you may hit total == 0, but probably never on real
+   * hardware.
+   */
+
+  if (total > 0 && idle <= total)
+    {
+      uint32_t tmp;
+
+      tmp       = 1000 - (uint32_t)(((uint64_t)1000 * idle) / total);
+      *intpart  = tmp / 10;
+      *fracpart = tmp - 10 * *intpart;
+    }
+  else
+    {
+      *intpart  = 0;
+      *fracpart = 0;
+    }
+}
+
 /****************************************************************************
  * Name: cpuload_open
  ****************************************************************************/
@@ -227,34 +265,57 @@ static ssize_t cpuload_read(FAR struct file *filep, FAR char *buffer,
       struct cpuload_s cpuload;
       uint32_t intpart;
       uint32_t fracpart;
-
-      /* Sample the counts for the IDLE thread.  clock_cpuload should only
-       * fail if the PID is not valid.  This, however, should never happen
-       * for the IDLE thread.
+#ifdef CONFIG_SMP
+      uint32_t idle[CONFIG_SMP_NCPUS];
+      uint32_t total;
+      uint32_t sum;
+      int cpu;
+
+      /* Sample the counts for the IDLE thread of each CPU.  These have the
+       * PIDs 0 through CONFIG_SMP_NCPUS-1.  The total count is incremented
+       * once for each CPU on each sample interval.
        */
 
-      DEBUGVERIFY(clock_cpuload(0, &cpuload));
-
-      /* On the simulator, you may hit cpuload.total == 0, but probably never on
-       * real hardware.
-       */
+      total = 0;
+      sum   = 0;
 
-      if (cpuload.total > 0)
+      for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
         {
-          uint32_t tmp;
-
-          tmp      = 1000 - (1000 * cpuload.active) / cpuload.total;
-          intpart  = tmp / 10;
-          fracpart = tmp - 10 * intpart;
+          DEBUGVERIFY(clock_cpuload(cpu, &cpuload));
+          idle[cpu] = cpuload.active;
+          sum      += cpuload.active;
+          total     = cpuload.total;
         }
-      else
+
+      /* The overall load first... */
+
+      cpuload_percent(sum, total, &intpart, &fracpart);
+      linesize = snprintf(attr->line, CPULOAD_LINELEN, "%3d.%01d%%\n",
+                          intpart, fracpart);
+
+      /* ...then the load of each CPU */
+
+      for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
         {
-          intpart  = 0;
-          fracpart = 0;
+          cpuload_percent(idle[cpu] * CONFIG_SMP_NCPUS, total, &intpart,
+                          &fracpart);
+          linesize += snprintf(&attr->line[linesize],
+                               CPULOAD_LINELEN - linesize,
+                               "CPU%d: %3d.%01d%%\n", cpu, intpart,
+                               fracpart);
         }
+#else
+      /* Sample the counts for the IDLE thread.  clock_cpuload should only
+       * fail if the PID is not valid.  This, however, should never happen
+       * for the IDLE thread.
+       */
+
+      DEBUGVERIFY(clock_cpuload(0, &cpuload));
 
+      cpuload_percent(cpuload.active, cpuload.total, &intpart, &fracpart);
       linesize = snprintf(attr->line, CPULOAD_LINELEN, "%3d.%01d%%\n",
                           intpart, fracpart);
+#endif
 
       /* Save the linesize in case we are re-entered with f_pos > 0 */
 
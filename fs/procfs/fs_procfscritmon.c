@@ -58,6 +58,7 @@
 #include <nuttx/kmalloc.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/procfs.h>
+#include <nuttx/wqueue.h>
 
 #if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
      defined(CONFIG_SCHED_CRITMONITOR)
@@ -272,6 +273,45 @@ static ssize_t critmon_read_cpu(FAR struct critmon_file_s *attr,
   return totalsize;
 }
 
+/****************************************************************************
+ * Name: critmon_read_wqueue
+ *
+ * Description:
+ *   Generate the line for one work queue:  The name of the work queue and
+ *   the maximum time that the work queue logic was in a critical section.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SCHED_HPWORK) || defined(CONFIG_SCHED_LPWORK)
+static ssize_t critmon_read_wqueue(FAR struct critmon_file_s *attr,
+                                   FAR char *buffer, size_t buflen,
+                                   FAR off_t *offset, int qid,
+                                   FAR const char *name)
+{
+  struct timespec maxtime;
+  uint32_t elapsed;
+  size_t linesize;
+
+  /* Get and reset the maximum */
+
+  elapsed = work_critmax(qid);
+  if (elapsed > 0)
+    {
+      up_critmon_convert(elapsed, &maxtime);
+    }
+  else
+    {
+      maxtime.tv_sec = 0;
+      maxtime.tv_nsec = 0;
+    }
+
+  linesize = snprintf(attr->line, CRITMON_LINELEN, "%s,%lu.%09lu\n",
+                      name, (unsigned long)maxtime.tv_sec,
+                      (unsigned long)maxtime.tv_nsec);
+  return procfs_memcpy(attr->line, linesize, buffer, buflen, offset);
+}
+#endif
+
 /****************************************************************************
  * Name: critmon_read
  ****************************************************************************/
@@ -319,6 +359,24 @@ static ssize_t critmon_read(FAR struct file *filep, FAR char *buffer,
   ret = critmon_read_cpu(attr, buffer + ret, buflen -ret, &offset, 0);
 #endif
 
+  /* Then the work queue logic */
+
+#ifdef CONFIG_SCHED_HPWORK
+  if (ret < buflen)
+    {
+      ret += critmon_read_wqueue(attr, buffer + ret, buflen - ret, &offset,
+                                 HPWORK, "hpwork");
+    }
+#endif
+
+#ifdef CONFIG_SCHED_LPWORK
+  if (ret < buflen)
+    {
+      ret += critmon_read_wqueue(attr, buffer + ret, buflen - ret, &offset,
+                                 LPWORK, "lpwork");
+    }
+#endif
+
   if (ret > 0)
     {
       filep->f_pos += ret;
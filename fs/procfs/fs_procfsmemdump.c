@@ -0,0 +1,565 @@
+/****************************************************************************
+ * fs/procfs/fs_procfsmemdump.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/mm/mm.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMDUMP)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.
+ */
+
+#define MEMDUMP_LINELEN   80
+
+/* The maximum number of distinct owners that are reported for each heap.
+ * Allocations by any further owners are summed in one additional entry.
+ */
+
+#define MEMDUMP_NOWNERS   32
+
+/* The heaps that are reported */
+
+#ifdef CONFIG_MM_KERNEL_HEAP
+#  define MEMDUMP_KHEAP   1
+#else
+#  define MEMDUMP_KHEAP   0
+#endif
+
+#ifndef CONFIG_BUILD_KERNEL
+#  define MEMDUMP_UHEAP   1
+#else
+#  define MEMDUMP_UHEAP   0
+#endif
+
+#define MEMDUMP_NHEAPS    (MEMDUMP_KHEAP + MEMDUMP_UHEAP)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The number and total size of chunks in one size class */
+
+struct memdump_class_s
+{
+  unsigned int nused;             /* Number of allocated chunks */
+  unsigned int nfree;             /* Number of free chunks */
+  size_t used;                    /* Size of all allocated chunks */
+  size_t free;                    /* Size of all free chunks */
+};
+
+#ifdef CONFIG_MM_TRACE
+/* The allocated chunks of one size class with the same owner */
+
+struct memdump_owner_s
+{
+  pid_t pid;                      /* Allocating task (or MM_OWNER_CACHED) */
+  uint8_t ndx;                    /* Size class */
+  FAR void *caller;               /* Address of the allocation call */
+  unsigned int nchunks;           /* Number of chunks */
+  size_t nbytes;                  /* Size of all chunks */
+};
+#endif
+
+/* A snapshot of the chunks in one heap */
+
+struct memdump_heap_s
+{
+  FAR const char *name;           /* Name of the heap */
+  struct memdump_class_s class[MM_NNODES];
+#ifdef CONFIG_MM_TRACE
+  unsigned int nowners;           /* Number of valid owner[] entries */
+  struct memdump_owner_s owner[MEMDUMP_NOWNERS + 1];
+#endif
+};
+
+/* This structure describes one open "file".  The heaps are visited when
+ * the file is opened so that all reads see the same state.
+ */
+
+struct memdump_file_s
+{
+  struct procfs_file_s base;      /* Base open file structure */
+  struct memdump_heap_s heap[MEMDUMP_NHEAPS];
+  char line[MEMDUMP_LINELEN];     /* Pre-allocated buffer for formatted lines */
+};
+
+/* This structure holds the state of one read operation */
+
+struct memdump_read_s
+{
+  FAR struct memdump_file_s *procfile;
+  FAR char *buffer;               /* User buffer */
+  size_t buflen;                  /* Remaining space in the user buffer */
+  size_t totalsize;               /* Number of bytes returned so far */
+  off_t offset;                   /* Offset remaining to be skipped */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     memdump_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     memdump_close(FAR struct file *filep);
+static ssize_t memdump_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     memdump_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     memdump_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations memdump_operations =
+{
+  memdump_open,   /* open */
+  memdump_close,  /* close */
+  memdump_read,   /* read */
+  NULL,           /* write */
+  memdump_dup,    /* dup */
+  NULL,           /* opendir */
+  NULL,           /* closedir */
+  NULL,           /* readdir */
+  NULL,           /* rewinddir */
+  memdump_stat    /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: memdump_walker
+ *
+ * Description:
+ *   mm_foreach() callback that adds one chunk to the heap snapshot.  The
+ *   heap is locked so this must not allocate memory.
+ *
+ ****************************************************************************/
+
+static void memdump_walker(FAR struct mm_allocnode_s *node, FAR void *arg)
+{
+  FAR struct memdump_heap_s *heap = (FAR struct memdump_heap_s *)arg;
+  FAR struct memdump_class_s *class;
+#ifdef CONFIG_MM_TRACE
+  FAR struct memdump_owner_s *owner;
+  unsigned int i;
+#endif
+  size_t size = node->size;
+  int ndx;
+
+  /* Ignore the guard nodes at the beginning and end of each region */
+
+  if (size <= SIZEOF_MM_ALLOCNODE)
+    {
+      return;
+    }
+
+  ndx   = mm_size2ndx(size);
+  class = &heap->class[ndx];
+
+  if ((node->preceding & MM_ALLOC_BIT) == 0)
+    {
+      class->nfree++;
+      class->free += size;
+      return;
+    }
+
+  class->nused++;
+  class->used += size;
+
+#ifdef CONFIG_MM_TRACE
+  /* Find the entry for this owner and size class.  If there is none and
+   * the table is full, then use the last entry for all remaining owners.
+   */
+
+  for (i = 0; i < heap->nowners; i++)
+    {
+      owner = &heap->owner[i];
+      if (owner->pid == node->pid && owner->caller == node->caller &&
+          owner->ndx == ndx)
+        {
+          break;
+        }
+    }
+
+  owner = &heap->owner[i];
+  if (i >= heap->nowners)
+    {
+      if (heap->nowners < MEMDUMP_NOWNERS)
+        {
+          owner->pid    = node->pid;
+          owner->caller = node->caller;
+          owner->ndx    = ndx;
+          heap->nowners++;
+        }
+      else
+        {
+          owner = &heap->owner[MEMDUMP_NOWNERS];
+        }
+    }
+
+  owner->nchunks++;
+  owner->nbytes += size;
+#endif
+}
+
+/****************************************************************************
+ * Name: memdump_copyline
+ *
+ * Description:
+ *   Copy the formatted line to the user buffer, skipping data before the
+ *   file offset.
+ *
+ ****************************************************************************/
+
+static void memdump_copyline(FAR struct memdump_read_s *rdstate,
+                             size_t linesize)
+{
+  size_t copysize;
+
+  copysize = procfs_memcpy(rdstate->procfile->line, linesize,
+                           rdstate->buffer, rdstate->buflen,
+                           &rdstate->offset);
+
+  rdstate->buffer    += copysize;
+  rdstate->buflen    -= copysize;
+  rdstate->totalsize += copysize;
+}
+
+/****************************************************************************
+ * Name: memdump_readheap
+ *
+ * Description:
+ *   Format the snapshot of one heap:  First the number and size of the
+ *   allocated and free chunks in each non-empty size class, then the
+ *   allocated chunks of each owner.
+ *
+ ****************************************************************************/
+
+static void memdump_readheap(FAR struct memdump_read_s *rdstate,
+                             FAR struct memdump_heap_s *heap)
+{
+  FAR char *line = rdstate->procfile->line;
+  size_t linesize;
+  int ndx;
+#ifdef CONFIG_MM_TRACE
+  unsigned int i;
+#endif
+
+  linesize = snprintf(line, MEMDUMP_LINELEN,
+                      "%s:\n%10s%9s%11s%9s%11s\n",
+                      heap->name, "SIZE", "NUSED", "USED", "NFREE", "FREE");
+  memdump_copyline(rdstate, linesize);
+
+  for (ndx = 0; ndx < MM_NNODES && rdstate->buflen > 0; ndx++)
+    {
+      FAR struct memdump_class_s *class = &heap->class[ndx];
+
+      if (class->nused > 0 || class->nfree > 0)
+        {
+          linesize = snprintf(line, MEMDUMP_LINELEN,
+                              "%9lu+%9u%11lu%9u%11lu\n",
+                              (unsigned long)MM_MIN_CHUNK << ndx,
+                              class->nused, (unsigned long)class->used,
+                              class->nfree, (unsigned long)class->free);
+          memdump_copyline(rdstate, linesize);
+        }
+    }
+
+#ifdef CONFIG_MM_TRACE
+  linesize = snprintf(line, MEMDUMP_LINELEN, "%10s%11s%10s%9s%11s\n",
+                      "PID", "CALLER", "SIZE", "NCHUNKS", "BYTES");
+  memdump_copyline(rdstate, linesize);
+
+  for (i = 0; i <= MEMDUMP_NOWNERS && rdstate->buflen > 0; i++)
+    {
+      FAR struct memdump_owner_s *owner = &heap->owner[i];
+
+      if (i < heap->nowners)
+        {
+          if (owner->pid == MM_OWNER_CACHED)
+            {
+              linesize = snprintf(line, MEMDUMP_LINELEN, "%10s%11s",
+                                  "cached", "");
+            }
+          else
+            {
+              linesize = snprintf(line, MEMDUMP_LINELEN, "%10d 0x%08lx",
+                                  (int)owner->pid,
+                                  (unsigned long)(uintptr_t)owner->caller);
+            }
+
+          linesize += snprintf(&line[linesize], MEMDUMP_LINELEN - linesize,
+                               "%9lu+%9u%11lu\n",
+                               (unsigned long)MM_MIN_CHUNK << owner->ndx,
+                               owner->nchunks,
+                               (unsigned long)owner->nbytes);
+          memdump_copyline(rdstate, linesize);
+        }
+      else if (i == MEMDUMP_NOWNERS && owner->nchunks > 0)
+        {
+          linesize = snprintf(line, MEMDUMP_LINELEN, "%10s%21s%9u%11lu\n",
+                              "other", "", owner->nchunks,
+                              (unsigned long)owner->nbytes);
+          memdump_copyline(rdstate, linesize);
+        }
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: memdump_open
+ ****************************************************************************/
+
+static int memdump_open(FAR struct file *filep, FAR const char *relpath,
+                        int oflags, mode_t mode)
+{
+  FAR struct memdump_file_s *procfile;
+  int i = 0;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   *
+   * REVISIT:  Write-able proc files could be quite useful.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* "memdump" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "memdump") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  procfile = (FAR struct memdump_file_s *)
+    kmm_zalloc(sizeof(struct memdump_file_s));
+  if (!procfile)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Take a snapshot of each heap.  The file structure itself is allocated
+   * before the kernel heap is visited so it is included.
+   */
+
+#ifdef CONFIG_MM_KERNEL_HEAP
+  procfile->heap[i].name = "Kmem";
+  kmm_foreach(memdump_walker, &procfile->heap[i]);
+  i++;
+#endif
+
+#ifndef CONFIG_BUILD_KERNEL
+  procfile->heap[i].name = "Umem";
+  umm_foreach(memdump_walker, &procfile->heap[i]);
+  i++;
+#endif
+
+  UNUSED(i);
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)procfile;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: memdump_close
+ ****************************************************************************/
+
+static int memdump_close(FAR struct file *filep)
+{
+  FAR struct memdump_file_s *procfile;
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = (FAR struct memdump_file_s *)filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  /* Release the file attributes structure */
+
+  kmm_free(procfile);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: memdump_read
+ ****************************************************************************/
+
+static ssize_t memdump_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen)
+{
+  struct memdump_read_s rdstate;
+  int i;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  DEBUGASSERT(filep != NULL && buffer != NULL && buflen > 0);
+
+  /* Recover our private data from the struct file instance */
+
+  rdstate.procfile  = (FAR struct memdump_file_s *)filep->f_priv;
+  rdstate.buffer    = buffer;
+  rdstate.buflen    = buflen;
+  rdstate.totalsize = 0;
+  rdstate.offset    = filep->f_pos;
+  DEBUGASSERT(rdstate.procfile);
+
+  /* Format the snapshot of each heap */
+
+  for (i = 0; i < MEMDUMP_NHEAPS && rdstate.buflen > 0; i++)
+    {
+      memdump_readheap(&rdstate, &rdstate.procfile->heap[i]);
+    }
+
+  /* Update the file offset */
+
+  filep->f_pos += rdstate.totalsize;
+  return rdstate.totalsize;
+}
+
+/****************************************************************************
+ * Name: memdump_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int memdump_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct memdump_file_s *oldattr;
+  FAR struct memdump_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct memdump_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = (FAR struct memdump_file_s *)
+    kmm_malloc(sizeof(struct memdump_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct memdump_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: memdump_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int memdump_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "memdump" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "memdump") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* "memdump" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * !CONFIG_FS_PROCFS_EXCLUDE_MEMDUMP */
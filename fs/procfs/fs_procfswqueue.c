@@ -0,0 +1,403 @@
+/****************************************************************************
+ * fs/procfs/fs_procfswqueue.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_SCHED_WORKQUEUE) && !defined(CONFIG_FS_PROCFS_EXCLUDE_WQUEUE)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.
+ */
+
+#ifdef CONFIG_SCHED_WORKQUEUE_LATENCY
+#  define WQUEUE_LINELEN (48 + 10 * CONFIG_SCHED_WORKQUEUE_NLATENCY)
+#else
+#  define WQUEUE_LINELEN 48
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct wqueue_file_s
+{
+  struct procfs_file_s base;      /* Base open file structure */
+  unsigned int linesize;          /* Number of valid characters in line[] */
+  char line[WQUEUE_LINELEN];      /* Pre-allocated buffer for formatted lines */
+};
+
+/* This structure holds the state of one read operation while the work
+ * queues are traversed.
+ */
+
+struct wqueue_read_s
+{
+  FAR struct wqueue_file_s *procfile;
+  FAR char *buffer;               /* User buffer */
+  size_t buflen;                  /* Remaining space in the user buffer */
+  size_t totalsize;               /* Number of bytes returned so far */
+  off_t offset;                   /* Offset remaining to be skipped */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     wqueue_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     wqueue_close(FAR struct file *filep);
+static ssize_t wqueue_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     wqueue_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     wqueue_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations wqueue_operations =
+{
+  wqueue_open,   /* open */
+  wqueue_close,  /* close */
+  wqueue_read,   /* read */
+  NULL,           /* write */
+  wqueue_dup,    /* dup */
+  NULL,           /* opendir */
+  NULL,           /* closedir */
+  NULL,           /* readdir */
+  NULL,           /* rewinddir */
+  wqueue_stat    /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wqueue_copyline
+ *
+ * Description:
+ *   Copy the formatted line to the user buffer, skipping data before the
+ *   file offset.
+ *
+ ****************************************************************************/
+
+static void wqueue_copyline(FAR struct wqueue_read_s *rdstate,
+                             size_t linesize)
+{
+  size_t copysize;
+
+  copysize = procfs_memcpy(rdstate->procfile->line, linesize,
+                           rdstate->buffer, rdstate->buflen,
+                           &rdstate->offset);
+
+  rdstate->buffer    += copysize;
+  rdstate->buflen    -= copysize;
+  rdstate->totalsize += copysize;
+}
+
+/****************************************************************************
+ * Name: wqueue_readqueue
+ *
+ * Description:
+ *   work_foreach() callback that formats the description of one work
+ *   queue.
+ *
+ ****************************************************************************/
+
+static int wqueue_readqueue(FAR const struct work_info_s *info,
+                            FAR void *arg)
+{
+  FAR struct wqueue_read_s *rdstate = (FAR struct wqueue_read_s *)arg;
+  FAR char *line = rdstate->procfile->line;
+  size_t linesize;
+#ifdef CONFIG_SCHED_WORKQUEUE_LATENCY
+  int i;
+#endif
+
+  if (rdstate->buflen == 0)
+    {
+      return 1;
+    }
+
+  linesize = snprintf(line, WQUEUE_LINELEN, "%-16s%4d%4d%8d",
+                      info->name, info->qid, info->cpu, info->nthreads);
+
+#ifdef CONFIG_SCHED_WORKQUEUE_LATENCY
+  linesize += snprintf(&line[linesize], WQUEUE_LINELEN - linesize, "%9lu",
+                       (unsigned long)info->maxlat);
+
+  for (i = 0; i < CONFIG_SCHED_WORKQUEUE_NLATENCY; i++)
+    {
+      linesize += snprintf(&line[linesize], WQUEUE_LINELEN - linesize,
+                           " %9lu", (unsigned long)info->latency[i]);
+    }
+#endif
+
+  linesize += snprintf(&line[linesize], WQUEUE_LINELEN - linesize, "\n");
+
+  wqueue_copyline(rdstate, linesize);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: wqueue_open
+ ****************************************************************************/
+
+static int wqueue_open(FAR struct file *filep, FAR const char *relpath,
+                        int oflags, mode_t mode)
+{
+  FAR struct wqueue_file_s *procfile;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   *
+   * REVISIT:  Write-able proc files could be quite useful.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* "wqueue" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "wqueue") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  procfile = (FAR struct wqueue_file_s *)
+    kmm_zalloc(sizeof(struct wqueue_file_s));
+  if (!procfile)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)procfile;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: wqueue_close
+ ****************************************************************************/
+
+static int wqueue_close(FAR struct file *filep)
+{
+  FAR struct wqueue_file_s *procfile;
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = (FAR struct wqueue_file_s *)filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  /* Release the file attributes structure */
+
+  kmm_free(procfile);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: wqueue_read
+ ****************************************************************************/
+
+static ssize_t wqueue_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen)
+{
+  struct wqueue_read_s rdstate;
+  size_t linesize;
+#ifdef CONFIG_SCHED_WORKQUEUE_LATENCY
+  int i;
+#endif
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  DEBUGASSERT(filep != NULL && buffer != NULL && buflen > 0);
+
+  /* Recover our private data from the struct file instance */
+
+  rdstate.procfile  = (FAR struct wqueue_file_s *)filep->f_priv;
+  rdstate.buffer    = buffer;
+  rdstate.buflen    = buflen;
+  rdstate.totalsize = 0;
+  rdstate.offset    = filep->f_pos;
+  DEBUGASSERT(rdstate.procfile);
+
+  /* The first line is the headers.  The latency columns are the
+   * histogram buckets described with work_foreach().
+   */
+
+  linesize = snprintf(rdstate.procfile->line, WQUEUE_LINELEN,
+                      "%-16s%4s%4s%8s", "NAME", "QID", "CPU", "THREADS");
+
+#ifdef CONFIG_SCHED_WORKQUEUE_LATENCY
+  linesize += snprintf(&rdstate.procfile->line[linesize],
+                       WQUEUE_LINELEN - linesize, "%9s", "MAXLAT");
+
+  for (i = 0; i < CONFIG_SCHED_WORKQUEUE_NLATENCY; i++)
+    {
+      linesize += snprintf(&rdstate.procfile->line[linesize],
+                           WQUEUE_LINELEN - linesize, " %8s%d", "LAT", i);
+    }
+#endif
+
+  linesize += snprintf(&rdstate.procfile->line[linesize],
+                       WQUEUE_LINELEN - linesize, "\n");
+
+  wqueue_copyline(&rdstate, linesize);
+
+  /* Then one line for each work queue */
+
+  work_foreach(wqueue_readqueue, &rdstate);
+
+  /* Update the file offset */
+
+  filep->f_pos += rdstate.totalsize;
+  return rdstate.totalsize;
+}
+
+/****************************************************************************
+ * Name: wqueue_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int wqueue_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct wqueue_file_s *oldattr;
+  FAR struct wqueue_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct wqueue_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = (FAR struct wqueue_file_s *)
+    kmm_malloc(sizeof(struct wqueue_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct wqueue_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: wqueue_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int wqueue_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "wqueue" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "wqueue") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* "wqueue" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * CONFIG_SCHED_WORKQUEUE && !CONFIG_FS_PROCFS_EXCLUDE_WQUEUE */
@@ -4,6 +4,9 @@
  *   Copyright (C) 2015 Anton D. Kachalov. All rights reserved.
  *   Author: Anton D. Kachalov <mouse@mayc.ru>
  *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
  * Redistribution and use in source and binary forms, with or without
  * modification, are permitted provided that the following conditions
  * are met:
@@ -42,194 +45,1034 @@
 #include <sys/epoll.h>
 
 #include <stdint.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <queue.h>
 #include <poll.h>
 #include <errno.h>
-#include <string.h>
+#include <assert.h>
 #include <debug.h>
 
+#include <nuttx/irq.h>
+#include <nuttx/clock.h>
+#include <nuttx/cancelpt.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
+
+#include "inode/inode.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The number of file and socket descriptors that could be registered */
+
+#if defined(CONFIG_NET) && CONFIG_NSOCKET_DESCRIPTORS > 0
+#  define EPOLL_NFDS (CONFIG_NFILE_DESCRIPTORS + CONFIG_NSOCKET_DESCRIPTORS)
+#else
+#  define EPOLL_NFDS CONFIG_NFILE_DESCRIPTORS
+#endif
+
+/* The events that are always reported */
+
+#define EPOLL_ALWAYS (POLLERR | POLLHUP)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One registered file descriptor.  The embedded pollfd stays set up with
+ * the driver for as long as the file descriptor is registered and armed.
+ * The driver notifies the epoll instance through epoll_callback() which
+ * adds the item to the ready list.
+ */
+
+struct epoll_head_s;
+struct epoll_item_s
+{
+  dq_entry_t link;                /* Supports the ready list (must be first) */
+  FAR struct epoll_head_s *eph;   /* The epoll instance */
+  struct pollfd pfd;              /* The persistent poll registration */
+  struct epoll_event event;       /* The registered events and user data */
+  bool armed;                     /* The poll registration is set up */
+  bool ready;                     /* In (or being removed from) ready list */
+  bool recheck;                   /* Level triggered; recheck before reporting */
+};
+
+/* One epoll instance */
+
+struct epoll_head_s
+{
+  dq_entry_t node;                /* Supports the list of instances */
+  sem_t exclsem;                  /* Serializes epoll_ctl() and epoll_wait() */
+  sem_t waitsem;                  /* Posted when an item becomes ready */
+  dq_queue_t ready;               /* Items with pending events */
+  FAR struct pollfd *fds;         /* A poll() waiting on the epoll instance */
+  unsigned int nposts;            /* Posts of waitsem by epoll_callback() */
+  FAR struct epoll_item_s *items[EPOLL_NFDS]; /* Indexed by descriptor */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int epoll_close_internal(FAR struct file *filep);
+static int epoll_poll(FAR struct file *filep, FAR struct pollfd *fds,
+                      bool setup);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* All epoll instances.  This is used to remove the registrations of a file
+ * or socket when it is closed.
+ */
+
+static dq_queue_t g_epoll_list;
+static sem_t g_epoll_sem = SEM_INITIALIZER(1);
+
+static const struct file_operations g_epoll_ops =
+{
+  NULL,                 /* open */
+  epoll_close_internal, /* close */
+  NULL,                 /* read */
+  NULL,                 /* write */
+  NULL,                 /* seek */
+  NULL,                 /* ioctl */
+  epoll_poll            /* poll */
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+  , NULL                /* unlink */
+#endif
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: epoll_takesem
+ *
+ * Description:
+ *   Take a semaphore, ignoring signals.  Used where the operation cannot
+ *   fail.
+ *
+ ****************************************************************************/
+
+static void epoll_takesem(FAR sem_t *sem)
+{
+  int ret;
+
+  do
+    {
+      ret = nxsem_wait(sem);
+      DEBUGASSERT(ret == OK || ret == -EINTR);
+    }
+  while (ret == -EINTR);
+}
+
+/****************************************************************************
+ * Name: epoll_head
+ *
+ * Description:
+ *   Return the epoll instance associated with a file descriptor.
+ *
+ ****************************************************************************/
+
+static FAR struct epoll_head_s *epoll_head(int epfd)
+{
+  FAR struct file *filep;
+  FAR struct inode *inode;
+
+  if ((unsigned int)epfd >= CONFIG_NFILE_DESCRIPTORS ||
+      fs_getfilep(epfd, &filep) < 0)
+    {
+      return NULL;
+    }
+
+  inode = filep->f_inode;
+  if (inode == NULL || inode->u.i_ops != &g_epoll_ops)
+    {
+      return NULL;
+    }
+
+  return (FAR struct epoll_head_s *)inode->i_private;
+}
+
+/****************************************************************************
+ * Name: epoll_callback
+ *
+ * Description:
+ *   Called by poll_notify() when the driver reports an event on a
+ *   registered file descriptor.  This adds the item to the ready list (if
+ *   it is not already there) and wakes up epoll_wait().
+ *
+ * Assumptions:
+ *   May be called from an interrupt handler.
+ *
+ ****************************************************************************/
+
+static void epoll_callback(FAR struct pollfd *fds)
+{
+  FAR struct epoll_item_s *item = (FAR struct epoll_item_s *)fds->arg;
+  FAR struct epoll_head_s *eph = item->eph;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  if (!item->ready)
+    {
+      item->ready = true;
+      dq_addlast(&item->link, &eph->ready);
+
+      eph->nposts++;
+      nxsem_post(&eph->waitsem);
+
+      /* Also notify a poll() on the epoll instance itself */
+
+      if (eph->fds != NULL)
+        {
+          poll_notify(&eph->fds, 1, POLLIN);
+        }
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: epoll_setup
+ *
+ * Description:
+ *   Set up or tear down the persistent poll registration of an item.
+ *
+ ****************************************************************************/
+
+static int epoll_setup(FAR struct epoll_item_s *item, bool setup)
+{
+  FAR struct pollfd *pfd = &item->pfd;
+
+#ifdef CONFIG_NET
+  if ((pfd->events & POLLMASK) == POLLSOCK)
+    {
+      return psock_poll((FAR struct socket *)pfd->ptr, pfd, setup);
+    }
+#endif
+
+  return file_poll((FAR struct file *)pfd->ptr, pfd, setup);
+}
+
+/****************************************************************************
+ * Name: epoll_arm
+ *
+ * Description:
+ *   Set up the poll registration of an item with its current events.  Any
+ *   event that is already pending will be reported through
+ *   epoll_callback().
+ *
+ ****************************************************************************/
+
+static int epoll_arm(FAR struct epoll_item_s *item)
+{
+  FAR struct pollfd *pfd = &item->pfd;
+  irqstate_t flags;
+  int ret;
+
+  pfd->events  = (pfd->events & POLLMASK) |
+                 (pollevent_t)(item->event.events & ~POLLMASK) |
+                 EPOLL_ALWAYS;
+  pfd->revents = 0;
+  pfd->priv    = NULL;
+
+  ret = epoll_setup(item, true);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  item->armed = true;
+
+  /* Some drivers post the semaphore instead of calling poll_notify().
+   * Don't miss an event that is already pending on such a driver.
+   */
+
+  flags = enter_critical_section();
+  if (pfd->revents != 0 && !item->ready)
+    {
+      item->ready = true;
+      dq_addlast(&item->link, &item->eph->ready);
+    }
+
+  leave_critical_section(flags);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: epoll_disarm
+ *
+ * Description:
+ *   Tear down the poll registration of an item.
+ *
+ ****************************************************************************/
+
+static void epoll_disarm(FAR struct epoll_item_s *item)
+{
+  if (item->armed)
+    {
+      (void)epoll_setup(item, false);
+      item->armed = false;
+    }
+}
+
+/****************************************************************************
+ * Name: epoll_remove
+ *
+ * Description:
+ *   Unregister a file descriptor and free its item.
+ *
+ ****************************************************************************/
+
+static void epoll_remove(FAR struct epoll_head_s *eph, int fd)
+{
+  FAR struct epoll_item_s *item = eph->items[fd];
+  irqstate_t flags;
+
+  epoll_disarm(item);
+
+  flags = enter_critical_section();
+  if (item->ready)
+    {
+      dq_rem(&item->link, &eph->ready);
+    }
+
+  leave_critical_section(flags);
+
+  eph->items[fd] = NULL;
+  kmm_free(item);
+}
+
+/****************************************************************************
+ * Name: epoll_account
+ *
+ * Description:
+ *   Account for one post of the wait semaphore.  Posts from
+ *   epoll_callback() are matched by an entry in the ready list.  Other
+ *   posts come from drivers that post the semaphore directly.  Those are
+ *   only found by checking each registered file descriptor.
+ *
+ ****************************************************************************/
+
+static void epoll_account(FAR struct epoll_head_s *eph)
+{
+  FAR struct epoll_item_s *item;
+  irqstate_t flags;
+  int fd;
+
+  flags = enter_critical_section();
+  if (eph->nposts > 0)
+    {
+      eph->nposts--;
+      leave_critical_section(flags);
+      return;
+    }
+
+  for (fd = 0; fd < EPOLL_NFDS; fd++)
+    {
+      item = eph->items[fd];
+      if (item != NULL && item->armed && !item->ready &&
+          item->pfd.revents != 0)
+        {
+          item->ready = true;
+          dq_addlast(&item->link, &eph->ready);
+        }
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: epoll_collect
+ *
+ * Description:
+ *   Return the pending events of up to maxevents items from the ready list.
+ *   Level triggered items are put back on the ready list after they are
+ *   reported.  The next time, their registration is renewed to find out
+ *   whether the condition still persists.
+ *
+ ****************************************************************************/
+
+static int epoll_collect(FAR struct epoll_head_s *eph,
+                         FAR struct epoll_event *evs, int maxevents)
+{
+  FAR struct epoll_item_s *item;
+  FAR dq_entry_t *entry;
+  dq_queue_t pending;
+  dq_queue_t requeue;
+  pollevent_t revents;
+  irqstate_t flags;
+  int nevents = 0;
+
+  dq_init(&requeue);
+
+  /* Take the entire ready list.  New events are added to the (now empty)
+   * ready list and will be collected next time.
+   */
+
+  flags   = enter_critical_section();
+  pending = eph->ready;
+  dq_init(&eph->ready);
+  leave_critical_section(flags);
+
+  while (nevents < maxevents &&
+         (item = (FAR struct epoll_item_s *)dq_remfirst(&pending)) != NULL)
+    {
+      /* The item remains marked as ready while we examine it so that a
+       * concurrent epoll_callback() will not queue it again.
+       */
+
+      if (item->recheck)
+        {
+          item->recheck = false;
+          epoll_disarm(item);
+          if (epoll_arm(item) < 0)
+            {
+              item->pfd.revents = POLLERR;
+            }
+        }
+
+      flags   = enter_critical_section();
+      revents = item->pfd.revents;
+      item->pfd.revents = 0;
+
+      if (revents == 0 || !item->armed ||
+          (item->event.events & EPOLLET) != 0)
+        {
+          item->ready = false;
+        }
+
+      leave_critical_section(flags);
+
+      if (revents == 0)
+        {
+          continue;
+        }
+
+      evs[nevents].events = revents;
+      evs[nevents].data   = item->event.data;
+      nevents++;
+
+      if ((item->event.events & EPOLLONESHOT) != 0)
+        {
+          /* Disable the item until it is re-armed by EPOLL_CTL_MOD */
+
+          epoll_disarm(item);
+          item->ready = false;
+        }
+      else if ((item->event.events & EPOLLET) == 0 && item->armed)
+        {
+          item->recheck = true;
+          dq_addlast(&item->link, &requeue);
+        }
+    }
+
+  /* Put back the items that were not examined ahead of any new arrivals
+   * and the reported level triggered items after them.
+   */
+
+  flags = enter_critical_section();
+  while ((entry = dq_remlast(&pending)) != NULL)
+    {
+      dq_addfirst(entry, &eph->ready);
+    }
+
+  while ((entry = dq_remfirst(&requeue)) != NULL)
+    {
+      dq_addlast(entry, &eph->ready);
+    }
+
+  leave_critical_section(flags);
+  return nevents;
+}
+
+/****************************************************************************
+ * Name: epoll_close_internal
+ *
+ * Description:
+ *   Called when a file descriptor referring to the epoll instance is
+ *   closed.  The epoll instance is freed with the last reference.  The
+ *   inode itself is freed by inode_release().
+ *
+ ****************************************************************************/
+
+static int epoll_close_internal(FAR struct file *filep)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct epoll_head_s *eph = (FAR struct epoll_head_s *)inode->i_private;
+  int fd;
+
+  /* The reference of this file descriptor is released after we return.
+   * Other file descriptors may still refer to the same instance (dup()).
+   */
+
+  if (inode->i_crefs > 1)
+    {
+      return OK;
+    }
+
+  epoll_takesem(&g_epoll_sem);
+  dq_rem(&eph->node, &g_epoll_list);
+  nxsem_post(&g_epoll_sem);
+
+  for (fd = 0; fd < EPOLL_NFDS; fd++)
+    {
+      if (eph->items[fd] != NULL)
+        {
+          epoll_remove(eph, fd);
+        }
+    }
+
+  nxsem_destroy(&eph->waitsem);
+  nxsem_destroy(&eph->exclsem);
+  kmm_free(eph);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: epoll_poll
+ *
+ * Description:
+ *   Support poll() (or epoll) on the epoll file descriptor itself.  The
+ *   epoll instance is readable when its ready list is not empty.
+ *
+ ****************************************************************************/
+
+static int epoll_poll(FAR struct file *filep, FAR struct pollfd *fds,
+                      bool setup)
+{
+  FAR struct epoll_head_s *eph =
+    (FAR struct epoll_head_s *)filep->f_inode->i_private;
+  irqstate_t flags;
+  int ret = OK;
+
+  flags = enter_critical_section();
+  if (setup)
+    {
+      if (eph->fds != NULL)
+        {
+          ret = -EBUSY;
+        }
+      else
+        {
+          eph->fds = fds;
+          if (!dq_empty(&eph->ready))
+            {
+              poll_notify(&fds, 1, POLLIN);
+            }
+        }
+    }
+  else if (eph->fds == fds)
+    {
+      eph->fds = NULL;
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
 
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
 /****************************************************************************
- * Name: epoll_create
+ * Name: epoll_create1
  *
  * Description:
+ *   Create an epoll instance and return a file descriptor that refers to
+ *   it.  The instance is freed when the last file descriptor referring to
+ *   it is closed.
  *
  * Input Parameters:
+ *   flags - Zero or EPOLL_CLOEXEC
  *
  * Returned Value:
+ *   A new file descriptor on success.  -1 (ERROR) is returned on failure
+ *   and the errno value is set appropriately:
+ *
+ *   EINVAL - Invalid flags
+ *   EMFILE - No free file descriptor
+ *   ENOMEM - Insufficient memory
  *
  ****************************************************************************/
 
-int epoll_create(int size)
+int epoll_create1(int flags)
 {
-  FAR struct epoll_head *eph =
-    (FAR struct epoll_head *)kmm_malloc(sizeof(struct epoll_head));
+  FAR struct epoll_head_s *eph;
+  FAR struct inode *inode;
+  int errcode;
+  int fd;
+
+  if ((flags & ~EPOLL_CLOEXEC) != 0)
+    {
+      errcode = EINVAL;
+      goto errout;
+    }
+
+  eph = (FAR struct epoll_head_s *)kmm_zalloc(sizeof(struct epoll_head_s));
+  if (eph == NULL)
+    {
+      errcode = ENOMEM;
+      goto errout;
+    }
+
+  /* The epoll instance is represented by an unnamed inode that is not
+   * part of the inode tree.  Marking it as deleted lets inode_release()
+   * free it when the last reference is closed.
+   */
+
+  inode = (FAR struct inode *)kmm_zalloc(FSNODE_SIZE(0));
+  if (inode == NULL)
+    {
+      errcode = ENOMEM;
+      goto errout_with_eph;
+    }
+
+  inode->i_crefs   = 1;
+  inode->i_flags   = FSNODEFLAG_TYPE_DRIVER | FSNODEFLAG_DELETED;
+  inode->u.i_ops   = &g_epoll_ops;
+  inode->i_private = eph;
 
-  eph->size = size;
-  eph->occupied = 0;
-  eph->evs = kmm_malloc(sizeof(struct epoll_event) * eph->size);
+  nxsem_init(&eph->exclsem, 0, 1);
+  nxsem_init(&eph->waitsem, 0, 0);
 
-  /* REVISIT: This will not work on machines where:
-   * sizeof(struct epoll_head *) > sizeof(int)
+  /* The wait semaphore is used for signaling and, hence, should not have
+   * priority inheritance enabled.
    */
 
-  return (int)((intptr_t)eph);
+  nxsem_setprotocol(&eph->waitsem, SEM_PRIO_NONE);
+  dq_init(&eph->ready);
+
+  epoll_takesem(&g_epoll_sem);
+  dq_addlast(&eph->node, &g_epoll_list);
+  nxsem_post(&g_epoll_sem);
+
+  fd = files_allocate(inode, O_RDOK, 0, 0);
+  if (fd < 0)
+    {
+      errcode = EMFILE;
+      goto errout_with_list;
+    }
+
+  finfo("epfd=%d\n", fd);
+  return fd;
+
+errout_with_list:
+  epoll_takesem(&g_epoll_sem);
+  dq_rem(&eph->node, &g_epoll_list);
+  nxsem_post(&g_epoll_sem);
+
+  nxsem_destroy(&eph->waitsem);
+  nxsem_destroy(&eph->exclsem);
+  kmm_free(inode);
+
+errout_with_eph:
+  kmm_free(eph);
+
+errout:
+  set_errno(errcode);
+  return ERROR;
 }
 
 /****************************************************************************
- * Name: epoll_close
+ * Name: epoll_create
  *
  * Description:
+ *   Create an epoll instance.  The size argument is only a hint and is
+ *   ignored except that it must be greater than zero.
  *
  * Input Parameters:
+ *   size - Greater than zero
  *
  * Returned Value:
+ *   See epoll_create1().
  *
  ****************************************************************************/
 
-void epoll_close(int epfd)
+int epoll_create(int size)
 {
-  /* REVISIT: This will not work on machines where:
-   * sizeof(struct epoll_head *) > sizeof(int)
-   */
+  if (size <= 0)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
 
-  FAR struct epoll_head *eph = (FAR struct epoll_head *)((intptr_t)epfd);
+  return epoll_create1(0);
+}
 
-  kmm_free(eph->evs);
-  kmm_free(eph);
+/****************************************************************************
+ * Name: epoll_close
+ *
+ * Description:
+ *   Close an epoll file descriptor.  This is equivalent to close() and is
+ *   retained for compatibility.
+ *
+ * Input Parameters:
+ *   epfd - The epoll file descriptor
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void epoll_close(int epfd)
+{
+  (void)close(epfd);
 }
 
 /****************************************************************************
  * Name: epoll_ctl
  *
  * Description:
+ *   Add, modify, or remove a file descriptor in the interest list of an
+ *   epoll instance.  The file descriptor stays registered with its driver
+ *   until it is removed with EPOLL_CTL_DEL or closed (see epoll_detach()).
  *
  * Input Parameters:
+ *   epfd - The epoll file descriptor
+ *   op   - EPOLL_CTL_ADD, EPOLL_CTL_MOD, or EPOLL_CTL_DEL
+ *   fd   - The target file or socket descriptor
+ *   ev   - The events of interest and the user data to be returned with
+ *          them.  Not used with EPOLL_CTL_DEL.
  *
  * Returned Value:
+ *   Zero (OK) on success.  -1 (ERROR) is returned on failure and the errno
+ *   value is set appropriately:
+ *
+ *   EBADF  - epfd or fd is not a valid file descriptor
+ *   EEXIST - fd is already registered (EPOLL_CTL_ADD)
+ *   EINVAL - epfd is not an epoll file descriptor, fd is epfd, or op is
+ *            not supported
+ *   ENOENT - fd is not registered (EPOLL_CTL_MOD or EPOLL_CTL_DEL)
+ *   ENOMEM - Insufficient memory
  *
  ****************************************************************************/
 
-int epoll_ctl(int epfd, int op, int fd, struct epoll_event *ev)
+int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
 {
-  /* REVISIT: This will not work on machines where:
-   * sizeof(struct epoll_head *) > sizeof(int)
-   */
+  FAR struct epoll_head_s *eph;
+  FAR struct epoll_item_s *item;
+  int ret;
+
+  eph = epoll_head(epfd);
+  if (eph == NULL)
+    {
+      ret = (unsigned int)epfd < CONFIG_NFILE_DESCRIPTORS ? -EINVAL : -EBADF;
+      goto errout;
+    }
+
+  if ((unsigned int)fd >= EPOLL_NFDS)
+    {
+      ret = -EBADF;
+      goto errout;
+    }
 
-  FAR struct epoll_head *eph = (FAR struct epoll_head *)((intptr_t)epfd);
+  if (fd == epfd || (op != EPOLL_CTL_DEL && ev == NULL))
+    {
+      ret = -EINVAL;
+      goto errout;
+    }
+
+  ret = nxsem_wait(&eph->exclsem);
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  item = eph->items[fd];
 
   switch (op)
     {
       case EPOLL_CTL_ADD:
-        finfo("%08x CTL ADD(%d): fd=%d ev=%08x\n",
-              epfd, eph->occupied, fd, ev->events);
+        finfo("%d CTL ADD: fd=%d ev=%08x\n", epfd, fd, ev->events);
+
+        if (item != NULL)
+          {
+            ret = -EEXIST;
+            break;
+          }
+
+        item = (FAR struct epoll_item_s *)
+          kmm_zalloc(sizeof(struct epoll_item_s));
+        if (item == NULL)
+          {
+            ret = -ENOMEM;
+            break;
+          }
+
+        item->eph      = eph;
+        item->event    = *ev;
+        item->pfd.fd   = fd;
+        item->pfd.sem  = &eph->waitsem;
+        item->pfd.cb   = epoll_callback;
+        item->pfd.arg  = item;
+
+        /* Bind the poll structure to the underlying file or socket so
+         * that it is always torn down on the same object.
+         */
+
+#ifdef CONFIG_NET
+        if (fd >= CONFIG_NFILE_DESCRIPTORS)
+          {
+            item->pfd.ptr    = sockfd_socket(fd);
+            item->pfd.events = POLLSOCK;
+            ret              = item->pfd.ptr != NULL ? OK : -EBADF;
+          }
+        else
+#endif
+          {
+            ret = fs_getfilep(fd, (FAR struct file **)&item->pfd.ptr);
+            item->pfd.events = POLLFILE;
+          }
+
+        if (ret >= 0)
+          {
+            eph->items[fd] = item;
+            ret = epoll_arm(item);
+            if (ret < 0)
+              {
+                eph->items[fd] = NULL;
+              }
+          }
 
-        eph->evs[eph->occupied].events = ev->events | POLLERR | POLLHUP;
-        eph->evs[eph->occupied++].data.fd = fd;
-        return 0;
+        if (ret < 0)
+          {
+            kmm_free(item);
+          }
+
+        break;
 
       case EPOLL_CTL_DEL:
-        {
-          int i;
+        finfo("%d CTL DEL: fd=%d\n", epfd, fd);
 
-          for (i = 0; i < eph->occupied; i++)
-            {
-              if (eph->evs[i].data.fd == fd)
-                {
-                  if (i != eph->occupied - 1)
-                    {
-                      memmove(&eph->evs[i], &eph->evs[i + 1],
-                              eph->occupied - i);
-                    }
-
-                  eph->occupied--;
-                  return 0;
-                }
-            }
+        if (item == NULL)
+          {
+            ret = -ENOENT;
+            break;
+          }
 
-          return -ENOENT;
-        }
+        epoll_remove(eph, fd);
+        break;
 
       case EPOLL_CTL_MOD:
-        {
-          int i;
+        finfo("%d CTL MOD: fd=%d ev=%08x\n", epfd, fd, ev->events);
+
+        if (item == NULL)
+          {
+            ret = -ENOENT;
+            break;
+          }
+
+        /* Renew the registration with the new events.  This also re-arms
+         * an EPOLLONESHOT item.
+         */
+
+        epoll_disarm(item);
+        item->event   = *ev;
+        item->recheck = false;
+        ret = epoll_arm(item);
+        break;
+
+      default:
+        ret = -EINVAL;
+        break;
+    }
+
+  nxsem_post(&eph->exclsem);
 
-          finfo("%08x CTL MOD(%d): fd=%d ev=%08x\n",
-                epfd, eph->occupied, fd, ev->events);
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  return OK;
 
-          for (i = 0; i < eph->occupied; i++)
+errout:
+  set_errno(-ret);
+  return ERROR;
+}
+
+/****************************************************************************
+ * Name: epoll_detach
+ *
+ * Description:
+ *   Remove a file or socket that is being closed from every epoll instance
+ *   where it is registered.  This tears down the poll registration while
+ *   the driver still exists and keeps epoll from using the file or socket
+ *   structure after it has been released or reused.
+ *
+ * Input Parameters:
+ *   ptr - The struct file or struct socket instance being closed
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void epoll_detach(FAR void *ptr)
+{
+  FAR struct epoll_head_s *eph;
+  FAR struct epoll_item_s *item;
+  int fd;
+
+  /* Nothing can be registered if there are no epoll instances */
+
+  if (dq_empty(&g_epoll_list))
+    {
+      return;
+    }
+
+  epoll_takesem(&g_epoll_sem);
+  for (eph = (FAR struct epoll_head_s *)dq_peek(&g_epoll_list);
+       eph != NULL;
+       eph = (FAR struct epoll_head_s *)dq_next(&eph->node))
+    {
+      epoll_takesem(&eph->exclsem);
+      for (fd = 0; fd < EPOLL_NFDS; fd++)
+        {
+          item = eph->items[fd];
+          if (item != NULL && item->pfd.ptr == ptr)
             {
-              if (eph->evs[i].data.fd == fd)
-                {
-                  eph->evs[i].events = ev->events | POLLERR | POLLHUP;
-                  return 0;
-                }
+              epoll_remove(eph, fd);
             }
-
-          return -ENOENT;
         }
+
+      nxsem_post(&eph->exclsem);
     }
 
-  return -EINVAL;
+  nxsem_post(&g_epoll_sem);
 }
 
 /****************************************************************************
  * Name: epoll_wait
  *
  * Description:
+ *   Wait for events on an epoll instance.  Only the file descriptors with
+ *   pending events are examined so the time required does not depend on
+ *   the number of registered file descriptors.
  *
  * Input Parameters:
+ *   epfd      - The epoll file descriptor
+ *   evs       - The location to return the events
+ *   maxevents - The maximum number of events to return
+ *   timeout   - The maximum time to wait in milliseconds.  Zero means that
+ *               epoll_wait() returns immediately; -1 waits indefinitely.
  *
  * Returned Value:
+ *   The number of events returned.  Zero is returned on a timeout.  -1
+ *   (ERROR) is returned on failure and the errno value is set
+ *   appropriately:
+ *
+ *   EBADF  - epfd is not a valid file descriptor
+ *   EINVAL - epfd is not an epoll file descriptor or maxevents is not
+ *            greater than zero
+ *   EINTR  - A signal was received
  *
  ****************************************************************************/
 
 int epoll_wait(int epfd, FAR struct epoll_event *evs, int maxevents,
                int timeout)
 {
-  /* REVISIT: This will not work on machines where:
-   * sizeof(struct epoll_head *) > sizeof(int)
-   */
+  FAR struct epoll_head_s *eph;
+  clock_t start;
+  clock_t ticks = 0;
+  int ret;
 
-  FAR struct epoll_head *eph = (FAR struct epoll_head *)((intptr_t)epfd);
-  int counter;
-  int rc;
-  int i;
+  /* epoll_wait() is a cancellation point */
 
-  rc = poll((FAR struct pollfd *)eph->evs, eph->occupied, timeout);
+  (void)enter_cancellation_point();
 
-  if (rc <= 0)
+  eph = epoll_head(epfd);
+  if (eph == NULL)
     {
-      if (rc < 0)
-        {
-          ferr("ERROR: %08x poll fail: %d for %d, %d msecs\n",
-               epfd, rc, eph->occupied, timeout);
+      ret = (unsigned int)epfd < CONFIG_NFILE_DESCRIPTORS ? -EINVAL : -EBADF;
+      goto errout;
+    }
 
-          for (i = 0; i < eph->occupied; i++)
-            {
-              ferr("  %02d: fd=%d\n", i, eph->evs[i].data.fd);
-            }
-        }
+  if (evs == NULL || maxevents <= 0)
+    {
+      ret = -EINVAL;
+      goto errout;
+    }
+
+  if (timeout > 0)
+    {
+      /* Round timeout up to next full tick as does poll() */
 
-      return rc;
+#if (MSEC_PER_TICK * USEC_PER_MSEC) != USEC_PER_TICK && \
+    defined(CONFIG_HAVE_LONG_LONG)
+      ticks = (((unsigned long long)timeout * USEC_PER_MSEC) +
+               (USEC_PER_TICK - 1)) /
+              USEC_PER_TICK;
+#else
+      ticks = ((unsigned int)timeout + (MSEC_PER_TICK - 1)) /
+              MSEC_PER_TICK;
+#endif
     }
 
-  /* Iterate over non NULL event fds */
+  start = clock_systimer();
 
-  for (i = 0, counter = 0; i < rc && counter < eph->size; counter++)
+  for (; ; )
     {
-      if (eph->evs[counter].revents != 0)
+      ret = nxsem_wait(&eph->exclsem);
+      if (ret < 0)
         {
-          evs[i].data.fd = eph->evs[counter].data.fd;
-          evs[i].events  = eph->evs[counter].revents;
-          i += 1;
+          goto errout;
         }
+
+      /* Account for all posts of the wait semaphore since the last time */
+
+      while (nxsem_trywait(&eph->waitsem) >= 0)
+        {
+          epoll_account(eph);
+        }
+
+      ret = epoll_collect(eph, evs, maxevents);
+      nxsem_post(&eph->exclsem);
+
+      if (ret > 0 || timeout == 0)
+        {
+          break;
+        }
+
+      /* Nothing is ready.  Wait for a notification. */
+
+      if (timeout > 0)
+        {
+          ret = nxsem_tickwait(&eph->waitsem, start, ticks);
+        }
+      else
+        {
+          ret = nxsem_wait(&eph->waitsem);
+        }
+
+      if (ret < 0)
+        {
+          if (ret == -ETIMEDOUT)
+            {
+              ret = 0;
+              break;
+            }
+
+          goto errout;
+        }
+
+      nxsem_post(&eph->waitsem);
     }
 
-  return i;
-}
+  leave_cancellation_point();
+  return ret;
 
+errout:
+  leave_cancellation_point();
+  set_errno(-ret);
+  return ERROR;
+}
@@ -149,6 +149,7 @@ static inline int poll_setup(FAR struct pollfd *fds, nfds_t nfds,
        */
 
       fds[i].sem     = sem;
+      fds[i].cb      = NULL;
       fds[i].revents = 0;
       fds[i].priv    = NULL;
 
@@ -357,11 +358,7 @@ int file_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
         {
           if (setup)
             {
-              fds->revents |= (fds->events & (POLLIN | POLLOUT));
-              if (fds->revents != 0)
-                {
-                  nxsem_post(fds->sem);
-                }
+              poll_notify(&fds, 1, POLLIN | POLLOUT);
             }
 
           ret = OK;
@@ -371,6 +368,53 @@ int file_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
   return ret;
 }
 
+/****************************************************************************
+ * Name: poll_notify
+ *
+ * Description:
+ *   Notify the poll waiters that some of the events of interest have
+ *   occurred.  Drivers should use this instead of posting the poll
+ *   semaphore directly so that a callback attached to the pollfd (as used
+ *   by epoll) is also honored.
+ *
+ * Input Parameters:
+ *   afds     - An array of pointers to the poll structures of the waiters.
+ *              NULL entries are ignored.
+ *   nfds     - The number of entries in the array
+ *   eventset - The events that occurred.  POLLERR and POLLHUP are always
+ *              reported; other events only if they are of interest.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void poll_notify(FAR struct pollfd **afds, int nfds, pollevent_t eventset)
+{
+  FAR struct pollfd *fds;
+  int i;
+
+  for (i = 0; i < nfds; i++)
+    {
+      fds = afds[i];
+      if (fds != NULL)
+        {
+          fds->revents |= eventset & (fds->events | POLLERR | POLLHUP);
+          if (fds->revents != 0)
+            {
+              if (fds->cb != NULL)
+                {
+                  fds->cb(fds);
+                }
+              else
+                {
+                  nxsem_post(fds->sem);
+                }
+            }
+        }
+    }
+}
+
 /****************************************************************************
  * Name: fdesc_poll
  *
@@ -278,9 +278,12 @@ next_subdir:
       goto errout_with_sem;
     }
 
-  /* Remove all of the children from the unlinked inode */
+  /* Remove all of the children from the unlinked inode.  The children
+   * are now found below the new inode.
+   */
 
   oldinode->i_child = NULL;
+  inode_cache_invalidate();
   ret = OK;
 
 errout_with_sem:
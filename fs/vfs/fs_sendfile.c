@@ -1,7 +1,7 @@
 /****************************************************************************
  * fs/vfs/fs_sendfile.c
  *
- *   Copyright (C) 2007, 2009, 2011, 2013, 2017-2018 Gregory Nutt. All
+ *   Copyright (C) 2007, 2009, 2011, 2013, 2017-2019 Gregory Nutt. All
  *     rights reserved.
  *   Author: Gregory Nutt <gnutt@nuttx.org>
  *
@@ -41,16 +41,188 @@
 #include <nuttx/config.h>
 
 #include <sys/sendfile.h>
+#include <sys/statfs.h>
+#include <fcntl.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <limits.h>
 #include <unistd.h>
 #include <errno.h>
 #include <assert.h>
 
 #include <nuttx/sched.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
 #include <nuttx/net/net.h>
 
-#ifdef CONFIG_NET_SENDFILE
+#ifdef CONFIG_FS_SENDFILE
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sendfile_fixedmap
+ *
+ * Description:
+ *   Return true if the memory that FIOC_MMAP returns for the file can
+ *   neither move nor shrink while the file is open.  That is true of romfs
+ *   on XIP media and of drivers such as the BCH driver over an XIP RAM
+ *   disk.  It is not true of tmpfs which reallocates a file when it grows.
+ *
+ ****************************************************************************/
+
+static bool sendfile_fixedmap(FAR struct file *filep)
+{
+#ifndef CONFIG_DISABLE_MOUNTPOINT
+  FAR struct inode *inode = filep->f_inode;
+  struct statfs buf;
+
+  if (INODE_IS_MOUNTPT(inode))
+    {
+      if (inode->u.i_mops == NULL || inode->u.i_mops->statfs == NULL ||
+          inode->u.i_mops->statfs(inode, &buf) < 0)
+        {
+          return false;
+        }
+
+      return buf.f_type == ROMFS_MAGIC;
+    }
+#endif
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: sendfile_mapped
+ *
+ * Description:
+ *   Transfer data from a file that is held in memory that cannot move.
+ *   The data is written to 'outfd' directly from that memory.
+ *
+ * Input Parameters:
+ *   outfd  - A descriptor opened for writing.
+ *   filep  - The file structure of the source file
+ *   offset - See sendfile()
+ *   count  - The number of bytes to copy
+ *
+ * Returned Value:
+ *   The number of bytes written to outfd or a negated errno value.  -ENOSYS
+ *   is returned if the source file is not held in such memory.
+ *
+ ****************************************************************************/
+
+static ssize_t sendfile_mapped(int outfd, FAR struct file *filep,
+                               FAR off_t *offset, size_t count)
+{
+  FAR const uint8_t *base = NULL;
+  ssize_t ntransferred;
+  ssize_t nwritten;
+  off_t startpos;
+  off_t size;
+  off_t pos;
+  int ret;
+
+  /* Is the content of the file held in memory?  This is the same check
+   * that mmap() uses.  The memory is used without holding any file system
+   * lock so it must not be able to move.
+   */
+
+  if (!sendfile_fixedmap(filep))
+    {
+      return -ENOSYS;
+    }
+
+  ret = file_ioctl(filep, FIOC_MMAP, (unsigned long)((uintptr_t)&base));
+  if (ret < 0 || base == NULL)
+    {
+      return -ENOSYS;
+    }
+
+  /* Get the current file position and the size of the file */
+
+  startpos = file_seek(filep, 0, SEEK_CUR);
+  if (startpos < 0)
+    {
+      return (ssize_t)startpos;
+    }
+
+  size = file_seek(filep, 0, SEEK_END);
+  if (size < 0)
+    {
+      return (ssize_t)size;
+    }
+
+  pos = file_seek(filep, startpos, SEEK_SET);
+  if (pos < 0)
+    {
+      return (ssize_t)pos;
+    }
+
+  if (offset != NULL)
+    {
+      startpos = *offset;
+      if (startpos < 0)
+        {
+          return -EINVAL;
+        }
+    }
+
+  /* Transfer no more than the rest of the file */
+
+  if (startpos >= size)
+    {
+      count = 0;
+    }
+  else if (count > (size_t)(size - startpos))
+    {
+      count = size - startpos;
+    }
+
+  if (count > SSIZE_MAX)
+    {
+      count = SSIZE_MAX;
+    }
+
+  /* Write the data directly from memory.  After a partial transfer, the
+   * partial count is returned rather than an error.
+   */
+
+  for (ntransferred = 0; (size_t)ntransferred < count; )
+    {
+      nwritten = nx_write(outfd, base + startpos + ntransferred,
+                          count - ntransferred);
+      if (nwritten <= 0)
+        {
+          if (ntransferred == 0)
+            {
+              return nwritten;
+            }
+
+          break;
+        }
+
+      ntransferred += nwritten;
+    }
+
+  /* Return or update the file position */
+
+  if (offset != NULL)
+    {
+      *offset = startpos + ntransferred;
+    }
+  else
+    {
+      pos = file_seek(filep, startpos + ntransferred, SEEK_SET);
+      if (pos < 0)
+        {
+          return (ssize_t)pos;
+        }
+    }
+
+  return ntransferred;
+}
 
 /****************************************************************************
  * Public Functions
@@ -64,6 +236,10 @@
  *   Used with file descriptors it basically just wraps a sequence of
  *   reads() and writes() to perform a copy.
  *
+ *   If the source file is held in memory that cannot move (XIP romfs or a
+ *   RAM disk accessed through the BCH driver), then the data is written to
+ *   the destination directly from that memory.
+ *
  *   If the destination descriptor is a socket, it gives a better
  *   performance than simple reds() and writes(). The data is read directly
  *   into the net buffer and the whole tcp window is filled if possible.
@@ -97,26 +273,21 @@
  *   There error values are those returned by read() or write() plus:
  *
  *   EINVAL - Bad input parameters.
+ *   EBADF  - 'infd' is not open for reading.
  *   ENOMEM - Could not allocated an I/O buffer
  *
  ****************************************************************************/
 
 ssize_t sendfile(int outfd, int infd, off_t *offset, size_t count)
 {
-#ifdef CONFIG_NET_SENDFILE
-  /* Check the destination file descriptor:  Is it a (probable) file
-   * descriptor?  Check the source file:  Is it a normal file?
-   */
+  FAR struct file *filep;
+  ssize_t ret;
 
-  if ((unsigned int)outfd >= CONFIG_NFILE_DESCRIPTORS &&
-      (unsigned int)infd < CONFIG_NFILE_DESCRIPTORS)
-    {
-      FAR struct file *filep;
-      int ret;
+  /* Check the source file:  Is it a (probable) file descriptor? */
 
-      /* This appears to be a file-to-socket transfer.  Get the file
-       * structure.
-       */
+  if ((unsigned int)infd < CONFIG_NFILE_DESCRIPTORS)
+    {
+      /* Get the file structure of the source file */
 
       ret = fs_getfilep(infd, &filep);
       if (ret < 0)
@@ -127,26 +298,57 @@ ssize_t sendfile(int outfd, int infd, off_t *offset, size_t count)
 
       DEBUGASSERT(filep != NULL);
 
-      /* Then let net_sendfile do the work. */
+      /* The source must be open for reading */
 
-      ret = net_sendfile(outfd, filep, offset, count);
-      if (ret >= 0 || get_errno() != ENOSYS)
+      if ((filep->f_oflags & O_RDOK) == 0)
         {
-          return ret;
+          set_errno(EBADF);
+          return ERROR;
         }
 
-      /* Fall back to the slow path if errno equals ENOSYS,
-       * because net_sendfile fail to optimize this transfer.
+#ifdef CONFIG_NET_SENDFILE
+      /* Check the destination file descriptor:  Is it a (probable) socket
+       * descriptor?
        */
-    }
+
+      if ((unsigned int)outfd >= CONFIG_NFILE_DESCRIPTORS)
+        {
+          /* This appears to be a file-to-socket transfer.  Let
+           * net_sendfile do the work.
+           */
+
+          ret = net_sendfile(outfd, filep, offset, count);
+          if (ret >= 0 || get_errno() != ENOSYS)
+            {
+              return ret;
+            }
+
+          /* Fall back to the slow path if errno equals ENOSYS,
+           * because net_sendfile fail to optimize this transfer.
+           */
+        }
 #endif
 
-  /* No... then this is probably a file-to-file transfer.  The generic
-   * lib_sendfile() can handle that case.
+      /* Transfer directly from memory if the file is held in memory */
+
+      ret = sendfile_mapped(outfd, filep, offset, count);
+      if (ret != -ENOSYS)
+        {
+          if (ret < 0)
+            {
+              set_errno(-ret);
+              return ERROR;
+            }
+
+          return ret;
+        }
+    }
+
+  /* No... then this is a transfer that the generic lib_sendfile() must
+   * handle.
    */
 
   return lib_sendfile(outfd, infd, offset, count);
 }
 
-#endif /* CONFIG_NET_SENDFILE */
-
+#endif /* CONFIG_FS_SENDFILE */
@@ -0,0 +1,238 @@
+/****************************************************************************
+ * fs/vfs/fs_splice.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/sendfile.h>
+#include <stdbool.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <assert.h>
+
+#include <nuttx/fs/fs.h>
+#include <nuttx/drivers/drivers.h>
+
+#ifdef CONFIG_FS_SENDFILE
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes the destination of data removed from a pipe */
+
+struct splice_out_s
+{
+  int so_fd;                       /* The destination descriptor */
+  FAR struct file *so_filep;       /* The destination file or NULL */
+  FAR off_t *so_offset;            /* The destination offset or NULL */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_PIPES
+/****************************************************************************
+ * Name: splice_write
+ *
+ * Description:
+ *   Write data taken from the pipe buffer to the destination of splice().
+ *
+ ****************************************************************************/
+
+static ssize_t splice_write(FAR void *arg, FAR const void *buf, size_t len)
+{
+  FAR struct splice_out_s *out = (FAR struct splice_out_s *)arg;
+  ssize_t nwritten;
+
+  if (out->so_offset != NULL)
+    {
+      nwritten = file_pwrite(out->so_filep, buf, len, *out->so_offset);
+      if (nwritten > 0)
+        {
+          *out->so_offset += nwritten;
+        }
+
+      return nwritten;
+    }
+
+  return nx_write(out->so_fd, buf, len);
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: splice
+ *
+ * Description:
+ *   splice() moves data between two file descriptors where one of the
+ *   descriptors refers to a pipe (or FIFO).
+ *
+ *   If 'fd_in' is a pipe, then up to 'len' bytes are removed from the pipe
+ *   and written to 'fd_out' directly from the pipe buffer.  As with read(),
+ *   splice() waits until the pipe holds some data and then transfers only
+ *   the data that is available.  'fd_out' may be a file, a device, or a
+ *   socket, but not another pipe.
+ *
+ *   Otherwise, if 'fd_out' is a pipe, then the data is copied from 'fd_in'
+ *   into the pipe as by sendfile().
+ *
+ *   NOTE: This interface is not specified by POSIX.  It is similar to the
+ *   Linux splice() interface, but the data is always copied once.
+ *
+ * Input Parameters:
+ *   fd_in   - The descriptor to read from
+ *   off_in  - Must be NULL if 'fd_in' is a pipe.  Otherwise, the file offset
+ *             to read from as for the 'offset' parameter of sendfile().
+ *   fd_out  - The descriptor to write to
+ *   off_out - Must be NULL if 'fd_out' is a pipe or a socket.  Otherwise,
+ *             the file offset to write at.  It is updated and the file
+ *             position is not changed.  If NULL, the data is written at the
+ *             current file position.
+ *   len     - The maximum number of bytes to transfer
+ *   flags   - SPLICE_F_NONBLOCK:  Do not wait for data in the 'fd_in' pipe.
+ *             The other SPLICE_F_* flags are ignored.
+ *
+ * Returned Value:
+ *   The number of bytes transferred, zero at the end of the input, or -1
+ *   on failure with errno set appropriately:
+ *
+ *   EAGAIN - SPLICE_F_NONBLOCK was specified or 'fd_in' is non-blocking
+ *     and the pipe is empty.
+ *   EBADF  - One of the descriptors is not valid.
+ *   EINVAL - Neither descriptor is a pipe or both are pipes.
+ *   ESPIPE - An offset was given for a pipe or a socket.
+ *
+ *   Or any error that read() or write() may report.
+ *
+ ****************************************************************************/
+
+ssize_t splice(int fd_in, FAR off_t *off_in, int fd_out, FAR off_t *off_out,
+               size_t len, unsigned int flags)
+{
+#ifdef CONFIG_PIPES
+  FAR struct file *infilep  = NULL;
+  FAR struct file *outfilep = NULL;
+  ssize_t ret;
+
+  /* Get the file structures.  Sockets have none. */
+
+  if ((unsigned int)fd_in < CONFIG_NFILE_DESCRIPTORS)
+    {
+      ret = fs_getfilep(fd_in, &infilep);
+      if (ret < 0)
+        {
+          goto errout;
+        }
+    }
+
+  if ((unsigned int)fd_out < CONFIG_NFILE_DESCRIPTORS)
+    {
+      ret = fs_getfilep(fd_out, &outfilep);
+      if (ret < 0)
+        {
+          goto errout;
+        }
+    }
+
+  if (infilep != NULL && pipe_ispipe(infilep))
+    {
+      struct splice_out_s out;
+
+      /* Pipe to file, device or socket.  The pipe stays locked while the
+       * data is written.  The destination may not be a pipe:  Two splices
+       * in opposite directions between the same two pipes would deadlock.
+       */
+
+      if (outfilep != NULL && pipe_ispipe(outfilep))
+        {
+          ret = -EINVAL;
+          goto errout;
+        }
+
+      if (off_in != NULL || (off_out != NULL && outfilep == NULL))
+        {
+          ret = -ESPIPE;
+          goto errout;
+        }
+
+      out.so_fd     = fd_out;
+      out.so_filep  = outfilep;
+      out.so_offset = off_out;
+
+      ret = pipe_splice(infilep, splice_write, &out, len,
+                        (flags & SPLICE_F_NONBLOCK) != 0);
+      if (ret < 0)
+        {
+          goto errout;
+        }
+
+      return ret;
+    }
+  else if (outfilep != NULL && pipe_ispipe(outfilep))
+    {
+      /* File, device or socket to pipe */
+
+      if (off_out != NULL)
+        {
+          ret = -ESPIPE;
+          goto errout;
+        }
+
+      return sendfile(fd_out, fd_in, off_in, len);
+    }
+
+  ret = -EINVAL;
+
+errout:
+  set_errno(-ret);
+  return ERROR;
+#else
+  /* There are no pipes */
+
+  set_errno(EINVAL);
+  return ERROR;
+#endif
+}
+
+#endif /* CONFIG_FS_SENDFILE */
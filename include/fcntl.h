@@ -129,6 +129,13 @@
 #define DN_RENAME   4  /* A file was renamed */
 #define DN_ATTRIB   5  /* Attributes of a file were changed */
 
+/* splice() flags (linux) */
+
+#define SPLICE_F_MOVE     (1 << 0) /* Move pages instead of copying (ignored) */
+#define SPLICE_F_NONBLOCK (1 << 1) /* Do not block on the pipe */
+#define SPLICE_F_MORE     (1 << 2) /* More data will follow (ignored) */
+#define SPLICE_F_GIFT     (1 << 3) /* Unused */
+
 /* int creat(const char *path, mode_t mode);
  *
  * is equivalent to open with O_WRONLY|O_CREAT|O_TRUNC.
@@ -173,6 +180,11 @@ extern "C"
 int open(const char *path, int oflag, ...);
 int fcntl(int fd, int cmd, ...);
 
+/* Non-standard, Linux-like splice() (requires CONFIG_FS_SENDFILE) */
+
+ssize_t splice(int fd_in, FAR off_t *off_in, int fd_out, FAR off_t *off_out,
+               size_t len, unsigned int flags);
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
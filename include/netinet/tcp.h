@@ -41,6 +41,7 @@
  ****************************************************************************/
 
 #include <sys/socket.h>
+#include <stdint.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -70,4 +71,49 @@
                                            * Argument: max retry count */
 #define TCP_MAXSEG    (__SO_PROTOCOL + 4) /* The maximum segment size */
 
+/* TCP protocol socket operations needed to support congestion control: */
+
+#define TCP_CONGESTION (__SO_PROTOCOL + 5) /* Congestion avoidance algorithm
+                                            * Argument: name string */
+#define TCP_INFO       (__SO_PROTOCOL + 6) /* Connection statistics (get only)
+                                            * Argument: struct tcp_info */
+
+#define TCP_CA_NAME_MAX 16                 /* Longest algorithm name + 1 */
+
+/* Values of tcpi_ca_state */
+
+#define TCP_CA_Open     0 /* Normal operation */
+#define TCP_CA_Disorder 1 /* Duplicate ACKs have been received */
+#define TCP_CA_CWR      2 /* Not used */
+#define TCP_CA_Recovery 3 /* Fast recovery after a fast retransmit */
+#define TCP_CA_Loss     4 /* Recovery after a retransmission time-out */
+
+/****************************************************************************
+ * Public Type Definitions
+ ****************************************************************************/
+
+/* The connection statistics returned by the TCP_INFO socket option.  The
+ * field names follow Linux, as do the units:  Times are in microseconds
+ * and the congestion window and slow start threshold are in segments of
+ * tcpi_snd_mss bytes.
+ */
+
+struct tcp_info
+{
+  uint8_t  tcpi_state;          /* TCP state (TCP_ESTABLISHED, etc.) */
+  uint8_t  tcpi_ca_state;       /* Congestion state (TCP_CA_*) */
+  uint8_t  tcpi_retransmits;    /* Retransmissions of the current segment */
+  uint8_t  tcpi_snd_wscale;     /* Shift count for the peer's window */
+  uint8_t  tcpi_rcv_wscale;     /* Shift count for our window */
+  uint32_t tcpi_rto;            /* Retransmission time-out */
+  uint32_t tcpi_snd_mss;        /* Maximum segment size for sending */
+  uint32_t tcpi_unacked;        /* Bytes sent but not yet ACKed */
+  uint32_t tcpi_rtt;            /* Smoothed round trip time */
+  uint32_t tcpi_rttvar;         /* Round trip time variation */
+  uint32_t tcpi_snd_ssthresh;   /* Slow start threshold */
+  uint32_t tcpi_snd_cwnd;       /* Congestion window */
+  uint32_t tcpi_snd_wnd;        /* Peer's receive window (bytes) */
+  uint32_t tcpi_total_retrans;  /* Total number of retransmitted segments */
+};
+
 #endif /* __INCLUDE_NETINET_TCP_H */
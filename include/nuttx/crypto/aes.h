@@ -42,6 +42,7 @@
  ****************************************************************************/
 
 #include <nuttx/config.h>
+#include <sys/types.h>
 #include <stdint.h>
 
 /****************************************************************************
@@ -49,14 +50,37 @@
  ****************************************************************************/
 
 #define AES128_KEY_SIZE    16
+#define AES192_KEY_SIZE    24
+#define AES256_KEY_SIZE    32
+
+#define AES_MAXROUNDS      14    /* AES-256 */
+#define AES_GCM_TAG_SIZE   16    /* Full size of the AES-GCM tag */
+#define AES_GCM_IV_SIZE    12    /* Recommended size of the AES-GCM IV */
 
 /****************************************************************************
  * Public Types
  ****************************************************************************/
 
+/* The round keys are kept as 32-bit words.  The decryption round keys
+ * are prepared for the equivalent inverse cipher.
+ */
+
 struct aes_state_s
 {
-  uint8_t expanded_key[176];
+  uint32_t enc_key[4 * (AES_MAXROUNDS + 1)];
+  uint32_t dec_key[4 * (AES_MAXROUNDS + 1)];
+  int nrounds;
+};
+
+/* AES-GCM context:  The AES key schedule and the table of multiples of the
+ * hash subkey H used for GHASH.
+ */
+
+struct aes_gcm_s
+{
+  struct aes_state_s aes;
+  uint64_t hl[16];      /* Low 64 bits of i * H, i = 0..15 */
+  uint64_t hh[16];      /* High 64 bits of i * H */
 };
 
 /****************************************************************************
@@ -118,14 +142,13 @@ void aes_decrypt(FAR uint8_t *state, FAR const uint8_t *key);
  *
  * Input Parameters:
  *  state  an AES context that can be used for AES operations
- *  key    a pointer to a 16-byte buffer holding the AES-128 key
- *  len    length of the key, must be 16
- *
- * TODO: Support other key lengths of 24 (AES-192) and 32 (AES-256)
+ *  key    a pointer to a buffer holding the AES key
+ *  len    length of the key, must be 16 (AES-128), 24 (AES-192), or 32
+ *         (AES-256)
  *
  * Returned Value:
  *   0 if OK
- *   -EINVAL if len is not 16
+ *   -EINVAL if len is not valid
  *
  ****************************************************************************/
 
@@ -164,6 +187,65 @@ void aes_encipher(FAR struct aes_state_s *state, FAR uint8_t *blocks,
 void aes_decipher(FAR struct aes_state_s *state, FAR uint8_t *blocks,
                   int nblk);
 
+/****************************************************************************
+ * Name: aes_gcm_setkey
+ *
+ * Description:
+ *   Configure the given AES-GCM context for operation with the selected
+ *   key.
+ *
+ * Input Parameters:
+ *  gcm    an AES-GCM context
+ *  key    a pointer to a buffer holding the AES key
+ *  len    length of the key, must be 16, 24, or 32
+ *
+ * Returned Value:
+ *   0 if OK
+ *   -EINVAL if len is not valid
+ *
+ ****************************************************************************/
+
+int aes_gcm_setkey(FAR struct aes_gcm_s *gcm, FAR const uint8_t *key,
+                   int len);
+
+/****************************************************************************
+ * Name: aes_gcm_crypt
+ *
+ * Description:
+ *   AES-GCM authenticated encryption and decryption (NIST SP 800-38D).
+ *
+ *   On encryption, the tag is computed over the additional authenticated
+ *   data and the cipher text and returned in 'tag'.  On decryption, the tag
+ *   in 'tag' is verified.  If it does not match, then the output is
+ *   cleared and -EBADMSG is returned.
+ *
+ * Input Parameters:
+ *  gcm     an AES-GCM context prepared with aes_gcm_setkey()
+ *  encrypt CYPHER_ENCRYPT or CYPHER_DECRYPT
+ *  iv      the initialization vector.  AES_GCM_IV_SIZE bytes are
+ *          recommended, but any non-zero length may be used.
+ *  ivlen   length of the initialization vector
+ *  aad     additional authenticated data (may be NULL if aadlen is zero)
+ *  aadlen  length of the additional authenticated data
+ *  in      the input data
+ *  out     the output data (may be the same as in)
+ *  len     length of the input and output data
+ *  tag     the tag
+ *  taglen  length of the tag, 4 to AES_GCM_TAG_SIZE bytes
+ *
+ * Returned Value:
+ *   0 if OK
+ *   -EINVAL if a length is not valid
+ *   -EBADMSG if the tag does not match on decryption
+ *
+ ****************************************************************************/
+
+int aes_gcm_crypt(FAR struct aes_gcm_s *gcm, int encrypt,
+                  FAR const uint8_t *iv, size_t ivlen,
+                  FAR const uint8_t *aad, size_t aadlen,
+                  FAR const uint8_t *in, FAR uint8_t *out, size_t len,
+                  FAR uint8_t *tag, size_t taglen);
+
 #ifdef  __cplusplus
 }
 #endif /* __cplusplus */
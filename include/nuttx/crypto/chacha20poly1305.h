@@ -0,0 +1,103 @@
+/****************************************************************************
+ * include/nuttx/crypto/chacha20poly1305.h
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_CRYPTO_CHACHA20POLY1305_H
+#define __INCLUDE_NUTTX_CRYPTO_CHACHA20POLY1305_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define CHACHA20POLY1305_KEY_SIZE    32
+#define CHACHA20POLY1305_NONCE_SIZE  12
+#define CHACHA20POLY1305_TAG_SIZE    16
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/****************************************************************************
+ * Name: chacha20poly1305_crypt
+ *
+ * Description:
+ *   ChaCha20-Poly1305 authenticated encryption and decryption (RFC 8439).
+ *
+ *   On encryption, the tag is computed over the additional authenticated
+ *   data and the cipher text and returned in 'tag'.  On decryption, the tag
+ *   in 'tag' is verified first and the data is decrypted only if it
+ *   matches.
+ *
+ * Input Parameters:
+ *   encrypt - CYPHER_ENCRYPT or CYPHER_DECRYPT
+ *   key     - The CHACHA20POLY1305_KEY_SIZE byte key
+ *   nonce   - The CHACHA20POLY1305_NONCE_SIZE byte nonce
+ *   aad     - Additional authenticated data (may be NULL if aadlen is 0)
+ *   aadlen  - Length of the additional authenticated data
+ *   in      - The input data
+ *   out     - The output data (may be the same as in)
+ *   len     - Length of the input and output data
+ *   tag     - The CHACHA20POLY1305_TAG_SIZE byte tag
+ *
+ * Returned Value:
+ *   0 if OK
+ *   -EBADMSG if the tag does not match on decryption
+ *
+ ****************************************************************************/
+
+int chacha20poly1305_crypt(int encrypt, FAR const uint8_t *key,
+                           FAR const uint8_t *nonce,
+                           FAR const uint8_t *aad, size_t aadlen,
+                           FAR const uint8_t *in, FAR uint8_t *out,
+                           size_t len, FAR uint8_t *tag);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_NUTTX_CRYPTO_CHACHA20POLY1305_H */
@@ -53,7 +53,9 @@
 #define CRYPTO_AES_ECB          1
 #define CRYPTO_AES_CBC          2
 #define CRYPTO_AES_CTR          3
-#define CRYPTO_ALGORITHM_MAX    1
+#define CRYPTO_AES_GCM          4  /* AEAD, use CIOCAUTHCRYPT */
+#define CRYPTO_CHACHA20_POLY1305 5 /* AEAD, use CIOCAUTHCRYPT */
+#define CRYPTO_ALGORITHM_MAX    5
 
 #define CRYPTO_FLAG_HARDWARE    0x01000000 /* hardware accelerated */
 #define CRYPTO_FLAG_SOFTWARE    0x02000000 /* software implementation */
@@ -65,6 +67,8 @@
 #define CIOCGSESSION            101
 #define CIOCFSESSION            102
 #define CIOCCRYPT               103
+#define CIOCAUTHCRYPT           104 /* Authenticated encryption */
+#define CIOCCRYPTM              105 /* Several CIOCCRYPT requests */
 
 typedef char* caddr_t;
 
@@ -92,4 +96,36 @@ struct crypt_op
   caddr_t iv;
 };
 
+/* Authenticated encryption with additional data (CIOCAUTHCRYPT).  On
+ * encryption, tag_len bytes of the tag are returned in tag.  On
+ * decryption, the tag is verified and EBADMSG is reported if it does not
+ * match.
+ */
+
+struct crypt_auth_op
+{
+  uint32_t ses;
+  uint16_t op;        /* i.e. COP_ENCRYPT */
+  uint16_t flags;
+  unsigned len;       /* Length of src and dst */
+  unsigned auth_len;  /* Length of the additional authenticated data */
+  caddr_t auth_src;   /* Additional authenticated data */
+  caddr_t src, dst;
+  caddr_t tag;        /* The authentication tag */
+  unsigned tag_len;
+  caddr_t iv;
+  unsigned iv_len;
+};
+
+/* Several CIOCCRYPT requests in a single call (CIOCCRYPTM).  The requests
+ * are processed in order until one of them fails.
+ */
+
+struct crypt_mop
+{
+  unsigned count;            /* Number of requests */
+  FAR struct crypt_op *reqs; /* The requests */
+  unsigned done;             /* returns: number of completed requests */
+};
+
 #endif /* __INCLUDE_NUTTX_CRYPTO_CRYPTODEV_H */
@@ -43,8 +43,33 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdint.h>
 #include <stdbool.h>
 
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* BCH sector cache statistics as returned by the DIOC_CACHESTATS ioctl
+ * command (see CONFIG_BCH_CACHE_STATS).
+ */
+
+struct bch_cachestats_s
+{
+  uint32_t hits;        /* Accesses to a sector in the cache */
+  uint32_t misses;      /* Accesses that required reading the sector */
+  uint32_t readahead;   /* Sectors read ahead of a sequential access */
+  uint32_t writebacks;  /* Modified sectors written to the block device */
+};
+
+/* The function that pipe_splice() uses to pass the data in a pipe buffer on
+ * to its destination.  It returns the number of bytes that were accepted
+ * or a negated errno value.
+ */
+
+typedef CODE ssize_t (*pipe_splice_t)(FAR void *arg, FAR const void *buf,
+                                      size_t len);
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -280,6 +305,46 @@ int pipe2(int fd[2], size_t bufsize);
 int mkfifo2(FAR const char *pathname, mode_t mode, size_t bufsize);
 #endif
 
+#if defined(CONFIG_PIPES) && defined(CONFIG_FS_SENDFILE)
+/****************************************************************************
+ * Name: pipe_ispipe
+ *
+ * Description:
+ *   Return true if the open file is a pipe or a FIFO.
+ *
+ ****************************************************************************/
+
+struct file;
+bool pipe_ispipe(FAR struct file *filep);
+
+/****************************************************************************
+ * Name: pipe_splice
+ *
+ * Description:
+ *   Remove up to 'len' bytes from a pipe, passing them to 'writer' directly
+ *   from the pipe buffer instead of copying them into a user buffer as
+ *   read() would.  Like read(), this waits until there is data in the pipe
+ *   and then transfers only the data that is available.  The pipe is
+ *   locked while 'writer' runs so 'writer' must not access any pipe.
+ *
+ * Input Parameters:
+ *   filep    - The open pipe or FIFO
+ *   writer   - The function that receives the data
+ *   arg      - The argument passed to 'writer'
+ *   len      - The maximum number of bytes to transfer
+ *   nonblock - Do not wait for data even if O_NONBLOCK is not set
+ *
+ * Returned Value:
+ *   The number of bytes transferred, zero on end-of-file, or a negated
+ *   errno value.  The error from 'writer' is returned only if no data was
+ *   transferred.
+ *
+ ****************************************************************************/
+
+ssize_t pipe_splice(FAR struct file *filep, pipe_splice_t writer,
+                    FAR void *arg, size_t len, bool nonblock);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
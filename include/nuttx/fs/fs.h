@@ -974,7 +974,7 @@ int lib_flushall(FAR struct streamlist *list);
  *
  ****************************************************************************/
 
-#ifdef CONFIG_NET_SENDFILE
+#ifdef CONFIG_FS_SENDFILE
 ssize_t lib_sendfile(int outfd, int infd, off_t *offset, size_t count);
 #endif
 
@@ -1256,6 +1256,23 @@ int file_fcntl(FAR struct file *filep, int cmd, ...);
 
 int file_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup);
 
+/****************************************************************************
+ * Name: epoll_detach
+ *
+ * Description:
+ *   Remove a file or socket that is being closed from every epoll instance
+ *   where it is registered.  Called by the file and socket close logic.
+ *
+ * Input Parameters:
+ *   ptr - The struct file or struct socket instance being closed
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void epoll_detach(FAR void *ptr);
+
 /****************************************************************************
  * Name: file_fstat
  *
@@ -191,6 +191,12 @@
 #define DIOC_SETKEY     _DIOC(0X0004)     /* IN:  Encryption key
                                            * OUT: None
                                            */
+#define DIOC_CACHESTATS _DIOC(0x0005)     /* IN:  Pointer to writable instance
+                                           *      of struct bch_cachestats_s
+                                           * OUT: BCH sector cache statistics
+                                           *      returned in the user-provided
+                                           *      buffer.
+                                           */
 
 /* NuttX block driver ioctl definitions *************************************/
 
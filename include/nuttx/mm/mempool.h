@@ -0,0 +1,213 @@
+/****************************************************************************
+ * include/nuttx/mm/mempool.h
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_MM_MEMPOOL_H
+#define __INCLUDE_NUTTX_MM_MEMPOOL_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <queue.h>
+
+#ifdef CONFIG_SMP
+#  include <nuttx/spinlock.h>
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* This structure describes one pool of fixed size memory blocks.  A pool
+ * is normally declared statically by the subsystem that uses it.  The
+ * first four fields must be set before calling mempool_initialize(); the
+ * remaining fields are private to the pool implementation.
+ *
+ *   bsize    - The size of each block.  Free blocks are linked through
+ *              their first word so the block size is rounded up to at
+ *              least the size of a pointer.
+ *   ninitial - The number of blocks allocated from the kernel heap when
+ *              the pool is initialized.
+ *   nreserve - The number of free blocks that are reserved for use by
+ *              interrupt handlers.  Allocations from task context will
+ *              not consume these but will grow the pool instead.
+ *   nexpand  - The number of blocks added to the pool when an allocation
+ *              from task context finds no unreserved blocks.  Zero means
+ *              that the pool has a fixed size.
+ */
+
+struct mempool_s
+{
+  size_t bsize;                     /* Size of one block */
+  uint16_t ninitial;                /* Number of blocks initially allocated */
+  uint16_t nreserve;                /* Number of blocks reserved for ISRs */
+  uint16_t nexpand;                 /* Number of blocks per expansion */
+
+  /* Private data */
+
+  FAR struct mempool_s *flink;      /* Supports the list of all pools */
+  FAR const char *name;             /* Name used for statistics */
+  sq_queue_t freelist;              /* The list of free blocks */
+#ifdef CONFIG_SMP
+  spinlock_t lock;                  /* Excludes other CPUs */
+#endif
+  unsigned int nblocks;             /* Total number of blocks in the pool */
+  unsigned int nfree;               /* Number of blocks in the free list */
+  unsigned int maxused;             /* Largest number of blocks in use */
+  unsigned int nfail;               /* Number of failed allocations */
+};
+
+/* Usage statistics of one pool as returned by mempool_info() */
+
+struct mempoolinfo_s
+{
+  size_t bsize;                     /* Size of one block */
+  unsigned int nblocks;             /* Total number of blocks in the pool */
+  unsigned int nfree;               /* Number of free blocks */
+  unsigned int maxused;             /* Largest number of blocks in use */
+  unsigned int nfail;               /* Number of failed allocations */
+};
+
+/* Callback used with mempool_foreach() */
+
+typedef CODE int (*mempool_handler_t)(FAR struct mempool_s *pool,
+                                      FAR void *arg);
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: mempool_initialize
+ *
+ * Description:
+ *   Initialize a memory pool.  The bsize, ninitial, nreserve, and nexpand
+ *   fields of the pool structure must have been set by the caller.  The
+ *   initial blocks are allocated from the kernel heap as a single chunk
+ *   and the pool is added to the list of pools reported by procfs.
+ *
+ * Input Parameters:
+ *   pool - The pool to be initialized
+ *   name - A name for the pool.  The string must persist.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ * Assumptions:
+ *   Called from task context after the kernel heap has been initialized.
+ *
+ ****************************************************************************/
+
+int mempool_initialize(FAR struct mempool_s *pool, FAR const char *name);
+
+/****************************************************************************
+ * Name: mempool_alloc
+ *
+ * Description:
+ *   Allocate one block from a memory pool.  Interrupt handlers may use any
+ *   free block, including the reserved blocks.  In task context, the pool
+ *   will be expanded from the kernel heap if only reserved blocks remain.
+ *
+ * Input Parameters:
+ *   pool - The pool from which to allocate
+ *
+ * Returned Value:
+ *   The allocated block or NULL if no block is available.
+ *
+ ****************************************************************************/
+
+FAR void *mempool_alloc(FAR struct mempool_s *pool);
+
+/****************************************************************************
+ * Name: mempool_free
+ *
+ * Description:
+ *   Return a block to the memory pool from which it was allocated.  Blocks
+ *   are never returned to the heap.  This may be called from any context.
+ *
+ * Input Parameters:
+ *   pool - The pool from which the block was allocated
+ *   blk  - The block to be freed
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void mempool_free(FAR struct mempool_s *pool, FAR void *blk);
+
+/****************************************************************************
+ * Name: mempool_info
+ *
+ * Description:
+ *   Return the usage statistics of a memory pool.
+ *
+ ****************************************************************************/
+
+void mempool_info(FAR struct mempool_s *pool,
+                  FAR struct mempoolinfo_s *info);
+
+/****************************************************************************
+ * Name: mempool_foreach
+ *
+ * Description:
+ *   Call the handler for each initialized memory pool.  Traversal stops if
+ *   the handler returns a non-zero value.
+ *
+ * Returned Value:
+ *   The last value returned by the handler.
+ *
+ ****************************************************************************/
+
+int mempool_foreach(mempool_handler_t handler, FAR void *arg);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_NUTTX_MM_MEMPOOL_H */
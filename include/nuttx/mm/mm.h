@@ -47,6 +47,10 @@
 #include <string.h>
 #include <semaphore.h>
 
+#if defined(CONFIG_MM_FASTCACHE) && defined(CONFIG_SMP)
+#  include <nuttx/spinlock.h>
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -110,6 +114,24 @@
 #  undef CONFIG_MM_KERNEL_HEAP
 #endif
 
+/* The per-CPU cache of small chunks must disable local interrupts and so
+ * may only be used by logic running in privileged mode.  The cache data
+ * is still present in user heaps so that the heap structure has the same
+ * layout in both user- and kernel-mode builds of the memory manager.
+ */
+
+#undef MM_USE_FASTCACHE
+#if defined(CONFIG_MM_FASTCACHE) && \
+   (defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__))
+#  define MM_USE_FASTCACHE 1
+#endif
+
+#ifdef CONFIG_SMP
+#  define MM_FASTCACHE_NCPUS CONFIG_SMP_NCPUS
+#else
+#  define MM_FASTCACHE_NCPUS 1
+#endif
+
 /* Chunk Header Definitions *************************************************/
 /* These definitions define the characteristics of allocator
  *
@@ -126,6 +148,17 @@
  *   minor performance losses.
  */
 
+/* If CONFIG_MM_TRACE is selected, each chunk header also holds the owner
+ * of the chunk.  The minimum chunk size must then be doubled to hold the
+ * larger free chunk header.
+ */
+
+#ifdef CONFIG_MM_TRACE
+#  define MM_TRACE_SHIFT 1
+#else
+#  define MM_TRACE_SHIFT 0
+#endif
+
 #if defined(CONFIG_MM_SMALL) && UINTPTR_MAX <= UINT32_MAX
 /* Two byte offsets; Pointers may be 2 or 4 bytes;
  * sizeof(struct mm_freenode_s) is 8 or 12 bytes.
@@ -137,22 +170,23 @@
 
 #elif defined(CONFIG_HAVE_LONG_LONG)
 /* Four byte offsets; Pointers may be 4 or 8 bytes
- * sizeof(struct mm_freenode_s) is 16 or 24 bytes.
+ * sizeof(struct mm_freenode_s) is 16 or 24 bytes (24 or 40 bytes with
+ * CONFIG_MM_TRACE).
  */
 
 #  if UINTPTR_MAX <= UINT32_MAX
-#    define MM_MIN_SHIFT B2C_SHIFT( 4)  /* 16 bytes */
+#    define MM_MIN_SHIFT B2C_SHIFT( 4 + MM_TRACE_SHIFT)  /* 16 bytes */
 #  elif UINTPTR_MAX <= UINT64_MAX
-#    define MM_MIN_SHIFT B2C_SHIFT( 5)  /* 32 bytes */
+#    define MM_MIN_SHIFT B2C_SHIFT( 5 + MM_TRACE_SHIFT)  /* 32 bytes */
 #  endif
 #  define MM_MAX_SHIFT   B2C_SHIFT(22)  /*  4 Mb */
 
 #else
 /* Four byte offsets; Pointers must be 4 bytes.
- * sizeof(struct mm_freenode_s) is 16 bytes.
+ * sizeof(struct mm_freenode_s) is 16 bytes (24 bytes with CONFIG_MM_TRACE).
  */
 
-#  define MM_MIN_SHIFT   B2C_SHIFT( 4)  /* 16 bytes */
+#  define MM_MIN_SHIFT   B2C_SHIFT( 4 + MM_TRACE_SHIFT)  /* 16 bytes */
 #  define MM_MAX_SHIFT   B2C_SHIFT(22)  /*  4 Mb */
 #endif
 
@@ -162,6 +196,25 @@
 #define MM_MAX_CHUNK     (1 << MM_MAX_SHIFT)
 #define MM_NNODES        (MM_MAX_SHIFT - MM_MIN_SHIFT + 1)
 
+/* Definitions for the two-level segregated fit free lists.  The first
+ * level divides the chunk sizes into powers of two; the second level
+ * divides each power of two into MM_SLI_COUNT equal parts.  Chunk sizes
+ * are represented with MM_SIZE_BITS bits, so MM_FLI_COUNT first level
+ * lists are enough to cover every possible chunk size.
+ */
+
+#ifdef CONFIG_MM_TLSF
+#  ifdef CONFIG_MM_SMALL
+#    define MM_SIZE_BITS 16
+#  else
+#    define MM_SIZE_BITS 32
+#  endif
+
+#  define MM_FLI_COUNT   (MM_SIZE_BITS - MM_MIN_SHIFT)
+#  define MM_SLI_SHIFT   CONFIG_MM_TLSF_SLI_SHIFT
+#  define MM_SLI_COUNT   (1 << MM_SLI_SHIFT)
+#endif
+
 #define MM_GRAN_MASK     (MM_MIN_CHUNK-1)
 #define MM_ALIGN_UP(a)   (((a) + MM_GRAN_MASK) & ~MM_GRAN_MASK)
 #define MM_ALIGN_DOWN(a) ((a) & ~MM_GRAN_MASK)
@@ -178,6 +231,25 @@
 #define MM_IS_ALLOCATED(n) \
   ((int)((struct mm_allocnode_s*)(n)->preceding) < 0))
 
+/* Allocation tracing.  If CONFIG_MM_TRACE is selected, then each allocated
+ * chunk records the ID of the task that allocated it and the address from
+ * which the allocator was called.  MM_SETOWNER() must be used in each
+ * allocation interface so that the recorded address is that of its
+ * caller.  Chunks held in the per-CPU caches are owned by MM_OWNER_CACHED.
+ */
+
+#ifdef CONFIG_MM_TRACE
+#  ifdef __GNUC__
+#    define MM_RETURN_ADDRESS() __builtin_return_address(0)
+#  else
+#    define MM_RETURN_ADDRESS() NULL
+#  endif
+#  define MM_SETOWNER(mem)      mm_setowner((mem), MM_RETURN_ADDRESS())
+#  define MM_OWNER_CACHED       ((pid_t)-1)
+#else
+#  define MM_SETOWNER(mem)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -201,12 +273,20 @@ struct mm_allocnode_s
 {
   mmsize_t size;           /* Size of this chunk */
   mmsize_t preceding;      /* Size of the preceding chunk */
+#ifdef CONFIG_MM_TRACE
+  pid_t pid;               /* ID of the task that allocated the chunk */
+  FAR void *caller;        /* Address from which the chunk was allocated */
+#endif
 };
 
-/* What is the size of the allocnode? */
+/* What is the size of the allocnode?  The owner fields are padded to the
+ * size of a pointer.
+ */
 
-#ifdef CONFIG_MM_SMALL
+#if defined(CONFIG_MM_SMALL)
 # define SIZEOF_MM_ALLOCNODE   B2C(4)
+#elif defined(CONFIG_MM_TRACE)
+# define SIZEOF_MM_ALLOCNODE   (B2C(8) + 2 * sizeof(FAR void *))
 #else
 # define SIZEOF_MM_ALLOCNODE   B2C(8)
 #endif
@@ -220,6 +300,10 @@ struct mm_freenode_s
 {
   mmsize_t size;                   /* Size of this chunk */
   mmsize_t preceding;              /* Size of the preceding chunk */
+#ifdef CONFIG_MM_TRACE
+  pid_t pid;                       /* Unused (same layout as allocnode) */
+  FAR void *caller;
+#endif
   FAR struct mm_freenode_s *flink; /* Supports a doubly linked list */
   FAR struct mm_freenode_s *blink;
 };
@@ -232,6 +316,23 @@ struct mm_freenode_s
 #define CHECK_FREENODE_SIZE \
   DEBUGASSERT(sizeof(struct mm_freenode_s) == SIZEOF_MM_FREENODE)
 
+/* This describes the per-CPU cache of small, recently freed chunks.  The
+ * cached chunks are still marked as allocated in the heap; they are linked
+ * together through the 'flink' field of struct mm_freenode_s.
+ */
+
+#ifdef CONFIG_MM_FASTCACHE
+struct mm_fastcache_s
+{
+#ifdef CONFIG_SMP
+  spinlock_t fc_lock;              /* Protects against remote flushes */
+#endif
+  uint8_t fc_count[CONFIG_MM_FASTCACHE_NCLASSES];  /* Chunks per class */
+  size_t fc_bytes;                 /* Total size of all cached chunks */
+  FAR struct mm_freenode_s *fc_head[CONFIG_MM_FASTCACHE_NCLASSES];
+};
+#endif
+
 /* This describes one heap (possibly with multiple regions) */
 
 struct mm_heap_s
@@ -257,14 +358,41 @@ struct mm_heap_s
   int mm_nregions;
 #endif
 
+#ifdef CONFIG_MM_TLSF
+  /* All free nodes are maintained in doubly linked lists of similar sizes.
+   * Bit n of mm_flbitmap is set if any of the lists mm_freelist[n][] is
+   * non-empty; bit m of mm_slbitmap[n] is set if mm_freelist[n][m] is
+   * non-empty.
+   */
+
+  uint32_t mm_flbitmap;
+  uint32_t mm_slbitmap[MM_FLI_COUNT];
+  FAR struct mm_freenode_s *mm_freelist[MM_FLI_COUNT][MM_SLI_COUNT];
+#else
   /* All free nodes are maintained in a doubly linked list.  This
    * array provides some hooks into the list at various points to
    * speed searches for free nodes.
    */
 
   struct mm_freenode_s mm_nodelist[MM_NNODES];
+#endif
+
+#ifdef CONFIG_MM_FASTCACHE
+  /* Per-CPU caches of small chunks */
+
+  struct mm_fastcache_s mm_fastcache[MM_FASTCACHE_NCPUS];
+#endif
 };
 
+/* This is the type of the function called by mm_foreach() for each chunk
+ * in the heap.  The chunk is free unless MM_ALLOC_BIT is set in its
+ * 'preceding' field.  The heap is locked while the function is called so
+ * it must not allocate from or free to the same heap.
+ */
+
+typedef CODE void (*mm_walker_t)(FAR struct mm_allocnode_s *node,
+                                 FAR void *arg);
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -378,6 +506,8 @@ FAR void *kmm_malloc(size_t size);
 /* Functions contained in mm_free.c *****************************************/
 
 void mm_free(FAR struct mm_heap_s *heap, FAR void *mem);
+void mm_freechunk(FAR struct mm_heap_s *heap,
+                  FAR struct mm_freenode_s *node);
 
 /* Functions contained in kmm_free.c ****************************************/
 
@@ -504,20 +634,66 @@ int kmm_mallinfo(struct mallinfo *info);
 #endif /* CONFIG_CAN_PASS_STRUCTS */
 #endif /* CONFIG_MM_KERNEL_HEAP */
 
+/* Functions contained in mm_foreach.c *************************************/
+
+void mm_foreach(FAR struct mm_heap_s *heap, mm_walker_t walker,
+                FAR void *arg);
+
+/* Functions contained in umm_foreach.c ************************************/
+
+void umm_foreach(mm_walker_t walker, FAR void *arg);
+
+/* Functions contained in kmm_foreach.c ************************************/
+
+#ifdef CONFIG_MM_KERNEL_HEAP
+void kmm_foreach(mm_walker_t walker, FAR void *arg);
+#endif
+
+/* Functions contained in mm_setowner.c ************************************/
+
+#ifdef CONFIG_MM_TRACE
+void mm_setowner(FAR void *mem, FAR void *caller);
+#endif
+
 /* Functions contained in mm_shrinkchunk.c **********************************/
 
 void mm_shrinkchunk(FAR struct mm_heap_s *heap,
                     FAR struct mm_allocnode_s *node, size_t size);
 
-/* Functions contained in mm_addfreechunk.c *********************************/
+/* Functions contained in mm_addfreechunk.c or mm_tlsf.c *******************/
 
 void mm_addfreechunk(FAR struct mm_heap_s *heap,
                      FAR struct mm_freenode_s *node);
 
+/* Functions contained in mm_delfreechunk.c or mm_tlsf.c *******************/
+
+void mm_delfreechunk(FAR struct mm_heap_s *heap,
+                     FAR struct mm_freenode_s *node);
+
+/* Functions contained in mm_findfreechunk.c or mm_tlsf.c ******************/
+
+FAR struct mm_freenode_s *mm_findfreechunk(FAR struct mm_heap_s *heap,
+                                           size_t size);
+
 /* Functions contained in mm_size2ndx.c.c ***********************************/
 
 int mm_size2ndx(size_t size);
 
+/* Functions contained in mm_fastcache.c ************************************/
+
+#ifdef CONFIG_MM_FASTCACHE
+void mm_fastcache_initialize(FAR struct mm_heap_s *heap);
+void mm_fastcache_info(FAR struct mm_heap_s *heap, FAR int *nchunks,
+                       FAR size_t *nbytes);
+#endif
+
+#ifdef MM_USE_FASTCACHE
+FAR void *mm_fastcache_alloc(FAR struct mm_heap_s *heap, size_t size);
+bool mm_fastcache_free(FAR struct mm_heap_s *heap,
+                       FAR struct mm_freenode_s *node);
+int mm_fastcache_flush(FAR struct mm_heap_s *heap);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -962,6 +962,65 @@ ssize_t psock_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
 #define psock_recv(psock,buf,len,flags) \
   psock_recvfrom(psock,buf,len,flags,NULL,0)
 
+/****************************************************************************
+ * Name: psock_udp_sendiob
+ *
+ * Description:
+ *   Send a datagram on a UDP socket without copying it.  This is an
+ *   internal OS interface.  It is functionally equivalent to
+ *   psock_sendto() except that the datagram payload is provided in an I/O
+ *   buffer chain which is queued for transmission as it is.
+ *
+ * Input Parameters:
+ *   psock - A pointer to a NuttX-specific, internal socket structure
+ *   iob   - The I/O buffer chain holding the datagram payload
+ *   to    - Address of recipient (NULL if the socket is connected)
+ *   tolen - The length of the address structure
+ *
+ * Returned Value:
+ *   On success, returns the number of bytes that will be sent.  The I/O
+ *   buffer chain then belongs to the network and must not be accessed
+ *   again.  On any failure, a negated errno value is returned and the I/O
+ *   buffer chain still belongs to the caller.  EOPNOTSUPP is returned if
+ *   the socket is not a UDP socket.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_UDP_ZEROCOPY
+ssize_t psock_udp_sendiob(FAR struct socket *psock, FAR struct iob_s *iob,
+                          FAR const struct sockaddr *to, socklen_t tolen);
+#endif
+
+/****************************************************************************
+ * Name: psock_udp_recviob
+ *
+ * Description:
+ *   Receive a datagram on a UDP socket without copying it.  This is an
+ *   internal OS interface.  It is functionally equivalent to
+ *   psock_recvfrom() except that the datagram payload is returned in the
+ *   I/O buffer chain in which it was received.  The caller must free the
+ *   I/O buffer chain with iob_free_chain() or pass it on to
+ *   psock_udp_sendiob().
+ *
+ * Input Parameters:
+ *   psock   - A pointer to a NuttX-specific, internal socket structure
+ *   iob     - The location to return the I/O buffer chain
+ *   from    - Address of source (may be NULL)
+ *   fromlen - The length of the address structure
+ *
+ * Returned Value:
+ *   On success, returns the size of the datagram.  Otherwise, a negated
+ *   errno value is returned (see comments with recvfrom() for a list of
+ *   appropriate errno values).  EOPNOTSUPP is returned if the socket is
+ *   not a UDP socket.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_UDP_ZEROCOPY
+ssize_t psock_udp_recviob(FAR struct socket *psock, FAR struct iob_s **iob,
+                          FAR struct sockaddr *from, FAR socklen_t *fromlen);
+#endif
+
 /****************************************************************************
  * Name: nx_recvfrom
  *
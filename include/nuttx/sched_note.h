@@ -106,6 +106,10 @@ enum note_type_e
   NOTE_SPINLOCK_UNLOCK = 16,
   NOTE_SPINLOCK_ABORT  = 17
 #endif
+#ifdef CONFIG_SCHED_INSTRUMENTATION_MIGRATION
+  ,
+  NOTE_CPU_MIGRATE     = 18
+#endif
 };
 
 /* This structure provides the common header of each note */
@@ -234,6 +238,16 @@ struct note_spinlock_s
   uint8_t nsp_value;            /* Value of spinlock */
 };
 #endif /* CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS */
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_MIGRATION
+/* This is the specific form of the NOTE_CPU_MIGRATE note */
+
+struct note_cpu_migrate_s
+{
+  struct note_common_s ncm_cmn; /* Common note parameters */
+  uint8_t ncm_target;           /* CPU the thread/task now runs on */
+};
+#endif /* CONFIG_SCHED_INSTRUMENTATION_MIGRATION */
 #endif /* CONFIG_SCHED_INSTRUMENTATION_BUFFER */
 
 /****************************************************************************
@@ -305,6 +319,12 @@ void sched_note_spinabort(FAR struct tcb_s *tcb, FAR volatile void *spinlock);
 #  define sched_note_spinabort(t,s)
 #endif
 
+#ifdef CONFIG_SCHED_INSTRUMENTATION_MIGRATION
+void sched_note_cpu_migrate(FAR struct tcb_s *tcb, int cpu);
+#else
+#  define sched_note_cpu_migrate(t,c)
+#endif
+
 /****************************************************************************
  * Name: sched_note_get
  *
@@ -387,6 +407,7 @@ int note_register(void);
 #  define sched_note_spinlocked(t,s)
 #  define sched_note_spinunlock(t,s)
 #  define sched_note_spinabort(t,s)
+#  define sched_note_cpu_migrate(t,c)
 
 #endif /* CONFIG_SCHED_INSTRUMENTATION */
 #endif /* __INCLUDE_NUTTX_SCHED_NOTE_H */
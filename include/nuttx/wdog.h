@@ -43,6 +43,7 @@
 
 #include <nuttx/config.h>
 
+#include <sys/types.h>
 #include <stdint.h>
 #include <queue.h>
 
@@ -75,19 +76,15 @@
 /* Flag bits for the flags field of struct wdog_s */
 
 #define WDOGF_ACTIVE       (1 << 0) /* Bit 0: 1=Watchdog is actively timing */
-#define WDOGF_ALLOCED      (1 << 1) /* Bit 1: 0=Pre-allocated, 1=Allocated */
-#define WDOGF_STATIC       (1 << 2) /* Bit 2: 0=[Pre-]allocated, 1=Static */
+#define WDOGF_STATIC       (1 << 2) /* Bit 2: 0=Allocated, 1=Static */
 
 #define WDOG_SETACTIVE(w)  do { (w)->flags |= WDOGF_ACTIVE; } while (0)
-#define WDOG_SETALLOCED(w) do { (w)->flags |= WDOGF_ALLOCED; } while (0)
 #define WDOG_SETSTATIC(w)  do { (w)->flags |= WDOGF_STATIC; } while (0)
 
 #define WDOG_CLRACTIVE(w)  do { (w)->flags &= ~WDOGF_ACTIVE; } while (0)
-#define WDOG_CLRALLOCED(w) do { (w)->flags &= ~WDOGF_ALLOCED; } while (0)
 #define WDOG_CLRSTATIC(w)  do { (w)->flags &= ~WDOGF_STATIC; } while (0)
 
 #define WDOG_ISACTIVE(w)   (((w)->flags & WDOGF_ACTIVE) != 0)
-#define WDOG_ISALLOCED(w)  (((w)->flags & WDOGF_ALLOCED) != 0)
 #define WDOG_ISSTATIC(w)   (((w)->flags & WDOGF_STATIC) != 0)
 
 /* Initialization of statically allocated timers ****************************/
@@ -95,7 +92,11 @@
 #define wd_static(w) \
   do { (w)->next = NULL; (w)->flags = WDOGF_STATIC; } while (0)
 
-#ifdef CONFIG_PIC
+#if defined(CONFIG_WDOG_TIMERWHEEL) && defined(CONFIG_PIC)
+#  define WDOG_INITIAILIZER { NULL, NULL, NULL, NULL, 0, WDOGF_STATIC, 0, 0 }
+#elif defined(CONFIG_WDOG_TIMERWHEEL)
+#  define WDOG_INITIAILIZER { NULL, NULL, NULL, 0, WDOGF_STATIC, 0, 0 }
+#elif defined(CONFIG_PIC)
 #  define WDOG_INITIAILIZER { NULL, NULL, NULL, 0, WDOGF_STATIC, 0 }
 #else
 #  define WDOG_INITIAILIZER { NULL, NULL, 0, WDOGF_STATIC, 0 }
@@ -139,13 +140,23 @@ typedef CODE void (*wdentry_t)(int argc, wdparm_t arg1, ...);
 struct wdog_s
 {
   FAR struct wdog_s *next;       /* Support for singly linked lists. */
+#ifdef CONFIG_WDOG_TIMERWHEEL
+  FAR struct wdog_s *prev;       /* Support for removal from a wheel slot */
+#endif
   wdentry_t          func;       /* Function to execute when delay expires */
 #ifdef CONFIG_PIC
   FAR void          *picbase;    /* PIC base address */
 #endif
+#ifdef CONFIG_WDOG_TIMERWHEEL
+  clock_t            expired;    /* Tick count at which the timer expires */
+#else
   int                lag;        /* Timer associated with the delay */
+#endif
   uint8_t            flags;      /* See WDOGF_* definitions above */
   uint8_t            argc;       /* The number of parameters to pass */
+#ifdef CONFIG_WDOG_TIMERWHEEL
+  uint8_t            slot;       /* The timer wheel slot holding the timer */
+#endif
   wdparm_t           parm[CONFIG_MAX_WDOGPARMS];
 };
 
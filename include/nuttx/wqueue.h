@@ -74,6 +74,8 @@
  *   priority worker thread.  Default: 224
  * CONFIG_SCHED_HPWORKSTACKSIZE - The stack size allocated for the worker
  *   thread.  Default: 2048.
+ * CONFIG_SCHED_HPWORK_PERCPU - Create a separate high priority work queue
+ *   for each CPU in the SMP configuration.  Default: n
  * CONFIG_SIG_SIGWORK - The signal number that will be used to wake-up
  *   the worker thread.  Default: 17
  *
@@ -90,6 +92,11 @@
  * CONFIG_SCHED_LPWORKSTACKSIZE - The stack size allocated for the lower
  *   priority worker thread.  Default: 2048.
  *
+ * CONFIG_SCHED_NAMEDWORK - The maximum number of additional kernel work
+ *   queues that may be created with work_create().  Default: 0
+ * CONFIG_SCHED_WORKQUEUE_LATENCY - Record a latency histogram for each
+ *   kernel work queue.  Default: n
+ *
  * The user-mode work queue is only available in the protected or kernel
  * builds.  This those configurations, the user-mode work queue provides the
  * same (non-standard) facility for use by applications.
@@ -222,11 +229,16 @@
  * Kernel Work Queues:
  *   HPWORK: This ID of the high priority work queue that should only be
  *     used for hi-priority, time-critical, driver bottom-half functions.
+ *     If CONFIG_SCHED_HPWORK_PERCPU is selected, then this selects the high
+ *     priority work queue of the CPU that queues the work.
  *
  *   LPWORK: This is the ID of the low priority work queue that can be
  *     used for any purpose.  if CONFIG_SCHED_LPWORK is not defined, then
  *     there is only one kernel work queue and LPWORK == HPWORK.
  *
+ *   NAMEDWORK: The ID of the first work queue created by work_create().
+ *     Subsequent work queues have consecutive IDs.
+ *
  * User Work Queue:
  *   USRWORK:  In the kernel phase a a kernel build, there should be no
  *     references to user-space work queues.  That would be an error.
@@ -251,6 +263,7 @@
 #    define LPWORK HPWORK     /* Redirect low-priority references */
 #  endif
 #  define USRWORK  LPWORK     /* Redirect user-mode references */
+#  define NAMEDWORK 3         /* First named, kernel-mode work queue */
 
 #endif /* CONFIG_LIB_USRWORK && !__KERNEL__ */
 
@@ -276,8 +289,30 @@ struct work_s
   FAR void *arg;         /* Callback argument */
   clock_t qtime;         /* Time work queued */
   clock_t delay;         /* Delay until work performed */
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+  FAR void *wqueue;      /* The work queue that holds the work */
+#endif
+};
+
+/* Describes one kernel work queue as returned by work_foreach() */
+
+struct work_info_s
+{
+  FAR const char *name;  /* Name of the work queue */
+  int qid;               /* Work queue ID */
+  int cpu;               /* CPU of a per-CPU work queue, otherwise -1 */
+  int nthreads;          /* Number of worker threads */
+#ifdef CONFIG_SCHED_WORKQUEUE_LATENCY
+  clock_t maxlat;        /* Largest latency (ticks) */
+  uint32_t latency[CONFIG_SCHED_WORKQUEUE_NLATENCY]; /* See work_foreach() */
+#endif
 };
 
+/* Callback used with work_foreach() */
+
+typedef CODE int (*work_handler_t)(FAR const struct work_info_s *info,
+                                   FAR void *arg);
+
 /* This is an enumeration of the various events that may be
  * notified via work_notifier_signal().
  */
@@ -446,6 +481,80 @@ int work_cancel(int qid, FAR struct work_s *work);
 
 int work_signal(int qid);
 
+/****************************************************************************
+ * Name: work_critmax
+ *
+ * Description:
+ *   Return (and reset) the maximum time that the work queue logic kept
+ *   interrupts disabled, in the units of up_critmon_gettime().  The time
+ *   spent in the worker functions is not included.
+ *
+ * Input Parameters:
+ *   qid    - The work queue ID (HPWORK or LPWORK)
+ *
+ * Returned Value:
+ *   The maximum time or zero if the work queue does not exist.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CRITMONITOR
+uint32_t work_critmax(int qid);
+#endif
+
+/****************************************************************************
+ * Name: work_create
+ *
+ * Description:
+ *   Create an additional kernel work queue with its own pool of worker
+ *   threads.  Work is queued to the new work queue with the returned work
+ *   queue ID.  Named work queues are never deleted.
+ *
+ * Input Parameters:
+ *   name      - The name of the work queue and its worker threads.  The
+ *               string must persist.
+ *   priority  - The priority of the worker threads
+ *   stacksize - The stack size of the worker threads
+ *   nthreads  - The number of worker threads
+ *
+ * Returned Value:
+ *   The work queue ID (NAMEDWORK or above) on success; a negated errno
+ *   value on failure:
+ *
+ *   -EINVAL - An invalid parameter was provided
+ *   -EEXIST - A work queue with this name already exists
+ *   -ENOSPC - CONFIG_SCHED_NAMEDWORK work queues have already been created
+ *   -ENOMEM - Insufficient memory
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SCHED_NAMEDWORK) && CONFIG_SCHED_NAMEDWORK > 0
+int work_create(FAR const char *name, int priority, int stacksize,
+                int nthreads);
+#endif
+
+/****************************************************************************
+ * Name: work_foreach
+ *
+ * Description:
+ *   Call the handler with a description of each kernel work queue.
+ *   Traversal stops if the handler returns a non-zero value.
+ *
+ *   If CONFIG_SCHED_WORKQUEUE_LATENCY is selected, then the description
+ *   includes a histogram of the time from when work was ready to run until
+ *   the worker function was called:  latency[0] counts the work that ran in
+ *   the same clock tick and latency[n] counts latencies of at least
+ *   2^(n-1) but less than 2^n ticks.  The last entry also counts all longer
+ *   latencies.
+ *
+ * Returned Value:
+ *   The last value returned by the handler.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE
+int work_foreach(work_handler_t handler, FAR void *arg);
+#endif
+
 /****************************************************************************
  * Name: work_available
  *
@@ -110,6 +110,13 @@ typedef unsigned int nfds_t;
 
 typedef uint8_t pollevent_t;
 
+/* A callback that may be attached to a struct pollfd.  If present, it is
+ * called by poll_notify() instead of posting the semaphore.
+ */
+
+struct pollfd;
+typedef CODE void (*pollcb_t)(FAR struct pollfd *fds);
+
 /* This is the Nuttx variant of the standard pollfd structure.  The poll()
  * interfaces receive a variable length array of such structures.
  *
@@ -131,6 +138,8 @@ struct pollfd
 
   FAR void    *ptr;     /* The psock or file being polled */
   FAR sem_t   *sem;     /* Pointer to semaphore used to post output event */
+  pollcb_t     cb;      /* Optional callback used instead of the semaphore */
+  FAR void    *arg;     /* For use by the callback */
   FAR void    *priv;    /* For use by drivers */
 };
 
@@ -157,6 +166,32 @@ int ppoll(FAR struct pollfd *fds, nfds_t nfds,
           FAR const struct timespec *timeout_ts,
           FAR const sigset_t *sigmask);
 
+/****************************************************************************
+ * Name: poll_notify
+ *
+ * Description:
+ *   Notify the poll waiters that some of the events of interest have
+ *   occurred.  Drivers should use this instead of posting the poll
+ *   semaphore directly so that a callback attached to the pollfd (as used
+ *   by epoll) is also honored.
+ *
+ * Input Parameters:
+ *   afds     - An array of pointers to the poll structures of the waiters.
+ *              NULL entries are ignored.
+ *   nfds     - The number of entries in the array
+ *   eventset - The events that occurred.  POLLERR and POLLHUP are always
+ *              reported; other events only if they are of interest.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   May be called from interrupt handlers.
+ *
+ ****************************************************************************/
+
+void poll_notify(FAR struct pollfd **afds, int nfds, pollevent_t eventset);
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
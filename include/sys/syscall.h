@@ -395,9 +395,10 @@
 #  define __SYS_sendfile               (__SYS_fs_fdopen + 0)
 #endif
 
-#if defined(CONFIG_NET_SENDFILE)
-#  define SYS_sendfile,                __SYS_sendfile
-#  define __SYS_mountpoint             (__SYS_sendfile + 1)
+#if defined(CONFIG_FS_SENDFILE)
+#  define SYS_sendfile                 (__SYS_sendfile + 0)
+#  define SYS_splice                   (__SYS_sendfile + 1)
+#  define __SYS_mountpoint             (__SYS_sendfile + 2)
 #else
 #  define __SYS_mountpoint             __SYS_sendfile
 #endif
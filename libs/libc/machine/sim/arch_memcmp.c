@@ -0,0 +1,105 @@
+/****************************************************************************
+ * libs/libc/machine/sim/arch_memcmp.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A 128-bit SSE2 register holding 16 bytes that may be loaded from any
+ * address.
+ */
+
+typedef char v16qi_t __attribute__((vector_size(16)));
+typedef char v16qi_u_t __attribute__((vector_size(16), aligned(1)));
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: memcmp
+ *
+ * Description:
+ *   SSE2 implementation of memcmp().  Sixteen bytes are compared at a time
+ *   using unaligned loads.
+ *
+ ****************************************************************************/
+
+int memcmp(FAR const void *s1, FAR const void *s2, size_t n)
+{
+  FAR const unsigned char *p1 = (FAR const unsigned char *)s1;
+  FAR const unsigned char *p2 = (FAR const unsigned char *)s2;
+  unsigned int mask;
+  unsigned int ndx;
+
+  while (n >= 16)
+    {
+      mask = __builtin_ia32_pmovmskb128(
+               (v16qi_t)(*(FAR const v16qi_u_t *)p1 ==
+                         *(FAR const v16qi_u_t *)p2));
+      if (mask != 0xffff)
+        {
+          ndx = __builtin_ctz(~mask);
+          return p1[ndx] < p2[ndx] ? -1 : 1;
+        }
+
+      p1 += 16;
+      p2 += 16;
+      n  -= 16;
+    }
+
+  while (n-- > 0)
+    {
+      if (*p1 != *p2)
+        {
+          return *p1 < *p2 ? -1 : 1;
+        }
+
+      p1++;
+      p2++;
+    }
+
+  return 0;
+}
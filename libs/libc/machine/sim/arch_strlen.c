@@ -0,0 +1,96 @@
+/****************************************************************************
+ * libs/libc/machine/sim/arch_strlen.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A 128-bit SSE2 register holding 16 bytes */
+
+typedef char v16qi_t __attribute__((vector_size(16)));
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: strlen
+ *
+ * Description:
+ *   SSE2 implementation of strlen().  Sixteen bytes are compared with zero
+ *   at a time.  Only aligned 16-byte blocks are read so that no block can
+ *   cross the end of a valid memory region.
+ *
+ ****************************************************************************/
+
+size_t strlen(FAR const char *s)
+{
+  FAR const v16qi_t *p;
+  v16qi_t zero = { 0 };
+  unsigned int off;
+  unsigned int mask;
+
+  /* Compare the aligned block that contains the first byte and ignore the
+   * matches that lie before the start of the string.
+   */
+
+  off  = (uintptr_t)s & 15;
+  p    = (FAR const v16qi_t *)(s - off);
+  mask = __builtin_ia32_pmovmskb128((v16qi_t)(*p == zero)) >> off;
+  if (mask != 0)
+    {
+      return __builtin_ctz(mask);
+    }
+
+  for (; ; )
+    {
+      p++;
+      mask = __builtin_ia32_pmovmskb128((v16qi_t)(*p == zero));
+      if (mask != 0)
+        {
+          return (FAR const char *)p - s + __builtin_ctz(mask);
+        }
+    }
+}
@@ -97,7 +97,7 @@
  *
  ****************************************************************************/
 
-#ifdef CONFIG_NET_SENDFILE
+#ifdef CONFIG_FS_SENDFILE
 ssize_t lib_sendfile(int outfd, int infd, off_t *offset, size_t count)
 #else
 ssize_t sendfile(int outfd, int infd, off_t *offset, size_t count)
@@ -106,6 +106,7 @@ ssize_t sendfile(int outfd, int infd, off_t *offset, size_t count)
   FAR uint8_t *iobuffer;
   FAR uint8_t *wrbuffer;
   off_t startpos = 0;
+  size_t nbytestoread;
   ssize_t nbytesread;
   ssize_t nbyteswritten;
   size_t  ntransferred;
@@ -148,9 +149,17 @@ ssize_t sendfile(int outfd, int infd, off_t *offset, size_t count)
 
       do
         {
-          /* Read a buffer of data from the infd */
+          /* Read a buffer of data from the infd, but no more than the
+           * rest of the transfer.
+           */
+
+          nbytestoread = count - ntransferred;
+          if (nbytestoread > CONFIG_LIB_SENDFILE_BUFSIZE)
+            {
+              nbytestoread = CONFIG_LIB_SENDFILE_BUFSIZE;
+            }
 
-          nbytesread = _NX_READ(infd, iobuffer, CONFIG_LIB_SENDFILE_BUFSIZE);
+          nbytesread = _NX_READ(infd, iobuffer, nbytestoread);
 
           /* Check for end of file */
 
@@ -39,8 +39,11 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
 #include <string.h>
 
+#include "lib_string.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -59,12 +62,40 @@
  *
  ****************************************************************************/
 
+#ifndef CONFIG_LIBC_ARCH_MEMCHR
 FAR void *memchr(FAR const void *s, int c, size_t n)
 {
   FAR const unsigned char *p = (FAR const unsigned char *)s;
 
   if (s)
     {
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+      if (n >= 2 * LIBC_WORDSIZE)
+        {
+          uintptr_t rep = LIBC_REPEAT(c);
+
+          while (!LIBC_ALIGNED(p))
+            {
+              if (*p == (unsigned char)c)
+                {
+                  return (FAR void *)p;
+                }
+
+              p++;
+              n--;
+            }
+
+          /* Skip over words that do not contain the byte */
+
+          while (n >= LIBC_WORDSIZE &&
+                 !LIBC_HASBYTE(*(FAR const uintptr_t *)p, rep))
+            {
+              p += LIBC_WORDSIZE;
+              n -= LIBC_WORDSIZE;
+            }
+        }
+#endif
+
       while (n--)
         {
           if (*p == (unsigned char)c)
@@ -78,3 +109,4 @@ FAR void *memchr(FAR const void *s, int c, size_t n)
 
   return NULL;
 }
+#endif
@@ -39,8 +39,11 @@
 
 #include <nuttx/config.h>
 #include <sys/types.h>
+#include <stdint.h>
 #include <string.h>
 
+#include "lib_string.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -51,6 +54,36 @@ int memcmp(FAR const void *s1, FAR const void *s2, size_t n)
   unsigned char *p1 = (unsigned char *)s1;
   unsigned char *p2 = (unsigned char *)s2;
 
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+  /* Skip over equal words if both buffers are equally aligned.  The
+   * first difference is then located by the byte comparison below.
+   */
+
+  if (n >= 2 * LIBC_WORDSIZE &&
+      (((uintptr_t)p1 ^ (uintptr_t)p2) & LIBC_WORDMASK) == 0)
+    {
+      while (!LIBC_ALIGNED(p1))
+        {
+          if (*p1 != *p2)
+            {
+              return *p1 < *p2 ? -1 : 1;
+            }
+
+          p1++;
+          p2++;
+          n--;
+        }
+
+      while (n >= LIBC_WORDSIZE &&
+             *(FAR const uintptr_t *)p1 == *(FAR const uintptr_t *)p2)
+        {
+          p1 += LIBC_WORDSIZE;
+          p2 += LIBC_WORDSIZE;
+          n  -= LIBC_WORDSIZE;
+        }
+    }
+#endif
+
   while (n-- > 0)
     {
       if (*p1 < *p2)
@@ -39,8 +39,11 @@
 
 #include <nuttx/config.h>
 #include <sys/types.h>
+#include <stdint.h>
 #include <string.h>
 
+#include "lib_string.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -54,6 +57,84 @@ FAR void *memcpy(FAR void *dest, FAR const void *src, size_t n)
 {
   FAR unsigned char *pout = (FAR unsigned char *)dest;
   FAR unsigned char *pin  = (FAR unsigned char *)src;
+
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+  if (n >= 2 * LIBC_WORDSIZE)
+    {
+      FAR uintptr_t *wout;
+      FAR const uintptr_t *win;
+      unsigned int shift;
+
+      /* Copy bytes until the destination is aligned to a word boundary */
+
+      while (!LIBC_ALIGNED(pout))
+        {
+          *pout++ = *pin++;
+          n--;
+        }
+
+      wout  = (FAR uintptr_t *)pout;
+      shift = 8 * ((uintptr_t)pin & LIBC_WORDMASK);
+
+      if (shift == 0)
+        {
+          /* The source is aligned too.  Copy four words at a time, then
+           * one word at a time.
+           */
+
+          win = (FAR const uintptr_t *)pin;
+          while (n >= 4 * LIBC_WORDSIZE)
+            {
+              wout[0] = win[0];
+              wout[1] = win[1];
+              wout[2] = win[2];
+              wout[3] = win[3];
+              wout   += 4;
+              win    += 4;
+              n      -= 4 * LIBC_WORDSIZE;
+            }
+
+          while (n >= LIBC_WORDSIZE)
+            {
+              *wout++ = *win++;
+              n      -= LIBC_WORDSIZE;
+            }
+
+          pin = (FAR unsigned char *)win;
+        }
+      else
+        {
+          uintptr_t w0;
+          uintptr_t w1;
+
+          /* The source is not aligned.  Read aligned source words and
+           * merge each pair of them into one destination word.  Each
+           * aligned word that is read contains at least one of the bytes
+           * to be copied so nothing is read outside of the source buffer.
+           */
+
+          win = (FAR const uintptr_t *)(pin - shift / 8);
+          w0  = *win++;
+
+          while (n >= LIBC_WORDSIZE)
+            {
+              w1 = *win++;
+#ifdef CONFIG_ENDIAN_BIG
+              *wout++ = (w0 << shift) | (w1 >> (LIBC_WORDBITS - shift));
+#else
+              *wout++ = (w0 >> shift) | (w1 << (LIBC_WORDBITS - shift));
+#endif
+              w0  = w1;
+              n  -= LIBC_WORDSIZE;
+            }
+
+          pin = (FAR unsigned char *)win - LIBC_WORDSIZE + shift / 8;
+        }
+
+      pout = (FAR unsigned char *)wout;
+    }
+#endif
+
   while (n-- > 0) *pout++ = *pin++;
   return dest;
 }
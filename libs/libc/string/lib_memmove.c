@@ -39,8 +39,11 @@
 
 #include <nuttx/config.h>
 #include <sys/types.h>
+#include <stdint.h>
 #include <string.h>
 
+#include "lib_string.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -56,6 +59,30 @@ FAR void *memmove(FAR void *dest, FAR const void *src, size_t count)
       tmp = (FAR char *) dest;
       s   = (FAR char *) src;
 
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+      /* Copy words in ascending order if the source and destination are
+       * equally aligned.  Each word is read before it can be overwritten.
+       */
+
+      if (count >= 2 * LIBC_WORDSIZE &&
+          (((uintptr_t)tmp ^ (uintptr_t)s) & LIBC_WORDMASK) == 0)
+        {
+          while (!LIBC_ALIGNED(tmp))
+            {
+              *tmp++ = *s++;
+              count--;
+            }
+
+          while (count >= LIBC_WORDSIZE)
+            {
+              *(FAR uintptr_t *)tmp = *(FAR const uintptr_t *)s;
+              tmp   += LIBC_WORDSIZE;
+              s     += LIBC_WORDSIZE;
+              count -= LIBC_WORDSIZE;
+            }
+        }
+#endif
+
       while (count--)
         {
           *tmp++ = *s++;
@@ -66,6 +93,30 @@ FAR void *memmove(FAR void *dest, FAR const void *src, size_t count)
       tmp = (FAR char *) dest + count;
       s   = (FAR char *) src + count;
 
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+      /* Copy words in descending order if the source and destination are
+       * equally aligned.
+       */
+
+      if (count >= 2 * LIBC_WORDSIZE &&
+          (((uintptr_t)tmp ^ (uintptr_t)s) & LIBC_WORDMASK) == 0)
+        {
+          while (!LIBC_ALIGNED(tmp))
+            {
+              *--tmp = *--s;
+              count--;
+            }
+
+          while (count >= LIBC_WORDSIZE)
+            {
+              tmp   -= LIBC_WORDSIZE;
+              s     -= LIBC_WORDSIZE;
+              count -= LIBC_WORDSIZE;
+              *(FAR uintptr_t *)tmp = *(FAR const uintptr_t *)s;
+            }
+        }
+#endif
+
       while (count--)
         {
           *--tmp = *--s;
@@ -39,8 +39,11 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
 #include <string.h>
 
+#include "lib_string.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -64,9 +67,40 @@ FAR char *strchr(FAR const char *s, int c)
 {
   if (s)
     {
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+      uintptr_t rep = LIBC_REPEAT(c);
+      uintptr_t w;
+
+      for (; !LIBC_ALIGNED(s); s++)
+        {
+          if (*s == (char)c)
+            {
+              return (FAR char *)s;
+            }
+
+          if (!*s)
+            {
+              return NULL;
+            }
+        }
+
+      /* Skip over words that contain neither the character nor the
+       * terminator.
+       */
+
+      for (; ; s += LIBC_WORDSIZE)
+        {
+          w = *(FAR const uintptr_t *)s;
+          if (LIBC_HASZERO(w) || LIBC_HASBYTE(w, rep))
+            {
+              break;
+            }
+        }
+#endif
+
       for (; ; s++)
         {
-          if (*s == c)
+          if (*s == (char)c)
             {
               return (FAR char *)s;
             }
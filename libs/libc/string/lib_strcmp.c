@@ -39,8 +39,11 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
 #include <string.h>
 
+#include "lib_string.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -49,6 +52,35 @@
 int strcmp(FAR const char *cs, FAR const char *ct)
 {
   register signed char result;
+
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+  /* Skip over equal words that do not contain the terminator if both
+   * strings are equally aligned.  The result is then found by the byte
+   * comparison below.
+   */
+
+  if ((((uintptr_t)cs ^ (uintptr_t)ct) & LIBC_WORDMASK) == 0)
+    {
+      for (; !LIBC_ALIGNED(cs); cs++, ct++)
+        {
+          if (*cs != *ct || !*cs)
+            {
+              break;
+            }
+        }
+
+      if (LIBC_ALIGNED(cs))
+        {
+          while (*(FAR const uintptr_t *)cs == *(FAR const uintptr_t *)ct &&
+                 !LIBC_HASZERO(*(FAR const uintptr_t *)cs))
+            {
+              cs += LIBC_WORDSIZE;
+              ct += LIBC_WORDSIZE;
+            }
+        }
+    }
+#endif
+
   for (; ; )
     {
       if ((result = *cs - *ct++) != 0 || !*cs++)
@@ -39,8 +39,11 @@
 
 #include <nuttx/config.h>
 #include <sys/types.h>
+#include <stdint.h>
 #include <string.h>
 
+#include "lib_string.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -49,7 +52,31 @@
 size_t strlen(const char *s)
 {
   const char *sc;
+
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+  /* Check bytes until aligned to a word boundary.  Then skip over words
+   * that do not contain the terminator.  An aligned word never crosses
+   * the end of a valid memory region, so reading beyond the terminator
+   * within the last word is harmless.
+   */
+
+  for (sc = s; !LIBC_ALIGNED(sc); ++sc)
+    {
+      if (*sc == '\0')
+        {
+          return sc - s;
+        }
+    }
+
+  while (!LIBC_HASZERO(*(FAR const uintptr_t *)sc))
+    {
+      sc += LIBC_WORDSIZE;
+    }
+
+  for (; *sc != '\0'; ++sc);
+#else
   for (sc = s; *sc != '\0'; ++sc);
+#endif
   return sc - s;
 }
 #endif
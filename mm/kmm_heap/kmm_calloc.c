@@ -57,7 +57,10 @@
 
 FAR void *kmm_calloc(size_t n, size_t elem_size)
 {
-  return mm_calloc(&g_kmmheap, n, elem_size);
+  FAR void *mem = mm_calloc(&g_kmmheap, n, elem_size);
+
+  MM_SETOWNER(mem);
+  return mem;
 }
 
 #endif /* CONFIG_MM_KERNEL_HEAP */
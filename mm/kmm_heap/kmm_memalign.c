@@ -66,7 +66,10 @@
 
 FAR void *kmm_memalign(size_t alignment, size_t size)
 {
-  return mm_memalign(&g_kmmheap, alignment, size);
+  FAR void *mem = mm_memalign(&g_kmmheap, alignment, size);
+
+  MM_SETOWNER(mem);
+  return mem;
 }
 
 #endif /* CONFIG_MM_KERNEL_HEAP */
@@ -64,7 +64,10 @@
 
 FAR void *kmm_realloc(FAR void *oldmem, size_t newsize)
 {
-  return mm_realloc(&g_kmmheap, oldmem, newsize);
+  FAR void *mem = mm_realloc(&g_kmmheap, oldmem, newsize);
+
+  MM_SETOWNER(mem);
+  return mem;
 }
 
 #endif /* CONFIG_MM_KERNEL_HEAP */
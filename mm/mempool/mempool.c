@@ -0,0 +1,377 @@
+/****************************************************************************
+ * mm/mempool/mempool.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <queue.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/mm/mempool.h>
+
+/* Memory pools are used only by the OS.  They are not available to user
+ * mode code in the PROTECTED and KERNEL builds.
+ */
+
+#if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Free blocks are linked through their first word */
+
+#define MEMPOOL_ALIGN_MASK  (sizeof(FAR void *) - 1)
+#define MEMPOOL_ALIGN_UP(s) (((s) + MEMPOOL_ALIGN_MASK) & ~MEMPOOL_ALIGN_MASK)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The list of all initialized pools */
+
+static FAR struct mempool_s *g_mempools;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mempool_lock and mempool_unlock
+ *
+ * Description:
+ *   Get exclusive access to the pool.  Disabling local interrupts excludes
+ *   interrupt handlers on this CPU;  in the SMP case, the per-pool spinlock
+ *   also excludes the other CPUs.  This is much lighter than a critical
+ *   section and the lock is held only to manipulate the free list.
+ *
+ ****************************************************************************/
+
+static inline irqstate_t mempool_lock(FAR struct mempool_s *pool)
+{
+  irqstate_t flags = up_irq_save();
+
+#ifdef CONFIG_SMP
+  spin_lock(&pool->lock);
+#endif
+  return flags;
+}
+
+static inline void mempool_unlock(FAR struct mempool_s *pool,
+                                  irqstate_t flags)
+{
+#ifdef CONFIG_SMP
+  spin_unlock(&pool->lock);
+#endif
+  up_irq_restore(flags);
+}
+
+/****************************************************************************
+ * Name: mempool_addblocks
+ *
+ * Description:
+ *   Add a contiguous array of nblocks blocks to the free list.  The pool
+ *   must be locked.
+ *
+ ****************************************************************************/
+
+static void mempool_addblocks(FAR struct mempool_s *pool, FAR void *base,
+                              unsigned int nblocks)
+{
+  FAR uint8_t *blk = (FAR uint8_t *)base;
+  unsigned int i;
+
+  for (i = 0; i < nblocks; i++)
+    {
+      sq_addlast((FAR sq_entry_t *)blk, &pool->freelist);
+      blk += pool->bsize;
+    }
+
+  pool->nblocks += nblocks;
+  pool->nfree   += nblocks;
+}
+
+/****************************************************************************
+ * Name: mempool_remblock
+ *
+ * Description:
+ *   Remove one block from the free list and update the statistics.  The
+ *   pool must be locked.
+ *
+ ****************************************************************************/
+
+static FAR void *mempool_remblock(FAR struct mempool_s *pool)
+{
+  FAR void *blk = sq_remfirst(&pool->freelist);
+
+  if (blk != NULL)
+    {
+      unsigned int nused;
+
+      DEBUGASSERT(pool->nfree > 0);
+      pool->nfree--;
+
+      nused = pool->nblocks - pool->nfree;
+      if (nused > pool->maxused)
+        {
+          pool->maxused = nused;
+        }
+    }
+
+  return blk;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mempool_initialize
+ *
+ * Description:
+ *   Initialize a memory pool.  The bsize, ninitial, nreserve, and nexpand
+ *   fields of the pool structure must have been set by the caller.  The
+ *   initial blocks are allocated from the kernel heap as a single chunk
+ *   and the pool is added to the list of pools reported by procfs.
+ *
+ * Input Parameters:
+ *   pool - The pool to be initialized
+ *   name - A name for the pool.  The string must persist.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ * Assumptions:
+ *   Called from task context after the kernel heap has been initialized.
+ *
+ ****************************************************************************/
+
+int mempool_initialize(FAR struct mempool_s *pool, FAR const char *name)
+{
+  irqstate_t flags;
+  FAR void *base;
+
+  DEBUGASSERT(pool != NULL && pool->bsize > 0 &&
+              pool->ninitial >= pool->nreserve);
+
+  if (pool->bsize < sizeof(sq_entry_t))
+    {
+      pool->bsize = sizeof(sq_entry_t);
+    }
+
+  pool->bsize   = MEMPOOL_ALIGN_UP(pool->bsize);
+  pool->name    = name;
+  pool->nblocks = 0;
+  pool->nfree   = 0;
+  pool->maxused = 0;
+  pool->nfail   = 0;
+
+  sq_init(&pool->freelist);
+#ifdef CONFIG_SMP
+  spin_initialize(&pool->lock, SP_UNLOCKED);
+#endif
+
+  if (pool->ninitial > 0)
+    {
+      base = kmm_malloc(pool->bsize * pool->ninitial);
+      if (base == NULL)
+        {
+          merr("ERROR: Failed to allocate %u blocks for %s\n",
+               pool->ninitial, name);
+          return -ENOMEM;
+        }
+
+      mempool_addblocks(pool, base, pool->ninitial);
+    }
+
+  /* Add the pool to the list of all pools.  Pools are never removed from
+   * the list, so it may be traversed without locking.
+   */
+
+  flags       = enter_critical_section();
+  pool->flink = g_mempools;
+  g_mempools  = pool;
+  leave_critical_section(flags);
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: mempool_alloc
+ *
+ * Description:
+ *   Allocate one block from a memory pool.  Interrupt handlers may use any
+ *   free block, including the reserved blocks.  In task context, the pool
+ *   will be expanded from the kernel heap if only reserved blocks remain.
+ *
+ * Input Parameters:
+ *   pool - The pool from which to allocate
+ *
+ * Returned Value:
+ *   The allocated block or NULL if no block is available.
+ *
+ ****************************************************************************/
+
+FAR void *mempool_alloc(FAR struct mempool_s *pool)
+{
+  FAR void *blk = NULL;
+  FAR void *base;
+  irqstate_t flags;
+
+  DEBUGASSERT(pool != NULL);
+
+  flags = mempool_lock(pool);
+  if (pool->nfree > pool->nreserve || up_interrupt_context())
+    {
+      blk = mempool_remblock(pool);
+    }
+
+  /* If we are in a normal tasking context AND there are no unreserved
+   * blocks, then expand the pool from the kernel heap.  The heap must not
+   * be accessed with the pool locked.
+   */
+
+  if (blk == NULL && pool->nexpand > 0 && !up_interrupt_context())
+    {
+      mempool_unlock(pool, flags);
+      base  = kmm_malloc(pool->bsize * pool->nexpand);
+      flags = mempool_lock(pool);
+
+      if (base != NULL)
+        {
+          mempool_addblocks(pool, base, pool->nexpand);
+          blk = mempool_remblock(pool);
+        }
+    }
+
+  if (blk == NULL)
+    {
+      pool->nfail++;
+    }
+
+  mempool_unlock(pool, flags);
+  return blk;
+}
+
+/****************************************************************************
+ * Name: mempool_free
+ *
+ * Description:
+ *   Return a block to the memory pool from which it was allocated.  Blocks
+ *   are never returned to the heap.  This may be called from any context.
+ *
+ * Input Parameters:
+ *   pool - The pool from which the block was allocated
+ *   blk  - The block to be freed
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void mempool_free(FAR struct mempool_s *pool, FAR void *blk)
+{
+  irqstate_t flags;
+
+  DEBUGASSERT(pool != NULL && blk != NULL);
+
+  /* Recently freed blocks are re-used first while they are still cached */
+
+  flags = mempool_lock(pool);
+  sq_addfirst((FAR sq_entry_t *)blk, &pool->freelist);
+  pool->nfree++;
+  DEBUGASSERT(pool->nfree <= pool->nblocks);
+  mempool_unlock(pool, flags);
+}
+
+/****************************************************************************
+ * Name: mempool_info
+ *
+ * Description:
+ *   Return the usage statistics of a memory pool.
+ *
+ ****************************************************************************/
+
+void mempool_info(FAR struct mempool_s *pool,
+                  FAR struct mempoolinfo_s *info)
+{
+  irqstate_t flags;
+
+  DEBUGASSERT(pool != NULL && info != NULL);
+
+  flags         = mempool_lock(pool);
+  info->bsize   = pool->bsize;
+  info->nblocks = pool->nblocks;
+  info->nfree   = pool->nfree;
+  info->maxused = pool->maxused;
+  info->nfail   = pool->nfail;
+  mempool_unlock(pool, flags);
+}
+
+/****************************************************************************
+ * Name: mempool_foreach
+ *
+ * Description:
+ *   Call the handler for each initialized memory pool.  Traversal stops if
+ *   the handler returns a non-zero value.
+ *
+ * Returned Value:
+ *   The last value returned by the handler.
+ *
+ ****************************************************************************/
+
+int mempool_foreach(mempool_handler_t handler, FAR void *arg)
+{
+  FAR struct mempool_s *pool;
+  int ret = OK;
+
+  for (pool = g_mempools; pool != NULL && ret == OK; pool = pool->flink)
+    {
+      ret = handler(pool, arg);
+    }
+
+  return ret;
+}
+
+#endif /* CONFIG_BUILD_FLAT || __KERNEL__ */
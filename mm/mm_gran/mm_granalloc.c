@@ -39,6 +39,7 @@
 
 #include <nuttx/config.h>
 
+#include <strings.h>
 #include <assert.h>
 
 #include <nuttx/mm/gran.h>
@@ -47,6 +48,150 @@
 
 #ifdef CONFIG_GRAN
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: gran_lastused
+ *
+ * Description:
+ *   Check if the ngranules granules beginning with granno are all free.
+ *   The GAT is examined one word at a time, beginning with the last.
+ *
+ * Returned Value:
+ *   -1 if all of the granules are free.  Otherwise, the number of the last
+ *   allocated granule in the range.  No run of free granules of this size
+ *   can begin before the granule that follows it.
+ *
+ ****************************************************************************/
+
+static int gran_lastused(FAR struct gran_s *priv, unsigned int granno,
+                         unsigned int ngranules)
+{
+  unsigned int end = granno + ngranules;
+  unsigned int gatidx;
+  uint32_t     used;
+
+  while (end > granno)
+    {
+      /* Get the allocated granules below 'end' in the last GAT entry */
+
+      gatidx = (end - 1) >> 5;
+      used   = priv->gat[gatidx];
+
+      if ((end & 31) != 0)
+        {
+          used &= 0xffffffff >> (32 - (end & 31));
+        }
+
+      /* Ignore the granules before the beginning of the range */
+
+      if ((gatidx << 5) < granno)
+        {
+          used &= 0xffffffff << (granno & 31);
+        }
+
+      if (used != 0)
+        {
+          return (int)((gatidx << 5) + flsl((long)used) - 1);
+        }
+
+      end = gatidx << 5;
+    }
+
+  return -1;
+}
+
+/****************************************************************************
+ * Name: gran_search
+ *
+ * Description:
+ *   Search the granule allocation table for the first run of ngranules
+ *   free granules.  The search begins at the free hint since all granules
+ *   below it are allocated.  Fully allocated GAT entries are skipped with a
+ *   single comparison, the first free granule within an entry is found
+ *   with ffsl(), and a range that is not entirely free is skipped up to
+ *   its last allocated granule with flsl().
+ *
+ * Input Parameters:
+ *   priv      - The granule heap state structure.
+ *   ngranules - The number of contiguous granules needed
+ *   firstfree - Returns the number of the first free granule, which is a
+ *               new value for the free hint.
+ *
+ * Returned Value:
+ *   The number of the first granule of the run, or -1 if there is no such
+ *   run.
+ *
+ ****************************************************************************/
+
+static int gran_search(FAR struct gran_s *priv, unsigned int ngranules,
+                       FAR unsigned int *firstfree)
+{
+  unsigned int granno = priv->freehint;
+  unsigned int end = priv->ngranules;
+  unsigned int gatidx;
+  uint32_t     avail;
+  int          lastused;
+
+  *firstfree = end;
+
+  while (granno + ngranules <= end)
+    {
+      /* Get the free granules at or after granno in this GAT entry */
+
+      gatidx = granno >> 5;
+      avail  = ~priv->gat[gatidx] & (0xffffffff << (granno & 31));
+
+      if (avail == 0)
+        {
+          /* No free granules here.  Move on to the next GAT entry */
+
+          granno = (gatidx + 1) << 5;
+          continue;
+        }
+
+      /* Find the first free granule and the length of the free run that
+       * begins there.
+       */
+
+      granno = (gatidx << 5) + ffsl((long)avail) - 1;
+      if (granno < *firstfree)
+        {
+          *firstfree = granno;
+        }
+
+      if (granno + ngranules > end)
+        {
+          break;
+        }
+
+      lastused = gran_lastused(priv, granno, ngranules);
+      if (lastused < 0)
+        {
+          return (int)granno;
+        }
+
+      /* The run is too short.  Continue after the last allocated granule
+       * in the range.
+       */
+
+      granno = lastused + 1;
+    }
+
+  /* The granules beyond the last one examined were not searched and may
+   * be free.
+   */
+
+  if (granno < *firstfree)
+    {
+      *firstfree = granno;
+    }
+
+  return -1;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -75,15 +220,10 @@ FAR void *gran_alloc(GRAN_HANDLE handle, size_t size)
 {
   FAR struct gran_s *priv = (FAR struct gran_s *)handle;
   unsigned int ngranules;
+  unsigned int firstfree;
   size_t       tmpmask;
   uintptr_t    alloc;
-  uint32_t     curr;
-  uint32_t     next;
-  uint32_t     mask;
-  int          granidx;
-  int          gatidx;
-  int          bitidx;
-  int          shift;
+  int          granno;
 
   DEBUGASSERT(priv != NULL && size <= 32 * (1 << priv->log2gran));
 
@@ -97,155 +237,35 @@ FAR void *gran_alloc(GRAN_HANDLE handle, size_t size)
 
       tmpmask   = (1 << priv->log2gran) - 1;
       ngranules = (size + tmpmask) >> priv->log2gran;
-
-      /* Then create mask for that number of granules */
-
       DEBUGASSERT(ngranules <= 32);
-      mask = 0xffffffff >> (32 - ngranules);
-
-      /* Now search the granule allocation table for that number of contiguous */
 
-      alloc = priv->heapstart;
+      /* Now search the granule allocation table for that number of
+       * contiguous free granules.
+       */
 
-      for (granidx = 0; granidx < priv->ngranules; granidx += 32)
-        {
-          /* Get the GAT index associated with the granule table entry */
-
-          gatidx = granidx >> 5;
-          curr = priv->gat[gatidx];
+      granno = gran_search(priv, ngranules, &firstfree);
 
-          /* Handle the case where there are no free granules in the entry */
+      /* Advance the free hint past the granules that are now known to be
+       * allocated.
+       */
 
-          if (curr == 0xffffffff)
-            {
-              alloc += (32 << priv->log2gran);
-              continue;
-            }
+      priv->freehint = firstfree;
+      if (granno >= 0)
+        {
+          /* Mark these granules allocated */
 
-          /* Get the next entry from the GAT to support a 64 bit shift */
+          alloc = priv->heapstart + ((uintptr_t)granno << priv->log2gran);
+          gran_mark_allocated(priv, alloc, ngranules);
 
-          if (granidx < priv->ngranules)
+          if ((unsigned int)granno == firstfree)
             {
-              next = priv->gat[gatidx + 1];
+              priv->freehint = granno + ngranules;
             }
 
-          /* Use all ones when are at the last entry in the GAT (meaning
-           * nothing can be allocated.
-           */
+          /* And return the allocation address */
 
-          else
-            {
-              next = 0xffffffff;
-            }
-
-          /* Search through the allocations in the 'curr' GAT entry
-           * to see if we can satisfy the allocation starting in that
-           * entry.
-           *
-           * This loop continues until either all of the bits have been
-           * examined (bitidx >= 32), or until there are insufficient
-           * granules left to satisfy the allocation.
-           */
-
-          for (bitidx = 0;
-               bitidx < 32 && (granidx + bitidx + ngranules) <= priv->ngranules;
-              )
-            {
-              /* Break out if there are no further free bits in 'curr'.
-               * All of the zero bits might have gotten shifted out.
-               */
-
-              if (curr == 0xffffffff)
-                {
-                  break;
-                }
-
-              /* Check for the first zero bit in the lower or upper 16-bits.
-               * From the test above, we know that at least one of the 32-
-               * bits in 'curr' is zero.
-               */
-
-              else if ((curr & 0x0000ffff) == 0x0000ffff)
-                {
-                  /* Not in the lower 16 bits.  The first free bit must be
-                   * in the upper 16 bits.
-                   */
-
-                  shift = 16;
-                }
-
-              /* We know that the first free bit is now within the lower 16
-               * bits of 'curr'.  Is it in the upper or lower byte?
-               */
-
-              else if ((curr & 0x0000ff) == 0x000000ff)
-                {
-                  /* Not in the lower 8 bits.  The first free bit must be in
-                   * the upper 8 bits.
-                   */
-
-                  shift = 8;
-                }
-
-              /* We know that the first free bit is now within the lower 4
-               * bits of 'curr'.  Is it in the upper or lower nibble?
-               */
-
-              else if ((curr & 0x00000f) == 0x0000000f)
-                {
-                  /* Not in the lower 4 bits.  The first free bit must be in
-                   * the upper 4 bits.
-                   */
-
-                  shift = 4;
-                }
-
-              /* We know that the first free bit is now within the lower 4 bits
-               * of 'curr'.  Is it in the upper or lower pair?
-               */
-
-              else if ((curr & 0x000003) == 0x00000003)
-                {
-                  /* Not in the lower 2 bits.  The first free bit must be in
-                   * the upper 2 bits.
-                   */
-
-                  shift = 2;
-                }
-
-              /* We know that the first free bit is now within the lower 4 bits
-               * of 'curr'.  Check if we have the allocation at this bit position.
-               */
-
-              else if ((curr & mask) == 0)
-                {
-                  /* Yes.. mark these granules allocated */
-
-                  gran_mark_allocated(priv, alloc, ngranules);
-
-                  /* And return the allocation address */
-
-                  gran_leave_critical(priv);
-                  return (FAR void *)alloc;
-                }
-
-              /* The free allocation does not start at this position */
-
-              else
-                {
-                  shift = 1;
-                }
-
-              /* Set up for the next time through the loop.  Perform a 64
-               * bit shift to move to the next gran position and increment
-               * to the next candidate allocation address.
-               */
-
-              alloc  += (shift << priv->log2gran);
-              curr    = (curr >> shift) | (next << (32 - shift));
-              next  >>= shift;
-              bitidx += shift;
-            }
+          gran_leave_critical(priv);
+          return (FAR void *)alloc;
         }
 
       gran_leave_critical(priv);
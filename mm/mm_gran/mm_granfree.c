@@ -133,6 +133,13 @@ void gran_free(GRAN_HANDLE handle, FAR void *memory, size_t size)
       priv->gat[gatidx] &= ~gatmask;
     }
 
+  /* Keep the free hint at or below the first free granule */
+
+  if (granno < priv->freehint)
+    {
+      priv->freehint = granno;
+    }
+
   gran_leave_critical(priv);
 }
 
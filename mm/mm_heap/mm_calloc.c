@@ -73,5 +73,6 @@ FAR void *mm_calloc(FAR struct mm_heap_s *heap, size_t n, size_t elem_size)
         }
     }
 
+  MM_SETOWNER(ret);
   return ret;
 }
@@ -0,0 +1,389 @@
+/****************************************************************************
+ * mm/mm_heap/mm_fastcache.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/mm/mm.h>
+
+#ifdef CONFIG_MM_FASTCACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The largest chunk (including the chunk header) that may be returned by
+ * mm_fastcache_alloc().  Larger chunks may be held in the last size class,
+ * but those can satisfy only requests of up to this size.
+ */
+
+#define MM_FASTCACHE_MAXALLOC \
+  ((size_t)MM_MIN_CHUNK << (CONFIG_MM_FASTCACHE_NCLASSES - 1))
+
+/* The smallest chunk that is too large to be cached */
+
+#define MM_FASTCACHE_LIMIT \
+  ((size_t)MM_MIN_CHUNK << CONFIG_MM_FASTCACHE_NCLASSES)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#ifdef MM_USE_FASTCACHE
+
+/****************************************************************************
+ * Name: mm_fastcache_lock and mm_fastcache_unlock
+ *
+ * Description:
+ *   Get exclusive access to the cache of the current CPU.  Disabling local
+ *   interrupts keeps this thread on this CPU and also excludes interrupt
+ *   handlers on this CPU.  In the SMP case, the per-CPU spinlock is also
+ *   needed to exclude mm_fastcache_flush() running on some other CPU.
+ *   That spinlock is only contended during a flush.
+ *
+ ****************************************************************************/
+
+static FAR struct mm_fastcache_s *
+mm_fastcache_lock(FAR struct mm_heap_s *heap, FAR irqstate_t *flags)
+{
+  FAR struct mm_fastcache_s *cache;
+
+  *flags = up_irq_save();
+  cache  = &heap->mm_fastcache[up_cpu_index()];
+
+#ifdef CONFIG_SMP
+  spin_lock(&cache->fc_lock);
+#endif
+  return cache;
+}
+
+static inline void mm_fastcache_unlock(FAR struct mm_fastcache_s *cache,
+                                       irqstate_t flags)
+{
+#ifdef CONFIG_SMP
+  spin_unlock(&cache->fc_lock);
+#endif
+  up_irq_restore(flags);
+}
+
+#endif /* MM_USE_FASTCACHE */
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_fastcache_initialize
+ *
+ * Description:
+ *   Initialize the per-CPU chunk caches of the selected heap.  All caches
+ *   are initially empty.
+ *
+ ****************************************************************************/
+
+void mm_fastcache_initialize(FAR struct mm_heap_s *heap)
+{
+  int cpu;
+
+  memset(heap->mm_fastcache, 0, sizeof(heap->mm_fastcache));
+
+#ifdef CONFIG_SMP
+  for (cpu = 0; cpu < MM_FASTCACHE_NCPUS; cpu++)
+    {
+      spin_initialize(&heap->mm_fastcache[cpu].fc_lock, SP_UNLOCKED);
+    }
+#else
+  UNUSED(cpu);
+#endif
+}
+
+#ifdef MM_USE_FASTCACHE
+
+/****************************************************************************
+ * Name: mm_fastcache_alloc
+ *
+ * Description:
+ *   Try to satisfy an allocation from the cache of the current CPU.  The
+ *   heap semaphore is not taken.
+ *
+ * Input Parameters:
+ *   heap - The selected heap
+ *   size - The aligned chunk size, including the chunk header
+ *
+ * Returned Value:
+ *   A pointer to the allocated memory (just beyond the chunk header) or
+ *   NULL if there is no suitable chunk in the cache.
+ *
+ ****************************************************************************/
+
+FAR void *mm_fastcache_alloc(FAR struct mm_heap_s *heap, size_t size)
+{
+  FAR struct mm_fastcache_s *cache;
+  FAR struct mm_freenode_s *node;
+  irqstate_t flags;
+  int ndx;
+
+  if (size > MM_FASTCACHE_MAXALLOC)
+    {
+      return NULL;
+    }
+
+  /* Every chunk in size class ndx is at least (MM_MIN_CHUNK << ndx) bytes.
+   * Round the request up to the first class where every chunk is large
+   * enough.
+   */
+
+  ndx = mm_size2ndx(size);
+  if (size > ((size_t)MM_MIN_CHUNK << ndx))
+    {
+      ndx++;
+    }
+
+  cache = mm_fastcache_lock(heap, &flags);
+
+  node = cache->fc_head[ndx];
+  if (node != NULL)
+    {
+      DEBUGASSERT((node->preceding & MM_ALLOC_BIT) != 0 &&
+                  node->size >= size);
+
+      cache->fc_head[ndx] = node->flink;
+      cache->fc_count[ndx]--;
+      cache->fc_bytes    -= node->size;
+    }
+
+  mm_fastcache_unlock(cache, flags);
+
+  if (node == NULL)
+    {
+      return NULL;
+    }
+
+  return (FAR void *)((FAR char *)node + SIZEOF_MM_ALLOCNODE);
+}
+
+/****************************************************************************
+ * Name: mm_fastcache_free
+ *
+ * Description:
+ *   Try to retain a freed chunk in the cache of the current CPU.  The chunk
+ *   remains marked as allocated in the heap.  The heap semaphore is not
+ *   taken.
+ *
+ * Input Parameters:
+ *   heap - The selected heap
+ *   node - The allocated chunk being freed
+ *
+ * Returned Value:
+ *   True if the chunk was cached; false if the chunk is too large or if
+ *   its size class is already full.  In the latter case, the caller must
+ *   return the chunk to the heap.
+ *
+ ****************************************************************************/
+
+bool mm_fastcache_free(FAR struct mm_heap_s *heap,
+                       FAR struct mm_freenode_s *node)
+{
+  FAR struct mm_fastcache_s *cache;
+#ifdef CONFIG_DEBUG_ASSERTIONS
+  FAR struct mm_freenode_s *tmp;
+#endif
+  irqstate_t flags;
+  bool cached = false;
+  int ndx;
+
+  DEBUGASSERT((node->preceding & MM_ALLOC_BIT) != 0);
+
+  if (node->size >= MM_FASTCACHE_LIMIT)
+    {
+      return false;
+    }
+
+  ndx   = mm_size2ndx(node->size);
+  cache = mm_fastcache_lock(heap, &flags);
+
+#ifdef CONFIG_DEBUG_ASSERTIONS
+  /* A cached chunk is still marked as allocated so the heap cannot detect
+   * that it is freed twice.  Check that it is not already in this class.
+   * A chunk held in the cache of some other CPU is not detected.
+   */
+
+  for (tmp = cache->fc_head[ndx]; tmp != NULL; tmp = tmp->flink)
+    {
+      DEBUGASSERT(tmp != node);
+    }
+#endif
+
+  if (cache->fc_count[ndx] < CONFIG_MM_FASTCACHE_DEPTH)
+    {
+      node->flink          = cache->fc_head[ndx];
+      cache->fc_head[ndx]  = node;
+      cache->fc_count[ndx]++;
+      cache->fc_bytes     += node->size;
+      cached               = true;
+
+#ifdef CONFIG_MM_TRACE
+      /* A cached chunk no longer belongs to the task that freed it */
+
+      node->pid            = MM_OWNER_CACHED;
+#endif
+    }
+
+  mm_fastcache_unlock(cache, flags);
+  return cached;
+}
+
+/****************************************************************************
+ * Name: mm_fastcache_flush
+ *
+ * Description:
+ *   Return all chunks held in the caches of every CPU to the heap.  This
+ *   is done automatically when an allocation cannot otherwise be
+ *   satisfied, but may also be used to reduce fragmentation before a large
+ *   allocation.
+ *
+ * Input Parameters:
+ *   heap - The selected heap
+ *
+ * Returned Value:
+ *   The number of chunks that were returned to the heap.
+ *
+ ****************************************************************************/
+
+int mm_fastcache_flush(FAR struct mm_heap_s *heap)
+{
+  FAR struct mm_freenode_s *list = NULL;
+  FAR struct mm_freenode_s *node;
+  FAR struct mm_freenode_s *next;
+  irqstate_t flags;
+  int nflushed = 0;
+  int cpu;
+  int ndx;
+
+  /* Detach the contents of each cache, one CPU at a time */
+
+  for (cpu = 0; cpu < MM_FASTCACHE_NCPUS; cpu++)
+    {
+      FAR struct mm_fastcache_s *cache = &heap->mm_fastcache[cpu];
+
+      flags = up_irq_save();
+#ifdef CONFIG_SMP
+      spin_lock(&cache->fc_lock);
+#endif
+
+      for (ndx = 0; ndx < CONFIG_MM_FASTCACHE_NCLASSES; ndx++)
+        {
+          for (node = cache->fc_head[ndx]; node != NULL; node = next)
+            {
+              next        = node->flink;
+              node->flink = list;
+              list        = node;
+            }
+
+          cache->fc_head[ndx]  = NULL;
+          cache->fc_count[ndx] = 0;
+        }
+
+      cache->fc_bytes = 0;
+
+#ifdef CONFIG_SMP
+      spin_unlock(&cache->fc_lock);
+#endif
+      up_irq_restore(flags);
+    }
+
+  /* Then return the detached chunks to the heap */
+
+  if (list != NULL)
+    {
+      mm_takesemaphore(heap);
+
+      for (node = list; node != NULL; node = next)
+        {
+          next = node->flink;
+          mm_freechunk(heap, node);
+          nflushed++;
+        }
+
+      mm_givesemaphore(heap);
+    }
+
+  minfo("Flushed %d chunks\n", nflushed);
+  return nflushed;
+}
+
+#endif /* MM_USE_FASTCACHE */
+
+/****************************************************************************
+ * Name: mm_fastcache_info
+ *
+ * Description:
+ *   Return the number of chunks and the total number of bytes currently
+ *   held in the caches of all CPUs.  These are still marked as allocated
+ *   in the heap, but are available for allocation.
+ *
+ ****************************************************************************/
+
+void mm_fastcache_info(FAR struct mm_heap_s *heap, FAR int *nchunks,
+                       FAR size_t *nbytes)
+{
+  int cpu;
+  int ndx;
+
+  *nchunks = 0;
+  *nbytes  = 0;
+
+  for (cpu = 0; cpu < MM_FASTCACHE_NCPUS; cpu++)
+    {
+      FAR struct mm_fastcache_s *cache = &heap->mm_fastcache[cpu];
+
+      for (ndx = 0; ndx < CONFIG_MM_FASTCACHE_NCLASSES; ndx++)
+        {
+          *nchunks += cache->fc_count[ndx];
+        }
+
+      *nbytes += cache->fc_bytes;
+    }
+}
+
+#endif /* CONFIG_MM_FASTCACHE */
@@ -55,73 +55,33 @@
 #endif
 
 /****************************************************************************
- * Public Functions
+ * Private Functions
  ****************************************************************************/
 
 /****************************************************************************
- * Name: mm_malloc
+ * Name: mm_allocchunk
  *
  * Description:
- *  Find the smallest chunk that satisfies the request. Take the memory from
- *  that chunk, save the remaining, smaller chunk (if any).
- *
- *  8-byte alignment of the allocated data is assured.
+ *  Find the smallest free chunk that can hold 'alignsize' bytes, remove it
+ *  from the nodelist and mark it as allocated.  Any remainder is returned
+ *  to the nodelist.
  *
  ****************************************************************************/
 
-FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
+static FAR void *mm_allocchunk(FAR struct mm_heap_s *heap, size_t alignsize)
 {
   FAR struct mm_freenode_s *node;
-  size_t alignsize;
   void *ret = NULL;
-  int ndx;
-
-  /* Ignore zero-length allocations */
-
-  if (size < 1)
-    {
-      return NULL;
-    }
-
-  /* Adjust the size to account for (1) the size of the allocated node and
-   * (2) to make sure that it is an even multiple of our granule size.
-   */
-
-  alignsize = MM_ALIGN_UP(size + SIZEOF_MM_ALLOCNODE);
-  DEBUGASSERT(alignsize >= size);  /* Check for integer overflow */
 
   /* We need to hold the MM semaphore while we muck with the nodelist. */
 
   mm_takesemaphore(heap);
 
-  /* Get the location in the node list to start the search. Special case
-   * really big allocations
-   */
+  /* Find a free chunk that is large enough */
 
-  if (alignsize >= MM_MAX_CHUNK)
-    {
-      ndx = MM_NNODES-1;
-    }
-  else
-    {
-      /* Convert the request size into a nodelist index */
+  node = mm_findfreechunk(heap, alignsize);
 
-      ndx = mm_size2ndx(alignsize);
-    }
-
-  /* Search for a large enough chunk in the list of nodes. This list is
-   * ordered by size, but will have occasional zero sized nodes as we visit
-   * other mm_nodelist[] entries.
-   */
-
-  for (node = heap->mm_nodelist[ndx].flink;
-       node && node->size < alignsize;
-       node = node->flink);
-
-  /* If we found a node with non-zero size, then this is one to use. Since
-   * the list is ordered, we know that is must be best fitting chunk
-   * available.
-   */
+  /* If we found a node, then this is the one to use. */
 
   if (node)
     {
@@ -129,16 +89,9 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
       FAR struct mm_freenode_s *next;
       size_t remaining;
 
-      /* Remove the node.  There must be a predecessor, but there may not be
-       * a successor node.
-       */
+      /* Remove the node from the free list */
 
-      DEBUGASSERT(node->blink);
-      node->blink->flink = node->flink;
-      if (node->flink)
-        {
-          node->flink->blink = node->blink;
-        }
+      mm_delfreechunk(heap, node);
 
       /* Check if we have to split the free node into one of the allocated
        * size and another smaller freenode.  In some cases, the remaining
@@ -184,6 +137,66 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
     }
 
   mm_givesemaphore(heap);
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_malloc
+ *
+ * Description:
+ *  Find the smallest chunk that satisfies the request. Take the memory from
+ *  that chunk, save the remaining, smaller chunk (if any).
+ *
+ *  8-byte alignment of the allocated data is assured.
+ *
+ ****************************************************************************/
+
+FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
+{
+  size_t alignsize;
+  void *ret = NULL;
+
+  /* Ignore zero-length allocations */
+
+  if (size < 1)
+    {
+      return NULL;
+    }
+
+  /* Adjust the size to account for (1) the size of the allocated node and
+   * (2) to make sure that it is an even multiple of our granule size.
+   */
+
+  alignsize = MM_ALIGN_UP(size + SIZEOF_MM_ALLOCNODE);
+  if (alignsize < size)
+    {
+      /* There was an integer overflow */
+
+      return NULL;
+    }
+
+#ifdef MM_USE_FASTCACHE
+  /* Try the per-CPU cache of small chunks first.  If there is nothing
+   * suitable there, then fall back to the heap.  If the heap is also
+   * exhausted, return all cached chunks to the heap and try once more.
+   */
+
+  ret = mm_fastcache_alloc(heap, alignsize);
+  if (ret == NULL)
+    {
+      ret = mm_allocchunk(heap, alignsize);
+      if (ret == NULL && mm_fastcache_flush(heap) > 0)
+        {
+          ret = mm_allocchunk(heap, alignsize);
+        }
+    }
+#else
+  ret = mm_allocchunk(heap, alignsize);
+#endif
 
 #ifdef CONFIG_MM_FILL_ALLOCATIONS
   if (ret)
@@ -192,6 +205,10 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
     }
 #endif
 
+  /* Record the owner of the allocated chunk */
+
+  MM_SETOWNER(ret);
+
   /* If CONFIG_DEBUG_MM is defined, then output the result of the allocation
    * to the SYSLOG.
    */
@@ -75,7 +75,9 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
 
   if (alignment <= MM_MIN_CHUNK)
     {
-      return mm_malloc(heap, size);
+      FAR void *mem = mm_malloc(heap, size);
+      MM_SETOWNER(mem);
+      return mem;
     }
 
   /* Adjust the size to account for (1) the size of the allocated node, (2)
@@ -206,5 +208,9 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
     }
 
   mm_givesemaphore(heap);
+
+  /* Record the owner of the allocated chunk */
+
+  MM_SETOWNER((FAR void *)alignedchunk);
   return (FAR void *)alignedchunk;
 }
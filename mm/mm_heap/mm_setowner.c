@@ -0,0 +1,84 @@
+/****************************************************************************
+ * mm/mm_heap/mm_setowner.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <unistd.h>
+
+#include <nuttx/mm/mm.h>
+
+#ifdef CONFIG_MM_TRACE
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_setowner
+ *
+ * Description:
+ *   Record the calling task and the address of the caller in the header of
+ *   an allocated chunk.  Each allocation interface does this on return so
+ *   that the outermost interface determines the recorded address.  The
+ *   heap need not be locked since the caller owns the chunk.
+ *
+ * Input Parameters:
+ *   mem    - The allocated memory (may be NULL)
+ *   caller - The address from which the memory was allocated
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void mm_setowner(FAR void *mem, FAR void *caller)
+{
+  FAR struct mm_allocnode_s *node;
+
+  if (mem != NULL)
+    {
+      node = (FAR struct mm_allocnode_s *)
+        ((FAR char *)mem - SIZEOF_MM_ALLOCNODE);
+
+      node->pid    = getpid();
+      node->caller = caller;
+    }
+}
+
+#endif /* CONFIG_MM_TRACE */
@@ -0,0 +1,243 @@
+/****************************************************************************
+ * mm/mm_heap/mm_tlsf.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <strings.h>
+#include <assert.h>
+
+#include <nuttx/mm/mm.h>
+
+#ifdef CONFIG_MM_TLSF
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_mapping
+ *
+ * Description:
+ *   Map a chunk size to the indices of the free list that holds chunks of
+ *   that size.  The first level index selects the power of two that
+ *   contains 'size'; the second level index selects one of MM_SLI_COUNT
+ *   equal parts of that power of two.
+ *
+ ****************************************************************************/
+
+static inline void mm_mapping(size_t size, FAR int *fl, FAR int *sl)
+{
+  int msb = flsl((long)size) - 1;
+
+  if (msb >= MM_SLI_SHIFT)
+    {
+      *sl = (int)(size >> (msb - MM_SLI_SHIFT)) - MM_SLI_COUNT;
+    }
+  else
+    {
+      *sl = (int)(size << (MM_SLI_SHIFT - msb)) - MM_SLI_COUNT;
+    }
+
+  *fl = msb - MM_MIN_SHIFT;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_addfreechunk
+ *
+ * Description:
+ *   Add a free chunk to the head of the free list for its size and mark
+ *   that list as non-empty.  It is assumed that the caller holds the mm
+ *   semaphore
+ *
+ ****************************************************************************/
+
+void mm_addfreechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
+{
+  FAR struct mm_freenode_s *head;
+  int fl;
+  int sl;
+
+  mm_mapping(node->size, &fl, &sl);
+  DEBUGASSERT(fl >= 0 && fl < MM_FLI_COUNT);
+
+  head        = heap->mm_freelist[fl][sl];
+  node->blink = NULL;
+  node->flink = head;
+
+  if (head)
+    {
+      head->blink = node;
+    }
+
+  heap->mm_freelist[fl][sl] = node;
+  heap->mm_flbitmap        |= (uint32_t)1 << fl;
+  heap->mm_slbitmap[fl]    |= (uint32_t)1 << sl;
+}
+
+/****************************************************************************
+ * Name: mm_delfreechunk
+ *
+ * Description:
+ *   Remove a free chunk from the free list for its size, marking the list
+ *   as empty if that was the last chunk.  The chunk size must not have
+ *   been changed since the chunk was added.  It is assumed that the caller
+ *   holds the mm semaphore
+ *
+ ****************************************************************************/
+
+void mm_delfreechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
+{
+  int fl;
+  int sl;
+
+  mm_mapping(node->size, &fl, &sl);
+
+  if (node->blink)
+    {
+      node->blink->flink = node->flink;
+    }
+  else
+    {
+      DEBUGASSERT(heap->mm_freelist[fl][sl] == node);
+      heap->mm_freelist[fl][sl] = node->flink;
+    }
+
+  if (node->flink)
+    {
+      node->flink->blink = node->blink;
+    }
+
+  /* Was this the last chunk in the list? */
+
+  if (heap->mm_freelist[fl][sl] == NULL)
+    {
+      heap->mm_slbitmap[fl] &= ~((uint32_t)1 << sl);
+      if (heap->mm_slbitmap[fl] == 0)
+        {
+          heap->mm_flbitmap &= ~((uint32_t)1 << fl);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: mm_findfreechunk
+ *
+ * Description:
+ *   Find a free chunk of at least 'size' bytes.  The request is rounded up
+ *   to the next free list boundary so that any chunk in the selected list
+ *   is large enough; the bitmaps then give the first non-empty list at or
+ *   above that one in constant time.  As a consequence, a request may
+ *   fail even though a large enough chunk is in the list that 'size'
+ *   maps to.  The chunk is not removed from the free list.  It is assumed
+ *   that the caller holds the mm semaphore
+ *
+ ****************************************************************************/
+
+FAR struct mm_freenode_s *mm_findfreechunk(FAR struct mm_heap_s *heap,
+                                           size_t size)
+{
+  uint32_t bitmap;
+  size_t search;
+  int msb;
+  int fl;
+  int sl;
+
+  if (size > MMSIZE_MAX)
+    {
+      return NULL;
+    }
+
+  /* Round the request up to the next free list boundary */
+
+  msb    = flsl((long)size) - 1;
+  search = size;
+
+  if (msb >= MM_SLI_SHIFT)
+    {
+      search += ((size_t)1 << (msb - MM_SLI_SHIFT)) - 1;
+    }
+
+  /* Fail if rounding up wrapped around */
+
+  if (search < size)
+    {
+      return NULL;
+    }
+
+  mm_mapping(search, &fl, &sl);
+  if (fl < MM_FLI_COUNT)
+    {
+      /* Is there a non-empty list in the same power of two? */
+
+      bitmap = heap->mm_slbitmap[fl] & ((uint32_t)~0 << sl);
+      if (bitmap == 0)
+        {
+          /* No.. use the smallest non-empty list of a larger power of two */
+
+          bitmap = heap->mm_flbitmap & ((uint32_t)~0 << (fl + 1));
+          if (bitmap != 0)
+            {
+              fl     = ffs(bitmap) - 1;
+              bitmap = heap->mm_slbitmap[fl];
+            }
+        }
+
+      if (bitmap != 0)
+        {
+          sl = ffs(bitmap) - 1;
+          DEBUGASSERT(heap->mm_freelist[fl][sl] != NULL &&
+                      heap->mm_freelist[fl][sl]->size >= size);
+          return heap->mm_freelist[fl][sl];
+        }
+    }
+
+  /* There is no list where every chunk is large enough.  The list that
+   * 'size' itself maps to may still hold a chunk that would do, but it is
+   * not searched:  That would take time proportional to the length of the
+   * list.
+   */
+
+  return NULL;
+}
+
+#endif /* CONFIG_MM_TLSF */
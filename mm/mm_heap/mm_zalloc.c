@@ -63,5 +63,6 @@ FAR void *mm_zalloc(FAR struct mm_heap_s *heap, size_t size)
        memset(alloc, 0, size);
     }
 
+  MM_SETOWNER(alloc);
   return alloc;
 }
@@ -80,11 +80,15 @@ FAR void *calloc(size_t n, size_t elem_size)
         }
     }
 
+  MM_SETOWNER(ret);
   return ret;
 
 #else
   /* Use mm_calloc() because it implements the clear */
 
-  return mm_calloc(USR_HEAP, n, elem_size);
+  FAR void *mem = mm_calloc(USR_HEAP, n, elem_size);
+
+  MM_SETOWNER(mem);
+  return mem;
 #endif
 }
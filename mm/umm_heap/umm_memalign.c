@@ -94,8 +94,12 @@ FAR void *memalign(size_t alignment, size_t size)
     }
   while (mem == NULL);
 
+  MM_SETOWNER(mem);
   return mem;
 #else
-  return mm_memalign(USR_HEAP, alignment, size);
+  FAR void *mem = mm_memalign(USR_HEAP, alignment, size);
+
+  MM_SETOWNER(mem);
+  return mem;
 #endif
 }
@@ -96,8 +96,12 @@ FAR void *realloc(FAR void *oldmem, size_t size)
     }
   while (mem == NULL);
 
+  MM_SETOWNER(mem);
   return mem;
 #else
-  return mm_realloc(USR_HEAP, oldmem, size);
+  FAR void *mem = mm_realloc(USR_HEAP, oldmem, size);
+
+  MM_SETOWNER(mem);
+  return mem;
 #endif
 }
@@ -75,11 +75,15 @@ FAR void *zalloc(size_t size)
        memset(alloc, 0, size);
     }
 
+  MM_SETOWNER(alloc);
   return alloc;
 
 #else
   /* Use mm_zalloc() because it implements the clear */
 
-  return mm_zalloc(USR_HEAP, size);
+  FAR void *mem = mm_zalloc(USR_HEAP, size);
+
+  MM_SETOWNER(mem);
+  return mem;
 #endif
 }
@@ -167,6 +167,20 @@ struct arp_notify_s
  ****************************************************************************/
 
 #ifdef CONFIG_NET_ARP
+/****************************************************************************
+ * Name: arp_initialize
+ *
+ * Description:
+ *   Initialize the ARP table lock.  Called once from net_initialize().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ARP_RWLOCK
+void arp_initialize(void);
+#else
+#  define arp_initialize()
+#endif
+
 /****************************************************************************
  * Name: arp_format
  *
@@ -317,23 +331,6 @@ void arp_notify(in_addr_t ipaddr);
 #  define arp_notify(i)
 #endif
 
-/****************************************************************************
- * Name: arp_lookup
- *
- * Description:
- *   Find the ARP entry corresponding to this IP address in the ARP table.
- *
- * Input Parameters:
- *   ipaddr - Refers to an IP address in network order
- *
- * Assumptions:
- *   The network is locked to assure exclusive access to the ARP table.
- *   The return value will become unstable when the network is unlocked.
- *
- ****************************************************************************/
-
-FAR struct arp_entry_s *arp_lookup(in_addr_t ipaddr);
-
 /****************************************************************************
  * Name: arp_find
  *
@@ -348,9 +345,6 @@ FAR struct arp_entry_s *arp_lookup(in_addr_t ipaddr);
  *             used simply to determine if the Ethernet MAC address is
  *             available.
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table.
- *
  ****************************************************************************/
 
 struct ether_addr;  /* Forward reference */
@@ -365,12 +359,13 @@ int arp_find(in_addr_t ipaddr, FAR struct ether_addr *ethaddr);
  * Input Parameters:
  *   ipaddr - Refers to an IP address in network order
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table.
+ * Returned Value:
+ *   Zero (OK) if the entry was removed; -ENOENT if there is no entry for
+ *   the IP address.
  *
  ****************************************************************************/
 
-void arp_delete(in_addr_t ipaddr);
+int arp_delete(in_addr_t ipaddr);
 
 /****************************************************************************
  * Name: arp_update
@@ -387,9 +382,6 @@ void arp_delete(in_addr_t ipaddr);
  *   Zero (OK) if the ARP table entry was successfully modified.  A negated
  *   errno value is returned on any error.
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table
- *
  ****************************************************************************/
 
 int arp_update(in_addr_t ipaddr, FAR uint8_t *ethaddr);
@@ -409,9 +401,6 @@ int arp_update(in_addr_t ipaddr, FAR uint8_t *ethaddr);
  *   Zero (OK) if the ARP table entry was successfully modified.  A negated
  *   errno value is returned on any error.
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table
- *
  ****************************************************************************/
 
 void arp_hdr_update(FAR uint16_t *pipaddr, FAR uint8_t *ethaddr);
@@ -431,9 +420,6 @@ void arp_hdr_update(FAR uint16_t *pipaddr, FAR uint8_t *ethaddr);
  *   On success, the number of entries actually copied is returned.  Unused
  *   entries are not returned.
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table
- *
  ****************************************************************************/
 
 #ifdef CONFIG_NETLINK_ROUTE
@@ -467,6 +453,7 @@ void arp_dump(FAR struct arp_hdr_s *arp);
 
 /* If ARP is disabled, stub out all ARP interfaces */
 
+#  define arp_initialize()
 #  define arp_format(d,i);
 #  define arp_send(i) (0)
 #  define arp_poll(d,c) (0)
@@ -475,7 +462,7 @@ void arp_dump(FAR struct arp_hdr_s *arp);
 #  define arp_wait(n,t) (0)
 #  define arp_notify(i)
 #  define arp_find(i,e) (-ENOSYS)
-#  define arp_delete(i)
+#  define arp_delete(i) (-ENOSYS)
 #  define arp_update(i,m);
 #  define arp_hdr_update(i,m);
 #  define arp_snapshot(s,n) (0)
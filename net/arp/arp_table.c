@@ -49,12 +49,14 @@
 #include <sys/ioctl.h>
 #include <stdint.h>
 #include <string.h>
+#include <assert.h>
 #include <debug.h>
 
 #include <netinet/in.h>
 #include <net/ethernet.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/semaphore.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
@@ -72,6 +74,17 @@
 
 #define ARP_MAXAGE_TICK SEC2TICK(10 * CONFIG_NET_ARP_MAXAGE)
 
+/* Without CONFIG_NET_ARP_RWLOCK, the ARP table is protected by the network
+ * lock.  That lock is re-entrant so callers may already hold it.
+ */
+
+#ifndef CONFIG_NET_ARP_RWLOCK
+#  define arp_rdlock()   (void)net_lock()
+#  define arp_rdunlock() net_unlock()
+#  define arp_wrlock()   (void)net_lock()
+#  define arp_wrunlock() net_unlock()
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -90,10 +103,108 @@ struct arp_table_info_s
 
 static struct arp_entry_s g_arptable[CONFIG_NET_ARPTAB_SIZE];
 
+#ifdef CONFIG_NET_ARP_RWLOCK
+/* The ARP table lock.  g_arpwrsem is held either by one writer or, on
+ * behalf of all of the readers, by the first reader.  g_arpexclsem
+ * protects the count of readers.
+ */
+
+static sem_t   g_arpexclsem;
+static sem_t   g_arpwrsem;
+static uint8_t g_arpnreaders;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: arp_rdlock, arp_rdunlock, arp_wrlock, and arp_wrunlock
+ *
+ * Description:
+ *   Lock the ARP table for reading (shared) or for writing (exclusive).
+ *   The network lock may be held when the ARP table is locked, but the
+ *   network lock must never be taken while the ARP table is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ARP_RWLOCK
+static void arp_rdlock(void)
+{
+  (void)nxsem_wait_uninterruptible(&g_arpexclsem);
+  if (g_arpnreaders++ == 0)
+    {
+      /* The first reader takes the table away from any writer */
+
+      (void)nxsem_wait_uninterruptible(&g_arpwrsem);
+    }
+
+  nxsem_post(&g_arpexclsem);
+}
+
+static void arp_rdunlock(void)
+{
+  (void)nxsem_wait_uninterruptible(&g_arpexclsem);
+  DEBUGASSERT(g_arpnreaders > 0);
+
+  if (--g_arpnreaders == 0)
+    {
+      /* The last reader gives the table back to the writers */
+
+      nxsem_post(&g_arpwrsem);
+    }
+
+  nxsem_post(&g_arpexclsem);
+}
+
+static inline void arp_wrlock(void)
+{
+  (void)nxsem_wait_uninterruptible(&g_arpwrsem);
+}
+
+static inline void arp_wrunlock(void)
+{
+  nxsem_post(&g_arpwrsem);
+}
+#endif
+
+/****************************************************************************
+ * Name: arp_lookup
+ *
+ * Description:
+ *   Find the ARP entry corresponding to this IP address in the ARP table.
+ *
+ * Input Parameters:
+ *   ipaddr - Refers to an IP address in network order
+ *
+ * Assumptions:
+ *   The caller holds the ARP table lock.  The return value will become
+ *   unstable when the ARP table is unlocked.
+ *
+ ****************************************************************************/
+
+static FAR struct arp_entry_s *arp_lookup(in_addr_t ipaddr)
+{
+  FAR struct arp_entry_s *tabptr;
+  int i;
+
+  /* Check if the IPv4 address is already in the ARP table. */
+
+  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
+    {
+      tabptr = &g_arptable[i];
+      if (net_ipv4addr_cmp(ipaddr, tabptr->at_ipaddr) &&
+          clock_systimer() - tabptr->at_time <= ARP_MAXAGE_TICK)
+        {
+          return tabptr;
+        }
+    }
+
+  /* Not found */
+
+  return NULL;
+}
+
 /****************************************************************************
  * Name: arp_match
  *
@@ -173,6 +284,28 @@ arp_return_old_entry(FAR struct arp_entry_s *e1, FAR struct arp_entry_s *e2)
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: arp_initialize
+ *
+ * Description:
+ *   Initialize the ARP table lock.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ARP_RWLOCK
+void arp_initialize(void)
+{
+  nxsem_init(&g_arpexclsem, 0, 1);
+  nxsem_init(&g_arpwrsem, 0, 1);
+
+  /* g_arpwrsem may be released by a different reader than the one that
+   * took it so it must not have priority inheritance enabled.
+   */
+
+  nxsem_setprotocol(&g_arpwrsem, SEM_PRIO_NONE);
+}
+#endif
+
 /****************************************************************************
  * Name: arp_update
  *
@@ -188,9 +321,6 @@ arp_return_old_entry(FAR struct arp_entry_s *e1, FAR struct arp_entry_s *e2)
  *   Zero (OK) if the ARP table entry was successfully modified.  A negated
  *   errno value is returned on any error.
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table
- *
  ****************************************************************************/
 
 int arp_update(in_addr_t ipaddr, FAR uint8_t *ethaddr)
@@ -198,6 +328,8 @@ int arp_update(in_addr_t ipaddr, FAR uint8_t *ethaddr)
   FAR struct arp_entry_s *tabptr = &g_arptable[0];
   int i;
 
+  arp_wrlock();
+
   /* Walk through the ARP mapping table and try to find an entry to
    * update. If none is found, the IP -> MAC address mapping is
    * inserted in the ARP table.
@@ -232,6 +364,8 @@ int arp_update(in_addr_t ipaddr, FAR uint8_t *ethaddr)
   tabptr->at_ipaddr = ipaddr;
   memcpy(tabptr->at_ethaddr.ether_addr_octet, ethaddr, ETHER_ADDR_LEN);
   tabptr->at_time = clock_systimer();
+
+  arp_wrunlock();
   return OK;
 }
 
@@ -250,9 +384,6 @@ int arp_update(in_addr_t ipaddr, FAR uint8_t *ethaddr)
  *   Zero (OK) if the ARP table entry was successfully modified.  A negated
  *   errno value is returned on any error.
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table
- *
  ****************************************************************************/
 
 void arp_hdr_update(FAR uint16_t *pipaddr, FAR uint8_t *ethaddr)
@@ -264,43 +395,6 @@ void arp_hdr_update(FAR uint16_t *pipaddr, FAR uint8_t *ethaddr)
   (void)arp_update(ipaddr, ethaddr);
 }
 
-/****************************************************************************
- * Name: arp_lookup
- *
- * Description:
- *   Find the ARP entry corresponding to this IP address in the ARP table.
- *
- * Input Parameters:
- *   ipaddr - Refers to an IP address in network order
- *
- * Assumptions:
- *   The network is locked to assure exclusive access to the ARP table.
- *   The return value will become unstable when the network is unlocked.
- *
- ****************************************************************************/
-
-FAR struct arp_entry_s *arp_lookup(in_addr_t ipaddr)
-{
-  FAR struct arp_entry_s *tabptr;
-  int i;
-
-  /* Check if the IPv4 address is already in the ARP table. */
-
-  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
-    {
-      tabptr = &g_arptable[i];
-      if (net_ipv4addr_cmp(ipaddr, tabptr->at_ipaddr) &&
-          clock_systimer() - tabptr->at_time <= ARP_MAXAGE_TICK)
-        {
-          return tabptr;
-        }
-    }
-
-  /* Not found */
-
-  return NULL;
-}
-
 /****************************************************************************
  * Name: arp_find
  *
@@ -315,18 +409,17 @@ FAR struct arp_entry_s *arp_lookup(in_addr_t ipaddr)
  *             used simply to determine if the Ethernet MAC address is
  *             available.
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table.
- *
  ****************************************************************************/
 
 int arp_find(in_addr_t ipaddr, FAR struct ether_addr *ethaddr)
 {
   FAR struct arp_entry_s *tabptr;
   struct arp_table_info_s info;
+  int ret;
 
   /* Check if the IPv4 address is already in the ARP table. */
 
+  arp_rdlock();
   tabptr = arp_lookup(ipaddr);
   if (tabptr != NULL)
     {
@@ -343,9 +436,12 @@ int arp_find(in_addr_t ipaddr, FAR struct ether_addr *ethaddr)
        * address mapping is available for the IP address.
        */
 
+      arp_rdunlock();
       return OK;
     }
 
+  arp_rdunlock();
+
   /* No.. check if the IPv4 address is the address assigned to a local
    * Ethernet network device.  If so, return a mapping of that IP address
    * to the Ethernet MAC address assigned to the network device.
@@ -354,14 +450,11 @@ int arp_find(in_addr_t ipaddr, FAR struct ether_addr *ethaddr)
   info.ai_ipaddr  = ipaddr;
   info.ai_ethaddr = ethaddr;
 
-  if (netdev_foreach(arp_match, &info) != 0)
-    {
-      return OK;
-    }
-
-  /* Not found */
+  (void)net_lock();
+  ret = netdev_foreach(arp_match, &info) != 0 ? OK : -ENOENT;
+  net_unlock();
 
-  return -ENOENT;
+  return ret;
 }
 
 /****************************************************************************
@@ -373,24 +466,31 @@ int arp_find(in_addr_t ipaddr, FAR struct ether_addr *ethaddr)
  * Input Parameters:
  *   ipaddr - Refers to an IP address in network order
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table.
+ * Returned Value:
+ *   Zero (OK) if the entry was removed; -ENOENT if there is no entry for
+ *   the IP address.
  *
  ****************************************************************************/
 
-void arp_delete(in_addr_t ipaddr)
+int arp_delete(in_addr_t ipaddr)
 {
   FAR struct arp_entry_s *tabptr;
+  int ret = -ENOENT;
 
   /* Check if the IPv4 address is in the ARP table. */
 
+  arp_wrlock();
   tabptr = arp_lookup(ipaddr);
   if (tabptr != NULL)
     {
       /* Yes.. Set the IP address to zero to "delete" it */
 
       tabptr->at_ipaddr = 0;
+      ret = OK;
     }
+
+  arp_wrunlock();
+  return ret;
 }
 
 /****************************************************************************
@@ -408,9 +508,6 @@ void arp_delete(in_addr_t ipaddr)
  *   On success, the number of entries actually copied is returned.  Unused
  *   entries are not returned.
  *
- * Assumptions
- *   The network is locked to assure exclusive access to the ARP table
- *
  ****************************************************************************/
 
 #ifdef CONFIG_NETLINK_ROUTE
@@ -424,6 +521,7 @@ unsigned int arp_snapshot(FAR struct arp_entry_s *snapshot,
 
   /* Copy all non-empty, non-expired entries in the ARP table. */
 
+  arp_rdlock();
   for (i = 0, now = clock_systimer(), ncopied = 0;
        nentries > ncopied && i < CONFIG_NET_ARPTAB_SIZE;
        i++)
@@ -437,6 +535,8 @@ unsigned int arp_snapshot(FAR struct arp_entry_s *snapshot,
         }
     }
 
+  arp_rdunlock();
+
   /* Return the number of entries copied into the user buffer */
 
   return ncopied;
@@ -141,8 +141,7 @@ static uint16_t icmpv6_poll_eventhandler(FAR struct net_driver_s *dev,
 
       if (eventset)
         {
-          info->fds->revents |= eventset;
-          nxsem_post(info->fds->sem);
+          poll_notify(&info->fds, 1, eventset);
         }
     }
 
@@ -244,7 +243,7 @@ int icmpv6_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
     {
       /* Yes.. then signal the poll logic */
 
-      nxsem_post(fds->sem);
+      poll_notify(&fds, 1, fds->revents);
     }
 
   net_unlock();
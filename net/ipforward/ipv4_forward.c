@@ -152,8 +152,8 @@ static int ipv4_hdrsize(FAR struct ipv4_hdr_s *ipv4)
 
 static int ipv4_decr_ttl(FAR struct ipv4_hdr_s *ipv4)
 {
-  uint16_t iphdrlen;
-  uint16_t sum;
+  uint16_t oldval;
+  uint16_t newval;
   int ttl;
 
   /* Check time-to-live (TTL) */
@@ -172,31 +172,19 @@ static int ipv4_decr_ttl(FAR struct ipv4_hdr_s *ipv4)
       return 0;
     }
 
-  /* Save the updated TTL value */
+  /* Save the updated TTL value.  The TTL shares a 16-bit word of the
+   * header with the protocol.
+   */
 
+  oldval    = HTONS(((uint16_t)ipv4->ttl << 8) | ipv4->proto);
+  newval    = HTONS(((uint16_t)ttl << 8) | ipv4->proto);
   ipv4->ttl = ttl;
 
-  /* Get the IP header length (accounting for possible options). */
-
-  iphdrlen = (ipv4->vhl & IPv4_HLMASK) << 2;
-
-  /* Re-calculate the IPv4 checksum.  This checksum is the Internet checksum
-   * of the 20 bytes of the IPv4 header.  This checksum will be different
-   * because we just modify the IPv4 TTL.
+  /* Update the IPv4 header checksum.  Only the TTL has changed, so there is
+   * no need to sum the whole header (including any options) again.
    */
 
-  ipv4->ipchksum = 0;
-  sum            = chksum(0, (FAR const uint8_t *)ipv4, iphdrlen);
-  if (sum == 0)
-    {
-      sum = 0xffff;
-    }
-  else
-    {
-      sum = htons(sum);
-    }
-
-  ipv4->ipchksum = ~sum;
+  ipv4->ipchksum = net_chksum_adjust(ipv4->ipchksum, oldval, newval);
   return ttl;
 }
 
@@ -53,6 +53,29 @@
 
 #ifdef HAVE_LOCAL_POLL
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: local_shadow_pollnotify
+ *
+ * Description:
+ *   Forward the events reported on one of the shadow pollfds used when
+ *   both POLLIN and POLLOUT are requested to the caller's pollfd.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_STREAM
+static void local_shadow_pollnotify(FAR struct pollfd *shadowfd)
+{
+  FAR struct pollfd *fds = (FAR struct pollfd *)shadowfd->arg;
+
+  poll_notify(&fds, 1, shadowfd->revents);
+  shadowfd->revents = 0;
+}
+#endif
+
 /****************************************************************************
  * Name: local_accept_pollsetup
  ****************************************************************************/
@@ -141,21 +164,8 @@ void local_accept_pollnotify(FAR struct local_conn_s *conn,
                              pollevent_t eventset)
 {
 #ifdef CONFIG_NET_LOCAL_STREAM
-  int i;
-
-  for (i = 0; i < LOCAL_ACCEPT_NPOLLWAITERS; i++)
-    {
-      struct pollfd *fds = conn->lc_accept_fds[i];
-      if (fds)
-        {
-          fds->revents |= (fds->events & eventset);
-          if (fds->revents != 0)
-            {
-              ninfo("Report events: %02x\n", fds->revents);
-              nxsem_post(fds->sem);
-            }
-        }
-    }
+  ninfo("Report events: %02x\n", eventset);
+  poll_notify(conn->lc_accept_fds, LOCAL_ACCEPT_NPOLLWAITERS, eventset);
 #endif
 }
 
@@ -225,10 +235,14 @@ int local_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
 
           shadowfds[0].fd     = 0; /* Does not matter */
           shadowfds[0].sem    = fds->sem;
+          shadowfds[0].cb     = local_shadow_pollnotify;
+          shadowfds[0].arg    = fds;
           shadowfds[0].events = fds->events & ~POLLOUT;
 
           shadowfds[1].fd     = 1; /* Does not matter */
           shadowfds[1].sem    = fds->sem;
+          shadowfds[1].cb     = local_shadow_pollnotify;
+          shadowfds[1].arg    = fds;
           shadowfds[1].events = fds->events & ~POLLIN;
 
           /* Setup poll for both shadow pollfds. */
@@ -294,8 +308,7 @@ int local_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
   return ret;
 
 pollerr:
-  fds->revents |= POLLERR;
-  nxsem_post(fds->sem);
+  poll_notify(&fds, 1, POLLERR);
   return OK;
 }
 
@@ -44,10 +44,12 @@
 #include <debug.h>
 
 #include <nuttx/net/net.h>
+#include <nuttx/net/arp.h>
 
 #include "socket/socket.h"
 #include "devif/devif.h"
 #include "netdev/netdev.h"
+#include "arp/arp.h"
 #include "ipforward/ipforward.h"
 #include "sixlowpan/sixlowpan.h"
 #include "icmp/icmp.h"
@@ -116,6 +118,12 @@ void net_initialize(void)
 
   devif_initialize();
 
+#ifdef CONFIG_NET_ARP_RWLOCK
+  /* Initialize the ARP table lock */
+
+  arp_initialize();
+#endif
+
 #ifdef HAVE_FWDALLOC
   /* Initialize IP forwarding support */
 
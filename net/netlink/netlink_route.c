@@ -546,14 +546,12 @@ static int netlink_get_arptable(FAR struct socket *psock,
   entry->payload.attr.rta_len  = RTA_LENGTH(tabsize);
   entry->payload.attr.rta_type = 0;
 
-  /* Lock the network so that the ARP table will be stable, then copy
-   * the ARP table into the allocated memory.
+  /* Copy the ARP table into the allocated memory.  arp_snapshot() locks
+   * the ARP table so that it will be stable while it is copied.
    */
 
-  net_lock();
   ncopied = arp_snapshot((FAR struct arp_entry_s *)entry->payload.data,
                          CONFIG_NET_ARPTAB_SIZE);
-  net_unlock();
 
   /* Now we have the real number of valid entries in the ARP table and
    * we can trim the allocation.
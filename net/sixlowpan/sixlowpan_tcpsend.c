@@ -270,7 +270,7 @@ static int sixlowpan_tcp_header(FAR struct tcp_conn_s *conn,
     {
       /* Update the TCP received window based on I/O buffer availability */
 
-      uint16_t recvwndo = tcp_get_recvwindow(dev);
+      uint16_t recvwndo = tcp_get_recvwindow(dev, conn);
 
       /* Set the TCP Window */
 
@@ -493,7 +493,7 @@ static uint16_t tcp_send_eventhandler(FAR struct net_driver_s *dev,
   if ((flags & WPAN_NEWDATA) == 0 && sinfo->s_sent < sinfo->s_buflen)
     {
       uint32_t seqno;
-      uint16_t winleft;
+      uint32_t winleft;
       uint16_t sndlen;
 
       /* Get the amount of TCP payload data that we can send in the next
@@ -512,8 +512,9 @@ static uint16_t tcp_send_eventhandler(FAR struct net_driver_s *dev,
           sndlen = winleft;
         }
 
-      ninfo("s_buflen=%u s_sent=%u mss=%u winsize=%u sndlen=%d\n",
-            sinfo->s_buflen, sinfo->s_sent, conn->mss, conn->winsize, sndlen);
+      ninfo("s_buflen=%u s_sent=%u mss=%u winsize=%lu sndlen=%d\n",
+            sinfo->s_buflen, sinfo->s_sent, conn->mss,
+            (unsigned long)conn->winsize, sndlen);
 
       if (sndlen > 0)
         {
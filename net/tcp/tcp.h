@@ -78,6 +78,14 @@
 #define tcp_callback_free(conn,cb) \
   devif_conn_callback_free((conn)->dev, (cb), &(conn)->list)
 
+/* The congestion avoidance algorithm of new connections */
+
+#if defined(CONFIG_NET_TCP_CC_DEFAULT_CUBIC)
+#  define TCP_CC_DEFAULT (&g_tcp_cubic)
+#elif defined(CONFIG_NET_TCP_CC)
+#  define TCP_CC_DEFAULT (&g_tcp_newreno)
+#endif
+
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
 /* TCP write buffer access macros */
 
@@ -123,6 +131,7 @@ struct net_driver_s;      /* Forward reference */
 struct devif_callback_s;  /* Forward reference */
 struct tcp_backlog_s;     /* Forward reference */
 struct tcp_hdr_s;         /* Forward reference */
+struct tcp_cc_ops_s;      /* Forward reference */
 
 struct tcp_conn_s
 {
@@ -158,6 +167,10 @@ struct tcp_conn_s
 
   /* TCP-specific content follows */
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  FAR struct tcp_conn_s *hnext; /* Next active connection in the same hash
+                                 * bucket */
+#endif
   union ip_binding_u u;   /* IP address binding */
   uint8_t  rcvseq[4];     /* The sequence number that we expect to
                            * receive next */
@@ -183,13 +196,73 @@ struct tcp_conn_s
   uint16_t rport;         /* The remoteTCP port, in network byte order */
   uint16_t mss;           /* Current maximum segment size for the
                            * connection */
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  uint32_t winsize;       /* Current window size of the connection */
+  uint8_t  snd_scale;     /* Shift count for windows received from the peer */
+  uint8_t  rcv_scale;     /* Shift count for windows sent to the peer */
+  bool     wscale;        /* The peer sent the window scale option */
+#else
   uint16_t winsize;       /* Current window size of the connection */
+#endif
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
   uint32_t tx_unacked;    /* Number bytes sent but not yet ACKed */
 #else
   uint16_t tx_unacked;    /* Number bytes sent but not yet ACKed */
 #endif
 
+#ifdef CONFIG_NET_TCP_CC
+  /* Congestion control.  All windows and sequence numbers are in bytes.
+   *
+   *   cc_ops     - The congestion avoidance algorithm
+   *   cwnd       - The congestion window.  The number of unacknowledged
+   *                bytes may not exceed this (nor the peer's window).
+   *   ssthresh   - Slow start is used while cwnd is below this threshold
+   *   lastack    - The highest ACK number received (SND.UNA)
+   *   sndmax     - The highest sequence number sent so far (SND.MAX)
+   *   recover    - The value of sndmax when loss recovery began
+   *   lastwnd    - The peer window in the last ACK (to recognize
+   *                duplicate ACKs)
+   *   rttseq     - The end sequence number of the segment being timed
+   *   rtttime    - The time that segment was sent (system ticks)
+   *   srtt       - Smoothed round trip time (microseconds)
+   *   rttvar     - Round trip time variation (microseconds)
+   *   cc_acked   - Bytes ACKed since the congestion window was last
+   *                increased in congestion avoidance
+   *   cc_rexmits - Total number of segments retransmitted
+   *   dupacks    - The number of consecutive duplicate ACKs
+   *   ca_state   - TCP_CA_Open, TCP_CA_Recovery, etc. (see netinet/tcp.h)
+   *   rtttiming  - True if rttseq/rtttime are valid
+   *   cubic      - Private state of the CUBIC algorithm
+   */
+
+  FAR const struct tcp_cc_ops_s *cc_ops;
+  uint32_t cwnd;
+  uint32_t ssthresh;
+  uint32_t lastack;
+  uint32_t sndmax;
+  uint32_t recover;
+  uint32_t lastwnd;
+  uint32_t rttseq;
+  clock_t  rtttime;
+  uint32_t srtt;
+  uint32_t rttvar;
+  uint32_t cc_acked;
+  uint32_t cc_rexmits;
+  uint8_t  dupacks;
+  uint8_t  ca_state;
+  bool     rtttiming;
+
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+  struct
+  {
+    clock_t  epoch;       /* Start of the current growth epoch (0 = none) */
+    uint32_t wmax;        /* Window before the last reduction (bytes) */
+    uint32_t origin;      /* Window at the plateau of the cubic (bytes) */
+    uint32_t k;           /* Time to reach the plateau (milliseconds) */
+  } cubic;
+#endif
+#endif
+
   /* If the TCP socket is bound to a local address, then this is
    * a reference to the device that routes traffic on the corresponding
    * network.
@@ -290,6 +363,31 @@ struct tcp_wrbuffer_s
 };
 #endif
 
+/* A congestion avoidance algorithm.  Slow start, duplicate ACK counting,
+ * fast retransmit and recovery, and the reaction to a retransmission
+ * time-out are common to all algorithms (tcp_cc.c).  The algorithm only
+ * decides how the congestion window grows above the slow start threshold
+ * and how far it is reduced on a loss.
+ *
+ *   name       - The name used with the TCP_CONGESTION socket option
+ *   init       - Reset any algorithm state.  Called when the connection is
+ *                established or the algorithm is selected.  May be NULL.
+ *   cong_avoid - Grow conn->cwnd on receipt of an ACK for 'acked' new
+ *                bytes while conn->cwnd >= conn->ssthresh.
+ *   ssthresh   - Return the new slow start threshold after a loss.  The
+ *                congestion window is then derived from it.
+ */
+
+#ifdef CONFIG_NET_TCP_CC
+struct tcp_cc_ops_s
+{
+  FAR const char *name;
+  CODE void (*init)(FAR struct tcp_conn_s *conn);
+  CODE void (*cong_avoid)(FAR struct tcp_conn_s *conn, uint32_t acked);
+  CODE uint32_t (*ssthresh)(FAR struct tcp_conn_s *conn);
+};
+#endif
+
 /* Support for listen backlog:
  *
  *   struct tcp_blcontainer_s describes one backlogged connection
@@ -331,6 +429,15 @@ extern "C"
 
 EXTERN struct net_driver_s *g_netdevices;
 
+#ifdef CONFIG_NET_TCP_CC
+/* The congestion avoidance algorithms (see struct tcp_cc_ops_s) */
+
+EXTERN const struct tcp_cc_ops_s g_tcp_newreno;
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+EXTERN const struct tcp_cc_ops_s g_tcp_cubic;
+#endif
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -1376,17 +1483,129 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
  * Name: tcp_get_recvwindow
  *
  * Description:
- *   Calculate the TCP receive window for the specified device.
+ *   Calculate the TCP receive window for the specified device and
+ *   connection.
  *
  * Input Parameters:
- *   dev - The device whose TCP receive window will be updated.
+ *   dev  - The device whose TCP receive window will be updated.
+ *   conn - The connection that will advertise the window.
  *
  * Returned Value:
- *   The value of the TCP receive window to use.
+ *   The value of the TCP receive window to use.  This is the value for
+ *   the window field of the TCP header, i.e., it is already scaled if
+ *   window scaling is in use on the connection.
+ *
+ ****************************************************************************/
+
+uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev,
+                            FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Name: tcp_get_recvwscale
+ *
+ * Description:
+ *   Return the window scale shift count that we offer to the remote peer.
+ *   This is the smallest shift count that can express the largest receive
+ *   window that tcp_get_recvwindow() can return.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+uint8_t tcp_get_recvwscale(void);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_init
+ *
+ * Description:
+ *   Initialize the congestion control state of a connection that has just
+ *   entered the ESTABLISHED state.  'ackno' is the first unacknowledged
+ *   sequence number.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+void tcp_cc_init(FAR struct tcp_conn_s *conn, uint32_t ackno);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_recvack
+ *
+ * Description:
+ *   Update the congestion window on receipt of an ACK.  'pure' is true if
+ *   the segment carries no data and no SYN or FIN.  Returns true if the
+ *   caller should perform a fast retransmit.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+bool tcp_cc_recvack(FAR struct tcp_conn_s *conn, uint32_t ackno, bool pure);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_timeout
+ *
+ * Description:
+ *   Collapse the congestion window after a retransmission time-out.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+void tcp_cc_timeout(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_sent
+ *
+ * Description:
+ *   Note that a segment with 'len' bytes of data starting at sequence
+ *   number 'seqno' is being sent.
  *
  ****************************************************************************/
 
-uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev);
+#ifdef CONFIG_NET_TCP_CC
+void tcp_cc_sent(FAR struct tcp_conn_s *conn, uint32_t seqno, uint16_t len);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_sndwnd
+ *
+ * Description:
+ *   Return the number of bytes that may be unacknowledged:  The smaller of
+ *   the congestion window and the peer's receive window.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+uint32_t tcp_cc_sndwnd(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_select
+ *
+ * Description:
+ *   Select the congestion avoidance algorithm of a connection by name.
+ *   Returns -ENOENT if there is no such algorithm.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+int tcp_cc_select(FAR struct tcp_conn_s *conn, FAR const char *name,
+                  size_t namelen);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_info
+ *
+ * Description:
+ *   Return the statistics of a connection for the TCP_INFO socket option.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+struct tcp_info;  /* Forward reference */
+void tcp_cc_info(FAR struct tcp_conn_s *conn, FAR struct tcp_info *info);
+#endif
 
 /****************************************************************************
  * Name: psock_tcp_cansend
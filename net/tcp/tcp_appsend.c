@@ -308,6 +308,15 @@ void tcp_rexmit(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
   if (dev->d_sndlen > 0 && conn->tx_unacked > 0)
 #endif
     {
+#ifdef CONFIG_NET_TCP_CC
+      /* Let congestion control time the segment and count retransmissions */
+
+      if ((conn->tcpstateflags & TCP_STATE_MASK) == TCP_ESTABLISHED)
+        {
+          tcp_cc_sent(conn, tcp_getsequence(conn->sndseq), dev->d_sndlen);
+        }
+#endif
+
       /* We always set the ACK flag in response packets adding the length of
        * the IP and TCP headers.
        */
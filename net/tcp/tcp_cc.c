@@ -0,0 +1,559 @@
+/****************************************************************************
+ * net/tcp/tcp_cc.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/param.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <netinet/tcp.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/tcp.h>
+
+#include "tcp/tcp.h"
+
+#ifdef CONFIG_NET_TCP_CC
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Sequence number comparisons that allow for wrap-around */
+
+#define TCP_SEQ_LT(a,b)   ((int32_t)((a) - (b)) < 0)
+#define TCP_SEQ_GT(a,b)   ((int32_t)((a) - (b)) > 0)
+#define TCP_SEQ_GEQ(a,b)  ((int32_t)((a) - (b)) >= 0)
+
+/* The number of duplicate ACKs that triggers a fast retransmit */
+
+#define TCP_CC_DUPTHRESH  3
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void newreno_cong_avoid(FAR struct tcp_conn_s *conn, uint32_t acked);
+static uint32_t newreno_ssthresh(FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct tcp_cc_ops_s g_tcp_newreno =
+{
+  "newreno",             /* name */
+  NULL,                  /* init */
+  newreno_cong_avoid,    /* cong_avoid */
+  newreno_ssthresh       /* ssthresh */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* All of the congestion avoidance algorithms that may be selected with the
+ * TCP_CONGESTION socket option.
+ */
+
+static FAR const struct tcp_cc_ops_s * const g_tcp_cc_algorithms[] =
+{
+  &g_tcp_newreno,
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+  &g_tcp_cubic,
+#endif
+};
+
+#define TCP_CC_NALGORITHMS \
+  (sizeof(g_tcp_cc_algorithms) / sizeof(g_tcp_cc_algorithms[0]))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: newreno_cong_avoid
+ *
+ * Description:
+ *   Increase the congestion window by one segment for each window of data
+ *   that is acknowledged (RFC 5681 with the byte counting of RFC 3465).
+ *
+ ****************************************************************************/
+
+static void newreno_cong_avoid(FAR struct tcp_conn_s *conn, uint32_t acked)
+{
+  conn->cc_acked += acked;
+  if (conn->cc_acked >= conn->cwnd)
+    {
+      conn->cc_acked -= conn->cwnd;
+      conn->cwnd     += conn->mss;
+    }
+}
+
+/****************************************************************************
+ * Name: newreno_ssthresh
+ *
+ * Description:
+ *   Return half of the data in flight, but no less than two segments
+ *   (RFC 5681, equation 4).
+ *
+ ****************************************************************************/
+
+static uint32_t newreno_ssthresh(FAR struct tcp_conn_s *conn)
+{
+  uint32_t flight = conn->sndmax - conn->lastack;
+
+  return MAX(flight / 2, 2 * (uint32_t)conn->mss);
+}
+
+/****************************************************************************
+ * Name: tcp_cc_rttsample
+ *
+ * Description:
+ *   Update the smoothed round trip time and its variation with a new
+ *   measurement as described in RFC 6298.  The resolution is one system
+ *   tick; shorter round trip times are counted as one tick.
+ *
+ ****************************************************************************/
+
+static void tcp_cc_rttsample(FAR struct tcp_conn_s *conn)
+{
+  clock_t elapsed = clock_systimer() - conn->rtttime;
+  uint32_t rtt;
+  uint32_t delta;
+
+  rtt = elapsed > 0 ? TICK2USEC(elapsed) : USEC_PER_TICK;
+
+  if (conn->srtt == 0)
+    {
+      /* This is the first measurement */
+
+      conn->srtt   = rtt;
+      conn->rttvar = rtt / 2;
+    }
+  else
+    {
+      delta        = conn->srtt > rtt ? conn->srtt - rtt : rtt - conn->srtt;
+      conn->rttvar = conn->rttvar - (conn->rttvar >> 2) + (delta >> 2);
+      conn->srtt   = conn->srtt - (conn->srtt >> 3) + (rtt >> 3);
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_cc_initwnd
+ *
+ * Description:
+ *   Return the initial congestion window for the given segment size
+ *   (RFC 5681, section 3.1).
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_cc_initwnd(uint16_t mss)
+{
+  if (mss > 2190)
+    {
+      return 2 * (uint32_t)mss;
+    }
+  else if (mss > 1095)
+    {
+      return 3 * (uint32_t)mss;
+    }
+  else
+    {
+      return 4 * (uint32_t)mss;
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_cc_init
+ *
+ * Description:
+ *   Initialize the congestion control state of a connection that has just
+ *   entered the ESTABLISHED state.
+ *
+ * Input Parameters:
+ *   conn  - The TCP connection structure.  The MSS must already be known.
+ *   ackno - The first unacknowledged sequence number (the ISN + 1).
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_init(FAR struct tcp_conn_s *conn, uint32_t ackno)
+{
+  DEBUGASSERT(conn->cc_ops != NULL);
+
+  conn->cwnd      = tcp_cc_initwnd(conn->mss);
+  conn->ssthresh  = UINT32_MAX;
+  conn->lastack   = ackno;
+  conn->sndmax    = ackno;
+  conn->recover   = ackno - 1;
+  conn->lastwnd   = conn->winsize;
+  conn->cc_acked  = 0;
+  conn->dupacks   = 0;
+  conn->ca_state  = TCP_CA_Open;
+  conn->rtttiming = false;
+
+  if (conn->cc_ops->init != NULL)
+    {
+      conn->cc_ops->init(conn);
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_cc_recvack
+ *
+ * Description:
+ *   Update the congestion window on receipt of an ACK in the ESTABLISHED
+ *   state.  An ACK of new data may end loss recovery and opens the window
+ *   by slow start or by the congestion avoidance algorithm.  A third
+ *   duplicate ACK starts fast recovery.
+ *
+ *   There is no retransmission queue of individual segments:  All data
+ *   from the first unacknowledged byte is sent again on a retransmission.
+ *   So the window is not inflated during fast recovery and a partial ACK
+ *   (RFC 6582) needs no further retransmission.  Only one reduction of the
+ *   window is made for all losses in the same window of data.
+ *
+ * Input Parameters:
+ *   conn  - The TCP connection structure
+ *   ackno - The ACK number of the received segment
+ *   pure  - True if the segment carries no data and no SYN or FIN
+ *
+ * Returned Value:
+ *   True if the caller should retransmit now (fast retransmit).
+ *
+ * Assumptions:
+ *   The network is locked.  conn->winsize already holds the window of the
+ *   received segment.
+ *
+ ****************************************************************************/
+
+bool tcp_cc_recvack(FAR struct tcp_conn_s *conn, uint32_t ackno, bool pure)
+{
+  uint32_t lastwnd = conn->lastwnd;
+  uint32_t acked;
+
+  conn->lastwnd = conn->winsize;
+
+  if (TCP_SEQ_GT(ackno, conn->lastack))
+    {
+      acked          = ackno - conn->lastack;
+      conn->lastack  = ackno;
+      conn->dupacks  = 0;
+
+      if (TCP_SEQ_GT(ackno, conn->sndmax))
+        {
+          conn->sndmax = ackno;
+        }
+
+      /* Measure the round trip time if the timed segment has been ACKed */
+
+      if (conn->rtttiming && TCP_SEQ_GEQ(ackno, conn->rttseq))
+        {
+          tcp_cc_rttsample(conn);
+          conn->rtttiming = false;
+        }
+
+      if (conn->ca_state == TCP_CA_Recovery)
+        {
+          /* Fast recovery ends when all of the data that was outstanding
+           * at the time of the loss has been ACKed.  Until then, the
+           * window is kept at the new slow start threshold.
+           */
+
+          if (TCP_SEQ_LT(ackno, conn->recover))
+            {
+              return false;
+            }
+
+          conn->cwnd     = conn->ssthresh;
+          conn->cc_acked = 0;
+          conn->ca_state = TCP_CA_Open;
+          return false;
+        }
+
+      if (conn->ca_state == TCP_CA_Loss && TCP_SEQ_LT(ackno, conn->recover))
+        {
+          /* Still recovering from a time-out:  Slow start below */
+        }
+      else
+        {
+          conn->ca_state = TCP_CA_Open;
+        }
+
+      /* Open the window by slow start or congestion avoidance */
+
+      if (conn->cwnd < conn->ssthresh)
+        {
+          conn->cwnd += MIN(acked, (uint32_t)conn->mss);
+        }
+      else
+        {
+          conn->cc_ops->cong_avoid(conn, acked);
+        }
+
+      return false;
+    }
+
+  /* A duplicate ACK acknowledges nothing new while data is outstanding and
+   * carries neither data nor a change of the peer's window (RFC 5681).
+   */
+
+  if (!pure || ackno != conn->lastack || conn->winsize != lastwnd ||
+      conn->sndmax == conn->lastack)
+    {
+      return false;
+    }
+
+  if (conn->dupacks < UINT8_MAX)
+    {
+      conn->dupacks++;
+    }
+
+  if (conn->ca_state == TCP_CA_Open)
+    {
+      conn->ca_state = TCP_CA_Disorder;
+    }
+
+  /* Fast retransmit on the third duplicate ACK unless we are already
+   * recovering from a loss in this window of data.
+   */
+
+  if (conn->dupacks == TCP_CC_DUPTHRESH &&
+      conn->ca_state == TCP_CA_Disorder &&
+      TCP_SEQ_GT(ackno, conn->recover))
+    {
+      conn->ssthresh  = conn->cc_ops->ssthresh(conn);
+      conn->cwnd      = conn->ssthresh;
+      conn->cc_acked  = 0;
+      conn->recover   = conn->sndmax;
+      conn->ca_state  = TCP_CA_Recovery;
+      conn->rtttiming = false;
+
+      ninfo("Fast retransmit: ackno=%08lx cwnd=%lu\n",
+            (unsigned long)ackno, (unsigned long)conn->cwnd);
+      return true;
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_timeout
+ *
+ * Description:
+ *   Collapse the congestion window to one segment after a retransmission
+ *   time-out (RFC 5681, section 3.1).  The slow start threshold is reduced
+ *   only for the first time-out of a segment.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_timeout(FAR struct tcp_conn_s *conn)
+{
+  if (conn->ca_state != TCP_CA_Loss)
+    {
+      conn->ssthresh = conn->cc_ops->ssthresh(conn);
+    }
+
+  conn->cwnd      = conn->mss;
+  conn->cc_acked  = 0;
+  conn->dupacks   = 0;
+  conn->recover   = conn->sndmax;
+  conn->ca_state  = TCP_CA_Loss;
+  conn->rtttiming = false;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_sent
+ *
+ * Description:
+ *   Note that a segment carrying data is being sent.  This starts a round
+ *   trip time measurement if none is in progress and counts
+ *   retransmissions.  Retransmitted data is never timed (Karn's algorithm).
+ *
+ * Input Parameters:
+ *   conn  - The TCP connection structure
+ *   seqno - The sequence number of the first byte of the segment
+ *   len   - The number of data bytes in the segment
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_sent(FAR struct tcp_conn_s *conn, uint32_t seqno, uint16_t len)
+{
+  uint32_t end = seqno + len;
+
+  if (TCP_SEQ_LT(seqno, conn->sndmax))
+    {
+      conn->cc_rexmits++;
+
+      if (conn->rtttiming && TCP_SEQ_LT(seqno, conn->rttseq))
+        {
+          conn->rtttiming = false;
+        }
+    }
+  else if (!conn->rtttiming)
+    {
+      conn->rttseq    = end;
+      conn->rtttime   = clock_systimer();
+      conn->rtttiming = true;
+    }
+
+  if (TCP_SEQ_GT(end, conn->sndmax))
+    {
+      conn->sndmax = end;
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_cc_sndwnd
+ *
+ * Description:
+ *   Return the number of bytes that may be unacknowledged:  The smaller
+ *   of the congestion window and the peer's receive window.
+ *
+ ****************************************************************************/
+
+uint32_t tcp_cc_sndwnd(FAR struct tcp_conn_s *conn)
+{
+  return MIN(conn->cwnd, (uint32_t)conn->winsize);
+}
+
+/****************************************************************************
+ * Name: tcp_cc_select
+ *
+ * Description:
+ *   Select the congestion avoidance algorithm of a connection by name.
+ *   This may be done at any time; the state of the new algorithm is reset.
+ *
+ * Input Parameters:
+ *   conn    - The TCP connection structure
+ *   name    - The name of the algorithm (need not be NUL terminated)
+ *   namelen - The maximum length of the name
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOENT if there is no algorithm of that name.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int tcp_cc_select(FAR struct tcp_conn_s *conn, FAR const char *name,
+                  size_t namelen)
+{
+  FAR const struct tcp_cc_ops_s *ops;
+  size_t len;
+  int i;
+
+  len = strnlen(name, namelen);
+  for (i = 0; i < TCP_CC_NALGORITHMS; i++)
+    {
+      ops = g_tcp_cc_algorithms[i];
+      if (strlen(ops->name) == len && strncmp(ops->name, name, len) == 0)
+        {
+          conn->cc_ops   = ops;
+          conn->cc_acked = 0;
+
+          if (ops->init != NULL)
+            {
+              ops->init(conn);
+            }
+
+          return OK;
+        }
+    }
+
+  return -ENOENT;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_info
+ *
+ * Description:
+ *   Return the statistics of a connection for the TCP_INFO socket option.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_info(FAR struct tcp_conn_s *conn, FAR struct tcp_info *info)
+{
+  uint32_t mss = conn->mss > 0 ? conn->mss : 1;
+
+  memset(info, 0, sizeof(struct tcp_info));
+
+  info->tcpi_state         = conn->tcpstateflags & TCP_STATE_MASK;
+  info->tcpi_ca_state      = conn->ca_state;
+  info->tcpi_retransmits   = conn->nrtx;
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  info->tcpi_snd_wscale    = conn->snd_scale;
+  info->tcpi_rcv_wscale    = conn->rcv_scale;
+#endif
+  info->tcpi_rto           = conn->rto * USEC_PER_HSEC;
+  info->tcpi_snd_mss       = conn->mss;
+  info->tcpi_unacked       = conn->tx_unacked;
+  info->tcpi_rtt           = conn->srtt;
+  info->tcpi_rttvar        = conn->rttvar;
+  info->tcpi_snd_ssthresh  = conn->ssthresh == UINT32_MAX ?
+                             UINT32_MAX : conn->ssthresh / mss;
+  info->tcpi_snd_cwnd      = conn->cwnd / mss;
+  info->tcpi_snd_wnd       = conn->winsize;
+  info->tcpi_total_retrans = conn->cc_rexmits;
+}
+
+#endif /* CONFIG_NET_TCP_CC */
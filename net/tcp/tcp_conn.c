@@ -72,6 +72,16 @@
 #define IPv4BUF ((struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 #define IPv6BUF ((struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 
+/* Candidate connections for an incoming segment are either the
+ * connections in one hash bucket or all active connections.
+ */
+
+#ifdef CONFIG_NET_TCP_CONN_HASH
+#  define TCP_NEXT_ACTIVE(c) ((c)->hnext)
+#else
+#  define TCP_NEXT_ACTIVE(c) ((FAR struct tcp_conn_s *)(c)->node.flink)
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -88,6 +98,14 @@ static dq_queue_t g_free_tcp_connections;
 
 static dq_queue_t g_active_tcp_connections;
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+/* The active connections hashed on the local port and on the remote port
+ * and address.  Each bucket is a singly linked list chained through hnext.
+ */
+
+static FAR struct tcp_conn_s *g_tcp_connhash[CONFIG_NET_TCP_CONN_HASHSIZE];
+#endif
+
 /* Last port used by a TCP connection connection. */
 
 static uint16_t g_last_tcp_port;
@@ -96,6 +114,114 @@ static uint16_t g_last_tcp_port;
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_hashkey
+ *
+ * Description:
+ *   Return the hash bucket index for the local port and the remote port and
+ *   address of a connection.
+ *
+ * Input Parameters:
+ *   lport  - The local port number (network byte order)
+ *   rport  - The remote port number (network byte order)
+ *   raddr  - The remote IP address (network byte order)
+ *   nwords - The number of 16-bit words in raddr
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CONN_HASH
+static unsigned int tcp_hashkey(uint16_t lport, uint16_t rport,
+                                FAR const uint16_t *raddr, int nwords)
+{
+  uint32_t hash = ((uint32_t)lport << 16) | rport;
+  int i;
+
+  for (i = 0; i < nwords; i++)
+    {
+      hash = hash * 31 + raddr[i];
+    }
+
+  /* Mix the upper bits into the lower bits before reducing */
+
+  hash ^= hash >> 16;
+  hash *= 0x45d9f3b;
+  hash ^= hash >> 16;
+
+  return hash % CONFIG_NET_TCP_CONN_HASHSIZE;
+}
+
+/****************************************************************************
+ * Name: tcp_conn_hashkey
+ *
+ * Description:
+ *   Return the hash bucket index of a connection.
+ *
+ ****************************************************************************/
+
+static unsigned int tcp_conn_hashkey(FAR struct tcp_conn_s *conn)
+{
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if (conn->domain == PF_INET)
+#endif
+    {
+      return tcp_hashkey(conn->lport, conn->rport,
+                         (FAR const uint16_t *)&conn->u.ipv4.raddr, 2);
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  else
+#endif
+    {
+      return tcp_hashkey(conn->lport, conn->rport, conn->u.ipv6.raddr, 8);
+    }
+#endif /* CONFIG_NET_IPv6 */
+}
+
+/****************************************************************************
+ * Name: tcp_hash_insert and tcp_hash_remove
+ *
+ * Description:
+ *   Add a connection to or remove a connection from the hash table.  This
+ *   must be done whenever a connection is added to or removed from the
+ *   list of active connections.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void tcp_hash_insert(FAR struct tcp_conn_s *conn)
+{
+  unsigned int ndx = tcp_conn_hashkey(conn);
+
+  conn->hnext         = g_tcp_connhash[ndx];
+  g_tcp_connhash[ndx] = conn;
+}
+
+static void tcp_hash_remove(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_conn_s **link = &g_tcp_connhash[tcp_conn_hashkey(conn)];
+
+  while (*link != NULL)
+    {
+      if (*link == conn)
+        {
+          *link       = conn->hnext;
+          conn->hnext = NULL;
+          break;
+        }
+
+      link = &(*link)->hnext;
+    }
+}
+#else
+#  define tcp_hash_insert(c)
+#  define tcp_hash_remove(c)
+#endif /* CONFIG_NET_TCP_CONN_HASH */
+
 /****************************************************************************
  * Name: tcp_ipv4_listener
  *
@@ -327,7 +453,12 @@ static inline FAR struct tcp_conn_s *
   in_addr_t srcipaddr;
   in_addr_t destipaddr;
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  conn       = g_tcp_connhash[tcp_hashkey(tcp->destport, tcp->srcport,
+                                          ip->srcipaddr, 2)];
+#else
   conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
+#endif
   srcipaddr  = net_ip4addr_conv32(ip->srcipaddr);
   destipaddr = net_ip4addr_conv32(ip->destipaddr);
 
@@ -364,9 +495,9 @@ static inline FAR struct tcp_conn_s *
           break;
         }
 
-      /* Look at the next active connection */
+      /* Look at the next candidate connection */
 
-      conn = (FAR struct tcp_conn_s *)conn->node.flink;
+      conn = TCP_NEXT_ACTIVE(conn);
     }
 
   return conn;
@@ -394,7 +525,12 @@ static inline FAR struct tcp_conn_s *
   net_ipv6addr_t *srcipaddr;
   net_ipv6addr_t *destipaddr;
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  conn       = g_tcp_connhash[tcp_hashkey(tcp->destport, tcp->srcport,
+                                          ip->srcipaddr, 8)];
+#else
   conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
+#endif
   srcipaddr  = (net_ipv6addr_t *)ip->srcipaddr;
   destipaddr = (net_ipv6addr_t *)ip->destipaddr;
 
@@ -431,9 +567,9 @@ static inline FAR struct tcp_conn_s *
           break;
         }
 
-      /* Look at the next active connection */
+      /* Look at the next candidate connection */
 
-      conn = (FAR struct tcp_conn_s *)conn->node.flink;
+      conn = TCP_NEXT_ACTIVE(conn);
     }
 
   return conn;
@@ -594,6 +730,10 @@ void tcp_initialize(void)
   dq_init(&g_free_tcp_connections);
   dq_init(&g_active_tcp_connections);
 
+#ifdef CONFIG_NET_TCP_CONN_HASH
+  memset(g_tcp_connhash, 0, sizeof(g_tcp_connhash));
+#endif
+
   /* Now initialize each connection structure */
 
   for (i = 0; i < CONFIG_NET_TCP_CONNS; i++)
@@ -723,6 +863,9 @@ FAR struct tcp_conn_s *tcp_alloc(uint8_t domain)
       conn->keepidle      = 2 * DSEC_PER_HOUR;
       conn->keepintvl     = 2 * DSEC_PER_SEC;
       conn->keepcnt       = 3;
+#endif
+#ifdef CONFIG_NET_TCP_CC
+      conn->cc_ops        = TCP_CC_DEFAULT;
 #endif
     }
 
@@ -773,6 +916,7 @@ void tcp_free(FAR struct tcp_conn_s *conn)
       /* Remove the connection from the active list */
 
       dq_rem(&conn->node, &g_active_tcp_connections);
+      tcp_hash_remove(conn);
     }
 
 #ifdef CONFIG_NET_TCP_READAHEAD
@@ -1038,6 +1182,7 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
        */
 
       dq_addlast(&conn->node, &g_active_tcp_connections);
+      tcp_hash_insert(conn);
     }
 
   return conn;
@@ -1250,6 +1395,11 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
   conn->sa         = 0;
   conn->sv         = 16;   /* Initial value of the RTT variance. */
   conn->lport      = htons((uint16_t)port);
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  conn->rcv_scale  = tcp_get_recvwscale(); /* Offered in our SYN */
+  conn->snd_scale  = 0;
+  conn->wscale     = false;
+#endif
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
   conn->expired    = 0;
   conn->isn        = 0;
@@ -1273,6 +1423,7 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
   /* And, finally, put the connection structure into the active list. */
 
   dq_addlast(&conn->node, &g_active_tcp_connections);
+  tcp_hash_insert(conn);
   ret = OK;
 
 errout_with_lock:
@@ -0,0 +1,280 @@
+/****************************************************************************
+ * net/tcp/tcp_cubic.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/param.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/net/net.h>
+
+#include "tcp/tcp.h"
+
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The constants of RFC 8312 scaled by 1024:
+ *
+ *   CUBIC_BETA   - beta_cubic = 0.7, the window reduction on a loss
+ *   CUBIC_C      - C = 0.4, the scaling constant of the cubic function
+ *   CUBIC_CSCALE - 2^30 / C, used to compute K
+ *   CUBIC_AIMD   - 3 * (1 - beta_cubic) / (1 + beta_cubic), the additive
+ *                  increase of the TCP-friendly window per round trip
+ *
+ * Time is measured in units of 1/1024 second and is limited to
+ * CUBIC_TMAX so that the cube of a time fits in 64 bits.
+ */
+
+#define CUBIC_BETA    717
+#define CUBIC_C       410
+#define CUBIC_CSCALE  2618882
+#define CUBIC_AIMD    542
+#define CUBIC_TMAX    (1 << 19)
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void cubic_init(FAR struct tcp_conn_s *conn);
+static void cubic_cong_avoid(FAR struct tcp_conn_s *conn, uint32_t acked);
+static uint32_t cubic_ssthresh(FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct tcp_cc_ops_s g_tcp_cubic =
+{
+  "cubic",               /* name */
+  cubic_init,            /* init */
+  cubic_cong_avoid,      /* cong_avoid */
+  cubic_ssthresh         /* ssthresh */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: cubic_cbrt
+ *
+ * Description:
+ *   Return the integer cube root of a 64-bit value.
+ *
+ ****************************************************************************/
+
+static uint32_t cubic_cbrt(uint64_t x)
+{
+  uint64_t y = 0;
+  uint64_t b;
+  int s;
+
+  for (s = 63; s >= 0; s -= 3)
+    {
+      y += y;
+      b  = 3 * y * (y + 1) + 1;
+      if ((x >> s) >= b)
+        {
+          x -= b << s;
+          y++;
+        }
+    }
+
+  return (uint32_t)y;
+}
+
+/****************************************************************************
+ * Name: cubic_init
+ ****************************************************************************/
+
+static void cubic_init(FAR struct tcp_conn_s *conn)
+{
+  memset(&conn->cubic, 0, sizeof(conn->cubic));
+}
+
+/****************************************************************************
+ * Name: cubic_cong_avoid
+ *
+ * Description:
+ *   Grow the congestion window toward the cubic function of the time since
+ *   the start of the current epoch (RFC 8312, section 4).  The window grows
+ *   quickly while it is far below the window at the last loss (wmax),
+ *   slowly near wmax, and then quickly again as it probes beyond wmax.  It
+ *   always grows at least as fast as standard TCP would (the TCP-friendly
+ *   region).
+ *
+ ****************************************************************************/
+
+static void cubic_cong_avoid(FAR struct tcp_conn_s *conn, uint32_t acked)
+{
+  clock_t now = clock_systimer();
+  uint32_t mss = conn->mss;
+  uint32_t target;
+  uint32_t needed;
+  uint64_t offs;
+  uint64_t delta;
+  uint32_t t;
+
+  /* Start a new epoch on the first ACK after a loss.  The epoch time zero
+   * is reserved to mean that no epoch has been started.
+   */
+
+  if (conn->cubic.epoch == 0)
+    {
+      conn->cubic.epoch = now != 0 ? now : 1;
+      conn->cc_acked    = 0;
+
+      if (conn->cwnd < conn->cubic.wmax)
+        {
+          /* K = cbrt((wmax - cwnd) / C), in segments and seconds */
+
+          delta = ((uint64_t)(conn->cubic.wmax - conn->cwnd) << 10) / mss;
+          conn->cubic.k      = cubic_cbrt(delta * CUBIC_CSCALE);
+          conn->cubic.origin = conn->cubic.wmax;
+        }
+      else
+        {
+          conn->cubic.k      = 0;
+          conn->cubic.origin = conn->cwnd;
+        }
+    }
+
+  /* The time one round trip from now, in units of 1/1024 second */
+
+  t = (uint32_t)(((uint64_t)TICK2USEC(now - conn->cubic.epoch) +
+                  conn->srtt) * 1024 / USEC_PER_SEC);
+  t = MIN(t, CUBIC_TMAX);
+
+  /* The cubic window at that time:  origin + C * (t - K)^3 */
+
+  offs  = t > conn->cubic.k ? t - conn->cubic.k : conn->cubic.k - t;
+  offs  = MIN(offs, CUBIC_TMAX);
+  delta = (((offs * offs * offs) >> 10) * CUBIC_C) >> 20;
+  delta = (delta * mss) >> 10;
+
+  if (t > conn->cubic.k)
+    {
+      target = (uint32_t)MIN((uint64_t)conn->cubic.origin + delta,
+                             UINT32_MAX);
+    }
+  else
+    {
+      target = delta < conn->cubic.origin ?
+               conn->cubic.origin - (uint32_t)delta : mss;
+    }
+
+  /* The window that standard TCP would have reached since the loss:
+   * wmax * beta_cubic plus CUBIC_AIMD segments per round trip.
+   */
+
+  if (conn->srtt > 0)
+    {
+      uint64_t west;
+
+      west = ((uint64_t)conn->cubic.wmax * CUBIC_BETA) >> 10;
+      west += ((uint64_t)TICK2USEC(now - conn->cubic.epoch) * CUBIC_AIMD /
+               conn->srtt * mss) >> 10;
+
+      if (west > target)
+        {
+          target = (uint32_t)MIN(west, UINT32_MAX);
+        }
+    }
+
+  /* Grow toward the target over one round trip:  One segment for each
+   * cwnd * mss / (target - cwnd) bytes ACKed.  Above the target, grow by
+   * only one segment per 100 windows of data.
+   */
+
+  if (target > conn->cwnd)
+    {
+      needed = (uint32_t)(((uint64_t)conn->cwnd * mss) /
+                          (target - conn->cwnd));
+    }
+  else
+    {
+      needed = 100 * conn->cwnd;
+    }
+
+  conn->cc_acked += acked;
+  if (conn->cc_acked >= needed)
+    {
+      conn->cc_acked = 0;
+      conn->cwnd    += mss;
+    }
+}
+
+/****************************************************************************
+ * Name: cubic_ssthresh
+ *
+ * Description:
+ *   Remember the window at the time of the loss and reduce it by
+ *   beta_cubic.  If the window did not recover to the previous wmax before
+ *   this loss, then the available capacity has probably decreased and wmax
+ *   is reduced further so that the window converges more quickly (fast
+ *   convergence).
+ *
+ ****************************************************************************/
+
+static uint32_t cubic_ssthresh(FAR struct tcp_conn_s *conn)
+{
+  uint32_t cwnd = conn->cwnd;
+
+  if (cwnd < conn->cubic.wmax)
+    {
+      conn->cubic.wmax = (uint32_t)(((uint64_t)cwnd *
+                                     (1024 + CUBIC_BETA)) >> 11);
+    }
+  else
+    {
+      conn->cubic.wmax = cwnd;
+    }
+
+  conn->cubic.epoch = 0;
+
+  return MAX((uint32_t)(((uint64_t)cwnd * CUBIC_BETA) >> 10),
+             2 * (uint32_t)conn->mss);
+}
+
+#endif /* CONFIG_NET_TCP_CC_CUBIC */
@@ -72,6 +72,108 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_parse_option
+ *
+ * Description:
+ *   Parse the TCP options of a received SYN or SYN-ACK segment:  The MSS
+ *   option limits the MSS of the connection and, if window scaling is
+ *   enabled, the window scale option gives the shift count to apply to
+ *   the windows that will be received from the peer.
+ *
+ * Input Parameters:
+ *   dev    - The device driver structure containing the received packet.
+ *   conn   - The TCP connection that is being established.
+ *   iplen  - Length of the IP header (IPv4_HDRLEN or IPv6_HDRLEN).
+ *   hdrlen - Offset of the TCP options in the device buffer.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void tcp_parse_option(FAR struct net_driver_s *dev,
+                             FAR struct tcp_conn_s *conn,
+                             unsigned int iplen, unsigned int hdrlen)
+{
+  FAR struct tcp_hdr_s *tcp;
+  uint16_t tmp16;
+  uint8_t  opt;
+  int      optlen;
+  int      i;
+
+  tcp    = (FAR struct tcp_hdr_s *)&dev->d_buf[iplen + NET_LL_HDRLEN(dev)];
+  optlen = ((tcp->tcpoffset >> 4) - 5) << 2;
+
+  for (i = 0; i < optlen; )
+    {
+      opt = dev->d_buf[hdrlen + i];
+      if (opt == TCP_OPT_END)
+        {
+          /* End of options. */
+
+          break;
+        }
+      else if (opt == TCP_OPT_NOOP)
+        {
+          /* NOP option. */
+
+          ++i;
+        }
+      else if (opt == TCP_OPT_MSS &&
+               dev->d_buf[hdrlen + 1 + i] == TCP_OPT_MSS_LEN)
+        {
+          uint16_t tcp_mss = TCP_MSS(dev, iplen);
+
+          /* An MSS option with the right option length. */
+
+          tmp16 = ((uint16_t)dev->d_buf[hdrlen + 2 + i] << 8) |
+                   (uint16_t)dev->d_buf[hdrlen + 3 + i];
+          conn->mss = tmp16 > tcp_mss ? tcp_mss : tmp16;
+
+          i += TCP_OPT_MSS_LEN;
+        }
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+      else if (opt == TCP_OPT_WS &&
+               dev->d_buf[hdrlen + 1 + i] == TCP_OPT_WS_LEN)
+        {
+          /* A window scale option with the right option length.  Larger
+           * shift counts than permitted are treated as the maximum.
+           */
+
+          conn->snd_scale = dev->d_buf[hdrlen + 2 + i];
+          if (conn->snd_scale > TCP_WSCALE_MAX)
+            {
+              conn->snd_scale = TCP_WSCALE_MAX;
+            }
+
+          conn->wscale = true;
+          i += TCP_OPT_WS_LEN;
+        }
+#endif
+      else
+        {
+          /* All other options have a length field, so that we easily can
+           * skip past them.
+           */
+
+          if (dev->d_buf[hdrlen + 1 + i] == 0)
+            {
+              /* If the length field is zero, the options are malformed and
+               * we don't process them further.
+               */
+
+              break;
+            }
+
+          i += dev->d_buf[hdrlen + 1 + i];
+        }
+    }
+}
+
 /****************************************************************************
  * Name: tcp_input
  *
@@ -101,9 +203,10 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
   uint16_t tmp16;
   uint16_t flags;
   uint16_t result;
-  uint8_t  opt;
   int      len;
-  int      i;
+#ifdef CONFIG_NET_TCP_CC
+  bool     fastrexmit = false;
+#endif
 
 #ifdef CONFIG_NET_STATISTICS
   /* Bump up the count of TCP packets received */
@@ -239,60 +342,22 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
 
           net_incr32(conn->rcvseq, 1);
 
-          /* Parse the TCP MSS option, if present. */
+          /* Parse the TCP MSS and window scale options, if present. */
 
           if ((tcp->tcpoffset & 0xf0) > 0x50)
             {
-              for (i = 0; i < ((tcp->tcpoffset >> 4) - 5) << 2 ; )
-                {
-                  opt = dev->d_buf[hdrlen + i];
-                  if (opt == TCP_OPT_END)
-                    {
-                      /* End of options. */
-
-                      break;
-                    }
-                  else if (opt == TCP_OPT_NOOP)
-                    {
-                      /* NOP option. */
-
-                      ++i;
-                    }
-                  else if (opt == TCP_OPT_MSS &&
-                          dev->d_buf[hdrlen + 1 + i] == TCP_OPT_MSS_LEN)
-                    {
-                      uint16_t tcp_mss = TCP_MSS(dev, iplen);
-
-                      /* An MSS option with the right option length. */
-
-                      tmp16 = ((uint16_t)dev->d_buf[hdrlen + 2 + i] << 8) |
-                               (uint16_t)dev->d_buf[hdrlen + 3 + i];
-                      conn->mss = tmp16 > tcp_mss ? tcp_mss : tmp16;
-
-                      /* And we are done processing options. */
-
-                      break;
-                    }
-                  else
-                    {
-                      /* All other options have a length field, so that we
-                       * easily can skip past them.
-                       */
-
-                      if (dev->d_buf[hdrlen + 1 + i] == 0)
-                        {
-                          /* If the length field is zero, the options are
-                           * malformed and we don't process them further.
-                           */
-
-                          break;
-                        }
-
-                      i += dev->d_buf[hdrlen + 1 + i];
-                    }
-                }
+              tcp_parse_option(dev, conn, iplen, hdrlen);
             }
 
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+          /* Scale our receive window only if the peer offered scaling */
+
+          if (conn->wscale)
+            {
+              conn->rcv_scale = tcp_get_recvwscale();
+            }
+#endif
+
           /* Our response will be a SYNACK. */
 
           tcp_synack(dev, conn, TCP_ACK | TCP_SYN);
@@ -327,6 +392,15 @@ found:
 
   conn->winsize = ((uint16_t)tcp->wnd[0] << 8) + (uint16_t)tcp->wnd[1];
 
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  /* The window in a SYN segment is never scaled */
+
+  if ((tcp->flags & TCP_SYN) == 0)
+    {
+      conn->winsize <<= conn->snd_scale;
+    }
+#endif
+
   flags = 0;
 
   /* We do a very naive form of TCP reset processing; we just accept
@@ -534,6 +608,19 @@ found:
             tcp_getsequence(conn->sndseq), ackseq, unackseq, conn->tx_unacked);
       tcp_setsequence(conn->sndseq, ackseq);
 
+#ifdef CONFIG_NET_TCP_CC
+      /* Update the congestion window.  Check for a duplicate ACK that
+       * calls for a fast retransmit.
+       */
+
+      if ((conn->tcpstateflags & TCP_STATE_MASK) == TCP_ESTABLISHED)
+        {
+          fastrexmit = tcp_cc_recvack(conn, ackseq,
+                                      dev->d_len == 0 &&
+                                      (tcp->flags & (TCP_SYN | TCP_FIN)) == 0);
+        }
+#endif
+
       /* Do RTT estimation, unless we have done retransmissions. */
 
       if (conn->nrtx == 0)
@@ -618,6 +705,9 @@ found:
             tcp_setsequence(conn->sndseq, conn->isn);
             conn->sent          = 0;
             conn->sndseq_max    = 0;
+#endif
+#ifdef CONFIG_NET_TCP_CC
+            tcp_cc_init(conn, tcp_getsequence(tcp->ackno));
 #endif
             conn->tx_unacked    = 0;
             flags               = TCP_CONNECTED;
@@ -655,60 +745,24 @@ found:
         if ((flags & TCP_ACKDATA) != 0 &&
             (tcp->flags & TCP_CTL) == (TCP_SYN | TCP_ACK))
           {
-            /* Parse the TCP MSS option, if present. */
+            /* Parse the TCP MSS and window scale options, if present. */
 
             if ((tcp->tcpoffset & 0xf0) > 0x50)
               {
-                for (i = 0; i < ((tcp->tcpoffset >> 4) - 5) << 2 ; )
-                  {
-                    opt = dev->d_buf[hdrlen + i];
-                    if (opt == TCP_OPT_END)
-                      {
-                        /* End of options. */
-
-                        break;
-                      }
-                    else if (opt == TCP_OPT_NOOP)
-                      {
-                        /* NOP option. */
-
-                        ++i;
-                      }
-                    else if (opt == TCP_OPT_MSS &&
-                              dev->d_buf[hdrlen + 1 + i] == TCP_OPT_MSS_LEN)
-                      {
-                        uint16_t tcp_mss = TCP_MSS(dev, iplen);
-
-                        /* An MSS option with the right option length. */
-
-                        tmp16 =
-                          (dev->d_buf[hdrlen + 2 + i] << 8) |
-                          dev->d_buf[hdrlen + 3 + i];
-                        conn->mss = tmp16 > tcp_mss ? tcp_mss : tmp16;
-
-                        /* And we are done processing options. */
-
-                        break;
-                      }
-                    else
-                      {
-                        /* All other options have a length field, so that we
-                         * easily can skip past them.
-                         */
-
-                        if (dev->d_buf[hdrlen + 1 + i] == 0)
-                          {
-                            /* If the length field is zero, the options are
-                             * malformed and we don't process them further.
-                             */
-
-                            break;
-                          }
-
-                        i += dev->d_buf[hdrlen + 1 + i];
-                      }
-                  }
+                tcp_parse_option(dev, conn, iplen, hdrlen);
+              }
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+            /* We offered window scaling in our SYN.  Scaling is used in
+             * neither direction unless the peer also sent the option.
+             */
+
+            if (!conn->wscale)
+              {
+                conn->rcv_scale = 0;
+                conn->snd_scale = 0;
               }
+#endif
 
             conn->tcpstateflags = TCP_ESTABLISHED;
             memcpy(conn->rcvseq, tcp->seqno, 4);
@@ -719,6 +773,9 @@ found:
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
             conn->isn           = tcp_getsequence(tcp->ackno);
             tcp_setsequence(conn->sndseq, conn->isn);
+#endif
+#ifdef CONFIG_NET_TCP_CC
+            tcp_cc_init(conn, tcp_getsequence(tcp->ackno));
 #endif
             dev->d_len          = 0;
             dev->d_sndlen       = 0;
@@ -852,6 +909,25 @@ found:
           }
 #endif
 
+#ifdef CONFIG_NET_TCP_CC
+        /* On the third duplicate ACK, retransmit now rather than waiting
+         * for the retransmission timer.  The application does the
+         * retransmission just as for a time-out.
+         */
+
+        if (fastrexmit)
+          {
+            dev->d_sndlen = 0;
+
+#ifdef CONFIG_NET_STATISTICS
+            g_netstats.tcp.rexmit++;
+#endif
+            result = tcp_callback(dev, conn, TCP_REXMIT);
+            tcp_rexmit(dev, conn, result);
+            return;
+          }
+#endif
+
         /* If d_len > 0 we have TCP data in the packet, and we flag this
          * by setting the TCP_NEWDATA flag. If the application has stopped
          * the data flow using TCP_STOPPED, we must not accept any data
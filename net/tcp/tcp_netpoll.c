@@ -141,14 +141,18 @@ static uint16_t tcp_poll_eventhandler(FAR struct net_driver_s *dev,
 
       if (eventset != 0)
         {
-          /* Stop further callbacks */
+          /* Stop further callbacks unless this is a persistent poll (as
+           * used by epoll).  That is torn down explicitly.
+           */
 
-          info->cb->flags   = 0;
-          info->cb->priv    = NULL;
-          info->cb->event   = NULL;
+          if (info->fds->cb == NULL)
+            {
+              info->cb->flags   = 0;
+              info->cb->priv    = NULL;
+              info->cb->event   = NULL;
+            }
 
-          info->fds->revents |= eventset;
-          nxsem_post(info->fds->sem);
+          poll_notify(&info->fds, 1, eventset);
         }
     }
 
@@ -203,8 +207,7 @@ static inline void tcp_iob_work(FAR void *arg)
            * exceptional event.
            */
 
-          fds->revents |= (POLLERR | POLLHUP);
-          nxsem_post(fds->sem);
+          poll_notify(&fds, 1, POLLERR | POLLHUP);
         }
     }
 
@@ -221,8 +224,7 @@ static inline void tcp_iob_work(FAR void *arg)
         {
           /* Yes.. then signal the poll logic */
 
-          fds->revents |= POLLWRNORM;
-          nxsem_post(fds->sem);
+          poll_notify(&fds, 1, POLLWRNORM);
         }
       else
         {
@@ -406,7 +408,7 @@ int tcp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
     {
       /* Yes.. then signal the poll logic */
 
-      nxsem_post(fds->sem);
+      poll_notify(&fds, 1, fds->revents);
     }
 
 #if defined(CONFIG_NET_TCP_WRITE_BUFFERS) && defined(CONFIG_IOB_NOTIFIER)
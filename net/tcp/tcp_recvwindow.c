@@ -52,6 +52,20 @@
 
 #include "tcp/tcp.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The largest receive window that we will ever compute.  Without window
+ * scaling, this is limited by the 16-bit window field of the TCP header.
+ */
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+#  define TCP_MAX_RECVWINDOW ((uint32_t)UINT16_MAX << TCP_WSCALE_MAX)
+#else
+#  define TCP_MAX_RECVWINDOW UINT16_MAX
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -60,21 +74,26 @@
  * Name: tcp_get_recvwindow
  *
  * Description:
- *   Calculate the TCP receive window for the specified device.
+ *   Calculate the TCP receive window for the specified device and
+ *   connection.
  *
  * Input Parameters:
- *   dev - The device whose TCP receive window will be updated.
+ *   dev  - The device whose TCP receive window will be updated.
+ *   conn - The connection that will advertise the window.
  *
  * Returned Value:
- *   The value of the TCP receive window to use.
+ *   The value of the TCP receive window to use.  This is the value for
+ *   the window field of the TCP header, i.e., it is already scaled if
+ *   window scaling is in use on the connection.
  *
  ****************************************************************************/
 
-uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev)
+uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev,
+                            FAR struct tcp_conn_s *conn)
 {
   uint16_t iplen;
   uint16_t mss;
-  uint16_t recvwndo;
+  uint32_t recvwndo;
 #ifdef CONFIG_NET_TCP_READAHEAD
   int  niob_avail;
   int  nqentry_avail;
@@ -158,14 +177,14 @@ uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev)
        */
 
       rwnd = (niob_avail * CONFIG_IOB_BUFSIZE) + mss;
-      if (rwnd > UINT16_MAX)
+      if (rwnd > TCP_MAX_RECVWINDOW)
         {
-          rwnd = UINT16_MAX;
+          rwnd = TCP_MAX_RECVWINDOW;
         }
 
       /* Save the new receive window size */
 
-      recvwndo = (uint16_t)rwnd;
+      recvwndo = rwnd;
     }
   else /* nqentry_avail == 0 || niob_avail == 0 */
 #endif
@@ -181,5 +200,51 @@ uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev)
       recvwndo = mss;
     }
 
-  return recvwndo;
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  /* The window in a SYN or SYN-ACK segment is never scaled.  Otherwise,
+   * scale the window as agreed with the peer (rounding down).
+   */
+
+  if ((conn->tcpstateflags & TCP_STATE_MASK) != TCP_SYN_SENT &&
+      (conn->tcpstateflags & TCP_STATE_MASK) != TCP_SYN_RCVD)
+    {
+      recvwndo >>= conn->rcv_scale;
+    }
+#else
+  UNUSED(conn);
+#endif
+
+  return recvwndo > UINT16_MAX ? UINT16_MAX : (uint16_t)recvwndo;
+}
+
+/****************************************************************************
+ * Name: tcp_get_recvwscale
+ *
+ * Description:
+ *   Return the window scale shift count that we offer to the remote peer.
+ *   This is the smallest shift count that can express the largest receive
+ *   window that tcp_get_recvwindow() can return.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+uint8_t tcp_get_recvwscale(void)
+{
+#ifdef CONFIG_NET_TCP_READAHEAD
+  uint32_t maxwndo = (uint32_t)CONFIG_IOB_NBUFFERS * CONFIG_IOB_BUFSIZE +
+                     MAX_NETDEV_PKTSIZE;
+  uint8_t shift = 0;
+
+  while (shift < TCP_WSCALE_MAX && (maxwndo >> shift) > UINT16_MAX)
+    {
+      shift++;
+    }
+
+  return shift;
+#else
+  /* Without read-ahead buffering, the window never exceeds one MSS */
+
+  return 0;
+#endif
 }
+#endif /* CONFIG_NET_TCP_WINDOW_SCALE */
@@ -360,7 +360,7 @@ static void tcp_sendcommon(FAR struct net_driver_s *dev,
     {
       /* Update the TCP received window based on I/O buffer availability */
 
-      uint16_t recvwndo = tcp_get_recvwindow(dev);
+      uint16_t recvwndo = tcp_get_recvwindow(dev, conn);
 
       /* Set the TCP Window */
 
@@ -573,7 +573,24 @@ void tcp_synack(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
                 uint8_t ack)
 {
   struct tcp_hdr_s *tcp;
+  FAR uint8_t *opt;
   uint16_t tcp_mss;
+  uint16_t optlen = TCP_OPT_MSS_LEN;
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  /* We offer window scaling in our SYN, but include the option in a
+   * SYN-ACK only if the peer included it in its SYN (RFC 7323).  The
+   * option is preceded by a NOP so that the options remain word aligned.
+   */
+
+  bool wscale = (ack & TCP_SYN) != 0 &&
+                ((ack & TCP_ACK) == 0 || conn->wscale);
+
+  if (wscale)
+    {
+      optlen += 1 + TCP_OPT_WS_LEN;
+    }
+#endif
 
   /* Get values that vary with the underlying IP domain */
 
@@ -589,7 +606,7 @@ void tcp_synack(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
 
       /* Set the packet length for the TCP Maximum Segment Size */
 
-      dev->d_len  = IPv6TCP_HDRLEN + TCP_OPT_MSS_LEN;
+      dev->d_len  = IPv6TCP_HDRLEN + optlen;
     }
 #endif /* CONFIG_NET_IPv6 */
 
@@ -605,7 +622,7 @@ void tcp_synack(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
 
       /* Set the packet length for the TCP Maximum Segment Size */
 
-      dev->d_len  = IPv4TCP_HDRLEN + TCP_OPT_MSS_LEN;
+      dev->d_len  = IPv4TCP_HDRLEN + optlen;
     }
 #endif /* CONFIG_NET_IPv4 */
 
@@ -613,13 +630,28 @@ void tcp_synack(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
 
   tcp->flags      = ack;
 
-  /* We send out the TCP Maximum Segment Size option with our ACK. */
+  /* We send out the TCP Maximum Segment Size option with our ACK.  The
+   * options follow the fixed TCP header in the packet buffer.  They may
+   * extend beyond the optdata[] field of struct tcp_hdr_s.
+   */
+
+  opt    = (FAR uint8_t *)tcp + TCP_HDRLEN;
+  opt[0] = TCP_OPT_MSS;
+  opt[1] = TCP_OPT_MSS_LEN;
+  opt[2] = tcp_mss >> 8;
+  opt[3] = tcp_mss & 0xff;
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  if (wscale)
+    {
+      opt[4] = TCP_OPT_NOOP;
+      opt[5] = TCP_OPT_WS;
+      opt[6] = TCP_OPT_WS_LEN;
+      opt[7] = conn->rcv_scale;
+    }
+#endif
 
-  tcp->optdata[0] = TCP_OPT_MSS;
-  tcp->optdata[1] = TCP_OPT_MSS_LEN;
-  tcp->optdata[2] = tcp_mss >> 8;
-  tcp->optdata[3] = tcp_mss & 0xff;
-  tcp->tcpoffset  = ((TCP_HDRLEN + TCP_OPT_MSS_LEN) / 4) << 4;
+  tcp->tcpoffset  = ((TCP_HDRLEN + optlen) / 4) << 4;
 
   /* Complete the common portions of the TCP message */
 
@@ -695,6 +695,9 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
       FAR struct tcp_wrbuffer_s *wrb;
       uint32_t predicted_seqno;
       size_t sndlen;
+#ifdef CONFIG_NET_TCP_CC
+      uint32_t sndwnd;
+#endif
 
       /* Peek at the head of the write queue (but don't remove anything
        * from the write queue yet).  We know from the above test that
@@ -721,10 +724,29 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
           sndlen = conn->winsize;
         }
 
+#ifdef CONFIG_NET_TCP_CC
+      /* Do not exceed the congestion window.  A partial segment is not
+       * sent while other data is in flight; the ACK of that data will
+       * open the window further.
+       */
+
+      sndwnd = tcp_cc_sndwnd(conn);
+      sndwnd = sndwnd > conn->tx_unacked ? sndwnd - conn->tx_unacked : 0;
+      if (sndlen > sndwnd)
+        {
+          if (conn->tx_unacked > 0)
+            {
+              return flags;
+            }
+
+          sndlen = sndwnd;
+        }
+#endif
+
       ninfo("SEND: wrb=%p pktlen=%u sent=%u sndlen=%u mss=%u "
-            "winsize=%u\n",
+            "winsize=%lu\n",
             wrb, TCP_WBPKTLEN(wrb), TCP_WBSENT(wrb), sndlen, conn->mss,
-            conn->winsize);
+            (unsigned long)conn->winsize);
 
       /* Set the sequence number for this segment.  If we are
        * retransmitting, then the sequence number will already
@@ -345,9 +345,15 @@ static uint16_t sendfile_eventhandler(FAR struct net_driver_s *dev,
           sndlen = conn->mss;
         }
 
-      /* Check if we have "space" in the window */
+      /* Check if we have "space" in the window.  With congestion control,
+       * the data in flight is also limited by the congestion window.
+       */
 
-      if ((pstate->snd_sent - pstate->snd_acked + sndlen) < conn->winsize)
+      if ((pstate->snd_sent - pstate->snd_acked + sndlen) < conn->winsize
+#ifdef CONFIG_NET_TCP_CC
+          && (pstate->snd_sent - pstate->snd_acked + sndlen) <= conn->cwnd
+#endif
+         )
         {
           uint32_t seqno;
 
@@ -118,6 +118,10 @@ struct udp_conn_s
 
   /* UDP-specific content follows */
 
+#ifdef CONFIG_NET_UDP_CONN_HASH
+  FAR struct udp_conn_s *hnext; /* Next bound connection in the same hash
+                                 * bucket */
+#endif
   union ip_binding_u u;   /* IP address binding */
   uint16_t lport;         /* Bound local port number (network byte order) */
   uint16_t rport;         /* Remote port number (network byte order) */
@@ -73,6 +73,17 @@
 #define IPv4BUF ((struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 #define IPv6BUF ((struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 
+/* Candidate connections for an incoming datagram are either the
+ * connections in one hash bucket or all allocated connections.
+ */
+
+#ifdef CONFIG_NET_UDP_CONN_HASH
+#  define UDP_HASHKEY(p)     (ntohs(p) % CONFIG_NET_UDP_CONN_HASHSIZE)
+#  define UDP_NEXT_ACTIVE(c) ((c)->hnext)
+#else
+#  define UDP_NEXT_ACTIVE(c) ((FAR struct udp_conn_s *)(c)->node.flink)
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -90,6 +101,14 @@ static sem_t g_free_sem;
 
 static dq_queue_t g_active_udp_connections;
 
+#ifdef CONFIG_NET_UDP_CONN_HASH
+/* The bound connections hashed on the local port number.  Each bucket is a
+ * singly linked list chained through hnext, in the order of binding.
+ */
+
+static FAR struct udp_conn_s *g_udp_connhash[CONFIG_NET_UDP_CONN_HASHSIZE];
+#endif
+
 /* Last port used by a UDP connection connection. */
 
 static uint16_t g_last_udp_port;
@@ -126,6 +145,63 @@ static inline void _udp_semtake(FAR sem_t *sem)
 
 #define _udp_semgive(sem) nxsem_post(sem)
 
+/****************************************************************************
+ * Name: udp_setlport()
+ *
+ * Description:
+ *   Bind the connection to a local port number (network byte order) or,
+ *   if the port number is zero, unbind it.  The connection is also moved
+ *   to the corresponding hash bucket.
+ *
+ ****************************************************************************/
+
+static void udp_setlport(FAR struct udp_conn_s *conn, uint16_t portno)
+{
+#ifdef CONFIG_NET_UDP_CONN_HASH
+  FAR struct udp_conn_s **link;
+
+  net_lock();
+
+  /* Remove the connection from the bucket of its old port number */
+
+  if (conn->lport != 0)
+    {
+      for (link = &g_udp_connhash[UDP_HASHKEY(conn->lport)];
+           *link != NULL;
+           link = &(*link)->hnext)
+        {
+          if (*link == conn)
+            {
+              *link = conn->hnext;
+              break;
+            }
+        }
+    }
+
+  /* And add it to the end of the bucket of the new port number so that
+   * connections bound to the same port are examined in binding order.
+   */
+
+  conn->lport = portno;
+  conn->hnext = NULL;
+
+  if (portno != 0)
+    {
+      for (link = &g_udp_connhash[UDP_HASHKEY(portno)];
+           *link != NULL;
+           link = &(*link)->hnext)
+        {
+        }
+
+      *link = conn;
+    }
+
+  net_unlock();
+#else
+  conn->lport = portno;
+#endif
+}
+
 /****************************************************************************
  * Name: udp_find_conn()
  *
@@ -142,13 +218,24 @@ static FAR struct udp_conn_s *udp_find_conn(uint8_t domain,
                                             uint16_t portno)
 {
   FAR struct udp_conn_s *conn;
+#ifndef CONFIG_NET_UDP_CONN_HASH
   int i;
+#endif
 
-  /* Now search each connection structure. */
+  /* Now search each connection structure (or only those bound to a port
+   * number in the same hash bucket).
+   */
 
+#ifdef CONFIG_NET_UDP_CONN_HASH
+  for (conn = g_udp_connhash[UDP_HASHKEY(portno)];
+       conn != NULL;
+       conn = conn->hnext)
+    {
+#else
   for (i = 0; i < CONFIG_NET_UDP_CONNS; i++)
     {
       conn = &g_udp_connections[i];
+#endif
 
       /* If the port local port number assigned to the connections matches
        * AND the IP address of the connection matches, then return a
@@ -266,7 +353,11 @@ static inline FAR struct udp_conn_s *
   FAR struct ipv4_hdr_s *ip = IPv4BUF;
   FAR struct udp_conn_s *conn;
 
+#ifdef CONFIG_NET_UDP_CONN_HASH
+  conn = g_udp_connhash[UDP_HASHKEY(udp->destport)];
+#else
   conn = (FAR struct udp_conn_s *)g_active_udp_connections.head;
+#endif
   while (conn)
     {
       /* If the local UDP port is non-zero, the connection is considered
@@ -377,9 +468,9 @@ static inline FAR struct udp_conn_s *
             }
         }
 
-      /* Look at the next active connection */
+      /* Look at the next candidate connection */
 
-      conn = (FAR struct udp_conn_s *)conn->node.flink;
+      conn = UDP_NEXT_ACTIVE(conn);
     }
 
   return conn;
@@ -405,7 +496,11 @@ static inline FAR struct udp_conn_s *
   FAR struct ipv6_hdr_s *ip = IPv6BUF;
   FAR struct udp_conn_s *conn;
 
+#ifdef CONFIG_NET_UDP_CONN_HASH
+  conn = g_udp_connhash[UDP_HASHKEY(udp->destport)];
+#else
   conn = (FAR struct udp_conn_s *)g_active_udp_connections.head;
+#endif
   while (conn != NULL)
     {
       /* If the local UDP port is non-zero, the connection is considered
@@ -516,9 +611,9 @@ static inline FAR struct udp_conn_s *
             }
         }
 
-      /* Look at the next active connection */
+      /* Look at the next candidate connection */
 
-      conn = (FAR struct udp_conn_s *)conn->node.flink;
+      conn = UDP_NEXT_ACTIVE(conn);
     }
 
   return conn;
@@ -548,6 +643,10 @@ void udp_initialize(void)
   dq_init(&g_active_udp_connections);
   nxsem_init(&g_free_sem, 0, 1);
 
+#ifdef CONFIG_NET_UDP_CONN_HASH
+  memset(g_udp_connhash, 0, sizeof(g_udp_connhash));
+#endif
+
   for (i = 0; i < CONFIG_NET_UDP_CONNS; i++)
     {
       /* Mark the connection closed and move it to the free list */
@@ -624,7 +723,7 @@ void udp_free(FAR struct udp_conn_s *conn)
   DEBUGASSERT(conn->crefs == 0);
 
   _udp_semtake(&g_free_sem);
-  conn->lport = 0;
+  udp_setlport(conn, 0);
 
   /* Remove the connection from the active list */
 
@@ -775,8 +874,8 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
     {
       /* Yes.. Select any unused local port number */
 
-      conn->lport = htons(udp_select_port(conn->domain, &conn->u));
-      ret         = OK;
+      udp_setlport(conn, htons(udp_select_port(conn->domain, &conn->u)));
+      ret = OK;
     }
   else
     {
@@ -790,12 +889,12 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
         {
           /* No.. then bind the socket to the port */
 
-          conn->lport = portno;
-          ret         = OK;
+          udp_setlport(conn, portno);
+          ret = OK;
         }
       else
         {
-          ret         = -EADDRINUSE;
+          ret = -EADDRINUSE;
         }
 
       net_unlock();
@@ -843,7 +942,7 @@ int udp_connect(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
        * connection structure.
        */
 
-      conn->lport = htons(udp_select_port(conn->domain, &conn->u));
+      udp_setlport(conn, htons(udp_select_port(conn->domain, &conn->u)));
     }
 
   /* Is there a remote port (rport)? */
@@ -138,8 +138,7 @@ static uint16_t udp_poll_eventhandler(FAR struct net_driver_s *dev,
 
       if (eventset)
         {
-          info->fds->revents |= eventset;
-          nxsem_post(info->fds->sem);
+          poll_notify(&info->fds, 1, eventset);
         }
     }
 
@@ -194,8 +193,7 @@ static inline void udp_iob_work(FAR void *arg)
         {
           /* Yes.. then signal the poll logic */
 
-          fds->revents |= POLLWRNORM;
-          nxsem_post(fds->sem);
+          poll_notify(&fds, 1, POLLWRNORM);
         }
       else
         {
@@ -333,7 +331,7 @@ int udp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
     {
       /* Yes.. then signal the poll logic */
 
-      nxsem_post(fds->sem);
+      poll_notify(&fds, 1, fds->revents);
     }
 
 #if defined(CONFIG_NET_UDP_WRITE_BUFFERS) && defined(CONFIG_IOB_NOTIFIER)
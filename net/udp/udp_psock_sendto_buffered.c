@@ -532,43 +532,33 @@ static uint16_t sendto_eventhandler(FAR struct net_driver_s *dev,
 }
 
 /****************************************************************************
- * Public Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: psock_udp_sendto
+ * Name: sendto_check
  *
  * Description:
- *   This function implements the UDP-specific logic of the standard
- *   sendto() socket operation.
+ *   Verify that the destination of a datagram is consistent with the state
+ *   of the socket and that the destination address maps to a valid MAC
+ *   address.
  *
  * Input Parameters:
  *   psock    A pointer to a NuttX-specific, internal socket structure
- *   buf      Data to send
- *   len      Length of data to send
- *   flags    Send flags
- *   to       Address of recipient
- *   tolen    The length of the address structure
- *
- *   NOTE: All input parameters were verified by sendto() before this
- *   function was called.
+ *   to       Address of recipient (NULL if the socket is connected)
  *
  * Returned Value:
- *   On success, returns the number of characters sent.  On  error,
- *   a negated errno value is returned.  See the description in
- *   net/socket/sendto.c for the list of appropriate return value.
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   any failure.
  *
  ****************************************************************************/
 
-ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
-                         size_t len, int flags, FAR const struct sockaddr *to,
-                         socklen_t tolen)
+static int sendto_check(FAR struct socket *psock,
+                        FAR const struct sockaddr *to)
 {
-  FAR struct udp_conn_s *conn;
-  FAR struct udp_wrbuffer_s *wrb;
-  bool empty;
+#if defined(CONFIG_NET_ARP_SEND) || defined(CONFIG_NET_ICMPv6_NEIGHBOR)
+  FAR struct udp_conn_s *conn = (FAR struct udp_conn_s *)psock->s_conn;
   int ret = OK;
 
+  DEBUGASSERT(conn);
+#endif
+
   /* If the UDP socket was previously assigned a remote peer address via
    * connect(), then as with connection-mode socket, sendto() may not be
    * used with a non-NULL destination address.  Normally send() would be
@@ -597,11 +587,6 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
       return -EDESTADDRREQ;
     }
 
-  /* Get the underlying the UDP connection structure.  */
-
-  conn = (FAR struct udp_conn_s *)psock->s_conn;
-  DEBUGASSERT(conn);
-
 #if defined(CONFIG_NET_ARP_SEND) || defined(CONFIG_NET_ICMPv6_NEIGHBOR)
 #ifdef CONFIG_NET_ARP_SEND
   /* Assure the the IPv4 destination address maps to a valid MAC address in
@@ -690,6 +675,171 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
     }
 #endif /* CONFIG_NET_ARP_SEND || CONFIG_NET_ICMPv6_NEIGHBOR */
 
+  return OK;
+}
+
+/****************************************************************************
+ * Name: sendto_enqueue
+ *
+ * Description:
+ *   Set the destination address of a filled write buffer and add it to the
+ *   tail of the write queue of the connection.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   wrb      The write buffer to be queued
+ *   to       Address of recipient (NULL if the socket is connected)
+ *   tolen    The length of the address structure
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   any failure.  On failure, the write buffer is not queued and still
+ *   belongs to the caller.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static int sendto_enqueue(FAR struct socket *psock,
+                          FAR struct udp_wrbuffer_s *wrb,
+                          FAR const struct sockaddr *to, socklen_t tolen)
+{
+  FAR struct udp_conn_s *conn = (FAR struct udp_conn_s *)psock->s_conn;
+  bool empty;
+  int ret;
+
+  /* Check if the socket is connected */
+
+  if (_SS_ISCONNECTED(psock->s_flags))
+    {
+      /* Yes.. get the connection address from the connection structure */
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+      if (conn->domain == PF_INET)
+#endif
+        {
+          FAR struct sockaddr_in *addr4 =
+            (FAR struct sockaddr_in *)&wrb->wb_dest;
+
+          addr4->sin_family = AF_INET;
+          addr4->sin_port   = conn->rport;
+          net_ipv4addr_copy(addr4->sin_addr.s_addr, conn->u.ipv4.raddr);
+        }
+#endif /* CONFIG_NET_IPv4 */
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+      else
+#endif
+        {
+          FAR struct sockaddr_in6 *addr6 =
+            (FAR struct sockaddr_in6 *)&wrb->wb_dest;
+
+          addr6->sin6_family = AF_INET6;
+          addr6->sin6_port   = conn->rport;
+          net_ipv6addr_copy(addr6->sin6_addr.s6_addr, conn->u.ipv6.raddr);
+        }
+#endif /* CONFIG_NET_IPv6 */
+    }
+
+  /* Not connected.  Use the provided destination address */
+
+  else
+    {
+      memcpy(&wrb->wb_dest, to, tolen);
+    }
+
+#ifdef CONFIG_NET_SOCKOPTS
+  wrb->wb_start = clock_systimer();
+#endif
+
+  /* Dump I/O buffer chain */
+
+  UDP_WBDUMP("I/O buffer chain", wrb, wrb->wb_iob->io_pktlen, 0);
+
+  /* sendto_eventhandler() will send data in FIFO order from the
+   * conn->write_q.
+   *
+   * REVISIT:  Why FIFO order?  Because it is easy.  In a real world
+   * environment where there are multiple network devices this might
+   * be inefficient because we could be sending data to different
+   * device out-of-queued-order to optimize performance.  Sending
+   * data to different networks from a single UDP socket is probably
+   * not a very common use case, however.
+   */
+
+  empty = sq_empty(&conn->write_q);
+
+  sq_addlast(&wrb->wb_node, &conn->write_q);
+  ninfo("Queued WRB=%p pktlen=%u write_q(%p,%p)\n",
+        wrb, wrb->wb_iob->io_pktlen,
+        conn->write_q.head, conn->write_q.tail);
+
+  if (empty)
+    {
+      /* The new write buffer lies at the head of the write queue.  Set
+       * up for the next packet transfer by setting the connection
+       * address to the address of the next packet now at the header of
+       * the write buffer queue.
+       */
+
+      ret = sendto_next_transfer(psock, conn);
+      if (ret < 0)
+        {
+          (void)sq_remlast(&conn->write_q);
+          return ret;
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_udp_sendto
+ *
+ * Description:
+ *   This function implements the UDP-specific logic of the standard
+ *   sendto() socket operation.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   buf      Data to send
+ *   len      Length of data to send
+ *   flags    Send flags
+ *   to       Address of recipient
+ *   tolen    The length of the address structure
+ *
+ *   NOTE: All input parameters were verified by sendto() before this
+ *   function was called.
+ *
+ * Returned Value:
+ *   On success, returns the number of characters sent.  On  error,
+ *   a negated errno value is returned.  See the description in
+ *   net/socket/sendto.c for the list of appropriate return value.
+ *
+ ****************************************************************************/
+
+ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
+                         size_t len, int flags, FAR const struct sockaddr *to,
+                         socklen_t tolen)
+{
+  FAR struct udp_wrbuffer_s *wrb;
+  int ret;
+
+  /* Verify the destination address */
+
+  ret = sendto_check(psock, to);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
   /* Dump the incoming buffer */
 
   BUF_DUMP("psock_udp_send", buf, len);
@@ -715,55 +865,6 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
           goto errout_with_lock;
         }
 
-      /* Initialize the write buffer
-       *
-       * Check if the socket is connected
-       */
-
-      if (_SS_ISCONNECTED(psock->s_flags))
-        {
-          /* Yes.. get the connection address from the connection structure */
-
-#ifdef CONFIG_NET_IPv4
-#ifdef CONFIG_NET_IPv6
-          if (conn->domain == PF_INET)
-#endif
-            {
-              FAR struct sockaddr_in *addr4 =
-                (FAR struct sockaddr_in *)&wrb->wb_dest;
-
-              addr4->sin_family = AF_INET;
-              addr4->sin_port   = conn->rport;
-              net_ipv4addr_copy(addr4->sin_addr.s_addr, conn->u.ipv4.raddr);
-            }
-#endif /* CONFIG_NET_IPv4 */
-
-#ifdef CONFIG_NET_IPv6
-#ifdef CONFIG_NET_IPv4
-          else
-#endif
-            {
-              FAR struct sockaddr_in6 *addr6 =
-                (FAR struct sockaddr_in6 *)&wrb->wb_dest;
-
-              addr6->sin6_family = AF_INET6;
-              addr6->sin6_port   = conn->rport;
-              net_ipv6addr_copy(addr6->sin6_addr.s6_addr, conn->u.ipv6.raddr);
-            }
-#endif /* CONFIG_NET_IPv6 */
-        }
-
-      /* Not connected.  Use the provided destination address */
-
-      else
-        {
-          memcpy(&wrb->wb_dest, to, tolen);
-        }
-
-#ifdef CONFIG_NET_SOCKOPTS
-      wrb->wb_start = clock_systimer();
-#endif
-
       /* Copy the user data into the write buffer.  We cannot wait for
        * buffer space if the socket was opened non-blocking.
        */
@@ -784,42 +885,12 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
           goto errout_with_wrb;
         }
 
-      /* Dump I/O buffer chain */
-
-      UDP_WBDUMP("I/O buffer chain", wrb, wrb->wb_iob->io_pktlen, 0);
-
-      /* sendto_eventhandler() will send data in FIFO order from the
-       * conn->write_q.
-       *
-       * REVISIT:  Why FIFO order?  Because it is easy.  In a real world
-       * environment where there are multiple network devices this might
-       * be inefficient because we could be sending data to different
-       * device out-of-queued-order to optimize performance.  Sending
-       * data to different networks from a single UDP socket is probably
-       * not a very common use case, however.
-       */
+      /* Queue the write buffer for transmission */
 
-      empty = sq_empty(&conn->write_q);
-
-      sq_addlast(&wrb->wb_node, &conn->write_q);
-      ninfo("Queued WRB=%p pktlen=%u write_q(%p,%p)\n",
-            wrb, wrb->wb_iob->io_pktlen,
-            conn->write_q.head, conn->write_q.tail);
-
-      if (empty)
+      ret = sendto_enqueue(psock, wrb, to, tolen);
+      if (ret < 0)
         {
-          /* The new write buffer lies at the head of the write queue.  Set
-           * up for the next packet transfer by setting the connection
-           * address to the address of the next packet now at the header of
-           * the write buffer queue.
-           */
-
-          ret = sendto_next_transfer(psock, conn);
-          if (ret < 0)
-            {
-              (void)sq_remlast(&conn->write_q);
-              goto errout_with_wrb;
-            }
+          goto errout_with_wrb;
         }
 
       net_unlock();
@@ -841,6 +912,112 @@ errout_with_lock:
   return ret;
 }
 
+/****************************************************************************
+ * Name: psock_udp_sendiob
+ *
+ * Description:
+ *   Send a datagram that the caller has already assembled in an I/O buffer
+ *   chain.  The I/O buffer chain is queued for transmission as it is; the
+ *   data is not copied into a new write buffer as it would be by
+ *   psock_udp_sendto().
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   iob      The I/O buffer chain holding the datagram payload
+ *   to       Address of recipient (NULL if the socket is connected)
+ *   tolen    The length of the address structure
+ *
+ * Returned Value:
+ *   On success, returns the number of bytes that will be sent and the I/O
+ *   buffer chain belongs to the network.  On any failure, a negated errno
+ *   value is returned and the I/O buffer chain still belongs to the caller.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_UDP_ZEROCOPY
+ssize_t psock_udp_sendiob(FAR struct socket *psock, FAR struct iob_s *iob,
+                          FAR const struct sockaddr *to, socklen_t tolen)
+{
+  FAR struct udp_wrbuffer_s *wrb;
+  ssize_t len;
+  int ret;
+
+  DEBUGASSERT(iob != NULL);
+
+  /* Verify that this is a valid UDP socket */
+
+  if (psock == NULL || psock->s_crefs <= 0)
+    {
+      return -EBADF;
+    }
+
+  if (psock->s_type != SOCK_DGRAM ||
+      (psock->s_domain != PF_INET && psock->s_domain != PF_INET6) ||
+      psock->s_sockif != inet_sockif(psock->s_domain, SOCK_DGRAM,
+                                     IPPROTO_UDP))
+    {
+      return -EOPNOTSUPP;
+    }
+
+  /* Verify the destination address */
+
+  ret = sendto_check(psock, to);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  len = iob->io_pktlen;
+  if (len <= 0)
+    {
+      /* Nothing to send.  As with psock_udp_sendto(), no datagram is
+       * generated.
+       */
+
+      iob_free_chain(iob, IOBUSER_NET_SOCK_UDP);
+      return 0;
+    }
+
+  /* Allocate a write buffer.  Careful, the network will be momentarily
+   * unlocked here.
+   */
+
+  net_lock();
+  wrb = udp_wrbuffer_alloc();
+  if (wrb == NULL)
+    {
+      nerr("ERROR: Failed to allocate write buffer\n");
+      net_unlock();
+      return -ENOMEM;
+    }
+
+  /* Replace the empty I/O buffer that came with the write buffer with the
+   * caller's I/O buffer chain.
+   */
+
+  iob_free_chain(wrb->wb_iob, IOBUSER_NET_UDP_WRITEBUFFER);
+  wrb->wb_iob = iob;
+
+  /* Queue the write buffer for transmission */
+
+  ret = sendto_enqueue(psock, wrb, to, tolen);
+  if (ret < 0)
+    {
+      /* The I/O buffer chain still belongs to the caller.  Release only
+       * the write buffer.
+       */
+
+      wrb->wb_iob = NULL;
+      udp_wrbuffer_release(wrb);
+      net_unlock();
+      return ret;
+    }
+
+  net_unlock();
+  return len;
+}
+#endif /* CONFIG_NET_UDP_ZEROCOPY */
+
 /****************************************************************************
  * Name: psock_udp_cansend
  *
@@ -0,0 +1,365 @@
+/****************************************************************************
+ * net/udp/udp_recviob.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <semaphore.h>
+#include <errno.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <netinet/in.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+
+#include "devif/devif.h"
+#include "socket/socket.h"
+#include "inet/inet.h"
+#include "udp/udp.h"
+
+#ifdef CONFIG_NET_UDP_ZEROCOPY
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct udp_recviob_s
+{
+  sem_t ri_sem;                  /* Posted when a datagram may be available */
+  int   ri_result;               /* Negated errno if the wait must end */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: recviob_eventhandler
+ *
+ * Description:
+ *   Wake up the thread waiting in psock_udp_recviob().  New data is not
+ *   consumed here:  UDP_NEWDATA is left set so that udp_callback() will
+ *   add the datagram to the read-ahead queue where the waiting thread will
+ *   find it.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static uint16_t recviob_eventhandler(FAR struct net_driver_s *dev,
+                                     FAR void *pvconn, FAR void *pvpriv,
+                                     uint16_t flags)
+{
+  FAR struct udp_recviob_s *pstate = (FAR struct udp_recviob_s *)pvpriv;
+
+  ninfo("flags: %04x\n", flags);
+
+  if (pstate != NULL)
+    {
+      if ((flags & NETDEV_DOWN) != 0)
+        {
+          nerr("ERROR: Network is down\n");
+          pstate->ri_result = -ENETUNREACH;
+          nxsem_post(&pstate->ri_sem);
+        }
+      else if ((flags & UDP_NEWDATA) != 0)
+        {
+          nxsem_post(&pstate->ri_sem);
+        }
+    }
+
+  return flags;
+}
+
+/****************************************************************************
+ * Name: recviob_dequeue
+ *
+ * Description:
+ *   Remove the datagram at the head of the read-ahead queue and strip the
+ *   source address that was stored in front of the payload.
+ *
+ * Returned Value:
+ *   The I/O buffer chain holding only the datagram payload or NULL if the
+ *   read-ahead queue is empty.  A zero-length datagram is returned as a
+ *   single, empty I/O buffer.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static FAR struct iob_s *recviob_dequeue(FAR struct udp_conn_s *conn,
+                                         FAR struct sockaddr *from,
+                                         FAR socklen_t *fromlen)
+{
+  FAR struct iob_s *iob;
+  unsigned int hdrlen;
+  uint8_t src_addr_size;
+
+  iob = iob_remove_queue(&conn->readahead);
+  if (iob == NULL)
+    {
+      return NULL;
+    }
+
+  /* The read-ahead data begins with the size of the source address and the
+   * source address itself (see udp_datahandler()).
+   */
+
+  src_addr_size = 0;
+  (void)iob_copyout(&src_addr_size, iob, sizeof(uint8_t), 0);
+
+  if (from != NULL && fromlen != NULL)
+    {
+      socklen_t len = *fromlen;
+
+      if (len > (socklen_t)src_addr_size)
+        {
+          len = (socklen_t)src_addr_size;
+        }
+
+      (void)iob_copyout((FAR uint8_t *)from, iob, len, sizeof(uint8_t));
+      *fromlen = len;
+    }
+
+  /* A zero-length datagram has nothing after the source address.  Don't
+   * leave it to iob_trimhead() to decide what is left over:  NULL would
+   * be taken for an empty read-ahead queue.
+   */
+
+  hdrlen = src_addr_size + sizeof(uint8_t);
+  if (iob->io_pktlen <= hdrlen)
+    {
+      if (iob->io_flink != NULL)
+        {
+          iob_free_chain(iob->io_flink, IOBUSER_NET_UDP_READAHEAD);
+          iob->io_flink = NULL;
+        }
+
+      iob->io_len    = 0;
+      iob->io_offset = 0;
+      iob->io_pktlen = 0;
+      return iob;
+    }
+
+  return iob_trimhead(iob, hdrlen, IOBUSER_NET_UDP_READAHEAD);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_udp_recviob
+ *
+ * Description:
+ *   Receive the next datagram from a UDP socket as an I/O buffer chain.
+ *   The I/O buffer chain is taken from the read-ahead queue as it is; the
+ *   data is not copied into a user buffer as it would be by
+ *   psock_recvfrom().
+ *
+ *   The caller owns the returned I/O buffer chain and must free it with
+ *   iob_free_chain() or pass it on to psock_udp_sendiob().
+ *
+ * Input Parameters:
+ *   psock   - A pointer to a NuttX-specific, internal socket structure
+ *   iob     - The location to return the I/O buffer chain
+ *   from    - Address of source (may be NULL)
+ *   fromlen - The length of the address structure
+ *
+ * Returned Value:
+ *   On success, the size of the datagram is returned.  Otherwise, a
+ *   negated errno value is returned:  EAGAIN if the socket is non-blocking
+ *   and no datagram is available or SO_RCVTIMEO expired, ENETUNREACH if
+ *   the network went down, or EINTR if the wait was interrupted.
+ *
+ ****************************************************************************/
+
+ssize_t psock_udp_recviob(FAR struct socket *psock, FAR struct iob_s **iob,
+                          FAR struct sockaddr *from, FAR socklen_t *fromlen)
+{
+  FAR struct udp_conn_s *conn;
+  FAR struct net_driver_s *dev;
+  FAR struct devif_callback_s *cb;
+  FAR struct timespec *ptimeo;
+  struct udp_recviob_s state;
+#ifdef CONFIG_NET_SOCKOPTS
+  struct timespec abstime;
+#endif
+  ssize_t ret;
+
+  DEBUGASSERT(iob != NULL);
+
+  /* Verify that this is a valid UDP socket */
+
+  if (psock == NULL || psock->s_crefs <= 0)
+    {
+      return -EBADF;
+    }
+
+  if (psock->s_type != SOCK_DGRAM ||
+      (psock->s_domain != PF_INET && psock->s_domain != PF_INET6) ||
+      psock->s_sockif != inet_sockif(psock->s_domain, SOCK_DGRAM,
+                                     IPPROTO_UDP))
+    {
+      return -EOPNOTSUPP;
+    }
+
+  conn = (FAR struct udp_conn_s *)psock->s_conn;
+  DEBUGASSERT(conn != NULL);
+
+  net_lock();
+
+  /* Take a datagram that is already buffered */
+
+  *iob = recviob_dequeue(conn, from, fromlen);
+  if (*iob != NULL)
+    {
+      net_unlock();
+      return (*iob)->io_pktlen;
+    }
+
+  if (_SS_ISNONBLOCK(psock->s_flags))
+    {
+      ret = -EAGAIN;
+      goto errout_with_lock;
+    }
+
+  /* Otherwise, wait for the next datagram to be added to the read-ahead
+   * queue.
+   */
+
+  ptimeo = NULL;
+#ifdef CONFIG_NET_SOCKOPTS
+  if (psock->s_rcvtimeo != 0)
+    {
+      DEBUGVERIFY(clock_gettime(CLOCK_REALTIME, &abstime));
+
+      abstime.tv_sec  += psock->s_rcvtimeo / DSEC_PER_SEC;
+      abstime.tv_nsec += (psock->s_rcvtimeo % DSEC_PER_SEC) * NSEC_PER_DSEC;
+      if (abstime.tv_nsec >= NSEC_PER_SEC)
+        {
+          abstime.tv_sec++;
+          abstime.tv_nsec -= NSEC_PER_SEC;
+        }
+
+      ptimeo = &abstime;
+    }
+#endif
+
+  /* This semaphore is used for signaling and, hence, should not have
+   * priority inheritance enabled.
+   */
+
+  nxsem_init(&state.ri_sem, 0, 0);
+  nxsem_setprotocol(&state.ri_sem, SEM_PRIO_NONE);
+  state.ri_result = OK;
+
+  /* Get the device that will receive the datagram.  This may be NULL if
+   * the UDP socket is bound to INADDR_ANY.  In that case, no NETDEV_DOWN
+   * notifications will be received.
+   */
+
+  dev = udp_find_laddr_device(conn);
+  cb  = udp_callback_alloc(dev, conn);
+  if (cb == NULL)
+    {
+      ret = -EBUSY;
+      goto errout_with_sem;
+    }
+
+  cb->flags = (UDP_NEWDATA | NETDEV_DOWN);
+  cb->priv  = (FAR void *)&state;
+  cb->event = recviob_eventhandler;
+
+  for (; ; )
+    {
+      /* The event handler only wakes us up.  The datagram is added to the
+       * read-ahead queue after the event handler returns and before the
+       * network is unlocked.  It may also have been dropped if there were
+       * no free I/O buffers.
+       */
+
+      ret = net_timedwait(&state.ri_sem, ptimeo);
+      if (ret < 0)
+        {
+          if (ret == -ETIMEDOUT)
+            {
+              ret = -EAGAIN;
+            }
+
+          break;
+        }
+
+      *iob = recviob_dequeue(conn, from, fromlen);
+      if (*iob != NULL)
+        {
+          ret = (*iob)->io_pktlen;
+          break;
+        }
+
+      if (state.ri_result < 0)
+        {
+          ret = state.ri_result;
+          break;
+        }
+    }
+
+  udp_callback_free(dev, conn, cb);
+
+errout_with_sem:
+  nxsem_destroy(&state.ri_sem);
+
+errout_with_lock:
+  net_unlock();
+  return ret;
+}
+
+#endif /* CONFIG_NET_UDP_ZEROCOPY */
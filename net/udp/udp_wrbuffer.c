@@ -184,13 +184,17 @@ FAR struct udp_wrbuffer_s *udp_wrbuffer_alloc(void)
 
 void udp_wrbuffer_release(FAR struct udp_wrbuffer_s *wrb)
 {
-  DEBUGASSERT(wrb && wrb->wb_iob);
+  DEBUGASSERT(wrb);
 
   /* To avoid deadlocks, we must following this ordering:  Release the I/O
-   * buffer chain first, then the write buffer structure.
+   * buffer chain first, then the write buffer structure.  There may be no
+   * I/O buffer chain if it was taken back by psock_udp_sendiob().
    */
 
-  iob_free_chain(wrb->wb_iob, IOBUSER_NET_UDP_WRITEBUFFER);
+  if (wrb->wb_iob != NULL)
+    {
+      iob_free_chain(wrb->wb_iob, IOBUSER_NET_UDP_WRITEBUFFER);
+    }
 
   /* Then free the write buffer structure */
 
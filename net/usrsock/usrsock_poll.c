@@ -144,8 +144,7 @@ static uint16_t poll_event(FAR struct net_driver_s *dev, FAR void *pvconn,
 
   if (eventset)
     {
-      info->fds->revents |= eventset;
-      nxsem_post(info->fds->sem);
+      poll_notify(&info->fds, 1, eventset);
     }
 
   return flags;
@@ -291,7 +290,7 @@ static int usrsock_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
     {
       /* Yes.. then signal the poll logic */
 
-      nxsem_post(fds->sem);
+      poll_notify(&fds, 1, fds->revents);
     }
 
 errout_unlock:
@@ -42,6 +42,7 @@
 #ifdef CONFIG_NET
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <debug.h>
 
 #include <nuttx/net/netconfig.h>
@@ -84,40 +85,111 @@
 #ifndef CONFIG_NET_ARCH_CHKSUM
 uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len)
 {
-  FAR const uint8_t *dataptr;
-  FAR const uint8_t *last_byte;
-  uint16_t t;
+  FAR const uint32_t *words;
+  uint64_t acc = 0;
+  uint32_t total;
+  bool odd;
 
-  dataptr = data;
-  last_byte = data + len - 1;
+  /* The one's complement sum does not depend on the byte order:  Summing
+   * the data as native 16-bit words gives the byte-swapped sum on a little-
+   * endian machine.  The same is true if the data begins at an odd address:
+   * Summing aligned words then puts every byte in the other half of the
+   * 16-bit word, which also just swaps the bytes of the result.
+   *
+   * So first bring the data pointer to a 16-bit boundary by summing the
+   * odd byte as the second byte of a word.
+   */
 
-  while (dataptr < last_byte)
+  odd = ((uintptr_t)data & 1) != 0;
+  if (odd && len > 0)
     {
-      /* At least two more bytes */
+#ifdef CONFIG_ENDIAN_BIG
+      acc = *data;
+#else
+      acc = (uint16_t)*data << 8;
+#endif
+      data++;
+      len--;
+    }
+
+  /* Then to a 32-bit boundary */
+
+  if (((uintptr_t)data & 2) != 0 && len >= 2)
+    {
+      acc  += *(FAR const uint16_t *)data;
+      data += 2;
+      len  -= 2;
+    }
+
+  /* Sum 32-bit words into the 64-bit accumulator.  The carries out of each
+   * word accumulate in the upper half and cannot overflow for any packet
+   * size.
+   */
 
-      t = ((uint16_t)dataptr[0] << 8) + dataptr[1];
-      sum += t;
-      if (sum < t)
-        {
-          sum++; /* carry */
-        }
+  words = (FAR const uint32_t *)data;
 
-      dataptr += 2;
+  while (len >= 16)
+    {
+      acc += words[0];
+      acc += words[1];
+      acc += words[2];
+      acc += words[3];
+      words += 4;
+      len   -= 16;
     }
 
-  if (dataptr == last_byte)
+  while (len >= 4)
     {
-      t = (dataptr[0] << 8) + 0;
-      sum += t;
-      if (sum < t)
-        {
-          sum++; /* carry */
-        }
+      acc += *words++;
+      len -= 4;
     }
 
-  /* Return sum in host byte order. */
+  data = (FAR const uint8_t *)words;
+
+  /* Then any remaining 16-bit word and the final byte (which is padded
+   * with a zero byte).
+   */
+
+  if (len >= 2)
+    {
+      acc  += *(FAR const uint16_t *)data;
+      data += 2;
+      len  -= 2;
+    }
 
-  return sum;
+  if (len > 0)
+    {
+#ifdef CONFIG_ENDIAN_BIG
+      acc += (uint16_t)*data << 8;
+#else
+      acc += *data;
+#endif
+    }
+
+  /* Fold the accumulator to 16 bits, adding back the carries */
+
+  acc   = (acc & 0xffffffff) + (acc >> 32);
+  acc   = (acc & 0xffffffff) + (acc >> 32);
+  total = (uint32_t)acc;
+  total = (total & 0xffff) + (total >> 16);
+  total = (total & 0xffff) + (total >> 16);
+
+  /* Return the sum in host byte order */
+
+#ifdef CONFIG_ENDIAN_BIG
+  if (odd)
+#else
+  if (!odd)
+#endif
+    {
+      total = ((total & 0xff) << 8) | (total >> 8);
+    }
+
+  /* Add the partial sum carried over from the previous call */
+
+  total += sum;
+  total  = (total & 0xffff) + (total >> 16);
+  return (uint16_t)total;
 }
 #endif /* CONFIG_NET_ARCH_CHKSUM */
 
@@ -153,4 +225,54 @@ uint16_t net_chksum(FAR uint16_t *data, uint16_t len)
 }
 #endif /* CONFIG_NET_ARCH_CHKSUM */
 
+/****************************************************************************
+ * Name: net_chksum_adjust
+ *
+ * Description:
+ *   Update an Internet checksum after one 16-bit word of the data that it
+ *   covers has been changed, without summing all of the data again.  This
+ *   is useful when forwarding (TTL) or translating (addresses and ports)
+ *   packets.  See RFC1624, equation 3.
+ *
+ *   The one's complement sum does not depend on the byte order so the
+ *   checksum and the old and new values may all be given either in network
+ *   or in host byte order, as long as they are all the same.
+ *
+ * Input Parameters:
+ *   chksum - The checksum field as it is in the packet
+ *   oldval - The previous value of the modified 16-bit word
+ *   newval - The new value of the modified 16-bit word
+ *
+ * Returned Value:
+ *   The new value for the checksum field.
+ *
+ ****************************************************************************/
+
+uint16_t net_chksum_adjust(uint16_t chksum, uint16_t oldval, uint16_t newval)
+{
+  uint32_t sum;
+
+  sum = (uint32_t)(uint16_t)~chksum + (uint16_t)~oldval + newval;
+  sum = (sum & 0xffff) + (sum >> 16);
+  sum = (sum & 0xffff) + (sum >> 16);
+  return (uint16_t)~sum;
+}
+
+/****************************************************************************
+ * Name: net_chksum_adjust32
+ *
+ * Description:
+ *   Like net_chksum_adjust() but for a modified, 16-bit aligned, 32-bit
+ *   value such as an IPv4 address.
+ *
+ ****************************************************************************/
+
+uint16_t net_chksum_adjust32(uint16_t chksum, uint32_t oldval,
+                             uint32_t newval)
+{
+  chksum = net_chksum_adjust(chksum, (uint16_t)(oldval >> 16),
+                             (uint16_t)(newval >> 16));
+  return net_chksum_adjust(chksum, (uint16_t)oldval, (uint16_t)newval);
+}
+
 #endif /* CONFIG_NET */
@@ -267,6 +267,43 @@ uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len);
 uint16_t net_chksum(FAR uint16_t *data, uint16_t len);
 #endif
 
+/****************************************************************************
+ * Name: net_chksum_adjust
+ *
+ * Description:
+ *   Update an Internet checksum after one 16-bit word of the data that it
+ *   covers has been changed, without summing all of the data again.  This
+ *   is useful when forwarding (TTL) or translating (addresses and ports)
+ *   packets.  See RFC1624, equation 3.
+ *
+ *   The one's complement sum does not depend on the byte order so the
+ *   checksum and the old and new values may all be given either in network
+ *   or in host byte order, as long as they are all the same.
+ *
+ * Input Parameters:
+ *   chksum - The checksum field as it is in the packet
+ *   oldval - The previous value of the modified 16-bit word
+ *   newval - The new value of the modified 16-bit word
+ *
+ * Returned Value:
+ *   The new value for the checksum field.
+ *
+ ****************************************************************************/
+
+uint16_t net_chksum_adjust(uint16_t chksum, uint16_t oldval, uint16_t newval);
+
+/****************************************************************************
+ * Name: net_chksum_adjust32
+ *
+ * Description:
+ *   Like net_chksum_adjust() but for a modified, 16-bit aligned, 32-bit
+ *   value such as an IPv4 address.
+ *
+ ****************************************************************************/
+
+uint16_t net_chksum_adjust32(uint16_t chksum, uint32_t oldval,
+                             uint32_t newval);
+
 /****************************************************************************
  * Name: ipv4_upperlayer_chksum
  *
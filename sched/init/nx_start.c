@@ -554,6 +554,9 @@ void nx_start(void)
       tasklist = TLIST_HEAD(TSTATE_TASK_RUNNING);
 #endif
       dq_addfirst((FAR dq_entry_t *)&g_idletcb[cpu], tasklist);
+#ifndef CONFIG_SMP
+      sched_readyindex_add(&g_idletcb[cpu].cmn);
+#endif
 
       /* Mark the idle task as the running task */
 
@@ -547,15 +547,20 @@ void leave_critical_section(irqstate_t flags)
                   /* Yes.. Check if there are pending tasks and that pre-emption
                    * is also enabled.  This is necessary because we may have
                    * deferred the up_release_pending() call in sched_unlock()
-                   * because we were within a critical section then.
+                   * because we were within a critical section then.  The
+                   * same applies if some CPU rescheduled while we held the
+                   * critical section and left a task waiting in the
+                   * g_readytorun list.
                    */
 
-                  if (g_pendingtasks.head != NULL && !sched_islocked_global())
+                  if (!sched_islocked_global() &&
+                      (g_pendingtasks.head != NULL ||
+                       (g_readytorun.head != NULL && sched_cpu_stealable())))
                     {
                       /* Release any ready-to-run tasks that have collected
-                       * in g_pendingtasks.  NOTE: This operation has a very
-                       * high likelihood of causing this task to be switched
-                       * out!
+                       * in g_pendingtasks or g_readytorun.  NOTE: This
+                       * operation has a very high likelihood of causing this
+                       * task to be switched out!
                        */
 
                       up_release_pending();
@@ -47,6 +47,7 @@
 
 #include <nuttx/sched.h>
 #include <nuttx/mqueue.h>
+#include <nuttx/mm/mempool.h>
 
 #include "mqueue/mqueue.h"
 
@@ -58,14 +59,14 @@
  * Name: mq_desfree
  *
  * Description:
- *   Deallocate a message queue descriptor but returning it to the free list
+ *   Deallocate a message queue descriptor by returning it to the pool
  *
  * Input Parameters:
  *   mqdes - message queue descriptor to free
  *
  ****************************************************************************/
 
-#define mq_desfree(mqdes) sq_addlast((FAR sq_entry_t*)mqdes, &g_desfree)
+#define mq_desfree(mqdes) mempool_free(&g_despool, mqdes)
 
 /****************************************************************************
  * Public Functions
@@ -52,6 +52,7 @@
 #include <nuttx/kmalloc.h>
 #include <nuttx/sched.h>
 #include <nuttx/mqueue.h>
+#include <nuttx/mm/mempool.h>
 
 #include "mqueue/mqueue.h"
 
@@ -75,26 +76,11 @@
 
 static mqd_t nxmq_alloc_des(void)
 {
-  mqd_t mqdes;
-
-  /* Try to get the message descriptorfrom the free list */
-
-  mqdes = (mqd_t)sq_remfirst(&g_desfree);
-
-  /* Check if we got one. */
-
-  if (!mqdes)
-    {
-      /* Add another block of message descriptors to the list */
-
-      nxmq_alloc_desblock();
-
-      /* And try again */
-
-      mqdes = (mqd_t)sq_remfirst(&g_desfree);
-    }
+  /* Get the message descriptor from the pool.  The pool will be expanded
+   * if there are no free descriptors.
+   */
 
-  return mqdes;
+  return (mqd_t)mempool_alloc(&g_despool);
 }
 
 /****************************************************************************
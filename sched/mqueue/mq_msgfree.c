@@ -39,11 +39,7 @@
 
 #include <nuttx/config.h>
 
-#include <queue.h>
-
-#include <nuttx/irq.h>
-#include <nuttx/arch.h>
-#include <nuttx/kmalloc.h>
+#include <nuttx/mm/mempool.h>
 
 #include "mqueue/mqueue.h"
 
@@ -55,9 +51,8 @@
  * Name: nxmq_free_msg
  *
  * Description:
- *   The nxmq_free_msg function will return a message to the free pool of
- *   messages if it was a pre-allocated message. If the message was
- *   allocated dynamically it will be deallocated.
+ *   The nxmq_free_msg function will return a message to the pool of free
+ *   messages.
  *
  * Input Parameters:
  *   mqmsg - message to free
@@ -69,49 +64,5 @@
 
 void nxmq_free_msg(FAR struct mqueue_msg_s *mqmsg)
 {
-  irqstate_t flags;
-
-  /* If this is a generally available pre-allocated message,
-   * then just put it back in the free list.
-   */
-
-  if (mqmsg->type == MQ_ALLOC_FIXED)
-    {
-      /* Make sure we avoid concurrent access to the free
-       * list from interrupt handlers.
-       */
-
-      flags = enter_critical_section();
-      sq_addlast((FAR sq_entry_t *)mqmsg, &g_msgfree);
-      leave_critical_section(flags);
-    }
-
-  /* If this is a message pre-allocated for interrupts,
-   * then put it back in the correct  free list.
-   */
-
-  else if (mqmsg->type == MQ_ALLOC_IRQ)
-    {
-      /* Make sure we avoid concurrent access to the free
-       * list from interrupt handlers.
-       */
-
-      flags = enter_critical_section();
-      sq_addlast((FAR sq_entry_t *)mqmsg, &g_msgfreeirq);
-      leave_critical_section(flags);
-    }
-
-  /* Otherwise, deallocate it.  Note:  interrupt handlers
-   * will never deallocate messages because they will not
-   * received them.
-   */
-
-  else if (mqmsg->type == MQ_ALLOC_DYN)
-    {
-      sched_kfree(mqmsg);
-    }
-  else
-    {
-      DEBUGPANIC();
-    }
+  mempool_free(&g_msgpool, mqmsg);
 }
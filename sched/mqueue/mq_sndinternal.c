@@ -49,10 +49,10 @@
 #include <debug.h>
 
 #include <nuttx/irq.h>
-#include <nuttx/kmalloc.h>
 #include <nuttx/arch.h>
 #include <nuttx/sched.h>
 #include <nuttx/cancelpt.h>
+#include <nuttx/mm/mempool.h>
 
 #include "sched/sched.h"
 #include "mqueue/mqueue.h"
@@ -114,84 +114,28 @@ int nxmq_verify_send(mqd_t mqdes, FAR const char *msg, size_t msglen,
  *
  * Description:
  *   The nxmq_alloc_msg function will get a free message for use by the
- *   operating system.  The message will be allocated from the g_msgfree
- *   list.
+ *   operating system.  The message will be allocated from the g_msgpool.
  *
- *   If the list is empty AND the message is NOT being allocated from the
- *   interrupt level, then the message will be allocated.  If a message
- *   cannot be obtained, the operating system is dead and therefore cannot
- *   continue.
+ *   If only the messages reserved for interrupt handlers remain AND the
+ *   message is NOT being allocated from the interrupt level, then the pool
+ *   will be expanded from the kernel heap.
  *
- *   If the list is empty AND the message IS being allocated from the
- *   interrupt level.  This function will attempt to get a message from
- *   the g_msgfreeirq list.  If this is unsuccessful, the calling interrupt
- *   handler will be notified.
+ *   If the message IS being allocated from the interrupt level, then the
+ *   reserved messages may also be used.  If this is unsuccessful, the
+ *   calling interrupt handler will be notified.
  *
  * Input Parameters:
  *   None
  *
  * Returned Value:
- *   A reference to the allocated msg structure.  On a failure to allocate,
- *   this function PANICs.
+ *   A reference to the allocated msg structure or NULL if no message is
+ *   available.
  *
  ****************************************************************************/
 
 FAR struct mqueue_msg_s *nxmq_alloc_msg(void)
 {
-  FAR struct mqueue_msg_s *mqmsg;
-  irqstate_t flags;
-
-  /* If we were called from an interrupt handler, then try to get the message
-   * from generally available list of messages. If this fails, then try the
-   * list of messages reserved for interrupt handlers
-   */
-
-  if (up_interrupt_context())
-    {
-      /* Try the general free list */
-
-      mqmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&g_msgfree);
-      if (mqmsg == NULL)
-        {
-          /* Try the free list reserved for interrupt handlers */
-
-          mqmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&g_msgfreeirq);
-        }
-    }
-
-  /* We were not called from an interrupt handler. */
-
-  else
-    {
-      /* Try to get the message from the generally available free list.
-       * Disable interrupts -- we might be called from an interrupt handler.
-       */
-
-      flags = enter_critical_section();
-      mqmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&g_msgfree);
-      leave_critical_section(flags);
-
-      /* If we cannot a message from the free list, then we will have to
-       * allocate one.
-       */
-
-      if (mqmsg == NULL)
-        {
-          mqmsg = (FAR struct mqueue_msg_s *)
-            kmm_malloc((sizeof (struct mqueue_msg_s)));
-
-          /* Check if we allocated the message */
-
-          if (mqmsg != NULL)
-            {
-              /* Yes... remember that this message was dynamically allocated */
-
-              mqmsg->type = MQ_ALLOC_DYN;
-            }
-        }
-    }
-
-  return mqmsg;
+  return (FAR struct mqueue_msg_s *)mempool_alloc(&g_msgpool);
 }
 
 /****************************************************************************
@@ -51,6 +51,7 @@
 #include <sched.h>
 
 #include <nuttx/mqueue.h>
+#include <nuttx/mm/mempool.h>
 
 #if CONFIG_MQ_MAXMSGSIZE > 0
 
@@ -74,23 +75,21 @@
 
 #define NUM_INTERRUPT_MSGS   8
 
+/* This defines the number of messages to add to the message pool when the
+ * pre-allocated messages have been exhausted.
+ */
+
+#define NUM_EXPAND_MSGS      4
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
 
-enum mqalloc_e
-{
-  MQ_ALLOC_FIXED = 0,  /* Pre-allocated; never freed */
-  MQ_ALLOC_DYN,        /* Dynamically allocated; free when unused */
-  MQ_ALLOC_IRQ         /* Preallocated, reserved for interrupt handling */
-};
-
 /* This structure describes one buffered POSIX message. */
 
 struct mqueue_msg_s
 {
   FAR struct mqueue_msg_s *next;  /* Forward link to next message */
-  uint8_t type;                   /* (Used to manage allocations) */
   uint8_t priority;               /* priority of message */
 #if MQ_MAX_BYTES < 256
   uint8_t msglen;                 /* Message data length */
@@ -112,24 +111,18 @@ extern "C"
 #define EXTERN extern
 #endif
 
-/* The g_msgfree is a list of messages that are available for general use.
- * The number of messages in this list is a system configuration item.
- */
-
-EXTERN sq_queue_t  g_msgfree;
-
-/* The g_msgfreeInt is a list of messages that are reserved for use by
- * interrupt handlers.
+/* The g_msgpool is the pool of messages available for general use.  The
+ * number of pre-allocated messages is a system configuration item.  A
+ * few additional messages are reserved for use by interrupt handlers.
  */
 
-EXTERN sq_queue_t  g_msgfreeirq;
+EXTERN struct mempool_s g_msgpool;
 
-/* The g_desfree data structure is a list of message descriptors available
- * to the operating system for general use. The number of messages in the
- * pool is a constant.
+/* The g_despool is the pool of message queue descriptors available to the
+ * operating system for general use.
  */
 
-EXTERN sq_queue_t  g_desfree;
+EXTERN struct mempool_s g_despool;
 
 /****************************************************************************
  * Public Function Prototypes
@@ -141,7 +134,6 @@ struct task_group_s; /* Forward reference */
 /* Functions defined in mq_initialize.c ************************************/
 
 void weak_function nxmq_initialize(void);
-void nxmq_alloc_desblock(void);
 void nxmq_free_msg(FAR struct mqueue_msg_s *mqmsg);
 
 /* mq_waitirq.c ************************************************************/
@@ -417,6 +417,19 @@ void sched_addblocked(FAR struct tcb_s *btcb, tstate_t task_state);
 void sched_removeblocked(FAR struct tcb_s *btcb);
 int  nxsched_setpriority(FAR struct tcb_s *tcb, int sched_priority);
 
+/* Priority index of the g_readytorun list */
+
+#ifdef CONFIG_SCHED_READYINDEX
+FAR struct tcb_s *sched_readyindex_find(uint8_t sched_priority);
+void sched_readyindex_add(FAR struct tcb_s *tcb);
+void sched_readyindex_remove(FAR struct tcb_s *tcb);
+void sched_readyindex_rebuild(void);
+#else
+#  define sched_readyindex_add(tcb)
+#  define sched_readyindex_remove(tcb)
+#  define sched_readyindex_rebuild()
+#endif
+
 /* Priority inheritance support */
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
@@ -468,6 +481,7 @@ FAR struct tcb_s *this_task(void);
 #endif
 
 int  sched_cpu_select(cpu_set_t affinity);
+bool sched_cpu_stealable(void);
 int  sched_cpu_pause(FAR struct tcb_s *tcb);
 
 irqstate_t sched_tasklist_lock(void);
@@ -485,6 +499,7 @@ void sched_tasklist_unlock(irqstate_t lock);
 
 #else
 #  define sched_cpu_select(a)     (0)
+#  define sched_cpu_stealable()   (false)
 #  define sched_cpu_pause(t)      (-38)  /* -ENOSYS */
 #  define sched_islocked_tcb(tcb) ((tcb)->lockcount > 0)
 #endif
@@ -87,13 +87,27 @@ bool sched_addprioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
 
   DEBUGASSERT(sched_priority >= SCHED_PRIORITY_MIN);
 
-  /* Search the list to find the location to insert the new Tcb.
-   * Each is list is maintained in descending sched_priority order.
+#ifdef CONFIG_SCHED_READYINDEX
+  /* The ready-to-run list is indexed by priority.  The new TCB goes just
+   * after the last TCB with the same or the nearest higher priority.
    */
 
-  for (next = (FAR struct tcb_s *)list->head;
-       (next && sched_priority <= next->sched_priority);
-       next = next->flink);
+  if (list == (FAR dq_queue_t *)&g_readytorun)
+    {
+      prev = sched_readyindex_find(sched_priority);
+      next = prev ? prev->flink : (FAR struct tcb_s *)list->head;
+    }
+  else
+#endif
+    {
+      /* Search the list to find the location to insert the new Tcb.
+       * Each is list is maintained in descending sched_priority order.
+       */
+
+      for (next = (FAR struct tcb_s *)list->head;
+           (next && sched_priority <= next->sched_priority);
+           next = next->flink);
+    }
 
   /* Add the tcb to the spot found in the list.  Check if the tcb
    * goes at the end of the list. NOTE:  This could only happen if list
@@ -151,6 +165,13 @@ bool sched_addprioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
         }
     }
 
+#ifdef CONFIG_SCHED_READYINDEX
+  if (list == (FAR dq_queue_t *)&g_readytorun)
+    {
+      sched_readyindex_add(tcb);
+    }
+#endif
+
   return ret;
 }
 
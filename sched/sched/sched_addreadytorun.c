@@ -44,6 +44,8 @@
 #include <queue.h>
 #include <assert.h>
 
+#include <nuttx/sched_note.h>
+
 #include "irq/irq.h"
 #include "sched/sched.h"
 
@@ -304,6 +306,11 @@ bool sched_addreadytorun(FAR struct tcb_s *btcb)
 
           DEBUGASSERT(task_state == TSTATE_TASK_RUNNING);
 
+          if (btcb->cpu != cpu)
+            {
+              sched_note_cpu_migrate(btcb, cpu);
+            }
+
           btcb->cpu        = cpu;
           btcb->task_state = TSTATE_TASK_RUNNING;
 
@@ -40,6 +40,7 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdbool.h>
 #include <assert.h>
 
 #include <nuttx/sched.h>
@@ -53,6 +54,7 @@
  ****************************************************************************/
 
 #define IMPOSSIBLE_CPU 0xff
+#define ALL_CPUS       ((cpu_set_t)-1)
 
 /****************************************************************************
  * Public Functions
@@ -63,7 +65,9 @@
  *
  * Description:
  *   Return the index to the CPU with the lowest priority running task,
- *   possbily its IDLE task.
+ *   possbily its IDLE task.  If several CPUs are running tasks of that
+ *   priority, the current CPU is preferred since starting a task on some
+ *   other CPU requires that CPU to be paused.
  *
  * Input Parameters:
  *   affinity - The set of CPUs on which the thread is permitted to run.
@@ -78,16 +82,19 @@
 
 int sched_cpu_select(cpu_set_t affinity)
 {
-  uint8_t minprio;
+  FAR struct tcb_s *rtcb;
+  int minprio;
   int cpu;
+  int me;
   int i;
 
-  /* Otherwise, find the CPU that is executing the lowest priority task
-   * (possibly its IDLE task).
+  /* Find the CPU that is executing the lowest priority task (possibly its
+   * IDLE task).
    */
 
-  minprio = SCHED_PRIORITY_MAX;
+  minprio = SCHED_PRIORITY_MAX + 1;
   cpu     = IMPOSSIBLE_CPU;
+  me      = this_cpu();
 
   for (i = 0; i < CONFIG_SMP_NCPUS; i++)
     {
@@ -95,26 +102,27 @@ int sched_cpu_select(cpu_set_t affinity)
 
       if ((affinity & (1 << i)) != 0)
         {
-          FAR struct tcb_s *rtcb = (FAR struct tcb_s *)g_assignedtasks[i].head;
+          rtcb = (FAR struct tcb_s *)g_assignedtasks[i].head;
 
-          /* If this thread is executing its IDLE task, the use it.  The
-           * IDLE task is always the last task in the assigned task list.
+          /* The IDLE task is always the last task in the assigned task
+           * list.  It should always be assigned to this CPU and have a
+           * priority of zero.
            */
 
-          if (rtcb->flink == NULL)
-            {
-              /* The IDLE task should always be assigned to this CPU and have
-               * a priority of zero.
-               */
+          DEBUGASSERT(rtcb->flink != NULL || rtcb->sched_priority == 0);
 
-              DEBUGASSERT(rtcb->sched_priority == 0);
-              return i;
-            }
-          else if (rtcb->sched_priority < minprio)
+          if (rtcb->sched_priority < minprio ||
+              (rtcb->sched_priority == minprio && i == me))
             {
-              DEBUGASSERT(rtcb->sched_priority > 0);
               minprio = rtcb->sched_priority;
-              cpu = i;
+              cpu     = i;
+
+              /* Nothing can be better than this CPU's IDLE task */
+
+              if (minprio == 0 && i == me)
+                {
+                  break;
+                }
             }
         }
     }
@@ -123,4 +131,58 @@ int sched_cpu_select(cpu_set_t affinity)
   return cpu;
 }
 
+/****************************************************************************
+ * Name:  sched_cpu_stealable
+ *
+ * Description:
+ *   Check if some task in the g_readytorun list could be running now on a
+ *   CPU that is executing a lower priority task, possibly its IDLE task.
+ *   That happens when a CPU reschedules while pre-emption is disabled or
+ *   while another CPU holds the critical section:  That CPU then continues
+ *   with the next task in its assigned task list instead of selecting a
+ *   task from g_readytorun.  sched_mergepending() will then move such
+ *   tasks to the CPU that should be running them.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   True if sched_mergepending() would start some task in g_readytorun.
+ *
+ * Assumptions:
+ *   Called from within a critical section.
+ *
+ ****************************************************************************/
+
+bool sched_cpu_stealable(void)
+{
+  FAR struct tcb_s *tcb;
+  FAR struct tcb_s *rtcb;
+  uint8_t minprio;
+
+  tcb = (FAR struct tcb_s *)g_readytorun.head;
+  if (tcb == NULL)
+    {
+      return false;
+    }
+
+  /* The list is sorted by priority so only the tasks with a higher priority
+   * than the lowest priority task running on any CPU need to be examined.
+   */
+
+  rtcb    = current_task(sched_cpu_select(ALL_CPUS));
+  minprio = rtcb->sched_priority;
+
+  for (; tcb != NULL && tcb->sched_priority > minprio; tcb = tcb->flink)
+    {
+      rtcb = current_task(sched_cpu_select(tcb->affinity));
+      if (tcb->sched_priority > rtcb->sched_priority)
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+
 #endif /* CONFIG_SMP */
@@ -275,6 +275,7 @@ int sched_lock(void)
       sched_mergeprioritized((FAR dq_queue_t *)&g_readytorun,
                              (FAR dq_queue_t *)&g_pendingtasks,
                              TSTATE_TASK_PENDING);
+      sched_readyindex_rebuild();
     }
 
   return OK;
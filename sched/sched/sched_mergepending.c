@@ -152,6 +152,10 @@ bool sched_mergepending(void)
           ptcb->task_state  = TSTATE_TASK_READYTORUN;
         }
 
+      /* The ptcb follows all TCBs of the same priority */
+
+      sched_readyindex_add(ptcb);
+
       /* Set up for the next time through */
 
       rtcb = ptcb;
@@ -166,12 +170,88 @@ bool sched_mergepending(void)
 }
 #endif /* !CONFIG_SMP */
 
+/****************************************************************************
+ * Name: sched_cpu_steal
+ *
+ * Description:
+ *   Start each task in the g_readytorun list that has a higher priority
+ *   than the task running on some CPU in its affinity set.  Such tasks are
+ *   left behind when a CPU reschedules while pre-emption is disabled or
+ *   while another CPU holds the critical section (see
+ *   sched_cpu_stealable()).  Otherwise an idle CPU would not pick them up
+ *   until the next scheduling event on that CPU.
+ *
+ * Input Parameters:
+ *   lock - The tasklist lock state, which may be updated.
+ *
+ * Returned Value:
+ *   true if the task running on this CPU has changed.
+ *
+ * Assumptions:
+ *   Pre-emption is enabled and no other CPU holds the critical section.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+static bool sched_cpu_steal(FAR irqstate_t *lock)
+{
+  FAR struct tcb_s *rtcb;
+  FAR struct tcb_s *tcb;
+  FAR struct tcb_s *next;
+  bool ret = false;
+  int me = this_cpu();
+
+  for (tcb = (FAR struct tcb_s *)g_readytorun.head; tcb != NULL; tcb = next)
+    {
+      next = tcb->flink;
+
+      /* The list is in priority order.  Stop when no CPU is running a
+       * lower priority task.
+       */
+
+      rtcb = current_task(sched_cpu_select(ALL_CPUS));
+      if (tcb->sched_priority <= rtcb->sched_priority)
+        {
+          break;
+        }
+
+      rtcb = current_task(sched_cpu_select(tcb->affinity));
+      if (tcb->sched_priority > rtcb->sched_priority)
+        {
+          /* Move the task from g_readytorun to that CPU */
+
+          sched_readyindex_remove(tcb);
+          dq_rem((FAR dq_entry_t *)tcb, (FAR dq_queue_t *)&g_readytorun);
+
+          sched_tasklist_unlock(*lock);
+          ret |= sched_addreadytorun(tcb);
+          *lock = sched_tasklist_lock();
+
+          if (sched_islocked_global() || irq_cpu_locked(me))
+            {
+              break;
+            }
+
+          /* The task that was running on that CPU may now be in the
+           * g_readytorun list.  Start over.
+           */
+
+          next = (FAR struct tcb_s *)g_readytorun.head;
+        }
+    }
+
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Name: sched_mergepending
  *
  * Description:
  *   This function merges the prioritized g_pendingtasks list into the
- *   prioritized ready-to-run task list.
+ *   prioritized ready-to-run task list.  Then any task in the ready-to-run
+ *   list that has a higher priority than the task running on some CPU in
+ *   its affinity set is started on that CPU.
  *
  * Input Parameters:
  *   None
@@ -219,7 +299,7 @@ bool sched_mergepending(void)
         {
           /* The pending task list is empty */
 
-          goto errout_with_lock;
+          goto steal_with_lock;
         }
 
       cpu  = sched_cpu_select(ALL_CPUS /* ptcb->affinity */);
@@ -260,6 +340,7 @@ bool sched_mergepending(void)
               sched_mergeprioritized((FAR dq_queue_t *)&g_readytorun,
                                      (FAR dq_queue_t *)&g_pendingtasks,
                                      TSTATE_TASK_PENDING);
+              sched_readyindex_rebuild();
 
               /* And return with the schedule locked and tasks in the
                * pending task list.
@@ -275,7 +356,7 @@ bool sched_mergepending(void)
             {
               /* The pending task list is empty */
 
-              goto errout_with_lock;
+              goto steal_with_lock;
             }
 
           cpu  = sched_cpu_select(ALL_CPUS /* ptcb->affinity */);
@@ -289,6 +370,15 @@ bool sched_mergepending(void)
       sched_mergeprioritized((FAR dq_queue_t *)&g_pendingtasks,
                              (FAR dq_queue_t *)&g_readytorun,
                              TSTATE_TASK_READYTORUN);
+      sched_readyindex_rebuild();
+
+steal_with_lock:
+
+      /* Then let CPUs running lower priority tasks take over any tasks that
+       * were left waiting in the ready-to-run list.
+       */
+
+      ret |= sched_cpu_steal(&lock);
     }
 
 errout_with_lock:
@@ -589,6 +589,23 @@ void sched_note_spinabort(FAR struct tcb_s *tcb, FAR volatile void *spinlock)
 }
 #endif
 
+#ifdef CONFIG_SCHED_INSTRUMENTATION_MIGRATION
+void sched_note_cpu_migrate(FAR struct tcb_s *tcb, int cpu)
+{
+  struct note_cpu_migrate_s note;
+
+  /* Format the note */
+
+  note_common(tcb, &note.ncm_cmn, sizeof(struct note_cpu_migrate_s),
+              NOTE_CPU_MIGRATE);
+  note.ncm_target = (uint8_t)cpu;
+
+  /* Add the note to circular buffer */
+
+  note_add((FAR const uint8_t *)&note, sizeof(struct note_cpu_migrate_s));
+}
+#endif
+
 /****************************************************************************
  * Name: sched_note_get
  *
@@ -0,0 +1,197 @@
+/****************************************************************************
+ * sched/sched/sched_readyindex.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <strings.h>
+#include <string.h>
+#include <queue.h>
+#include <assert.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_READYINDEX
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define NPRIORITIES   (SCHED_PRIORITY_MAX + 1)
+#define NBITMAPWORDS  ((NPRIORITIES + 31) >> 5)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* g_readytorun is sorted by descending priority and tasks of the same
+ * priority are kept in FIFO order.  g_readytail[] holds the last TCB of
+ * each priority in that list (or NULL) and g_readymap has a bit set for
+ * each priority that is present.
+ */
+
+static FAR struct tcb_s *g_readytail[NPRIORITIES];
+static uint32_t g_readymap[NBITMAPWORDS];
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_readyindex_find
+ *
+ * Description:
+ *   Return the TCB in the g_readytorun list after which a new TCB of the
+ *   given priority must be inserted.  That is the last TCB with the same
+ *   priority or, if there is none, the last TCB with the nearest higher
+ *   priority.
+ *
+ * Input Parameters:
+ *   sched_priority - The priority of the TCB to be inserted
+ *
+ * Returned Value:
+ *   The preceding TCB or NULL if the new TCB goes at the head of the list.
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+FAR struct tcb_s *sched_readyindex_find(uint8_t sched_priority)
+{
+  unsigned int ndx = sched_priority >> 5;
+  uint32_t bits;
+
+  /* Find the lowest priority present that is not below sched_priority */
+
+  bits = g_readymap[ndx] & ((uint32_t)0xffffffff << (sched_priority & 31));
+  while (bits == 0)
+    {
+      if (++ndx >= NBITMAPWORDS)
+        {
+          return NULL;
+        }
+
+      bits = g_readymap[ndx];
+    }
+
+  return g_readytail[(ndx << 5) + ffs((int)bits) - 1];
+}
+
+/****************************************************************************
+ * Name: sched_readyindex_add
+ *
+ * Description:
+ *   Update the index after a TCB was added to the g_readytorun list.  The
+ *   TCB must follow all other TCBs of the same priority.
+ *
+ ****************************************************************************/
+
+void sched_readyindex_add(FAR struct tcb_s *tcb)
+{
+  uint8_t sched_priority = tcb->sched_priority;
+
+  DEBUGASSERT(tcb->flink == NULL ||
+              tcb->flink->sched_priority < sched_priority);
+
+  g_readytail[sched_priority]      = tcb;
+  g_readymap[sched_priority >> 5] |= (uint32_t)1 << (sched_priority & 31);
+}
+
+/****************************************************************************
+ * Name: sched_readyindex_remove
+ *
+ * Description:
+ *   Update the index before a TCB is removed from the g_readytorun list.
+ *
+ ****************************************************************************/
+
+void sched_readyindex_remove(FAR struct tcb_s *tcb)
+{
+  uint8_t sched_priority = tcb->sched_priority;
+  FAR struct tcb_s *prev;
+
+  if (g_readytail[sched_priority] == tcb)
+    {
+      prev = tcb->blink;
+      if (prev != NULL && prev->sched_priority == sched_priority)
+        {
+          g_readytail[sched_priority] = prev;
+        }
+      else
+        {
+          /* This was the only TCB of this priority */
+
+          g_readytail[sched_priority] = NULL;
+          g_readymap[sched_priority >> 5] &=
+            ~((uint32_t)1 << (sched_priority & 31));
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: sched_readyindex_rebuild
+ *
+ * Description:
+ *   Rebuild the index from the g_readytorun list.  This is necessary after
+ *   TCBs were merged into or removed from the list by other means than
+ *   sched_addprioritized() and sched_removereadytorun().
+ *
+ ****************************************************************************/
+
+void sched_readyindex_rebuild(void)
+{
+  FAR struct tcb_s *tcb;
+
+  memset(g_readytail, 0, sizeof(g_readytail));
+  memset(g_readymap, 0, sizeof(g_readymap));
+
+  for (tcb = (FAR struct tcb_s *)g_readytorun.head;
+       tcb != NULL;
+       tcb = tcb->flink)
+    {
+      if (tcb->flink == NULL ||
+          tcb->flink->sched_priority != tcb->sched_priority)
+        {
+          sched_readyindex_add(tcb);
+        }
+    }
+}
+
+#endif /* CONFIG_SCHED_READYINDEX */
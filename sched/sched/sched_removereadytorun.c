@@ -101,6 +101,7 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
    * is always the g_readytorun list.
    */
 
+  sched_readyindex_remove(rtcb);
   dq_rem((FAR dq_entry_t *)rtcb, (FAR dq_queue_t *)&g_readytorun);
 
   /* Since the TCB is not in any list, it is now invalid */
@@ -198,6 +199,11 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
        * or the g_assignedtasks[cpu] list.
        */
 
+      if (tasklist == (FAR dq_queue_t *)&g_readytorun)
+        {
+          sched_readyindex_remove(rtcb);
+        }
+
       dq_rem((FAR dq_entry_t *)rtcb, tasklist);
 
       /* Which task will go at the head of the list?  It will be either the
@@ -237,11 +243,19 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
            * list and add to the head of the g_assignedtasks[cpu] list.
            */
 
+          sched_readyindex_remove((FAR struct tcb_s *)g_readytorun.head);
           tmptcb = (FAR struct tcb_s *)
             dq_remfirst((FAR dq_queue_t *)&g_readytorun);
 
           dq_addfirst((FAR dq_entry_t *)tmptcb, tasklist);
 
+          /* Note a task that last ran on another CPU */
+
+          if (tmptcb->cpu != cpu)
+            {
+              sched_note_cpu_migrate(tmptcb, cpu);
+            }
+
           tmptcb->cpu = cpu;
           nxttcb = tmptcb;
         }
@@ -328,6 +342,11 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
        * g_assignedtasks[cpu] list.
        */
 
+      if (tasklist == (FAR dq_queue_t *)&g_readytorun)
+        {
+          sched_readyindex_remove(rtcb);
+        }
+
       dq_rem((FAR dq_entry_t *)rtcb, tasklist);
     }
 
@@ -165,9 +165,21 @@ static inline void nxsched_running_setpriority(FAR struct tcb_s *tcb,
 
   else
     {
+#ifndef CONFIG_SMP
+      /* The running task remains at the head of the ready-to-run list, but
+       * the index of that list must follow the change of priority.
+       */
+
+      sched_readyindex_remove(tcb);
+#endif
+
       /* Change the task priority */
 
       tcb->sched_priority = (uint8_t)sched_priority;
+
+#ifndef CONFIG_SMP
+      sched_readyindex_add(tcb);
+#endif
     }
 }
 
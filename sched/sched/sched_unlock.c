@@ -152,7 +152,8 @@ int sched_unlock(void)
            */
 
           if (!sched_islocked_global() && !irq_cpu_locked(cpu) &&
-              g_pendingtasks.head != NULL)
+              (g_pendingtasks.head != NULL ||
+               (g_readytorun.head != NULL && sched_cpu_stealable())))
             {
               up_release_pending();
             }
@@ -48,6 +48,7 @@
 #include <errno.h>
 
 #include <nuttx/irq.h>
+#include <nuttx/mm/mempool.h>
 
 #include "sched/sched.h"
 #include "group/group.h"
@@ -69,23 +70,12 @@ static FAR sigactq_t *nxsig_alloc_action(void)
 {
   FAR sigactq_t *sigact;
 
-  /* Try to get the signal action structure from the free list */
-
-  sigact = (FAR sigactq_t *)sq_remfirst(&g_sigfreeaction);
-
-  /* Check if we got one. */
-
-  if (!sigact)
-    {
-      /* Add another block of signal actions to the list */
-
-      nxsig_alloc_actionblock();
-
-      /* And try again */
+  /* Get the signal action structure from the pool.  Another block of
+   * signal actions will be added to the pool if it is empty.
+   */
 
-      sigact = (FAR sigactq_t *)sq_remfirst(&g_sigfreeaction);
-      DEBUGASSERT(sigact);
-    }
+  sigact = (FAR sigactq_t *)mempool_alloc(&g_sigactionpool);
+  DEBUGASSERT(sigact);
 
   return sigact;
 }
@@ -376,7 +366,7 @@ int sigaction(int signo, FAR const struct sigaction *act,
 
 void nxsig_release_action(FAR sigactq_t *sigact)
 {
-  /* Just put it back on the free list */
+  /* Just put it back in the pool */
 
-  sq_addlast((FAR sq_entry_t *)sigact, &g_sigfreeaction);
+  mempool_free(&g_sigactionpool, sigact);
 }
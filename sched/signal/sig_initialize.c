@@ -41,10 +41,9 @@
 #include <nuttx/config.h>
 
 #include <stdint.h>
-#include <queue.h>
 #include <assert.h>
 
-#include <nuttx/kmalloc.h>
+#include <nuttx/mm/mempool.h>
 
 #include "signal/signal.h"
 
@@ -52,149 +51,22 @@
  * Public Data
  ****************************************************************************/
 
-/* The g_sigfreeaction data structure is a list of available signal
- * action structures.
- */
-
-sq_queue_t  g_sigfreeaction;
-
-/* The g_sigpendingaction data structure is a list of available pending
- * signal action structures.
- */
-
-sq_queue_t  g_sigpendingaction;
-
-/* The g_sigpendingirqaction is a list of available pending signal actions
- * that are reserved for use by interrupt handlers.
- */
-
-sq_queue_t  g_sigpendingirqaction;
-
-/* The g_sigpendingsignal data structure is a list of available pending
- * signal structures.
- */
+/* The g_sigactionpool is the pool of available signal action structures */
 
-sq_queue_t  g_sigpendingsignal;
+struct mempool_s g_sigactionpool;
 
-/* The g_sigpendingirqsignal data structure is a list of available
- * pending signal structures that are reserved for use by interrupt
+/* The g_sigpendingactionpool is the pool of available pending signal
+ * action structures.  Some of these are reserved for use by interrupt
  * handlers.
  */
 
-sq_queue_t  g_sigpendingirqsignal;
-
-/****************************************************************************
- * Private Data
- ****************************************************************************/
-
-/* g_sigactionalloc is a pointer to the start of the allocated blocks of
- * signal actions.
- */
-
-static sigactq_t  *g_sigactionalloc;
-
-/* g_sigpendingactionalloc is a pointer to the start of the allocated
- * blocks of pending signal actions.
- */
-
-static sigq_t     *g_sigpendingactionalloc;
+struct mempool_s g_sigpendingactionpool;
 
-/* g_sigpendingirqactionalloc is a pointer to the start of the allocated
- * block of pending signal actions.
+/* The g_sigpendingsignalpool is the pool of available pending signal
+ * structures.  Some of these are reserved for use by interrupt handlers.
  */
 
-static sigq_t     *g_sigpendingirqactionalloc;
-
-/* g_sigpendingsignalalloc is a pointer to the start of the allocated
- * blocks of pending signals.
- */
-
-static sigpendq_t *g_sigpendingsignalalloc;
-
-/* g_sigpendingirqsignalalloc is a pointer to the start of the allocated
- * blocks of pending signals.
- */
-
-static sigpendq_t *g_sigpendingirqsignalalloc;
-
-/****************************************************************************
- * Private Function Prototypes
- ****************************************************************************/
-
-static sigq_t     *nxsig_alloc_block(sq_queue_t *siglist, uint16_t nsigs,
-                                     uint8_t sigtype);
-static sigpendq_t *nxsig_alloc_pendingsignalblock(sq_queue_t *siglist,
-                                                  uint16_t nsigs, uint8_t sigtype);
-
-/****************************************************************************
- * Private Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: nxsig_alloc_block
- *
- * Description:
- *   Allocate a block of pending signal actions and place them
- *   on the free list.
- *
- ****************************************************************************/
-
-static FAR sigq_t *nxsig_alloc_block(sq_queue_t *siglist, uint16_t nsigs,
-                                     uint8_t sigtype)
-{
-  FAR sigq_t *sigqalloc;
-  FAR sigq_t *sigq;
-  int i;
-
-  /* Allocate a block of pending signal actions. */
-
-  sigqalloc = (FAR sigq_t *)kmm_malloc((sizeof(sigq_t)) * nsigs);
-  if (sigqalloc != NULL)
-    {
-      sigq = sigqalloc;
-      for (i = 0; i < nsigs; i++)
-        {
-          sigq->type = sigtype;
-          sq_addlast((FAR sq_entry_t *)sigq++, siglist);
-        }
-    }
-
-  return sigqalloc;
-}
-
-/****************************************************************************
- * Name: nxsig_alloc_pendingsignalblock
- *
- * Description:
- *   Allocate a block of pending signal structures  and place them on
- *   the free list.
- *
- ****************************************************************************/
-
-static sigpendq_t *nxsig_alloc_pendingsignalblock(sq_queue_t *siglist,
-                                                  uint16_t nsigs, uint8_t sigtype)
-{
-  FAR sigpendq_t *sigpendalloc;
-  FAR sigpendq_t *sigpend;
-  int i;
-
-  /* Allocate a block of pending signal structures  */
-
-  sigpendalloc =
-    (FAR sigpendq_t *)kmm_malloc((sizeof(sigpendq_t)) * nsigs);
-
-  if (sigpendalloc != NULL)
-    {
-      sigpend = sigpendalloc;
-      for (i = 0; i < nsigs; i++)
-        {
-          sigpend->type = sigtype;
-          sq_addlast((FAR sq_entry_t *)sigpend++, siglist);
-        }
-    }
-
-  return sigpendalloc;
-}
+struct mempool_s g_sigpendingsignalpool;
 
 /****************************************************************************
  * Public Functions
@@ -210,68 +82,44 @@ static sigpendq_t *nxsig_alloc_pendingsignalblock(sq_queue_t *siglist,
 
 void nxsig_initialize(void)
 {
-  /* Initialize free lists */
-
-  sq_init(&g_sigfreeaction);
-  sq_init(&g_sigpendingaction);
-  sq_init(&g_sigpendingirqaction);
-  sq_init(&g_sigpendingsignal);
-  sq_init(&g_sigpendingirqsignal);
-
-  /* Add a block of signal structures to each list */
-
-  g_sigpendingactionalloc =
-    nxsig_alloc_block(&g_sigpendingaction,
-                      NUM_PENDING_ACTIONS,
-                      SIG_ALLOC_FIXED);
-  DEBUGASSERT(g_sigpendingactionalloc != NULL);
-
-  g_sigpendingirqactionalloc =
-    nxsig_alloc_block(&g_sigpendingirqaction,
-                      NUM_PENDING_INT_ACTIONS,
-                      SIG_ALLOC_IRQ);
-  DEBUGASSERT(g_sigpendingirqactionalloc != NULL);
-
-  nxsig_alloc_actionblock();
-
-  g_sigpendingsignalalloc =
-    nxsig_alloc_pendingsignalblock(&g_sigpendingsignal,
-                                   NUM_SIGNALS_PENDING,
-                                   SIG_ALLOC_FIXED);
-  DEBUGASSERT(g_sigpendingsignalalloc != NULL);
-
-  g_sigpendingirqsignalalloc =
-    nxsig_alloc_pendingsignalblock(&g_sigpendingirqsignal,
-                                   NUM_INT_SIGNALS_PENDING,
-                                   SIG_ALLOC_IRQ);
-  DEBUGASSERT(g_sigpendingirqsignalalloc != NULL);
-}
-
-/****************************************************************************
- * Name: nxsig_alloc_actionblock
- *
- * Description:
- *   Allocate a block of signal actions and place them
- *   on the free list.
- *
- ****************************************************************************/
-
-void nxsig_alloc_actionblock(void)
-{
-  FAR sigactq_t *sigact;
-  int i;
-
-  /* Allocate a block of signal actions */
-
-  g_sigactionalloc =
-    (FAR sigactq_t *)kmm_malloc((sizeof(sigactq_t)) * NUM_SIGNAL_ACTIONS);
-
-  if (g_sigactionalloc != NULL)
-    {
-      sigact = g_sigactionalloc;
-      for (i = 0; i < NUM_SIGNAL_ACTIONS; i++)
-        {
-          sq_addlast((FAR sq_entry_t *)sigact++, &g_sigfreeaction);
-        }
-    }
+  int ret;
+
+  /* Initialize the pool of signal actions.  It is expanded a block at a
+   * time as needed.
+   */
+
+  g_sigactionpool.bsize    = sizeof(sigactq_t);
+  g_sigactionpool.ninitial = NUM_SIGNAL_ACTIONS;
+  g_sigactionpool.nreserve = 0;
+  g_sigactionpool.nexpand  = NUM_SIGNAL_ACTIONS;
+
+  ret = mempool_initialize(&g_sigactionpool, "sigaction");
+  DEBUGASSERT(ret == OK);
+
+  /* Initialize the pool of pending signal actions, including those reserved
+   * for interrupt handlers.
+   */
+
+  g_sigpendingactionpool.bsize    = sizeof(sigq_t);
+  g_sigpendingactionpool.ninitial = NUM_PENDING_ACTIONS +
+                                    NUM_PENDING_INT_ACTIONS;
+  g_sigpendingactionpool.nreserve = NUM_PENDING_INT_ACTIONS;
+  g_sigpendingactionpool.nexpand  = NUM_PENDING_EXPAND;
+
+  ret = mempool_initialize(&g_sigpendingactionpool, "sigpendaction");
+  DEBUGASSERT(ret == OK);
+
+  /* Initialize the pool of pending signals, including those reserved for
+   * interrupt handlers.
+   */
+
+  g_sigpendingsignalpool.bsize    = sizeof(sigpendq_t);
+  g_sigpendingsignalpool.ninitial = NUM_SIGNALS_PENDING +
+                                    NUM_INT_SIGNALS_PENDING;
+  g_sigpendingsignalpool.nreserve = NUM_INT_SIGNALS_PENDING;
+  g_sigpendingsignalpool.nexpand  = NUM_PENDING_EXPAND;
+
+  ret = mempool_initialize(&g_sigpendingsignalpool, "sigpending");
+  DEBUGASSERT(ret == OK);
+  UNUSED(ret);
 }
@@ -42,6 +42,7 @@
 #include <sched.h>
 
 #include <nuttx/irq.h>
+#include <nuttx/mm/mempool.h>
 
 #include "signal/signal.h"
 
@@ -59,45 +60,5 @@
 
 void nxsig_release_pendingsigaction(FAR sigq_t *sigq)
 {
-  irqstate_t flags;
-
-  /* If this is a generally available pre-allocated structyre,
-   * then just put it back in the free list.
-   */
-
-  if (sigq->type == SIG_ALLOC_FIXED)
-    {
-      /* Make sure we avoid concurrent access to the free
-       * list from interrupt handlers.
-       */
-
-      flags = enter_critical_section();
-      sq_addlast((FAR sq_entry_t *)sigq, &g_sigpendingaction);
-      leave_critical_section(flags);
-    }
-
-  /* If this is a message pre-allocated for interrupts,
-   * then put it back in the correct  free list.
-   */
-
-  else if (sigq->type == SIG_ALLOC_IRQ)
-    {
-      /* Make sure we avoid concurrent access to the free
-       * list from interrupt handlers.
-       */
-
-      flags = enter_critical_section();
-      sq_addlast((FAR sq_entry_t *)sigq, &g_sigpendingirqaction);
-      leave_critical_section(flags);
-    }
-
-  /* Otherwise, deallocate it.  Note:  interrupt handlers
-   * will never deallocate signals because they will not
-   * receive them.
-   */
-
-  else if (sigq->type == SIG_ALLOC_DYN)
-    {
-      sched_kfree(sigq);
-    }
+  mempool_free(&g_sigpendingactionpool, sigq);
 }
@@ -49,7 +49,7 @@
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
 #include <nuttx/wdog.h>
-#include <nuttx/kmalloc.h>
+#include <nuttx/mm/mempool.h>
 
 #include "signal/signal.h"
 
@@ -67,45 +67,5 @@
 
 void nxsig_release_pendingsignal(FAR sigpendq_t *sigpend)
 {
-  irqstate_t flags;
-
-  /* If this is a generally available pre-allocated structyre,
-   * then just put it back in the free list.
-   */
-
-  if (sigpend->type == SIG_ALLOC_FIXED)
-    {
-      /* Make sure we avoid concurrent access to the free
-       * list from interrupt handlers.
-       */
-
-      flags = enter_critical_section();
-      sq_addlast((FAR sq_entry_t *)sigpend, &g_sigpendingsignal);
-      leave_critical_section(flags);
-    }
-
-  /* If this is a message pre-allocated for interrupts,
-   * then put it back in the correct free list.
-   */
-
-  else if (sigpend->type == SIG_ALLOC_IRQ)
-    {
-      /* Make sure we avoid concurrent access to the free
-       * list from interrupt handlers.
-       */
-
-      flags = enter_critical_section();
-      sq_addlast((FAR sq_entry_t *)sigpend, &g_sigpendingirqsignal);
-      leave_critical_section(flags);
-    }
-
-  /* Otherwise, deallocate it.  Note:  interrupt handlers
-   * will never deallocate signals because they will not
-   * receive them.
-   */
-
-  else if (sigpend->type == SIG_ALLOC_DYN)
-    {
-      sched_kfree(sigpend);
-    }
+  mempool_free(&g_sigpendingsignalpool, sigpend);
 }
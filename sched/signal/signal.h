@@ -49,6 +49,7 @@
 #include <sched.h>
 
 #include <nuttx/kmalloc.h>
+#include <nuttx/mm/mempool.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -64,19 +65,16 @@
 #define NUM_SIGNALS_PENDING     16
 #define NUM_INT_SIGNALS_PENDING  8
 
+/* The number of pending signal structures to add to the pools when the
+ * pre-allocated structures have been exhausted.
+ */
+
+#define NUM_PENDING_EXPAND       4
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
 
-/* This enumeration identifies the type of signal data allocation */
-
-enum sigalloc_e
-{
-  SIG_ALLOC_FIXED = 0,  /* pre-allocated; never freed */
-  SIG_ALLOC_DYN,        /* dynamically allocated; free when unused */
-  SIG_ALLOC_IRQ         /* Preallocated, reserved for interrupt handling */
-};
-
 /* The following defines the sigaction queue entry */
 
 struct sigactq
@@ -97,7 +95,6 @@ struct sigpendq
 {
   FAR struct sigpendq *flink;    /* Forward link */
   siginfo_t info;                /* Signal information */
-  uint8_t   type;                /* (Used to manage allocations) */
 };
 typedef struct sigpendq sigpendq_t;
 
@@ -115,7 +112,6 @@ struct sigq_s
   sigset_t  mask;                /* Additional signals to mask while the
                                   * the signal-catching function executes */
   siginfo_t info;                /* Signal information */
-  uint8_t   type;                /* (Used to manage allocations) */
 };
 typedef struct sigq_s sigq_t;
 
@@ -123,35 +119,22 @@ typedef struct sigq_s sigq_t;
  * Public Data
  ****************************************************************************/
 
-/* The g_sigfreeaction data structure is a list of available signal action
- * structures.
- */
-
-extern sq_queue_t  g_sigfreeaction;
-
-/* The g_sigpendingaction data structure is a list of available pending
- * signal action structures.
- */
-
-extern sq_queue_t  g_sigpendingaction;
-
-/* The g_sigpendingirqaction is a list of available pending signal actions
- * that are reserved for use by interrupt handlers.
- */
+/* The g_sigactionpool is the pool of available signal action structures */
 
-extern sq_queue_t  g_sigpendingirqaction;
+extern struct mempool_s g_sigactionpool;
 
-/* The g_sigpendingsignal data structure is a list of available pending
- * signal structures.
+/* The g_sigpendingactionpool is the pool of available pending signal
+ * action structures.  Some of these are reserved for use by interrupt
+ * handlers.
  */
 
-extern sq_queue_t  g_sigpendingsignal;
+extern struct mempool_s g_sigpendingactionpool;
 
-/* The g_sigpendingirqsignal data structure is a list of available pending
- * signal structures that are reserved for use by interrupt handlers.
+/* The g_sigpendingsignalpool is the pool of available pending signal
+ * structures.  Some of these are reserved for use by interrupt handlers.
  */
 
-extern sq_queue_t  g_sigpendingirqsignal;
+extern struct mempool_s g_sigpendingsignalpool;
 
 /****************************************************************************
  * Public Function Prototypes
@@ -165,7 +148,6 @@ struct task_group_s;
 /* sig_initializee.c */
 
 void weak_function nxsig_initialize(void);
-void               nxsig_alloc_actionblock(void);
 
 /* sig_action.c */
 
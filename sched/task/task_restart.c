@@ -155,6 +155,13 @@ int task_restart(pid_t pid)
   tasklist = TLIST_HEAD(tcb->cmn.task_state);
 #endif
 
+#ifdef CONFIG_SCHED_READYINDEX
+  if (tasklist == (FAR dq_queue_t *)&g_readytorun)
+    {
+      sched_readyindex_remove((FAR struct tcb_s *)tcb);
+    }
+#endif
+
   dq_rem((FAR dq_entry_t *)tcb, tasklist);
   tcb->cmn.task_state = TSTATE_TASK_INVALID;
 
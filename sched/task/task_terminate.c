@@ -157,6 +157,13 @@ int nxtask_terminate(pid_t pid, bool nonblocking)
 
   /* Remove the task from the task list */
 
+#ifdef CONFIG_SCHED_READYINDEX
+  if (tasklist == (FAR dq_queue_t *)&g_readytorun)
+    {
+      sched_readyindex_remove((FAR struct tcb_s *)dtcb);
+    }
+#endif
+
   dq_rem((FAR dq_entry_t *)dtcb, tasklist);
   dtcb->task_state = TSTATE_TASK_INVALID;
 
@@ -73,8 +73,14 @@
 
 int wd_cancel(WDOG_ID wdog)
 {
+#ifdef CONFIG_WDOG_TIMERWHEEL
+#ifdef CONFIG_SCHED_TICKLESS
+  bool first;
+#endif
+#else
   FAR struct wdog_s *curr;
   FAR struct wdog_s *prev;
+#endif
   irqstate_t flags;
   int ret = -EINVAL;
 
@@ -90,6 +96,29 @@ int wd_cancel(WDOG_ID wdog)
 
   if (wdog != NULL && WDOG_ISACTIVE(wdog))
     {
+#ifdef CONFIG_WDOG_TIMERWHEEL
+#ifdef CONFIG_SCHED_TICKLESS
+      /* Check if the interval timer may have been set for this watchdog */
+
+      first = (clock_t)(wdog->expired - g_wdtickbase) <= wd_wheel_next();
+#endif
+
+      /* Remove the watchdog from its wheel slot */
+
+      wd_wheel_remove(wdog);
+
+#ifdef CONFIG_SCHED_TICKLESS
+      /* Reassess the interval timer that will generate the next interval
+       * event.
+       */
+
+      if (first)
+        {
+          sched_timer_reassess();
+        }
+#endif
+
+#else
       /* Search the g_wdactivelist for the target FCB.  We can't use sq_rem
        * to do this because there are additional operations that need to be
        * done.
@@ -139,6 +168,7 @@ int wd_cancel(WDOG_ID wdog)
 
           sched_timer_reassess();
         }
+#endif /* CONFIG_WDOG_TIMERWHEEL */
 
       /* Mark the watchdog inactive */
 
@@ -40,6 +40,9 @@
 #include <nuttx/config.h>
 
 #include <queue.h>
+#include <assert.h>
+
+#include <nuttx/mm/mempool.h>
 
 #include "wdog/wdog.h"
 
@@ -47,44 +50,31 @@
  * Public Data
  ****************************************************************************/
 
-/* The g_wdfreelist data structure is a singly linked list of watchdogs
- * available to the system for delayed function use.
+/* g_wdpool is the pool of watchdogs available to the system for delayed
+ * function use.  The number of pre-allocated watchdogs in the pool and the
+ * number reserved for interrupt handlers are configuration items.
  */
 
-sq_queue_t g_wdfreelist;
+struct mempool_s g_wdpool;
 
+#ifndef CONFIG_WDOG_TIMERWHEEL
 /* The g_wdactivelist data structure is a singly linked list ordered by
  * watchdog expiration time. When watchdog timers expire,the functions on
  * this linked list are removed and the function is called.
  */
 
 sq_queue_t g_wdactivelist;
-
-/* This is the number of free, pre-allocated watchdog structures in the
- * g_wdfreelist.  This value is used to enforce a reserve for interrupt
- * handlers.
- */
-
-uint16_t g_wdnfree;
+#endif
 
 /* This is wdog tickbase, for wd_gettime() may called many times
- * between 2 times of wd_timer(), we use it to update wd_gettime().
+ * between 2 times of wd_timer(), we use it to update wd_gettime().  With
+ * the timer wheel, this is also the current time of the wheel.
  */
 
-#ifdef CONFIG_SCHED_TICKLESS
+#if defined(CONFIG_SCHED_TICKLESS) || defined(CONFIG_WDOG_TIMERWHEEL)
 clock_t g_wdtickbase;
 #endif
 
-/****************************************************************************
- * Private Data
- ****************************************************************************/
-
-/* g_wdpool is a list of pre-allocated watchdogs. The number of watchdogs
- * in the pool is a configuration item.
- */
-
-static struct wdog_s g_wdpool[CONFIG_PREALLOC_WDOGS];
-
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -110,24 +100,25 @@ static struct wdog_s g_wdpool[CONFIG_PREALLOC_WDOGS];
 
 void wd_initialize(void)
 {
-  FAR struct wdog_s *wdog = g_wdpool;
-  int i;
+  int ret;
 
-  /* Initialize watchdog lists */
+#ifndef CONFIG_WDOG_TIMERWHEEL
+  /* Initialize the list of active watchdogs */
 
-  sq_init(&g_wdfreelist);
   sq_init(&g_wdactivelist);
+#endif
 
-  /* The g_wdfreelist must be loaded at initialization time to hold the
-   * configured number of watchdogs.
+  /* The watchdog pool must be loaded at initialization time to hold the
+   * configured number of watchdogs.  When those are exhausted, the pool
+   * will be expanded from the kernel heap.
    */
 
-  for (i = 0; i < CONFIG_PREALLOC_WDOGS; i++)
-    {
-      sq_addlast((FAR sq_entry_t *)wdog++, &g_wdfreelist);
-    }
-
-  /* All watchdogs are free */
+  g_wdpool.bsize    = sizeof(struct wdog_s);
+  g_wdpool.ninitial = CONFIG_PREALLOC_WDOGS;
+  g_wdpool.nreserve = CONFIG_WDOG_INTRESERVE;
+  g_wdpool.nexpand  = WDOG_NEXPAND;
 
-  g_wdnfree = CONFIG_PREALLOC_WDOGS;
+  ret = mempool_initialize(&g_wdpool, "wdog");
+  DEBUGASSERT(ret == OK);
+  UNUSED(ret);
 }
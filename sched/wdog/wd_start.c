@@ -67,10 +67,63 @@
 #  define MAX(a,b) (((a) > (b)) ? (a) : (b))
 #endif
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#if defined(CONFIG_WDOG_TIMERWHEEL) && defined(CONFIG_SCHED_TICKLESS)
+/* Non-zero while wd_timer() advances the wheel time (wd_timer() may be
+ * nested through sched_timer_cancel()).  A watchdog started from a
+ * watchdog function then must not resynchronize the wheel time with the
+ * system timer:  The ticks of the interval that are still being processed
+ * are added to the wheel time by wd_timer().
+ */
+
+static uint8_t g_wdprocessing;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: wd_callback
+ *
+ * Description:
+ *   Execute the function of an expired watchdog.
+ *
+ * Input Parameters:
+ *   wdog - The expired watchdog
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static inline void wd_callback(FAR struct wdog_s *wdog)
+{
+  up_setpicbase(wdog->picbase);
+
+#if CONFIG_MAX_WDOGPARMS == 0
+  wdog->func(0);
+#elif CONFIG_MAX_WDOGPARMS == 1
+  wdog->func((int)wdog->argc,
+             wdog->parm[0]);
+#elif CONFIG_MAX_WDOGPARMS == 2
+  wdog->func((int)wdog->argc,
+             wdog->parm[0], wdog->parm[1]);
+#elif CONFIG_MAX_WDOGPARMS == 3
+  wdog->func((int)wdog->argc,
+             wdog->parm[0], wdog->parm[1], wdog->parm[2]);
+#elif CONFIG_MAX_WDOGPARMS == 4
+  wdog->func((int)wdog->argc,
+             wdog->parm[0], wdog->parm[1], wdog->parm[2],
+             wdog->parm[3]);
+#else
+#  error Missing support
+#endif
+}
+
 /****************************************************************************
  * Name: wd_expiration
  *
@@ -78,6 +131,10 @@
  *   Check if the timer for the watchdog at the head of list is ready to
  *   run.  If so, remove the watchdog from the list and execute it.
  *
+ *   With the timer wheel, first cascade any watchdogs that are now due
+ *   into the lowest level of the wheel, then remove and execute each
+ *   watchdog that expires at the current wheel time.
+ *
  * Input Parameters:
  *   None
  *
@@ -86,6 +143,29 @@
  *
  ****************************************************************************/
 
+#ifdef CONFIG_WDOG_TIMERWHEEL
+static inline void wd_expiration(void)
+{
+  FAR struct wdog_s *wdog;
+
+  wd_wheel_cascade();
+
+  while ((wdog = wd_wheel_expired()) != NULL)
+    {
+      /* Remove the watchdog from the wheel and indicate that it is no
+       * longer active.
+       */
+
+      wd_wheel_remove(wdog);
+      WDOG_CLRACTIVE(wdog);
+
+      /* Execute the watchdog function */
+
+      wd_callback(wdog);
+    }
+}
+
+#else
 static inline void wd_expiration(void)
 {
   FAR struct wdog_s *wdog;
@@ -120,29 +200,11 @@ static inline void wd_expiration(void)
 
           /* Execute the watchdog function */
 
-          up_setpicbase(wdog->picbase);
-
-#if CONFIG_MAX_WDOGPARMS == 0
-          wdog->func(0);
-#elif CONFIG_MAX_WDOGPARMS == 1
-          wdog->func((int)wdog->argc,
-                     wdog->parm[0]);
-#elif CONFIG_MAX_WDOGPARMS == 2
-          wdog->func((int)wdog->argc,
-                     wdog->parm[0], wdog->parm[1]);
-#elif CONFIG_MAX_WDOGPARMS == 3
-          wdog->func((int)wdog->argc,
-                     wdog->parm[0], wdog->parm[1], wdog->parm[2]);
-#elif CONFIG_MAX_WDOGPARMS == 4
-          wdog->func((int)wdog->argc,
-                     wdog->parm[0], wdog->parm[1], wdog->parm[2],
-                     wdog->parm[3]);
-#else
-#  error Missing support
-#endif
+          wd_callback(wdog);
         }
     }
 }
+#endif /* CONFIG_WDOG_TIMERWHEEL */
 
 /****************************************************************************
  * Public Functions
@@ -185,10 +247,12 @@ static inline void wd_expiration(void)
 int wd_start(WDOG_ID wdog, int32_t delay, wdentry_t wdentry,  int argc, ...)
 {
   va_list ap;
+#ifndef CONFIG_WDOG_TIMERWHEEL
   FAR struct wdog_s *curr;
   FAR struct wdog_s *prev;
   FAR struct wdog_s *next;
   int32_t now;
+#endif
   irqstate_t flags;
   int i;
 
@@ -253,6 +317,22 @@ int wd_start(WDOG_ID wdog, int32_t delay, wdentry_t wdentry,  int argc, ...)
   (void)sched_timer_cancel();
 #endif
 
+#ifdef CONFIG_WDOG_TIMERWHEEL
+#ifdef CONFIG_SCHED_TICKLESS
+  /* The wheel time is not advanced while the wheel is empty */
+
+  if (g_wdprocessing == 0 && wd_wheel_next() == 0)
+    {
+      g_wdtickbase = clock_systimer();
+    }
+#endif
+
+  /* Add the watchdog to the wheel slot that covers its expiration time */
+
+  wdog->expired = g_wdtickbase + delay;
+  wd_wheel_add(wdog);
+
+#else
   /* Do the easy case first -- when the watchdog timer queue is empty. */
 
   if (g_wdactivelist.head == NULL)
@@ -343,9 +423,13 @@ int wd_start(WDOG_ID wdog, int32_t delay, wdentry_t wdentry,  int argc, ...)
         }
     }
 
-  /* Put the lag into the watchdog structure and mark it as active. */
+  /* Put the lag into the watchdog structure */
 
   wdog->lag = delay;
+#endif /* CONFIG_WDOG_TIMERWHEEL */
+
+  /* Mark the watchdog as active */
+
   WDOG_SETACTIVE(wdog);
 
 #ifdef CONFIG_SCHED_TICKLESS
@@ -389,12 +473,18 @@ int wd_start(WDOG_ID wdog, int32_t delay, wdentry_t wdentry,  int argc, ...)
 #ifdef CONFIG_SCHED_TICKLESS
 unsigned int wd_timer(int ticks)
 {
+#ifndef CONFIG_WDOG_TIMERWHEEL
   FAR struct wdog_s *wdog;
+#endif
 #ifdef CONFIG_SMP
   irqstate_t flags;
 #endif
   unsigned int ret;
+#ifdef CONFIG_WDOG_TIMERWHEEL
+  unsigned int next;
+#else
   int decr;
+#endif
 
 #ifdef CONFIG_SMP
   /* We are in an interrupt handler as, as a consequence, interrupts are
@@ -409,6 +499,41 @@ unsigned int wd_timer(int ticks)
   flags = enter_critical_section();
 #endif
 
+#ifdef CONFIG_WDOG_TIMERWHEEL
+  /* Advance the wheel time to each point where the wheel must be processed
+   * within the interval that just expired.
+   */
+
+  g_wdprocessing++;
+
+  while (ticks > 0)
+    {
+      next = wd_wheel_next();
+      if (next == 0 || next > (unsigned int)ticks)
+        {
+          break;
+        }
+
+      ticks        -= next;
+      g_wdtickbase += next;
+
+      /* Cascade and execute the watchdogs that are due at this time */
+
+      wd_expiration();
+    }
+
+  /* Update clock tickbase */
+
+  g_wdtickbase += ticks;
+  g_wdprocessing--;
+
+  /* Return the delay until the wheel must be processed next.  This may be
+   * the time of a cascade rather than the time that a watchdog expires.
+   */
+
+  ret = wd_wheel_next();
+
+#else
   /* Check if there are any active watchdogs to process */
 
   while (g_wdactivelist.head != NULL && ticks > 0)
@@ -448,6 +573,7 @@ unsigned int wd_timer(int ticks)
 
   ret = g_wdactivelist.head ?
           ((FAR struct wdog_s *)g_wdactivelist.head)->lag : 0;
+#endif /* CONFIG_WDOG_TIMERWHEEL */
 
 #ifdef CONFIG_SMP
   leave_critical_section(flags);
@@ -476,6 +602,15 @@ void wd_timer(void)
   flags = enter_critical_section();
 #endif
 
+#ifdef CONFIG_WDOG_TIMERWHEEL
+  /* Advance the wheel time by one tick, then cascade and execute the
+   * watchdogs that are due at this time.
+   */
+
+  g_wdtickbase++;
+  wd_expiration();
+
+#else
   /* Check if there are any active watchdogs to process */
 
   if (g_wdactivelist.head)
@@ -488,6 +623,7 @@ void wd_timer(void)
 
       wd_expiration();
     }
+#endif /* CONFIG_WDOG_TIMERWHEEL */
 
 #ifdef CONFIG_SMP
   leave_critical_section(flags);
@@ -0,0 +1,332 @@
+/****************************************************************************
+ * sched/wdog/wd_wheel.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <strings.h>
+#include <assert.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/wdog.h>
+
+#include "wdog/wdog.h"
+
+#ifdef CONFIG_WDOG_TIMERWHEEL
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The shift that converts a tick count to a slot number in a level */
+
+#define WDOG_WHEEL_SHIFT(l)  ((l) * CONFIG_WDOG_WHEEL_BITS)
+
+/* The longest delay that the wheel can represent.  Watchdogs with longer
+ * delays are placed in the top level slot that is reached last and are
+ * re-inserted from there.
+ */
+
+#define WDOG_WHEEL_SPAN \
+  (((clock_t)1 << WDOG_WHEEL_SHIFT(WDOG_WHEEL_NLEVELS)) - 1)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The timer wheel.  Level 0 has one slot for each of the next
+ * WDOG_WHEEL_NSLOTS ticks; each slot in level l covers
+ * (1 << WDOG_WHEEL_SHIFT(l)) ticks.  Each slot holds a doubly linked,
+ * unordered list of watchdogs.  A bit is set in the level bitmap for each
+ * non-empty slot.
+ */
+
+struct wd_wheel_s
+{
+  uint32_t bitmap[WDOG_WHEEL_NLEVELS];
+  FAR struct wdog_s *slot[WDOG_WHEEL_NLEVELS * WDOG_WHEEL_NSLOTS];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct wd_wheel_s g_wdwheel;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_search
+ *
+ * Description:
+ *   Return the distance from slot 'start' to the first non-empty slot of a
+ *   level, wrapping around at the end of the level, or -1 if the level is
+ *   empty.
+ *
+ ****************************************************************************/
+
+static int wd_wheel_search(uint32_t bitmap, unsigned int start)
+{
+  uint32_t bits;
+
+  bits = bitmap >> start;
+  if (bits != 0)
+    {
+      return ffs((int)bits) - 1;
+    }
+
+  bits = bitmap & ((1 << start) - 1);
+  if (bits != 0)
+    {
+      return WDOG_WHEEL_NSLOTS - start + ffs((int)bits) - 1;
+    }
+
+  return -1;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_add
+ *
+ * Description:
+ *   Add a watchdog to the timer wheel.  The expiration time must already be
+ *   set and must not be earlier than the current wheel time, g_wdtickbase.
+ *   A watchdog that expires at the current time is placed in the current
+ *   level 0 slot; this happens when watchdogs are cascaded.
+ *
+ ****************************************************************************/
+
+void wd_wheel_add(FAR struct wdog_s *wdog)
+{
+  FAR struct wdog_s **head;
+  sclock_t delay;
+  clock_t expired;
+  int level;
+  int ndx;
+
+  /* Select the lowest level that spans the delay */
+
+  delay = (sclock_t)(wdog->expired - g_wdtickbase);
+  DEBUGASSERT(delay >= 0);
+
+  if (delay < 0)
+    {
+      delay = 0;
+    }
+  else if ((clock_t)delay > WDOG_WHEEL_SPAN)
+    {
+      delay = WDOG_WHEEL_SPAN;
+    }
+
+  for (level = 0;
+       level < WDOG_WHEEL_NLEVELS - 1 &&
+       (clock_t)delay >= ((clock_t)1 << WDOG_WHEEL_SHIFT(level + 1));
+       level++)
+    {
+    }
+
+  /* Then the slot within that level that covers the expiration time */
+
+  expired = g_wdtickbase + delay;
+  ndx     = (expired >> WDOG_WHEEL_SHIFT(level)) & WDOG_WHEEL_MASK;
+
+  /* Add the watchdog at the head of the slot list */
+
+  wdog->slot = level * WDOG_WHEEL_NSLOTS + ndx;
+  head       = &g_wdwheel.slot[wdog->slot];
+
+  wdog->prev = NULL;
+  wdog->next = *head;
+  if (*head != NULL)
+    {
+      (*head)->prev = wdog;
+    }
+
+  *head = wdog;
+  g_wdwheel.bitmap[level] |= (uint32_t)1 << ndx;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_remove
+ *
+ * Description:
+ *   Remove a watchdog from the timer wheel.
+ *
+ ****************************************************************************/
+
+void wd_wheel_remove(FAR struct wdog_s *wdog)
+{
+  FAR struct wdog_s **head = &g_wdwheel.slot[wdog->slot];
+
+  if (wdog->prev != NULL)
+    {
+      wdog->prev->next = wdog->next;
+    }
+  else
+    {
+      DEBUGASSERT(*head == wdog);
+      *head = wdog->next;
+
+      /* Mark the slot empty if this was the only watchdog */
+
+      if (*head == NULL)
+        {
+          g_wdwheel.bitmap[wdog->slot >> CONFIG_WDOG_WHEEL_BITS] &=
+            ~((uint32_t)1 << (wdog->slot & WDOG_WHEEL_MASK));
+        }
+    }
+
+  if (wdog->next != NULL)
+    {
+      wdog->next->prev = wdog->prev;
+    }
+
+  wdog->next = NULL;
+  wdog->prev = NULL;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_cascade
+ *
+ * Description:
+ *   Called when the wheel time has advanced.  If the wheel time is at the
+ *   beginning of the period of a slot in a higher level, the watchdogs in
+ *   that slot are moved to the lower levels.
+ *
+ ****************************************************************************/
+
+void wd_wheel_cascade(void)
+{
+  FAR struct wdog_s *wdog;
+  FAR struct wdog_s **head;
+  unsigned int ndx;
+  int level;
+
+  /* A slot in level l is reached when the slot number of each lower level
+   * wraps around to zero.  Each watchdog in that slot then expires within
+   * the period of the slot and is re-inserted in a lower level.  The
+   * watchdogs that were placed there because their delay exceeded the
+   * span of the wheel may be re-inserted in the top level again, but
+   * never in the same slot.
+   */
+
+  ndx = g_wdtickbase & WDOG_WHEEL_MASK;
+  for (level = 1; ndx == 0 && level < WDOG_WHEEL_NLEVELS; level++)
+    {
+      ndx  = (g_wdtickbase >> WDOG_WHEEL_SHIFT(level)) & WDOG_WHEEL_MASK;
+      head = &g_wdwheel.slot[level * WDOG_WHEEL_NSLOTS + ndx];
+
+      while ((wdog = *head) != NULL)
+        {
+          wd_wheel_remove(wdog);
+          wd_wheel_add(wdog);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: wd_wheel_expired
+ *
+ * Description:
+ *   Return a watchdog that expires at the current wheel time, or NULL if
+ *   there are none.  The watchdog is not removed from the wheel.
+ *
+ ****************************************************************************/
+
+FAR struct wdog_s *wd_wheel_expired(void)
+{
+  FAR struct wdog_s *wdog;
+
+  /* Every watchdog in the level 0 slot for the current time expires now */
+
+  wdog = g_wdwheel.slot[g_wdtickbase & WDOG_WHEEL_MASK];
+  DEBUGASSERT(wdog == NULL || wdog->expired == g_wdtickbase);
+  return wdog;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_next
+ *
+ * Description:
+ *   Return the number of ticks from the current wheel time until the wheel
+ *   must next be processed, or zero if the wheel is empty.
+ *
+ ****************************************************************************/
+
+unsigned int wd_wheel_next(void)
+{
+  clock_t next = 0;
+  clock_t period;
+  clock_t delay;
+  int level;
+  int dist;
+
+  for (level = 0; level < WDOG_WHEEL_NLEVELS; level++)
+    {
+      if (g_wdwheel.bitmap[level] == 0)
+        {
+          continue;
+        }
+
+      /* Find the first non-empty slot, beginning with the next period of
+       * this level.  Its watchdogs are handled at the beginning of that
+       * period.
+       */
+
+      period = (g_wdtickbase >> WDOG_WHEEL_SHIFT(level)) + 1;
+      dist   = wd_wheel_search(g_wdwheel.bitmap[level],
+                               period & WDOG_WHEEL_MASK);
+      DEBUGASSERT(dist >= 0);
+
+      delay  = ((period + dist) << WDOG_WHEEL_SHIFT(level)) - g_wdtickbase;
+      if (next == 0 || delay < next)
+        {
+          next = delay;
+        }
+    }
+
+  return (unsigned int)next;
+}
+
+#endif /* CONFIG_WDOG_TIMERWHEEL */
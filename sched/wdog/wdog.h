@@ -48,11 +48,27 @@
 #include <nuttx/compiler.h>
 #include <nuttx/clock.h>
 #include <nuttx/wdog.h>
+#include <nuttx/mm/mempool.h>
 
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* This is the number of watchdogs that are added to the watchdog pool from
+ * the kernel heap when the unreserved, pre-allocated watchdogs have been
+ * exhausted.
+ */
+
+#define WDOG_NEXPAND 4
+
+/* Timer wheel geometry */
+
+#ifdef CONFIG_WDOG_TIMERWHEEL
+#  define WDOG_WHEEL_NLEVELS 4
+#  define WDOG_WHEEL_NSLOTS  (1 << CONFIG_WDOG_WHEEL_BITS)
+#  define WDOG_WHEEL_MASK    (WDOG_WHEEL_NSLOTS - 1)
+#endif
+
 /****************************************************************************
  * Name: wd_elapse
  *
@@ -82,31 +98,27 @@ extern "C"
 #define EXTERN extern
 #endif
 
-/* The g_wdfreelist data structure is a singly linked list of watchdogs
- * available to the system for delayed function use.
+/* g_wdpool is the pool of watchdogs available to the system for delayed
+ * function use.
  */
 
-extern sq_queue_t g_wdfreelist;
+extern struct mempool_s g_wdpool;
 
+#ifndef CONFIG_WDOG_TIMERWHEEL
 /* The g_wdactivelist data structure is a singly linked list ordered by
  * watchdog expiration time. When watchdog timers expire,the functions on
  * this linked list are removed and the function is called.
  */
 
 extern sq_queue_t g_wdactivelist;
-
-/* This is the number of free, pre-allocated watchdog structures in the
- * g_wdfreelist.  This value is used to enforce a reserve for interrupt
- * handlers.
- */
-
-extern uint16_t g_wdnfree;
+#endif
 
 /* This is wdog tickbase, for wd_gettime() may called many times
  * between 2 times of wd_timer(), we use it to update wd_gettime().
+ * With the timer wheel, this is also the current time of the wheel.
  */
 
-#ifdef CONFIG_SCHED_TICKLESS
+#if defined(CONFIG_SCHED_TICKLESS) || defined(CONFIG_WDOG_TIMERWHEEL)
 extern clock_t g_wdtickbase;
 #endif
 
@@ -188,6 +200,82 @@ void wd_timer(void);
 struct tcb_s;
 void wd_recover(FAR struct tcb_s *tcb);
 
+#ifdef CONFIG_WDOG_TIMERWHEEL
+/****************************************************************************
+ * Name: wd_wheel_add
+ *
+ * Description:
+ *   Add a watchdog to the timer wheel.  The expiration time must already be
+ *   set and must be later than the current wheel time, g_wdtickbase.
+ *
+ * Assumptions:
+ *   Called in a critical section.
+ *
+ ****************************************************************************/
+
+void wd_wheel_add(FAR struct wdog_s *wdog);
+
+/****************************************************************************
+ * Name: wd_wheel_remove
+ *
+ * Description:
+ *   Remove a watchdog from the timer wheel.
+ *
+ * Assumptions:
+ *   Called in a critical section.
+ *
+ ****************************************************************************/
+
+void wd_wheel_remove(FAR struct wdog_s *wdog);
+
+/****************************************************************************
+ * Name: wd_wheel_cascade
+ *
+ * Description:
+ *   Called when the wheel time has advanced.  If the wheel time is at the
+ *   beginning of the period of a slot in a higher level, the watchdogs in
+ *   that slot are moved to the lower levels.
+ *
+ * Assumptions:
+ *   Called in a critical section.
+ *
+ ****************************************************************************/
+
+void wd_wheel_cascade(void);
+
+/****************************************************************************
+ * Name: wd_wheel_expired
+ *
+ * Description:
+ *   Return a watchdog that expires at the current wheel time, or NULL if
+ *   there are none.  The watchdog is not removed from the wheel.
+ *
+ * Assumptions:
+ *   Called in a critical section after wd_wheel_cascade().
+ *
+ ****************************************************************************/
+
+FAR struct wdog_s *wd_wheel_expired(void);
+
+/****************************************************************************
+ * Name: wd_wheel_next
+ *
+ * Description:
+ *   Return the number of ticks from the current wheel time until the wheel
+ *   must next be processed:  Either a watchdog expires or the watchdogs in
+ *   a higher level slot must be moved to the lower levels.
+ *
+ * Returned Value:
+ *   The number of ticks or zero if the wheel is empty.
+ *
+ * Assumptions:
+ *   Called in a critical section.
+ *
+ ****************************************************************************/
+
+unsigned int wd_wheel_next(void);
+#endif /* CONFIG_WDOG_TIMERWHEEL */
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -92,18 +92,20 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue,
   flags = enter_critical_section();
   if (work->worker != NULL)
     {
+      FAR dq_queue_t *list = WORK_LIST(WORK_QUEUE(wqueue, work), work);
+
       /* A little test of the integrity of the work queue */
 
       DEBUGASSERT(work->dq.flink != NULL ||
-                  (FAR dq_entry_t *)work == wqueue->q.tail);
+                  (FAR dq_entry_t *)work == list->tail);
       DEBUGASSERT(work->dq.blink != NULL ||
-                  (FAR dq_entry_t *)work == wqueue->q.head);
+                  (FAR dq_entry_t *)work == list->head);
 
       /* Remove the entry from the work queue and make sure that it is
        * marked as available (i.e., the worker field is nullified).
        */
 
-      dq_rem((FAR dq_entry_t *)work, &wqueue->q);
+      dq_rem((FAR dq_entry_t *)work, list);
       work->worker = NULL;
       ret = OK;
     }
@@ -139,27 +141,14 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue,
 
 int work_cancel(int qid, FAR struct work_s *work)
 {
-#ifdef CONFIG_SCHED_HPWORK
-  if (qid == HPWORK)
-    {
-      /* Cancel high priority work */
+  FAR struct kwork_wqueue_s *wqueue = work_wqueue(qid);
 
-      return work_qcancel((FAR struct kwork_wqueue_s *)&g_hpwork, work);
-    }
-  else
-#endif
-#ifdef CONFIG_SCHED_LPWORK
-  if (qid == LPWORK)
-    {
-      /* Cancel low priority work */
-
-      return work_qcancel((FAR struct kwork_wqueue_s *)&g_lpwork, work);
-    }
-  else
-#endif
+  if (wqueue == NULL)
     {
       return -EINVAL;
     }
+
+  return work_qcancel(wqueue, work);
 }
 
 #endif /* CONFIG_SCHED_WORKQUEUE */
@@ -46,6 +46,7 @@
 #include <queue.h>
 #include <debug.h>
 
+#include <nuttx/sched.h>
 #include <nuttx/wqueue.h>
 #include <nuttx/kthread.h>
 #include <nuttx/kmalloc.h>
@@ -61,7 +62,7 @@
 
 /* The state of the kernel mode, high priority work queue(s). */
 
-struct hp_wqueue_s g_hpwork;
+struct hp_wqueue_s g_hpwork[HPWORK_NQUEUES];
 
 /****************************************************************************
  * Private Functions
@@ -95,65 +96,70 @@ struct hp_wqueue_s g_hpwork;
 
 static int work_hpthread(int argc, char *argv[])
 {
-#if CONFIG_SCHED_HPNTHREADS > 1
-  int wndx;
+  FAR struct kwork_wqueue_s *wqueue =
+    (FAR struct kwork_wqueue_s *)&g_hpwork[0];
+  int wndx = 0;
+#if HPWORK_NQUEUES > 1 || CONFIG_SCHED_HPNTHREADS > 1
   pid_t me = getpid();
+  int cpu;
   int i;
 
-  /* Find out thread index by search the workers in g_hpwork */
+  /* Find our work queue and thread index by searching the workers in
+   * g_hpwork.
+   */
 
-  for (wndx = 0, i = 0; i < CONFIG_SCHED_HPNTHREADS; i++)
+  for (cpu = 0; cpu < HPWORK_NQUEUES; cpu++)
     {
-      if (g_hpwork.worker[i].pid == me)
+      for (i = 0; i < CONFIG_SCHED_HPNTHREADS; i++)
+        {
+          if (g_hpwork[cpu].worker[i].pid == me)
+            {
+              wqueue = (FAR struct kwork_wqueue_s *)&g_hpwork[cpu];
+              wndx   = i;
+              break;
+            }
+        }
+
+      if (i < CONFIG_SCHED_HPNTHREADS)
         {
-          wndx = i;
           break;
         }
     }
 
-  DEBUGASSERT(i < CONFIG_SCHED_HPNTHREADS);
+  DEBUGASSERT(cpu < HPWORK_NQUEUES);
 #endif
 
   /* Loop forever */
 
   for (; ; )
     {
-#if CONFIG_SCHED_HPNTHREADS > 1
-      /* Thread 0 is special.  Only thread 0 performs period garbage collection */
-
-      if (wndx > 0)
-        {
-          /* The other threads will perform work, waiting indefinitely until
-           * signalled for the next work availability.
-           */
-
-          work_process((FAR struct kwork_wqueue_s *)&g_hpwork, wndx);
-        }
-      else
-#endif
-        {
 #ifndef CONFIG_SCHED_LPWORK
-          /* First, perform garbage collection.  This cleans-up memory
-           * de-allocations that were queued because they could not be freed in
-           * that execution context (for example, if the memory was freed from
-           * an interrupt handler).
-           *
-           * NOTE: If the work thread is disabled, this clean-up is performed by
-           * the IDLE thread (at a very, very low priority).  If the low-priority
-           * work thread is enabled, then the garbage collection is done on that
-           * thread instead.
-           */
-
+      /* Thread 0 of the first work queue is special.  Only that thread
+       * performs period garbage collection.  This cleans-up memory
+       * de-allocations that were queued because they could not be freed in
+       * that execution context (for example, if the memory was freed from
+       * an interrupt handler).
+       *
+       * NOTE: If the work thread is disabled, this clean-up is performed by
+       * the IDLE thread (at a very, very low priority).  If the low-priority
+       * work thread is enabled, then the garbage collection is done on that
+       * thread instead.
+       */
+
+      if (wndx == 0 && wqueue == (FAR struct kwork_wqueue_s *)&g_hpwork[0])
+        {
           sched_garbage_collection();
+        }
 #endif
 
-          /* Then process queued work.  work_process will not return until: (1)
-           * there is no further work in the work queue, and (2) signal is
-           * triggered, or delayed work expires.
-           */
+      /* Then process queued work.  work_process will not return until: (1)
+       * there is no further work in the work queue, and (2) signal is
+       * triggered, or delayed work expires.  The other threads (wndx > 0)
+       * will wait indefinitely until signalled for the next work
+       * availability.
+       */
 
-          work_process((FAR struct kwork_wqueue_s *)&g_hpwork, 0);
-        }
+      work_process(wqueue, wndx);
     }
 
   return OK; /* To keep some compilers happy */
@@ -180,8 +186,13 @@ static int work_hpthread(int argc, char *argv[])
 
 int work_hpstart(void)
 {
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+  cpu_set_t cpuset;
+  int ret;
+#endif
   pid_t pid;
   int wndx;
+  int cpu;
 
   /* Don't permit any of the threads to run until we have fully initialized
    * g_hpwork.
@@ -193,27 +204,49 @@ int work_hpstart(void)
 
   sinfo("Starting high-priority kernel worker thread(s)\n");
 
-  for (wndx = 0; wndx < CONFIG_SCHED_HPNTHREADS; wndx++)
+  for (cpu = 0; cpu < HPWORK_NQUEUES; cpu++)
     {
-      pid = kthread_create(HPWORKNAME, CONFIG_SCHED_HPWORKPRIORITY,
-                           CONFIG_SCHED_HPWORKSTACKSIZE,
-                           (main_t)work_hpthread,
-                           (FAR char * const *)NULL);
+      g_hpwork[cpu].name     = HPWORKNAME;
+      g_hpwork[cpu].nthreads = CONFIG_SCHED_HPNTHREADS;
 
-      DEBUGASSERT(pid > 0);
-      if (pid < 0)
+      for (wndx = 0; wndx < CONFIG_SCHED_HPNTHREADS; wndx++)
         {
-          serr("ERROR: kthread_create %d failed: %d\n", wndx, (int)pid);
-          sched_unlock();
-          return (int)pid;
-        }
+          pid = kthread_create(HPWORKNAME, CONFIG_SCHED_HPWORKPRIORITY,
+                               CONFIG_SCHED_HPWORKSTACKSIZE,
+                               (main_t)work_hpthread,
+                               (FAR char * const *)NULL);
+
+          DEBUGASSERT(pid > 0);
+          if (pid < 0)
+            {
+              serr("ERROR: kthread_create %d failed: %d\n", wndx, (int)pid);
+              sched_unlock();
+              return (int)pid;
+            }
+
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+          /* Each thread only processes the work queue of its own CPU */
+
+          CPU_ZERO(&cpuset);
+          CPU_SET(cpu, &cpuset);
+
+          ret = nxsched_setaffinity(pid, sizeof(cpu_set_t), &cpuset);
+          if (ret < 0)
+            {
+              serr("ERROR: nxsched_setaffinity %d failed: %d\n",
+                   (int)pid, ret);
+              sched_unlock();
+              return ret;
+            }
+#endif
 
-      g_hpwork.worker[wndx].pid  = pid;
-      g_hpwork.worker[wndx].busy = true;
+          g_hpwork[cpu].worker[wndx].pid  = pid;
+          g_hpwork[cpu].worker[wndx].busy = true;
+        }
     }
 
   sched_unlock();
-  return g_hpwork.worker[0].pid;
+  return g_hpwork[0].worker[0].pid;
 }
 
 #endif /* CONFIG_SCHED_HPWORK */
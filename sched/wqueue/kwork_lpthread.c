@@ -189,6 +189,9 @@ int work_lpstart(void)
 
   sinfo("Starting low-priority kernel worker thread(s)\n");
 
+  g_lpwork.name     = LPWORKNAME;
+  g_lpwork.nthreads = CONFIG_SCHED_LPNTHREADS;
+
   for (wndx = 0; wndx < CONFIG_SCHED_LPNTHREADS; wndx++)
     {
       pid = kthread_create(LPWORKNAME, CONFIG_SCHED_LPWORKPRIORITY,
@@ -0,0 +1,258 @@
+/****************************************************************************
+ * sched/wqueue/kwork_named.c
+ *
+ *   Copyright (C) 2019 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sched.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/wqueue.h>
+#include <nuttx/kthread.h>
+#include <nuttx/kmalloc.h>
+
+#include "task/task.h"
+#include "wqueue/wqueue.h"
+
+#if defined(CONFIG_SCHED_WORKQUEUE) && defined(CONFIG_SCHED_NAMEDWORK) && \
+    CONFIG_SCHED_NAMEDWORK > 0
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* The state of the named kernel work queues */
+
+FAR struct kwork_wqueue_s *g_namedwork[CONFIG_SCHED_NAMEDWORK];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: work_namedthread
+ *
+ * Description:
+ *   These are the worker threads of the named work queues.  The work queue
+ *   ID is provided as the only argument.
+ *
+ * Input Parameters:
+ *   argc, argv - argv[1] holds the work queue ID
+ *
+ * Returned Value:
+ *   Does not return
+ *
+ ****************************************************************************/
+
+static int work_namedthread(int argc, FAR char *argv[])
+{
+  FAR struct kwork_wqueue_s *wqueue;
+  pid_t me = getpid();
+  int wndx;
+  int qid;
+
+  DEBUGASSERT(argc == 2);
+  qid    = atoi(argv[1]);
+  wqueue = g_namedwork[qid - NAMEDWORK];
+  DEBUGASSERT(wqueue != NULL);
+
+  /* Find out thread index by searching the workers of the work queue */
+
+  for (wndx = 0; wndx < wqueue->nthreads; wndx++)
+    {
+      if (wqueue->worker[wndx].pid == me)
+        {
+          break;
+        }
+    }
+
+  DEBUGASSERT(wndx < wqueue->nthreads);
+
+  /* Loop forever.  Only thread 0 waits for delayed work to expire. */
+
+  for (; ; )
+    {
+      work_process(wqueue, wndx);
+    }
+
+  return OK; /* To keep some compilers happy */
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: work_create
+ *
+ * Description:
+ *   Create an additional kernel work queue with its own pool of worker
+ *   threads.  Work is queued to the new work queue with the returned work
+ *   queue ID.  Named work queues are never deleted.
+ *
+ * Input Parameters:
+ *   name      - The name of the work queue and its worker threads.  The
+ *               string must persist.
+ *   priority  - The priority of the worker threads
+ *   stacksize - The stack size of the worker threads
+ *   nthreads  - The number of worker threads
+ *
+ * Returned Value:
+ *   The work queue ID (NAMEDWORK or above) on success; a negated errno
+ *   value on failure.
+ *
+ ****************************************************************************/
+
+int work_create(FAR const char *name, int priority, int stacksize,
+                int nthreads)
+{
+  FAR struct kwork_wqueue_s *wqueue;
+  FAR char *argv[2];
+  char qidstr[8];
+  pid_t pid;
+  int wndx;
+  int ndx;
+  int ret;
+  int i;
+
+  if (name == NULL || nthreads < 1 || nthreads > UINT8_MAX ||
+      priority < SCHED_PRIORITY_MIN || priority > SCHED_PRIORITY_MAX)
+    {
+      return -EINVAL;
+    }
+
+  /* Allocate the work queue with room for all of its workers */
+
+  wqueue = (FAR struct kwork_wqueue_s *)
+    kmm_zalloc(sizeof(struct kwork_wqueue_s) +
+               (nthreads - 1) * sizeof(struct kworker_s));
+  if (wqueue == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  wqueue->name     = name;
+  wqueue->nthreads = nthreads;
+
+  /* Don't permit any of the threads to run until the work queue has been
+   * fully initialized.  This also keeps other callers from taking the same
+   * work queue ID.
+   */
+
+  sched_lock();
+
+  for (ndx = -1, i = 0; i < CONFIG_SCHED_NAMEDWORK; i++)
+    {
+      if (g_namedwork[i] == NULL)
+        {
+          if (ndx < 0)
+            {
+              ndx = i;
+            }
+        }
+      else if (strcmp(g_namedwork[i]->name, name) == 0)
+        {
+          ret = -EEXIST;
+          goto errout_with_lock;
+        }
+    }
+
+  if (ndx < 0)
+    {
+      ret = -ENOSPC;
+      goto errout_with_lock;
+    }
+
+  g_namedwork[ndx] = wqueue;
+
+  /* Start the worker threads */
+
+  snprintf(qidstr, sizeof(qidstr), "%d", NAMEDWORK + ndx);
+  argv[0] = qidstr;
+  argv[1] = NULL;
+
+  for (wndx = 0; wndx < nthreads; wndx++)
+    {
+      pid = kthread_create(name, priority, stacksize,
+                           (main_t)work_namedthread,
+                           (FAR char * const *)argv);
+
+      DEBUGASSERT(pid > 0);
+      if (pid < 0)
+        {
+          serr("ERROR: kthread_create %d failed: %d\n", wndx, (int)pid);
+          ret = (int)pid;
+          goto errout_with_threads;
+        }
+
+      wqueue->worker[wndx].pid  = pid;
+      wqueue->worker[wndx].busy = true;
+    }
+
+  sched_unlock();
+
+  sinfo("Created work queue %s: qid=%d\n", name, NAMEDWORK + ndx);
+  return NAMEDWORK + ndx;
+
+errout_with_threads:
+
+  /* None of the threads has run yet so they may simply be terminated */
+
+  while (--wndx >= 0)
+    {
+      (void)nxtask_terminate(wqueue->worker[wndx].pid, false);
+    }
+
+  g_namedwork[ndx] = NULL;
+
+errout_with_lock:
+  sched_unlock();
+  kmm_free(wqueue);
+  return ret;
+}
+
+#endif /* CONFIG_SCHED_WORKQUEUE && CONFIG_SCHED_NAMEDWORK > 0 */
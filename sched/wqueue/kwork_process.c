@@ -41,11 +41,13 @@
 
 #include <stdint.h>
 #include <unistd.h>
+#include <string.h>
 #include <signal.h>
 #include <assert.h>
 #include <queue.h>
 
 #include <nuttx/irq.h>
+#include <nuttx/arch.h>
 #include <nuttx/clock.h>
 #include <nuttx/signal.h>
 #include <nuttx/wqueue.h>
@@ -78,6 +80,166 @@
 #  define MIN(a,b) ((a) < (b) ? (a) : (b))
 #endif
 
+/* Measure the time spent in each critical section of work_process() */
+
+#ifdef CONFIG_SCHED_CRITMONITOR
+#  define work_critstart(s)   ((s) = up_critmon_gettime())
+#  define work_critstop(q,s)  work_critupdate(q, s)
+#else
+#  define work_critstart(s)
+#  define work_critstop(q,s)
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: work_critupdate
+ *
+ * Description:
+ *   Update the maximum time that work_process() kept the critical section
+ *   for this work queue.  This does not include the time spent waiting
+ *   for work or the time spent in the worker functions.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CRITMONITOR
+static void work_critupdate(FAR struct kwork_wqueue_s *wqueue,
+                            uint32_t start)
+{
+  uint32_t elapsed = up_critmon_gettime() - start;
+
+  if (start != 0 && elapsed > wqueue->crit_max)
+    {
+      wqueue->crit_max = elapsed;
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: work_latency
+ *
+ * Description:
+ *   Add the time since the work became ready to the latency histogram of
+ *   the work queue.
+ *
+ * Assumptions:
+ *   Called in a critical section.  The work has been removed from the
+ *   ready list.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE_LATENCY
+static void work_latency(FAR struct kwork_wqueue_s *wqueue,
+                         FAR struct work_s *work)
+{
+  clock_t latency = clock_systimer() - work->qtime;
+  clock_t limit;
+  int ndx;
+
+  if (latency > wqueue->maxlat)
+    {
+      wqueue->maxlat = latency;
+    }
+
+  /* Bucket n > 0 holds latencies in the range [2^(n-1), 2^n) */
+
+  ndx   = 0;
+  limit = 1;
+
+  while (ndx < CONFIG_SCHED_WORKQUEUE_NLATENCY - 1 && latency >= limit)
+    {
+      ndx++;
+      limit <<= 1;
+    }
+
+  wqueue->latency[ndx]++;
+}
+#else
+#  define work_latency(q,w)
+#endif
+
+/****************************************************************************
+ * Name: work_expire
+ *
+ * Description:
+ *   Move the delayed work that has expired to the end of the ready list.
+ *   The delayed list is ordered by expiration time so only expired work
+ *   and the first unexpired work need to be examined.
+ *
+ * Returned Value:
+ *   The number of ticks until the next delayed work expires or
+ *   WORK_DELAY_MAX if there is no delayed work.
+ *
+ * Assumptions:
+ *   Called in a critical section.
+ *
+ ****************************************************************************/
+
+static clock_t work_expire(FAR struct kwork_wqueue_s *wqueue)
+{
+  FAR struct work_s *work;
+  clock_t elapsed;
+  clock_t ctick;
+
+  ctick = clock_systimer();
+  while ((work = (FAR struct work_s *)wqueue->delayed.head) != NULL)
+    {
+      /* qtime is the time that the work was added to the work queue.
+       * Stop at the first work that is not ready.
+       */
+
+      elapsed = ctick - work->qtime;
+      if (elapsed < work->delay)
+        {
+          return work->delay - elapsed;
+        }
+
+      /* Move the expired work to the ready list.  From now on, qtime is
+       * the time that the work became ready.
+       */
+
+      (void)dq_remfirst(&wqueue->delayed);
+      work->qtime += work->delay;
+      work->delay  = 0;
+      dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
+    }
+
+  return WORK_DELAY_MAX;
+}
+
+/****************************************************************************
+ * Name: work_info
+ *
+ * Description:
+ *   Call the work_foreach() handler with a snapshot of one work queue.
+ *
+ ****************************************************************************/
+
+static int work_info(FAR struct kwork_wqueue_s *wqueue, int qid, int cpu,
+                     work_handler_t handler, FAR void *arg)
+{
+  struct work_info_s info;
+#ifdef CONFIG_SCHED_WORKQUEUE_LATENCY
+  irqstate_t flags;
+#endif
+
+  info.name     = wqueue->name;
+  info.qid      = qid;
+  info.cpu      = cpu;
+  info.nthreads = wqueue->nthreads;
+
+#ifdef CONFIG_SCHED_WORKQUEUE_LATENCY
+  flags       = enter_critical_section();
+  info.maxlat = wqueue->maxlat;
+  memcpy(info.latency, wqueue->latency, sizeof(info.latency));
+  leave_critical_section(flags);
+#endif
+
+  return handler(&info, arg);
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -101,126 +263,78 @@
 
 void work_process(FAR struct kwork_wqueue_s *wqueue, int wndx)
 {
-  volatile FAR struct work_s *work;
+  FAR struct work_s *work;
   worker_t  worker;
   irqstate_t flags;
   FAR void *arg;
-  clock_t elapsed;
-  clock_t remaining;
-  clock_t stick;
-  clock_t ctick;
   clock_t next;
+#ifdef CONFIG_SCHED_CRITMONITOR
+  uint32_t start;
+#endif
 
   /* Then process queued work.  We need to keep interrupts disabled while
-   * we process items in the work list.
+   * we manipulate the work lists.
    */
 
-  next  = WORK_DELAY_MAX;
   flags = enter_critical_section();
+  work_critstart(start);
 
-  /* Get the time that we started processing the queue in clock ticks. */
-
-  stick = clock_systimer();
-
-  /* And check each entry in the work queue.  Since we have disabled
-   * interrupts we know:  (1) we will not be suspended unless we do
-   * so ourselves, and (2) there will be no changes to the work queue
-   */
-
-  work = (FAR struct work_s *)wqueue->q.head;
-  while (work != NULL)
+  for (; ; )
     {
-      /* Is this work ready?  It is ready if there is no delay or if
-       * the delay has elapsed. qtime is the time that the work was added
-       * to the work queue.  It will always be greater than or equal to
-       * zero.  Therefore a delay of zero will always execute immediately.
+      /* Move any expired delayed work to the ready list and find out when
+       * the next delayed work will expire.
        */
 
-      ctick   = clock_systimer();
-      elapsed = ctick - work->qtime;
-      if (elapsed >= work->delay)
-        {
-          /* Remove the ready-to-execute work from the list */
-
-          (void)dq_rem((struct dq_entry_s *)work, &wqueue->q);
-
-          /* Extract the work description from the entry (in case the work
-           * instance by the re-used after it has been de-queued).
-           */
-
-          worker = work->worker;
-
-          /* Check for a race condition where the work may be nullified
-           * before it is removed from the queue.
-           */
-
-          if (worker != NULL)
-            {
-              /* Extract the work argument (before re-enabling interrupts) */
-
-              arg = work->arg;
+      next = work_expire(wqueue);
 
-              /* Mark the work as no longer being queued */
+      /* Then take the work at the head of the ready list */
 
-              work->worker = NULL;
-
-              /* Do the work.  Re-enable interrupts while the work is being
-               * performed... we don't have any idea how long this will take!
-               */
+      work = (FAR struct work_s *)dq_remfirst(&wqueue->q);
+      if (work == NULL)
+        {
+          break;
+        }
 
-              leave_critical_section(flags);
-              worker(arg);
+      /* Extract the work description from the entry (in case the work
+       * instance by the re-used after it has been de-queued).
+       */
 
-              /* Now, unfortunately, since we re-enabled interrupts we don't
-               * know the state of the work list and we will have to start
-               * back at the head of the list.
-               */
+      worker = work->worker;
 
-              flags = enter_critical_section();
-              work  = (FAR struct work_s *)wqueue->q.head;
-            }
-          else
-            {
-              /* Cancelled.. Just move to the next work in the list with
-               * interrupts still disabled.
-               */
+      /* Check for a race condition where the work may be nullified
+       * before it is removed from the queue.
+       */
 
-              work = (FAR struct work_s *)work->dq.flink;
-            }
-        }
-      else /* elapsed < work->delay */
+      if (worker != NULL)
         {
-          /* This one is not ready.
-           *
-           * NOTE that elapsed is relative to the current time,
-           * not the time of beginning of this queue processing pass.
-           * So it may need an adjustment.
-           */
+          /* Extract the work argument (before re-enabling interrupts) */
 
-          elapsed += (ctick - stick);
-          if (elapsed > work->delay)
-            {
-              /* The delay has expired while we are processing */
+          arg = work->arg;
 
-              elapsed = work->delay;
-            }
+          /* Mark the work as no longer being queued */
 
-          /* Will it be ready before the next scheduled wakeup interval? */
+          work->worker = NULL;
+          work_latency(wqueue, work);
 
-          remaining = work->delay - elapsed;
-          if (remaining < next)
-            {
-              /* Yes.. Then schedule to wake up when the work is ready */
+          /* Do the work.  Re-enable interrupts while the work is being
+           * performed... we don't have any idea how long this will take!
+           */
 
-              next = remaining;
-            }
+          work_critstop(wqueue, start);
+          leave_critical_section(flags);
+          worker(arg);
 
-          /* Then try the next in the list. */
+          /* Since we re-enabled interrupts, expired work must be checked
+           * again.
+           */
 
-          work = (FAR struct work_s *)work->dq.flink;
+          flags = enter_critical_section();
+          work_critstart(start);
         }
     }
 
+  work_critstop(wqueue, start);
+
   /* When multiple worker threads are created for this work queue, only
    * thread 0 (wndx = 0) will monitor the unexpired works.
    *
@@ -258,4 +372,120 @@ void work_process(FAR struct kwork_wqueue_s *wqueue, int wndx)
   leave_critical_section(flags);
 }
 
+/****************************************************************************
+ * Name: work_critmax
+ *
+ * Description:
+ *   Return the maximum time that the work queue logic kept interrupts
+ *   disabled since the last call, in the units of up_critmon_gettime().
+ *   The maximum is reset.  This does not include the time in the worker
+ *   functions.  That time is attributed to the worker thread as with any
+ *   other thread.
+ *
+ * Input Parameters:
+ *   qid - The work queue ID.  With per-CPU high priority work queues,
+ *         HPWORK reports the maximum of all CPUs.
+ *
+ * Returned Value:
+ *   The maximum time or zero if the work queue does not exist.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CRITMONITOR
+uint32_t work_critmax(int qid)
+{
+  FAR struct kwork_wqueue_s *wqueue;
+  uint32_t maxtime = 0;
+  irqstate_t flags;
+  int nqueues = 1;
+  int i;
+
+  flags  = enter_critical_section();
+  wqueue = work_wqueue(qid);
+
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+  /* Report the maximum of all of the per-CPU work queues */
+
+  if (qid == HPWORK)
+    {
+      wqueue  = (FAR struct kwork_wqueue_s *)&g_hpwork[0];
+      nqueues = HPWORK_NQUEUES;
+    }
+#endif
+
+  for (i = 0; wqueue != NULL && i < nqueues; i++)
+    {
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+      if (nqueues > 1)
+        {
+          wqueue = (FAR struct kwork_wqueue_s *)&g_hpwork[i];
+        }
+#endif
+
+      if (wqueue->crit_max > maxtime)
+        {
+          maxtime = wqueue->crit_max;
+        }
+
+      wqueue->crit_max = 0;
+    }
+
+  leave_critical_section(flags);
+  return maxtime;
+}
+#endif
+
+/****************************************************************************
+ * Name: work_foreach
+ *
+ * Description:
+ *   Call the handler with a description of each kernel work queue.
+ *   Traversal stops if the handler returns a non-zero value.
+ *
+ * Returned Value:
+ *   The last value returned by the handler.
+ *
+ ****************************************************************************/
+
+int work_foreach(work_handler_t handler, FAR void *arg)
+{
+  int ret = OK;
+  int i;
+
+  UNUSED(i);
+
+#ifdef CONFIG_SCHED_HPWORK
+  for (i = 0; ret == OK && i < HPWORK_NQUEUES; i++)
+    {
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+      ret = work_info((FAR struct kwork_wqueue_s *)&g_hpwork[i], HPWORK, i,
+                      handler, arg);
+#else
+      ret = work_info((FAR struct kwork_wqueue_s *)&g_hpwork[i], HPWORK, -1,
+                      handler, arg);
+#endif
+    }
+#endif
+
+#ifdef CONFIG_SCHED_LPWORK
+  if (ret == OK)
+    {
+      ret = work_info((FAR struct kwork_wqueue_s *)&g_lpwork, LPWORK, -1,
+                      handler, arg);
+    }
+#endif
+
+#if defined(CONFIG_SCHED_NAMEDWORK) && CONFIG_SCHED_NAMEDWORK > 0
+  for (i = 0; ret == OK && i < CONFIG_SCHED_NAMEDWORK; i++)
+    {
+      if (g_namedwork[i] != NULL)
+        {
+          ret = work_info(g_namedwork[i], NAMEDWORK + i, -1, handler, arg);
+        }
+    }
+#endif
+
+  return ret;
+}
+
 #endif /* CONFIG_SCHED_WORKQUEUE */
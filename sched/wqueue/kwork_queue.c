@@ -57,6 +57,47 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: work_insert
+ *
+ * Description:
+ *   Insert delayed work into the delayed list, which is ordered by
+ *   expiration time.  New work usually expires after the work already in
+ *   the list, so the search begins at the tail of the list.
+ *
+ * Assumptions:
+ *   Called in a critical section.  work->qtime and work->delay have been
+ *   set.
+ *
+ ****************************************************************************/
+
+static void work_insert(FAR struct kwork_wqueue_s *wqueue,
+                        FAR struct work_s *work)
+{
+  FAR struct work_s *prev;
+  clock_t elapsed;
+  clock_t remaining;
+
+  for (prev = (FAR struct work_s *)wqueue->delayed.tail;
+       prev != NULL;
+       prev = (FAR struct work_s *)prev->dq.blink)
+    {
+      /* Time until the queued work expires (zero if it already has) */
+
+      elapsed   = work->qtime - prev->qtime;
+      remaining = elapsed < prev->delay ? prev->delay - elapsed : 0;
+
+      if (remaining <= work->delay)
+        {
+          dq_addafter((FAR dq_entry_t *)prev, (FAR dq_entry_t *)work,
+                      &wqueue->delayed);
+          return;
+        }
+    }
+
+  dq_addfirst((FAR dq_entry_t *)work, &wqueue->delayed);
+}
+
 /****************************************************************************
  * Name: work_qqueue
  *
@@ -108,7 +149,8 @@ static void work_qqueue(FAR struct kwork_wqueue_s *wqueue,
        * end of the work queue.
        */
 
-      dq_rem((FAR dq_entry_t *)work, &wqueue->q);
+      FAR struct kwork_wqueue_s *oldq = WORK_QUEUE(wqueue, work);
+      dq_rem((FAR dq_entry_t *)work, WORK_LIST(oldq, work));
     }
 
   /* Initialize the work structure. */
@@ -120,8 +162,20 @@ static void work_qqueue(FAR struct kwork_wqueue_s *wqueue,
   /* Now, time-tag that entry and put it in the work queue */
 
   work->qtime  = clock_systimer(); /* Time work queued */
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+  work->wqueue = wqueue;           /* Work queue holding the work */
+#endif
 
-  dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
+  if (delay == 0)
+    {
+      /* The work is ready now */
+
+      dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
+    }
+  else
+    {
+      work_insert(wqueue, work);
+    }
 
   leave_critical_section(flags);
 }
@@ -162,31 +216,75 @@ static void work_qqueue(FAR struct kwork_wqueue_s *wqueue,
 int work_queue(int qid, FAR struct work_s *work, worker_t worker,
                FAR void *arg, clock_t delay)
 {
-  /* Queue the new work */
+  FAR struct kwork_wqueue_s *wqueue;
+  irqstate_t flags;
+  int ret;
+
+  /* Keep the selected work queue (which may depend on the current CPU)
+   * until the worker thread has been signalled.
+   */
+
+  flags  = enter_critical_section();
+  wqueue = work_wqueue(qid);
+  if (wqueue == NULL)
+    {
+      leave_critical_section(flags);
+      return -EINVAL;
+    }
+
+  /* Queue the new work and wake up an idle worker thread */
+
+  work_qqueue(wqueue, work, worker, arg, delay);
+  ret = work_qsignal(wqueue);
+
+  leave_critical_section(flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: work_wqueue
+ *
+ * Description:
+ *   Return the work queue that corresponds to a work queue ID.  With
+ *   per-CPU high priority work queues, HPWORK selects the work queue of
+ *   the current CPU.
+ *
+ * Input Parameters:
+ *   qid - The work queue ID
+ *
+ * Returned Value:
+ *   The work queue or NULL if the work queue ID is not valid.
+ *
+ ****************************************************************************/
 
+FAR struct kwork_wqueue_s *work_wqueue(int qid)
+{
 #ifdef CONFIG_SCHED_HPWORK
   if (qid == HPWORK)
     {
-      /* Queue high priority work */
-
-      work_qqueue((FAR struct kwork_wqueue_s *)&g_hpwork, work, worker, arg, delay);
-      return work_signal(HPWORK);
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+      return (FAR struct kwork_wqueue_s *)&g_hpwork[up_cpu_index()];
+#else
+      return (FAR struct kwork_wqueue_s *)&g_hpwork[0];
+#endif
     }
-  else
 #endif
+
 #ifdef CONFIG_SCHED_LPWORK
   if (qid == LPWORK)
     {
-      /* Queue low priority work */
-
-      work_qqueue((FAR struct kwork_wqueue_s *)&g_lpwork, work, worker, arg, delay);
-      return work_signal(LPWORK);
+      return (FAR struct kwork_wqueue_s *)&g_lpwork;
     }
-  else
 #endif
+
+#if defined(CONFIG_SCHED_NAMEDWORK) && CONFIG_SCHED_NAMEDWORK > 0
+  if (qid >= NAMEDWORK && qid < NAMEDWORK + CONFIG_SCHED_NAMEDWORK)
     {
-      return -EINVAL;
+      return g_namedwork[qid - NAMEDWORK];
     }
+#endif
+
+  return NULL;
 }
 
 #endif /* CONFIG_SCHED_WORKQUEUE */
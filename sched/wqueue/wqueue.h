@@ -43,6 +43,7 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdint.h>
 #include <stdbool.h>
 #include <queue.h>
 
@@ -59,6 +60,26 @@
 #define HPWORKNAME "hpwork"
 #define LPWORKNAME "lpwork"
 
+/* Queued work with a remaining delay is kept in the delayed list, ordered
+ * by expiration time.  All other queued work is in the ready list.  Work is
+ * moved to the ready list (and its delay set to zero) when it expires.
+ */
+
+#define WORK_LIST(wq,w) ((w)->delay > 0 ? &(wq)->delayed : &(wq)->q)
+
+/* With per-CPU high priority work queues, work queued with HPWORK may be in
+ * the work queue of any CPU so each work structure records the work queue
+ * that holds it.
+ */
+
+#ifdef CONFIG_SCHED_HPWORK_PERCPU
+#  define HPWORK_NQUEUES   CONFIG_SMP_NCPUS
+#  define WORK_QUEUE(wq,w) ((FAR struct kwork_wqueue_s *)(w)->wqueue)
+#else
+#  define HPWORK_NQUEUES   1
+#  define WORK_QUEUE(wq,w) (wq)
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -75,7 +96,17 @@ struct kworker_s
 
 struct kwork_wqueue_s
 {
-  struct dq_queue_s q;         /* The queue of pending work */
+  struct dq_queue_s q;         /* The queue of ready work */
+  struct dq_queue_s delayed;   /* Delayed work, ordered by expiration */
+  FAR const char   *name;      /* Name of the work queue */
+  uint8_t           nthreads;  /* Number of worker threads */
+#ifdef CONFIG_SCHED_CRITMONITOR
+  uint32_t          crit_max;  /* Max time in a critical section */
+#endif
+#ifdef CONFIG_SCHED_WORKQUEUE_LATENCY
+  clock_t           maxlat;    /* Largest latency (ticks) */
+  uint32_t          latency[CONFIG_SCHED_WORKQUEUE_NLATENCY];
+#endif
   struct kworker_s  worker[1]; /* Describes a worker thread */
 };
 
@@ -86,7 +117,17 @@ struct kwork_wqueue_s
 #ifdef CONFIG_SCHED_HPWORK
 struct hp_wqueue_s
 {
-  struct dq_queue_s q;         /* The queue of pending work */
+  struct dq_queue_s q;         /* The queue of ready work */
+  struct dq_queue_s delayed;   /* Delayed work, ordered by expiration */
+  FAR const char   *name;      /* Name of the work queue */
+  uint8_t           nthreads;  /* Number of worker threads */
+#ifdef CONFIG_SCHED_CRITMONITOR
+  uint32_t          crit_max;  /* Max time in a critical section */
+#endif
+#ifdef CONFIG_SCHED_WORKQUEUE_LATENCY
+  clock_t           maxlat;    /* Largest latency (ticks) */
+  uint32_t          latency[CONFIG_SCHED_WORKQUEUE_NLATENCY];
+#endif
 
   /* Describes each thread in the high priority queue's thread pool */
 
@@ -101,7 +142,17 @@ struct hp_wqueue_s
 #ifdef CONFIG_SCHED_LPWORK
 struct lp_wqueue_s
 {
-  struct dq_queue_s q;      /* The queue of pending work */
+  struct dq_queue_s q;         /* The queue of ready work */
+  struct dq_queue_s delayed;   /* Delayed work, ordered by expiration */
+  FAR const char   *name;      /* Name of the work queue */
+  uint8_t           nthreads;  /* Number of worker threads */
+#ifdef CONFIG_SCHED_CRITMONITOR
+  uint32_t          crit_max;  /* Max time in a critical section */
+#endif
+#ifdef CONFIG_SCHED_WORKQUEUE_LATENCY
+  clock_t           maxlat;    /* Largest latency (ticks) */
+  uint32_t          latency[CONFIG_SCHED_WORKQUEUE_NLATENCY];
+#endif
 
   /* Describes each thread in the low priority queue's thread pool */
 
@@ -114,9 +165,11 @@ struct lp_wqueue_s
  ****************************************************************************/
 
 #ifdef CONFIG_SCHED_HPWORK
-/* The state of the kernel mode, high priority work queue. */
+/* The state of the kernel mode, high priority work queue (one per CPU if
+ * CONFIG_SCHED_HPWORK_PERCPU is selected).
+ */
 
-extern struct hp_wqueue_s g_hpwork;
+extern struct hp_wqueue_s g_hpwork[HPWORK_NQUEUES];
 #endif
 
 #ifdef CONFIG_SCHED_LPWORK
@@ -125,6 +178,14 @@ extern struct hp_wqueue_s g_hpwork;
 extern struct lp_wqueue_s g_lpwork;
 #endif
 
+#if defined(CONFIG_SCHED_NAMEDWORK) && CONFIG_SCHED_NAMEDWORK > 0
+/* The state of the named kernel work queues created by work_create().  The
+ * work queue ID of g_namedwork[n] is (NAMEDWORK + n).
+ */
+
+extern FAR struct kwork_wqueue_s *g_namedwork[CONFIG_SCHED_NAMEDWORK];
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -167,6 +228,40 @@ int work_hpstart(void);
 int work_lpstart(void);
 #endif
 
+/****************************************************************************
+ * Name: work_wqueue
+ *
+ * Description:
+ *   Return the work queue that corresponds to a work queue ID.  With
+ *   per-CPU high priority work queues, HPWORK selects the work queue of
+ *   the current CPU.
+ *
+ * Input Parameters:
+ *   qid - The work queue ID
+ *
+ * Returned Value:
+ *   The work queue or NULL if the work queue ID is not valid.
+ *
+ ****************************************************************************/
+
+FAR struct kwork_wqueue_s *work_wqueue(int qid);
+
+/****************************************************************************
+ * Name: work_qsignal
+ *
+ * Description:
+ *   Wake up an idle worker thread of a work queue, if there is one.
+ *
+ * Input Parameters:
+ *   wqueue - The work queue to be signalled
+ *
+ * Returned Value:
+ *   Zero (OK) on success, a negated errno value on failure
+ *
+ ****************************************************************************/
+
+int work_qsignal(FAR struct kwork_wqueue_s *wqueue);
+
 /****************************************************************************
  * Name: work_process
  *
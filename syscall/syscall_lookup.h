@@ -277,8 +277,9 @@ SYSCALL_LOOKUP(up_assert,                  2, STUB_up_assert)
   SYSCALL_LOOKUP(sched_getstreams,         0, STUB_sched_getstreams)
 #endif
 
-#if defined(CONFIG_NET_SENDFILE)
+#if defined(CONFIG_FS_SENDFILE)
   SYSCALL_LOOKUP(sendfile,                 4, STUB_fs_sendifile)
+  SYSCALL_LOOKUP(splice,                   6, STUB_splice)
 #endif
 
 #if !defined(CONFIG_DISABLE_MOUNTPOINT)
@@ -283,6 +283,9 @@ uintptr_t STUB_fs_fdopen(int nbr, uintptr_t parm1, uintptr_t parm2,
 uintptr_t STUB_sched_getstreams(int nbr);
 
 ssize_t sendfile(int outfd, int infd, FAR off_t *offset, size_t count);
+uintptr_t STUB_splice(int nbr, uintptr_t parm1, uintptr_t parm2,
+            uintptr_t parm3, uintptr_t parm4, uintptr_t parm5,
+            uintptr_t parm6);
 
 uintptr_t STUB_fsync(int nbr, uintptr_t parm1);
 uintptr_t STUB_ftruncate(int nbr, uintptr_t parm1, uintptr_t parm2);
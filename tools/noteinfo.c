@@ -728,7 +728,7 @@ struct note_common_s
   uint8_t nc_systime[4];       /* Time when note buffered */
 };
 
-#define NTYPES 18
+#define NTYPES 19
 static char *noteid[NTYPES] =
 {
   "NOTE_START",           /* type = 0 */
@@ -752,7 +752,9 @@ static char *noteid[NTYPES] =
   "NOTE_SPINLOCK_LOCK",   /* type = 14 */
   "NOTE_SPINLOCK_LOCKED", /* type = 15 */
   "NOTE_SPINLOCK_UNLOCK", /* type = 16 */
-  "NOTE_SPINLOCK_ABORT"   /* type = 17 */
+  "NOTE_SPINLOCK_ABORT",  /* type = 17 */
+
+  "NOTE_CPU_MIGRATE"      /* type = 18 */
 };
 
 static unsigned int next_ndx(unsigned int ndx)
@@ -843,6 +845,7 @@ int main(int argc, char **argv)
             case 4: /* NOTE_CPU_START */
             case 6: /* NOTE_CPU_PAUSE */
             case 8: /* NOTE_CPU_RESUME */
+            case 18: /* NOTE_CPU_MIGRATE */
               printf(" Target CPU%u", (unsigned int)buffer[bufndx]);
               bufndx++;
               remainder--;